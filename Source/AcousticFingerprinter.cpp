@@ -0,0 +1,410 @@
+/*
+  ==============================================================================
+
+    AcousticFingerprinter.cpp
+    Created: 19 Oct 2026 1:08:16pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "AcousticFingerprinter.h"
+#include <algorithm>
+#include <numeric>
+
+AcousticFingerprinter::AcousticFingerprinter(juce::AudioFormatManager& _formatManager,
+                                             AnalysisScheduler& _scheduler,
+                                             Listener& _listener)
+                                            : formatManager(_formatManager),
+                                              scheduler(_scheduler),
+                                              listener(_listener)
+{
+}
+
+AcousticFingerprinter::~AcousticFingerprinter()
+{
+    cancelSearch();
+}
+
+void AcousticFingerprinter::findDuplicates(std::vector<Candidate> tracks)
+{
+    auto search = std::make_shared<Search>();
+    const int numTracks = (int) tracks.size();
+    std::vector<std::shared_ptr<AnalysisJob>> previousJobs;
+
+    {
+        // A newer generation makes the previous search's result stale, so it is never delivered.
+        const juce::ScopedLock sl(lock);
+        search->generation = ++searchGeneration;
+        result.clear();
+        hasResult = false;
+
+        // Jobs that have stopped are forgotten; the rest are still waited for by the destructor.
+        auto hasFinished = [](const std::shared_ptr<AnalysisJob>& job)
+        {
+            return job->waitUntilFinished(0);
+        };
+
+        searchJobs.erase(std::remove_if(searchJobs.begin(), searchJobs.end(), hasFinished), searchJobs.end());
+        previousJobs = searchJobs;
+    }
+
+    cancelPendingUpdate();
+
+    // Abandon the previous search without blocking the message thread on its running decodes.
+    for (auto& job : previousJobs)
+    {
+        job->cancel();
+    }
+
+    search->candidates = std::move(tracks);
+    search->fingerprints.resize((size_t) numTracks);
+    search->isFingerprinted.assign((size_t) numTracks, 0);
+    search->numRemaining = numTracks;
+
+    if (numTracks == 0)
+    {
+        {
+            const juce::ScopedLock sl(lock);
+            hasResult = true;
+        }
+
+        triggerAsyncUpdate();
+        return;
+    }
+
+    std::vector<std::shared_ptr<AnalysisJob>> jobs;
+
+    for (int i = 0; i < numTracks; ++i)
+    {
+        jobs.push_back(std::make_shared<FingerprintJob>(*this, search, i));
+    }
+
+    {
+        const juce::ScopedLock sl(lock);
+        searchJobs.insert(searchJobs.end(), jobs.begin(), jobs.end());
+    }
+
+    // The user asked for this search, so it goes ahead of bulk library analysis.
+    for (auto& job : jobs)
+    {
+        scheduler.addJob(job, AnalysisScheduler::Priority::normal);
+    }
+}
+
+void AcousticFingerprinter::cancelSearch()
+{
+    std::vector<std::shared_ptr<AnalysisJob>> jobs;
+
+    {
+        const juce::ScopedLock sl(lock);
+        jobs.swap(searchJobs);
+    }
+
+    for (auto& job : jobs)
+    {
+        job->cancel();
+    }
+
+    for (auto& job : jobs)
+    {
+        job->waitUntilFinished(-1);
+    }
+
+    cancelPendingUpdate();
+
+    const juce::ScopedLock sl(lock);
+    result.clear();
+    hasResult = false;
+}
+
+bool AcousticFingerprinter::computeFingerprint(juce::AudioFormatReader& reader, const AnalysisJob* job, Fingerprint& fingerprint)
+{
+    if (reader.sampleRate <= 0.0)
+    {
+        return false;
+    }
+
+    fingerprint.lengthInSeconds = reader.lengthInSamples / reader.sampleRate;
+    fingerprint.frames.clear();
+
+    // Map every FFT bin to the pitch class of its frequency (-1 outside the musical range).
+    std::vector<int> pitchClasses(fftSize / 2, -1);
+
+    for (int bin = 1; bin < fftSize / 2; ++bin)
+    {
+        double frequency = bin * reader.sampleRate / fftSize;
+
+        if (frequency >= 55.0 && frequency <= 5000.0)
+        {
+            int midiNote = juce::roundToInt(69.0 + 12.0 * std::log2(frequency / 440.0));
+            pitchClasses[bin] = ((midiNote % 12) + 12) % 12;
+        }
+    }
+
+    juce::dsp::FFT fft(fftOrder);
+    juce::dsp::WindowingFunction<float> window((size_t) fftSize, juce::dsp::WindowingFunction<float>::hann);
+    juce::AudioBuffer<float> block(2, fftSize);
+    std::vector<float> fftData(2 * fftSize);
+    float chroma[12];
+    float previousChroma[12] = {};
+
+    auto hopSize = (juce::int64) (secondsPerFrame * reader.sampleRate);
+    auto numFrames = (juce::int64) (juce::jmin(secondsToFingerprint, fingerprint.lengthInSeconds) / secondsPerFrame);
+
+    for (juce::int64 frame = 0; frame < numFrames; ++frame)
+    {
+        if (job != nullptr && job->shouldExit())
+        {
+            return false;
+        }
+
+        reader.read(&block, 0, fftSize, frame * hopSize, true, true);
+
+        // Mix down to mono.
+        for (int i = 0; i < fftSize; ++i)
+        {
+            fftData[i] = 0.5f * (block.getSample(0, i) + block.getSample(1, i));
+        }
+
+        std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+        window.multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+        fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+        std::fill(chroma, chroma + 12, 0.0f);
+
+        for (int bin = 1; bin < fftSize / 2; ++bin)
+        {
+            if (pitchClasses[bin] >= 0)
+            {
+                chroma[pitchClasses[bin]] += fftData[bin] * fftData[bin];
+            }
+        }
+
+        float total = std::accumulate(chroma, chroma + 12, 0.0f);
+        juce::uint32 word = 0;
+
+        if (total > 1.0e-6f)
+        {
+            // Bits 0-11: how the pitch classes compare with their neighbours.
+            // Bits 12-23: which pitch classes got stronger since the previous frame.
+            for (int i = 0; i < 12; ++i)
+            {
+                chroma[i] /= total;
+            }
+
+            for (int i = 0; i < 12; ++i)
+            {
+                if (chroma[i] > chroma[(i + 1) % 12])
+                {
+                    word |= 1u << i;
+                }
+            }
+
+            for (int i = 0; i < 12; ++i)
+            {
+                if (chroma[i] > previousChroma[i])
+                {
+                    word |= 1u << (12 + i);
+                }
+            }
+
+            std::copy(chroma, chroma + 12, previousChroma);
+        }
+
+        fingerprint.frames.push_back(word);
+    }
+
+    return (int) fingerprint.frames.size() >= minFramesToCompare;
+}
+
+bool AcousticFingerprinter::isSameRecording(const Fingerprint& first, const Fingerprint& second)
+{
+    if (std::abs(first.lengthInSeconds - second.lengthInSeconds) > maxLengthDifference)
+    {
+        return false;
+    }
+
+    const int numFirst = (int) first.frames.size();
+    const int numSecond = (int) second.frames.size();
+
+    for (int offset = -maxFrameOffset; offset <= maxFrameOffset; ++offset)
+    {
+        int numBits = 0;
+        int numDifferentBits = 0;
+
+        for (int i = juce::jmax(0, -offset); i < numFirst && i + offset < numSecond; ++i)
+        {
+            juce::uint32 a = first.frames[i];
+            juce::uint32 b = second.frames[i + offset];
+
+            // Silent frames carry no information.
+            if (a != 0 || b != 0)
+            {
+                numBits += 24;
+                numDifferentBits += juce::countNumberOfBits(a ^ b);
+            }
+        }
+
+        if (numBits >= 24 * minFramesToCompare && numDifferentBits <= maxBitErrorRate * numBits)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void AcousticFingerprinter::handleAsyncUpdate()
+{
+    std::vector<std::vector<TrackId>> groups;
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        if (!hasResult)
+        {
+            return;
+        }
+
+        groups.swap(result);
+        hasResult = false;
+    }
+
+    listener.duplicateRecordingsFound(groups);
+}
+
+std::vector<std::vector<TrackId>> AcousticFingerprinter::groupDuplicates(const std::vector<TrackId>& ids,
+                                                                         const std::vector<Fingerprint>& fingerprints,
+                                                                         const AnalysisJob& job)
+{
+    const int numTracks = (int) ids.size();
+
+    // Sort by length so that only tracks of similar length are compared.
+    std::vector<int> byLength(numTracks);
+    std::iota(byLength.begin(), byLength.end(), 0);
+    std::sort(byLength.begin(), byLength.end(), [&fingerprints](int a, int b)
+    {
+        return fingerprints[a].lengthInSeconds < fingerprints[b].lengthInSeconds;
+    });
+
+    // Union-find over the tracks, joining every pair that is the same recording.
+    std::vector<int> parent(numTracks);
+    std::iota(parent.begin(), parent.end(), 0);
+
+    auto findRoot = [&parent](int i)
+    {
+        while (parent[i] != i)
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+
+        return i;
+    };
+
+    for (int i = 0; i < numTracks && !job.shouldExit(); ++i)
+    {
+        const Fingerprint& fingerprint = fingerprints[byLength[i]];
+
+        for (int j = i + 1; j < numTracks; ++j)
+        {
+            const Fingerprint& other = fingerprints[byLength[j]];
+
+            if (other.lengthInSeconds - fingerprint.lengthInSeconds > maxLengthDifference)
+            {
+                break;
+            }
+
+            if (isSameRecording(fingerprint, other))
+            {
+                parent[findRoot(byLength[j])] = findRoot(byLength[i]);
+            }
+        }
+    }
+
+    std::vector<std::vector<TrackId>> groups;
+    std::vector<int> groupOfRoot(numTracks, -1);
+
+    for (int i = 0; i < numTracks; ++i)
+    {
+        int root = findRoot(i);
+
+        if (root == i)
+        {
+            continue;
+        }
+
+        if (groupOfRoot[root] < 0)
+        {
+            groupOfRoot[root] = (int) groups.size();
+            groups.push_back({ ids[root] });
+        }
+
+        groups[groupOfRoot[root]].push_back(ids[i]);
+    }
+
+    return groups;
+}
+
+AcousticFingerprinter::FingerprintJob::FingerprintJob(AcousticFingerprinter& _owner,
+                                                      std::shared_ptr<Search> _search,
+                                                      int _index)
+                                                     : owner(_owner),
+                                                       search(std::move(_search)),
+                                                       index(_index)
+{
+}
+
+void AcousticFingerprinter::FingerprintJob::runJob()
+{
+    const Candidate& track = search->candidates[(size_t) index];
+
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        owner.formatManager.createReaderFor(juce::URL{ track.path }.createInputStream(false)));
+
+    if (reader != nullptr && !shouldExit())
+    {
+        search->isFingerprinted[(size_t) index] = computeFingerprint(*reader, this, search->fingerprints[(size_t) index]);
+    }
+
+    // Only the last job of the search to finish goes on to group the duplicates.
+    if (search->numRemaining.fetch_sub(1) != 1 || shouldExit())
+    {
+        return;
+    }
+
+    std::vector<TrackId> ids;
+    std::vector<Fingerprint> fingerprints;
+
+    for (size_t i = 0; i < search->candidates.size(); ++i)
+    {
+        if (search->isFingerprinted[i])
+        {
+            ids.push_back(search->candidates[i].id);
+            fingerprints.push_back(std::move(search->fingerprints[i]));
+        }
+    }
+
+    auto groups = groupDuplicates(ids, fingerprints, *this);
+
+    if (shouldExit())
+    {
+        return;
+    }
+
+    {
+        const juce::ScopedLock sl(owner.lock);
+
+        // A newer search has started since this one, so nobody is waiting for this result.
+        if (search->generation != owner.searchGeneration)
+        {
+            return;
+        }
+
+        owner.result = std::move(groups);
+        owner.hasResult = true;
+    }
+
+    owner.triggerAsyncUpdate();
+}
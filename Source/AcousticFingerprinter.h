@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+    AcousticFingerprinter.h
+    Created: 19 Oct 2026 1:08:16pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Track.h"
+#include "AnalysisScheduler.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/*
+    Finds tracks in the music library that are the same recording stored in
+    different files, e.g. an MP3 and a FLAC of the same song, or the same song
+    ripped at two bitrates. Such files have different contents, so they can't be
+    caught by the content hash.
+
+    Runs in the background on the AnalysisScheduler, one job per track: the
+    first seconds of every track are decoded and turned into a chroma-based
+    fingerprint (one 24-bit word per 100 ms), and once all are done, tracks of
+    similar length whose fingerprints mostly agree are reported as duplicates.
+*/
+class AcousticFingerprinter : private juce::AsyncUpdater
+{
+    public:
+        /** A track to be checked. */
+        struct Candidate
+        {
+            TrackId id;
+            juce::String path;
+        };
+
+        /** The fingerprint of the beginning of a track. */
+        struct Fingerprint
+        {
+            double lengthInSeconds;
+            std::vector<juce::uint32> frames;
+        };
+
+        /** Receives the result of a duplicate search on the message thread. */
+        class Listener
+        {
+            public:
+                virtual ~Listener() = default;
+
+                /**
+                * PURPOSE: Called when a duplicate search has finished.
+                * INPUTS: Groups of IDs of tracks that are the same recording.
+                * OUTPUTS: None.
+                */
+                virtual void duplicateRecordingsFound(const std::vector<std::vector<TrackId>>& groups) = 0;
+        };
+
+        /**
+        * PURPOSE: Creates the AcousticFingerprinter object.
+        * INPUTS: A reference to the juce AudioFormatManager used to decode the tracks, the scheduler
+        *         to run the search on and the listener that receives the results.
+        * OUTPUTS: None.
+        */
+        AcousticFingerprinter(juce::AudioFormatManager& _formatManager,
+                              AnalysisScheduler& _scheduler,
+                              Listener& _listener);
+
+        /**
+        * PURPOSE: Destroys the AcousticFingerprinter object, stopping any search still running.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~AcousticFingerprinter() override;
+
+        /**
+        * PURPOSE: Starts looking for duplicate recordings in the background, abandoning any previous search.
+        *          The previous search's jobs are cancelled but not waited for; its result is dropped if it comes in.
+        * INPUTS: The tracks to be checked.
+        * OUTPUTS: None.
+        */
+        void findDuplicates(std::vector<Candidate> tracks);
+
+        /**
+        * PURPOSE: Decodes the beginning of a track and computes its fingerprint.
+        * INPUTS: A reader for the track, the job doing it (checked for cancellation between frames,
+        *         may be nullptr) and a reference to the fingerprint to be filled.
+        * OUTPUTS: A boolean; true if a usable fingerprint was computed and false if the track is
+        *          too short or the job was cancelled.
+        */
+        static bool computeFingerprint(juce::AudioFormatReader& reader, const AnalysisJob* job, Fingerprint& fingerprint);
+
+        /**
+        * PURPOSE: Compares two fingerprints, allowing for a small time offset between them
+        *          (e.g. the different encoder delays of MP3 and FLAC).
+        * INPUTS: The two fingerprints.
+        * OUTPUTS: A boolean; true if they are the same recording and false if they aren't.
+        */
+        static bool isSameRecording(const Fingerprint& first, const Fingerprint& second);
+
+    private:
+        /** The state of one duplicate search, shared by the jobs fingerprinting its tracks. */
+        struct Search
+        {
+            std::vector<Candidate> candidates;
+            std::vector<Fingerprint> fingerprints;
+            std::vector<char> isFingerprinted;
+            std::atomic<int> numRemaining{ 0 };
+            int generation = 0;
+        };
+
+        /** The job that fingerprints one track of a search. The last one to finish groups the duplicates. */
+        class FingerprintJob : public AnalysisJob
+        {
+            public:
+                /**
+                * PURPOSE: Creates the FingerprintJob object.
+                * INPUTS: The fingerprinter that owns it, the search and the index of the track in the search.
+                * OUTPUTS: None.
+                */
+                FingerprintJob(AcousticFingerprinter& _owner, std::shared_ptr<Search> _search, int _index);
+
+                /**
+                * PURPOSE: Fingerprints the track. Implements AnalysisJob (i.e. function is pure virtual).
+                * INPUTS: None.
+                * OUTPUTS: None.
+                */
+                void runJob() override;
+
+                /** DATA MEMBERS */
+
+                AcousticFingerprinter& owner;
+                std::shared_ptr<Search> search;
+                const int index;
+        };
+
+        /**
+        * PURPOSE: Cancels every search and waits for its running jobs to stop, which is quick
+        *          as the jobs check for cancellation between frames.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void cancelSearch();
+
+        /**
+        * PURPOSE: Delivers the result of the finished search to the listener.
+        *          Implements juce AsyncUpdater (i.e. function is pure virtual).
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void handleAsyncUpdate() override;
+
+        /**
+        * PURPOSE: Groups the fingerprinted tracks that are the same recording.
+        * INPUTS: The IDs of the fingerprinted tracks, their fingerprints and the job doing the
+        *         grouping (checked for cancellation).
+        * OUTPUTS: The groups of duplicate tracks (only groups of two or more tracks).
+        */
+        static std::vector<std::vector<TrackId>> groupDuplicates(const std::vector<TrackId>& ids,
+                                                                 const std::vector<Fingerprint>& fingerprints,
+                                                                 const AnalysisJob& job);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int fftOrder = 12;
+        static constexpr int fftSize = 1 << fftOrder;
+        static constexpr double secondsPerFrame = 0.1;
+        static constexpr double secondsToFingerprint = 30.0;
+        static constexpr int minFramesToCompare = 30;
+        static constexpr int maxFrameOffset = 2;
+        static constexpr double maxLengthDifference = 1.0;
+        static constexpr double maxBitErrorRate = 0.15;
+
+        juce::AudioFormatManager& formatManager;
+        AnalysisScheduler& scheduler;
+        Listener& listener;
+
+        juce::CriticalSection lock;
+        std::vector<std::shared_ptr<AnalysisJob>> searchJobs;
+        std::vector<std::vector<TrackId>> result;
+        int searchGeneration = 0;
+        bool hasResult = false;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AcousticFingerprinter)
+};
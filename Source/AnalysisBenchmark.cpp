@@ -0,0 +1,238 @@
+/*
+  ==============================================================================
+
+    AnalysisBenchmark.cpp
+    Created: 19 Oct 2026 9:05:18pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "AnalysisBenchmark.h"
+#include "BenchmarkRunner.h"
+#include <cmath>
+
+AnalysisBenchmark::AnalysisBenchmark()
+                                    : random(20261019)
+{
+    formatManager.registerBasicFormats();
+}
+
+AnalysisBenchmark::~AnalysisBenchmark()
+{
+}
+
+juce::var AnalysisBenchmark::runFromCommandLine(const juce::StringArray& arguments)
+{
+    juce::String numTracks = BenchmarkRunner::getOption(arguments, "--tracks");
+    int numSyntheticTracks = numTracks.isNotEmpty() && numTracks.getIntValue() >= 0 ? numTracks.getIntValue() : 50;
+
+    AnalysisBenchmark benchmark;
+
+    return benchmark.run(numSyntheticTracks, BenchmarkRunner::getFileOption(arguments, "--corpus"));
+}
+
+juce::var AnalysisBenchmark::run(int numSyntheticTracks, const juce::File& corpusFolder)
+{
+    juce::DynamicObject::Ptr trackAnalysis = new juce::DynamicObject();
+    trackAnalysis->setProperty("synthetic", benchmarkSyntheticTracks(numSyntheticTracks));
+
+    if (corpusFolder.isDirectory())
+    {
+        trackAnalysis->setProperty("folder", benchmarkFolder(corpusFolder));
+    }
+
+    juce::DynamicObject::Ptr results = BenchmarkRunner::createResults();
+    results->setProperty("trackAnalysis", juce::var(trackAnalysis.get()));
+
+    return juce::var(results.get());
+}
+
+juce::var AnalysisBenchmark::benchmarkSyntheticTracks(int numTracks)
+{
+    AnalysisScores scores;
+
+    for (int i = 0; i < numTracks; ++i)
+    {
+        // Tempos to a tenth of a BPM, over the range DJs play.
+        double bpm = std::round(700.0 + random.nextDouble() * 1100.0) / 10.0;
+        double firstBeatSeconds = random.nextDouble() * 60.0 / bpm;
+
+        auto reader = createSyntheticTrack(bpm, firstBeatSeconds, syntheticTrackSeconds);
+
+        if (reader != nullptr)
+        {
+            measureTrack(*reader, bpm, firstBeatSeconds, CamelotKey::noKey, scores);
+        }
+    }
+
+    return toVar(scores);
+}
+
+juce::var AnalysisBenchmark::benchmarkFolder(const juce::File& folder)
+{
+    AnalysisScores scores;
+
+    for (const auto& entry : juce::RangedDirectoryIterator(folder, true, formatManager.getWildcardForAllFormats()))
+    {
+        juce::File file = entry.getFile();
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+        if (reader == nullptr)
+        {
+            continue;
+        }
+
+        // The BPM and key tags are the reference; the files don't say where their first beat is.
+        Track track{ "", juce::URL{ file }.toString(false) };
+        metadataScanner.scan(file, track);
+
+        measureTrack(*reader, track.bpm, -1.0, CamelotKey::parse(track.key), scores);
+    }
+
+    return toVar(scores);
+}
+
+std::unique_ptr<juce::AudioFormatReader> AnalysisBenchmark::createSyntheticTrack(double bpm,
+                                                                                 double firstBeatSeconds,
+                                                                                 double lengthInSeconds)
+{
+    const int numSamples = (int) (lengthInSeconds * sampleRate);
+    const double beatSeconds = 60.0 / bpm;
+    const double bassHz = 55.0 * std::pow(2.0, random.nextInt(12) / 12.0);
+    juce::AudioBuffer<float> buffer(2, numSamples);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        double time = i / sampleRate;
+        double beatPosition = (time - firstBeatSeconds) / beatSeconds;
+        double sinceBeat = (beatPosition - std::floor(beatPosition)) * beatSeconds;
+        double sinceOffbeat = std::fmod(sinceBeat + beatSeconds / 2.0, beatSeconds);
+        bool isDownbeat = ((int) std::floor(beatPosition) % 4) == 0;
+
+        float sample = 0.05f * (random.nextFloat() * 2.0f - 1.0f);
+
+        if (time >= firstBeatSeconds)
+        {
+            // Kick: a falling sine with a click, accented on the downbeat.
+            double pitch = 2.0 * juce::MathConstants<double>::pi * 55.0 * sinceBeat * (1.0 + 2.0 * std::exp(-sinceBeat * 40.0));
+            sample += (isDownbeat ? 0.9f : 0.7f) * (float) (std::exp(-sinceBeat * 30.0) * std::sin(pitch));
+
+            // Hi-hat: a burst of noise between the beats.
+            sample += 0.15f * (float) std::exp(-sinceOffbeat * 80.0) * (random.nextFloat() * 2.0f - 1.0f);
+        }
+
+        // Bassline: a held note that swells over every bar.
+        sample += 0.1f * (float) (std::sin(2.0 * juce::MathConstants<double>::pi * bassHz * time)
+                                  * (0.5 + 0.5 * std::sin(2.0 * juce::MathConstants<double>::pi * time / (4.0 * beatSeconds))));
+
+        buffer.setSample(0, i, sample);
+        buffer.setSample(1, i, sample);
+    }
+
+    juce::MemoryBlock wavData;
+    juce::WavAudioFormat wavFormat;
+
+    {
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            wavFormat.createWriterFor(new juce::MemoryOutputStream(wavData, false), sampleRate, 2, 16, {}, 0));
+
+        if (writer == nullptr)
+        {
+            return nullptr;
+        }
+
+        writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+    }
+
+    return std::unique_ptr<juce::AudioFormatReader>(
+        wavFormat.createReaderFor(new juce::MemoryInputStream(wavData, true), true));
+}
+
+void AnalysisBenchmark::measureTrack(juce::AudioFormatReader& reader,
+                                     double trueBpm,
+                                     double trueFirstBeatSeconds,
+                                     int trueKey,
+                                     AnalysisScores& scores)
+{
+    TrackAnalyser::Result result;
+    double startMs = juce::Time::getMillisecondCounterHiRes();
+
+    // The same decoding pass as the app's background analysis, so decoding is part of the cost.
+    TrackAnalyser::decodeTrack(reader, nullptr, result);
+
+    const BeatDetector::BeatGrid& grid = result.beatGrid;
+
+    scores.analysisSeconds += (juce::Time::getMillisecondCounterHiRes() - startMs) / 1000.0;
+    scores.audioSeconds += reader.lengthInSamples / reader.sampleRate;
+    scores.numTracks++;
+
+    if (trueKey != CamelotKey::noKey)
+    {
+        scores.numWithKeyReference++;
+        scores.numKeysCorrect += result.key.key == trueKey ? 1 : 0;
+        scores.numKeysCompatible += CamelotKey::areCompatible(trueKey, result.key.key) ? 1 : 0;
+    }
+
+    if (trueBpm <= 0.0)
+    {
+        return;
+    }
+
+    scores.numWithReference++;
+
+    double ratio = grid.bpm / trueBpm;
+    bool isCorrect = std::abs(ratio - 1.0) <= tempoTolerance;
+    bool isCorrectUpToOctave = isCorrect;
+
+    for (double factor : { 2.0, 0.5, 3.0, 1.0 / 3.0 })
+    {
+        isCorrectUpToOctave = isCorrectUpToOctave || std::abs(ratio / factor - 1.0) <= tempoTolerance;
+    }
+
+    scores.numCorrect += isCorrect ? 1 : 0;
+    scores.numCorrectUpToOctave += isCorrectUpToOctave ? 1 : 0;
+
+    if (isCorrect && trueFirstBeatSeconds >= 0.0)
+    {
+        // The distance to the nearest true beat.
+        double beatSeconds = 60.0 / trueBpm;
+        double error = std::fmod(std::abs(grid.firstBeatSeconds - trueFirstBeatSeconds), beatSeconds);
+
+        scores.totalPhaseErrorMs += 1000.0 * juce::jmin(error, beatSeconds - error);
+        scores.numPhasesChecked++;
+    }
+}
+
+juce::var AnalysisBenchmark::toVar(const AnalysisScores& scores)
+{
+    juce::DynamicObject::Ptr result = new juce::DynamicObject();
+    result->setProperty("tracks", scores.numTracks);
+    result->setProperty("tracksWithReference", scores.numWithReference);
+
+    if (scores.numWithReference > 0)
+    {
+        result->setProperty("accuracy1", (double) scores.numCorrect / scores.numWithReference);
+        result->setProperty("accuracy2", (double) scores.numCorrectUpToOctave / scores.numWithReference);
+    }
+
+    if (scores.numWithKeyReference > 0)
+    {
+        result->setProperty("tracksWithKeyReference", scores.numWithKeyReference);
+        result->setProperty("keyAccuracy", (double) scores.numKeysCorrect / scores.numWithKeyReference);
+        result->setProperty("keyAccuracyCompatible", (double) scores.numKeysCompatible / scores.numWithKeyReference);
+    }
+
+    if (scores.numPhasesChecked > 0)
+    {
+        result->setProperty("meanPhaseErrorMs", scores.totalPhaseErrorMs / scores.numPhasesChecked);
+    }
+
+    if (scores.analysisSeconds > 0.0)
+    {
+        result->setProperty("tracksPerSecondPerCore", scores.numTracks / scores.analysisSeconds);
+        result->setProperty("audioSecondsPerSecond", scores.audioSeconds / scores.analysisSeconds);
+    }
+
+    return juce::var(result.get());
+}
@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+    AnalysisBenchmark.h
+    Created: 19 Oct 2026 9:05:18pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "BeatDetector.h"
+#include "KeyDetector.h"
+#include "CamelotKey.h"
+#include "TrackAnalyser.h"
+#include "TrackMetadataScanner.h"
+#include <memory>
+
+//==============================================================================
+/*
+    Measures the accuracy and the throughput of the track analysers.
+
+    Two corpora are used. The synthetic corpus is generated in memory: short
+    drum and bass loops at random tempos and phases, so the true beat grid of
+    every track is known. The folder corpus is any folder of music files; the
+    BPM and key tags of its files are taken as the truth, and untagged files only
+    count towards the throughput. The synthetic tracks have no key, so key
+    accuracy is only measured on the folder corpus.
+
+    Tempo accuracy is reported the usual way: "accuracy1" is the share of
+    tracks within 4% of the true BPM and "accuracy2" also accepts half, double,
+    a third and three times the true BPM. Key accuracy is the share of tracks
+    whose key is exactly right, and "keyAccuracyCompatible" also accepts the
+    keys next to it on the Camelot wheel. Throughput is measured on a single
+    thread, so tracks per second is also tracks per second per core.
+
+    Run the app with "--analysis-benchmark [output.json] [--tracks 50]
+    [--corpus folder]" to run it without opening a window; the results are
+    written as JSON (to the standard output if no file is given).
+*/
+class AnalysisBenchmark
+{
+    public:
+        /**
+        * PURPOSE: Creates the AnalysisBenchmark object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        AnalysisBenchmark();
+
+        /**
+        * PURPOSE: Destroys the AnalysisBenchmark object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~AnalysisBenchmark();
+
+        /**
+        * PURPOSE: Runs the benchmark with the options given on the command line.
+        * INPUTS: The arguments of the command line.
+        * OUTPUTS: The results, as a juce var holding a JSON object.
+        */
+        static juce::var runFromCommandLine(const juce::StringArray& arguments);
+
+        /**
+        * PURPOSE: Runs the benchmark.
+        * INPUTS: The number of synthetic tracks to generate and the folder corpus (a non-existent
+        *         folder to skip it).
+        * OUTPUTS: The results, as a juce var holding a JSON object.
+        */
+        juce::var run(int numSyntheticTracks, const juce::File& corpusFolder);
+
+    private:
+        /** The running totals of the analysis benchmark over one corpus. */
+        struct AnalysisScores
+        {
+            int numTracks = 0;
+            int numWithReference = 0;
+            int numCorrect = 0;
+            int numCorrectUpToOctave = 0;
+            int numPhasesChecked = 0;
+            int numWithKeyReference = 0;
+            int numKeysCorrect = 0;
+            int numKeysCompatible = 0;
+            double totalPhaseErrorMs = 0.0;
+            double audioSeconds = 0.0;
+            double analysisSeconds = 0.0;
+        };
+
+        /**
+        * PURPOSE: Runs the analysis over the synthetic corpus.
+        * INPUTS: The number of tracks to generate.
+        * OUTPUTS: The results, as a juce var holding a JSON object.
+        */
+        juce::var benchmarkSyntheticTracks(int numTracks);
+
+        /**
+        * PURPOSE: Runs the analysis over the music files of a folder.
+        * INPUTS: The folder.
+        * OUTPUTS: The results, as a juce var holding a JSON object.
+        */
+        juce::var benchmarkFolder(const juce::File& folder);
+
+        /**
+        * PURPOSE: Generates a synthetic track: a kick on every beat, hi-hats between the beats,
+        *          a bassline and some noise, as an in-memory WAV file.
+        * INPUTS: The tempo, the time of the first beat in seconds and the length in seconds.
+        * OUTPUTS: A reader for the track.
+        */
+        std::unique_ptr<juce::AudioFormatReader> createSyntheticTrack(double bpm, double firstBeatSeconds, double lengthInSeconds);
+
+        /**
+        * PURPOSE: Times the analysis of one track and adds its outcome to the scores.
+        * INPUTS: A reader for the track, its true BPM (0 if unknown), its true first beat
+        *         (negative if unknown), its true key (CamelotKey::noKey if unknown) and the scores to add to.
+        * OUTPUTS: None.
+        */
+        static void measureTrack(juce::AudioFormatReader& reader,
+                                 double trueBpm,
+                                 double trueFirstBeatSeconds,
+                                 int trueKey,
+                                 AnalysisScores& scores);
+
+        /**
+        * PURPOSE: Turns the scores of a corpus into JSON.
+        * INPUTS: The scores.
+        * OUTPUTS: The results, as a juce var holding a JSON object.
+        */
+        static juce::var toVar(const AnalysisScores& scores);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr double sampleRate = 44100.0;
+        static constexpr double syntheticTrackSeconds = 60.0;
+        static constexpr double tempoTolerance = 0.04;
+
+        juce::Random random;
+        juce::AudioFormatManager formatManager;
+        TrackMetadataScanner metadataScanner{ formatManager };
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisBenchmark)
+};
@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+
+    AnalysisCache.cpp
+    Created: 19 Oct 2026 6:20:12pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "AnalysisCache.h"
+
+AnalysisCache::AnalysisCache(const juce::File& _directory)
+                            : directory(_directory)
+{
+}
+
+AnalysisCache::~AnalysisCache()
+{
+}
+
+juce::File AnalysisCache::getDefaultDirectory()
+{
+    auto dir = juce::File::getCurrentWorkingDirectory();
+    int numTries = 0;
+
+    while (!dir.getChildFile("Resources").exists() && numTries++ < 15)
+    {
+        dir = dir.getParentDirectory();
+    }
+
+    return dir.getChildFile("Resources").getChildFile("analysis");
+}
+
+bool AnalysisCache::readSection(juce::uint64 contentHash,
+                                SectionType type,
+                                juce::uint32 analyserVersion,
+                                juce::MemoryBlock& data) const
+{
+    if (contentHash == 0)
+    {
+        return false;
+    }
+
+    juce::MemoryMappedFile mappedFile{ getSidecarFile(contentHash), juce::MemoryMappedFile::readOnly };
+    juce::uint32 numSections;
+    const juce::uint8* sidecar = openSidecar(mappedFile, numSections);
+
+    if (sidecar == nullptr)
+    {
+        return false;
+    }
+
+    for (juce::uint32 i = 0; i < numSections; ++i)
+    {
+        const juce::uint8* entry = sidecar + headerSize + i * tableEntrySize;
+
+        if (juce::ByteOrder::littleEndianInt(entry) == (juce::uint32) type)
+        {
+            // A result from another version of the analyser is as good as no result.
+            if (juce::ByteOrder::littleEndianInt(entry + 4) != analyserVersion)
+            {
+                return false;
+            }
+
+            data.replaceAll(sidecar + juce::ByteOrder::littleEndianInt64(entry + 8),
+                            (size_t) juce::ByteOrder::littleEndianInt64(entry + 16));
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool AnalysisCache::writeSection(juce::uint64 contentHash,
+                                 SectionType type,
+                                 juce::uint32 analyserVersion,
+                                 const void* data,
+                                 size_t size)
+{
+    if (contentHash == 0 || !directory.createDirectory())
+    {
+        return false;
+    }
+
+    // Sections of one sidecar may be written by several workers at once.
+    const juce::ScopedLock sl(writeLock);
+
+    juce::File sidecarFile = getSidecarFile(contentHash);
+    std::vector<Section> sections = readAllSections(sidecarFile);
+    Section* section = nullptr;
+
+    for (auto& existingSection : sections)
+    {
+        if (existingSection.type == (juce::uint32) type)
+        {
+            section = &existingSection;
+        }
+    }
+
+    if (section == nullptr)
+    {
+        sections.push_back({ (juce::uint32) type, 0, {} });
+        section = &sections.back();
+    }
+
+    section->analyserVersion = analyserVersion;
+    section->data.replaceAll(data, size);
+
+    // Write a new sidecar next to the old one and swap them, so readers never see half a file.
+    juce::TemporaryFile tempFile{ sidecarFile };
+
+    {
+        juce::FileOutputStream stream{ tempFile.getFile() };
+
+        if (stream.failedToOpen())
+        {
+            return false;
+        }
+
+        stream.write("OTOA", 4);
+        stream.writeInt((int) formatVersion);
+        stream.writeInt((int) sections.size());
+        stream.writeInt(0);
+
+        juce::uint64 offset = (juce::uint64) (headerSize + sections.size() * tableEntrySize);
+
+        for (const auto& s : sections)
+        {
+            stream.writeInt((int) s.type);
+            stream.writeInt((int) s.analyserVersion);
+            stream.writeInt64((juce::int64) offset);
+            stream.writeInt64((juce::int64) s.data.getSize());
+            offset += s.data.getSize();
+        }
+
+        for (const auto& s : sections)
+        {
+            stream.write(s.data.getData(), s.data.getSize());
+        }
+
+        stream.flush();
+
+        if (stream.getStatus().failed())
+        {
+            return false;
+        }
+    }
+
+    return tempFile.overwriteTargetFileWithTemporary();
+}
+
+juce::File AnalysisCache::getSidecarFile(juce::uint64 contentHash) const
+{
+    return directory.getChildFile(juce::String::toHexString((juce::int64) contentHash).paddedLeft('0', 16) + ".otoa");
+}
+
+const juce::uint8* AnalysisCache::openSidecar(const juce::MemoryMappedFile& mappedFile, juce::uint32& numSections)
+{
+    auto* sidecar = static_cast<const juce::uint8*>(mappedFile.getData());
+    const juce::uint64 fileSize = (juce::uint64) mappedFile.getSize();
+
+    if (sidecar == nullptr
+        || fileSize < (juce::uint64) headerSize
+        || memcmp(sidecar, "OTOA", 4) != 0
+        || juce::ByteOrder::littleEndianInt(sidecar + 4) != formatVersion)
+    {
+        return nullptr;
+    }
+
+    numSections = juce::ByteOrder::littleEndianInt(sidecar + 8);
+
+    if ((juce::uint64) headerSize + (juce::uint64) numSections * tableEntrySize > fileSize)
+    {
+        return nullptr;
+    }
+
+    // Check that every section lies inside the file.
+    for (juce::uint32 i = 0; i < numSections; ++i)
+    {
+        const juce::uint8* entry = sidecar + headerSize + i * tableEntrySize;
+        juce::uint64 offset = juce::ByteOrder::littleEndianInt64(entry + 8);
+        juce::uint64 size = juce::ByteOrder::littleEndianInt64(entry + 16);
+
+        if (offset > fileSize || size > fileSize - offset)
+        {
+            return nullptr;
+        }
+    }
+
+    return sidecar;
+}
+
+std::vector<AnalysisCache::Section> AnalysisCache::readAllSections(const juce::File& sidecarFile)
+{
+    std::vector<Section> sections;
+    juce::MemoryMappedFile mappedFile{ sidecarFile, juce::MemoryMappedFile::readOnly };
+    juce::uint32 numSections;
+    const juce::uint8* sidecar = openSidecar(mappedFile, numSections);
+
+    if (sidecar == nullptr)
+    {
+        return sections;
+    }
+
+    for (juce::uint32 i = 0; i < numSections; ++i)
+    {
+        const juce::uint8* entry = sidecar + headerSize + i * tableEntrySize;
+
+        sections.push_back({ juce::ByteOrder::littleEndianInt(entry),
+                             juce::ByteOrder::littleEndianInt(entry + 4),
+                             juce::MemoryBlock(sidecar + juce::ByteOrder::littleEndianInt64(entry + 8),
+                                               (size_t) juce::ByteOrder::littleEndianInt64(entry + 16)) });
+    }
+
+    return sections;
+}
@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+    AnalysisCache.h
+    Created: 19 Oct 2026 6:20:12pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <type_traits>
+#include <vector>
+
+//==============================================================================
+/*
+    Stores the results of analysing tracks (waveform thumbnails, duration, BPM,
+    key, loudness, cue points) so that each is computed once per file version.
+
+    Results are kept in one binary sidecar file per content hash, so a track
+    that is renamed or copied keeps its analysis and an edited file gets a new
+    one. A sidecar holds a table of sections, one per type of analysis, each
+    tagged with the version of the analyser that produced it: bumping an
+    analyser's version invalidates only its own sections.
+
+    Sidecar layout (little endian):
+        header:  "OTOA", format version (uint32), number of sections (uint32), 0 (uint32)
+        table:   per section: type (uint32), analyser version (uint32), offset (uint64), size (uint64)
+        data:    the sections' bytes
+
+    Sidecars are memory mapped to be read and rewritten through a temporary
+    file that replaces the old one, so readers never see half a file. Both can
+    be done from any thread.
+*/
+class AnalysisCache
+{
+    public:
+        /** The types of analysis that can be stored. */
+        enum SectionType
+        {
+            thumbnail = 1,
+            duration = 2,
+            bpm = 3,
+            key = 4,
+            loudness = 5,
+            cuePoints = 6
+        };
+
+        /**
+        * PURPOSE: Creates the AnalysisCache object.
+        * INPUTS: The folder to keep the sidecar files in (created when needed).
+        * OUTPUTS: None.
+        */
+        AnalysisCache(const juce::File& _directory);
+
+        /**
+        * PURPOSE: Destroys the AnalysisCache object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~AnalysisCache();
+
+        /**
+        * PURPOSE: Gets the default folder for the sidecar files, next to the playlist file in Resources.
+        * INPUTS: None.
+        * OUTPUTS: The folder.
+        */
+        static juce::File getDefaultDirectory();
+
+        /**
+        * PURPOSE: Reads a stored analysis result.
+        * INPUTS: The content hash of the track, the type of analysis, the current version of
+        *         its analyser and the memory block to copy the result into.
+        * OUTPUTS: A boolean; true if there is a result from this analyser version and false if there isn't.
+        */
+        bool readSection(juce::uint64 contentHash,
+                         SectionType type,
+                         juce::uint32 analyserVersion,
+                         juce::MemoryBlock& data) const;
+
+        /**
+        * PURPOSE: Stores an analysis result, replacing any older result of the same type.
+        * INPUTS: The content hash of the track (0 isn't stored), the type of analysis,
+        *         the version of its analyser and the result.
+        * OUTPUTS: A boolean; true if the sidecar was written and false if it wasn't.
+        */
+        bool writeSection(juce::uint64 contentHash,
+                          SectionType type,
+                          juce::uint32 analyserVersion,
+                          const void* data,
+                          size_t size);
+
+        /**
+        * PURPOSE: Reads a stored analysis result made of a single plain value (or struct).
+        * INPUTS: The content hash of the track, the type of analysis, the current version
+        *         of its analyser and a reference to store the value in.
+        * OUTPUTS: A boolean; true if there is a result from this analyser version and false if there isn't.
+        */
+        template <typename ValueType>
+        bool readValue(juce::uint64 contentHash, SectionType type, juce::uint32 analyserVersion, ValueType& value) const
+        {
+            static_assert(std::is_trivially_copyable<ValueType>::value, "Only plain values can be stored");
+            juce::MemoryBlock data;
+
+            if (!readSection(contentHash, type, analyserVersion, data) || data.getSize() != sizeof(ValueType))
+            {
+                return false;
+            }
+
+            data.copyTo(&value, 0, sizeof(ValueType));
+            return true;
+        }
+
+        /**
+        * PURPOSE: Stores an analysis result made of a single plain value (or struct).
+        * INPUTS: The content hash of the track, the type of analysis, the version of its analyser and the value.
+        * OUTPUTS: A boolean; true if the sidecar was written and false if it wasn't.
+        */
+        template <typename ValueType>
+        bool writeValue(juce::uint64 contentHash, SectionType type, juce::uint32 analyserVersion, const ValueType& value)
+        {
+            static_assert(std::is_trivially_copyable<ValueType>::value, "Only plain values can be stored");
+            return writeSection(contentHash, type, analyserVersion, &value, sizeof(ValueType));
+        }
+
+    private:
+        /** A section read from a sidecar. */
+        struct Section
+        {
+            juce::uint32 type;
+            juce::uint32 analyserVersion;
+            juce::MemoryBlock data;
+        };
+
+        /**
+        * PURPOSE: Gets the sidecar file of a track.
+        * INPUTS: The content hash of the track.
+        * OUTPUTS: The sidecar file.
+        */
+        juce::File getSidecarFile(juce::uint64 contentHash) const;
+
+        /**
+        * PURPOSE: Memory maps a sidecar file and checks its header and section table.
+        * INPUTS: The mapped file and a reference to store the number of sections in.
+        * OUTPUTS: A pointer to the start of the file, or nullptr if it is missing or invalid.
+        */
+        static const juce::uint8* openSidecar(const juce::MemoryMappedFile& mappedFile, juce::uint32& numSections);
+
+        /**
+        * PURPOSE: Reads all the sections of a sidecar file.
+        * INPUTS: The sidecar file.
+        * OUTPUTS: The sections (none if the file is missing or invalid).
+        */
+        static std::vector<Section> readAllSections(const juce::File& sidecarFile);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr juce::uint32 formatVersion = 1;
+        static constexpr int headerSize = 16;
+        static constexpr int tableEntrySize = 24;
+
+        juce::File directory;
+        juce::CriticalSection writeLock;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisCache)
+};
@@ -0,0 +1,212 @@
+/*
+  ==============================================================================
+
+    AnalysisScheduler.cpp
+    Created: 19 Oct 2026 7:12:05pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "AnalysisScheduler.h"
+
+AnalysisJob::AnalysisJob()
+{
+}
+
+AnalysisJob::~AnalysisJob()
+{
+}
+
+void AnalysisJob::cancel()
+{
+    cancelled = true;
+
+    // A job that is still queued is finished straight away; the worker that dequeues it drops it.
+    int expected = queued;
+
+    if (state.compare_exchange_strong(expected, finished))
+    {
+        finishedEvent.signal();
+    }
+}
+
+bool AnalysisJob::cancelIfQueued()
+{
+    int expected = queued;
+
+    if (!state.compare_exchange_strong(expected, finished))
+    {
+        return false;
+    }
+
+    cancelled = true;
+    finishedEvent.signal();
+    return true;
+}
+
+bool AnalysisJob::shouldExit() const
+{
+    return cancelled || (schedulerStopping != nullptr && *schedulerStopping);
+}
+
+bool AnalysisJob::waitUntilFinished(int timeoutMs)
+{
+    return finishedEvent.wait(timeoutMs);
+}
+
+bool AnalysisJob::startRunning()
+{
+    int expected = queued;
+    return state.compare_exchange_strong(expected, running);
+}
+
+void AnalysisJob::finishRunning()
+{
+    state = finished;
+    finishedEvent.signal();
+}
+
+AnalysisScheduler::AnalysisScheduler()
+{
+    const int numWorkers = getDefaultNumWorkers();
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        workers.push_back(std::make_unique<Worker>(*this, i));
+    }
+
+    for (auto& worker : workers)
+    {
+        worker->startThread(workerPriority);
+    }
+}
+
+AnalysisScheduler::~AnalysisScheduler()
+{
+    stopping = true;
+
+    for (auto& worker : workers)
+    {
+        worker->signalThreadShouldExit();
+        worker->notify();
+    }
+
+    for (auto& worker : workers)
+    {
+        worker->stopThread(4000);
+    }
+
+    // Anyone still waiting for a queued job must not wait forever.
+    for (auto& worker : workers)
+    {
+        for (auto& queue : worker->queues)
+        {
+            for (auto& job : queue)
+            {
+                job->cancel();
+            }
+        }
+    }
+}
+
+void AnalysisScheduler::addJob(std::shared_ptr<AnalysisJob> job, Priority priority)
+{
+    if (stopping)
+    {
+        job->cancel();
+        return;
+    }
+
+    job->schedulerStopping = &stopping;
+
+    Worker& worker = *workers[nextWorker++ % workers.size()];
+
+    {
+        const juce::ScopedLock sl(worker.queueLock);
+        worker.queues[(int) priority].push_back(std::move(job));
+    }
+
+    // Wake every worker: an idle one may steal the job before its owner gets to it.
+    for (auto& w : workers)
+    {
+        w->notify();
+    }
+}
+
+int AnalysisScheduler::getNumWorkers() const
+{
+    return (int) workers.size();
+}
+
+int AnalysisScheduler::getDefaultNumWorkers()
+{
+    return juce::jmax(1, juce::SystemStats::getNumCpus() - 2);
+}
+
+std::shared_ptr<AnalysisJob> AnalysisScheduler::takeJob(int workerIndex)
+{
+    const int numWorkers = (int) workers.size();
+
+    for (int priority = 0; priority < numPriorities; ++priority)
+    {
+        // Own queue first, oldest job first.
+        {
+            Worker& own = *workers[(size_t) workerIndex];
+            const juce::ScopedLock sl(own.queueLock);
+            auto& queue = own.queues[priority];
+
+            if (!queue.empty())
+            {
+                auto job = std::move(queue.front());
+                queue.pop_front();
+                return job;
+            }
+        }
+
+        // Then steal from the other workers, newest job first, to keep out of their way.
+        for (int i = 1; i < numWorkers; ++i)
+        {
+            Worker& victim = *workers[(size_t) ((workerIndex + i) % numWorkers)];
+            const juce::ScopedLock sl(victim.queueLock);
+            auto& queue = victim.queues[priority];
+
+            if (!queue.empty())
+            {
+                auto job = std::move(queue.back());
+                queue.pop_back();
+                return job;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+AnalysisScheduler::Worker::Worker(AnalysisScheduler& _scheduler, int _index)
+                                 : juce::Thread("Analysis worker " + juce::String(_index + 1)),
+                                   scheduler(_scheduler),
+                                   index(_index)
+{
+}
+
+void AnalysisScheduler::Worker::run()
+{
+    while (!threadShouldExit())
+    {
+        std::shared_ptr<AnalysisJob> job = scheduler.takeJob(index);
+
+        if (job == nullptr)
+        {
+            // notify() from addJob() ends the wait early; the timeout is only a safety net.
+            wait(500);
+            continue;
+        }
+
+        if (job->startRunning())
+        {
+            job->runJob();
+            job->finishRunning();
+        }
+    }
+}
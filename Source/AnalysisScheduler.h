@@ -0,0 +1,220 @@
+/*
+  ==============================================================================
+
+    AnalysisScheduler.h
+    Created: 19 Oct 2026 7:12:05pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/*
+    A piece of background work run by the AnalysisScheduler, e.g. analysing one
+    track. Subclasses implement runJob() and should call shouldExit() often,
+    returning early once it is true: cancelling a job is cooperative.
+*/
+class AnalysisJob
+{
+    public:
+        /**
+        * PURPOSE: Creates the AnalysisJob object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        AnalysisJob();
+
+        /**
+        * PURPOSE: Destroys the AnalysisJob object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        virtual ~AnalysisJob();
+
+        /**
+        * PURPOSE: Does the job's work on one of the scheduler's workers (i.e. function is pure virtual).
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        virtual void runJob() = 0;
+
+        /**
+        * PURPOSE: Asks the job to stop. A job that hasn't started yet will never run.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void cancel();
+
+        /**
+        * PURPOSE: Cancels the job only if it hasn't started yet, leaving a running job alone.
+        * INPUTS: None.
+        * OUTPUTS: A boolean; true if the job was taken off the queue and false if it is running or finished.
+        */
+        bool cancelIfQueued();
+
+        /**
+        * PURPOSE: Checks whether the job has been cancelled or the scheduler is shutting down.
+        * INPUTS: None.
+        * OUTPUTS: A boolean; true if the job should return as soon as possible and false if it shouldn't.
+        */
+        bool shouldExit() const;
+
+        /**
+        * PURPOSE: Waits for the job to finish running, or to be dropped from the queue if it was cancelled.
+        * INPUTS: The longest time to wait in milliseconds (-1 to wait forever).
+        * OUTPUTS: A boolean; true if the job finished and false if the wait timed out.
+        */
+        bool waitUntilFinished(int timeoutMs);
+
+    private:
+        friend class AnalysisScheduler;
+
+        /** The states of a job. A job only leaves the queue once, either to run or because it was cancelled. */
+        enum State
+        {
+            queued,
+            running,
+            finished
+        };
+
+        /**
+        * PURPOSE: Claims a queued job for a worker.
+        * INPUTS: None.
+        * OUTPUTS: A boolean; true if the job should be run and false if it was cancelled while queued.
+        */
+        bool startRunning();
+
+        /**
+        * PURPOSE: Marks the job as finished and wakes up whoever is waiting for it.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void finishRunning();
+
+
+        /** DATA MEMBERS */
+
+        std::atomic<int> state{ queued };
+        std::atomic<bool> cancelled{ false };
+        std::atomic<bool>* schedulerStopping = nullptr;
+        juce::WaitableEvent finishedEvent{ true };
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisJob)
+};
+
+//==============================================================================
+/*
+    Runs AnalysisJobs on a small pool of low priority worker threads.
+
+    Jobs have a priority class, so that e.g. analysing the track just loaded on
+    a deck jumps ahead of bulk analysis of the library. Every worker has its own
+    queue per priority: jobs are spread over the workers' queues, a worker takes
+    the oldest job from its own queue and, when its queue runs dry, steals the
+    newest job of the same priority from another worker. A higher priority job
+    anywhere is always taken before a lower priority one.
+
+    The pool leaves two cores free, one for the audio thread and one for the
+    message thread, and its workers run at a low priority, so analysis never
+    causes dropouts.
+*/
+class AnalysisScheduler
+{
+    public:
+        /** The priority classes of jobs, most urgent first. */
+        enum class Priority
+        {
+            interactive,
+            normal,
+            background
+        };
+
+        /**
+        * PURPOSE: Creates the AnalysisScheduler object and starts its workers.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        AnalysisScheduler();
+
+        /**
+        * PURPOSE: Destroys the AnalysisScheduler object, cancelling all jobs and stopping the workers.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~AnalysisScheduler();
+
+        /**
+        * PURPOSE: Queues a job to be run.
+        * INPUTS: The job and its priority class.
+        * OUTPUTS: None.
+        */
+        void addJob(std::shared_ptr<AnalysisJob> job, Priority priority);
+
+        /**
+        * PURPOSE: Gets the number of worker threads.
+        * INPUTS: None.
+        * OUTPUTS: The number of workers.
+        */
+        int getNumWorkers() const;
+
+        /**
+        * PURPOSE: Gets the number of workers to use on this machine.
+        * INPUTS: None.
+        * OUTPUTS: The number of cores minus the two kept free, and at least one.
+        */
+        static int getDefaultNumWorkers();
+
+    private:
+        /** A worker thread with its own queue per priority class. */
+        class Worker : public juce::Thread
+        {
+            public:
+                /**
+                * PURPOSE: Creates the Worker object.
+                * INPUTS: The scheduler it works for and its index in the scheduler's workers.
+                * OUTPUTS: None.
+                */
+                Worker(AnalysisScheduler& _scheduler, int _index);
+
+                /**
+                * PURPOSE: The worker's main loop. Implements juce Thread (i.e. function is pure virtual).
+                * INPUTS: None.
+                * OUTPUTS: None.
+                */
+                void run() override;
+
+                /** DATA MEMBERS */
+
+                AnalysisScheduler& scheduler;
+                const int index;
+                juce::CriticalSection queueLock;
+                std::deque<std::shared_ptr<AnalysisJob>> queues[3];
+        };
+
+        /**
+        * PURPOSE: Finds the next job for a worker: its own oldest job, or another worker's newest
+        *          job, of the highest priority available.
+        * INPUTS: The index of the worker.
+        * OUTPUTS: The job, or nullptr if there is nothing to do.
+        */
+        std::shared_ptr<AnalysisJob> takeJob(int workerIndex);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int numPriorities = 3;
+        static constexpr int workerPriority = 2;
+
+        std::atomic<bool> stopping{ false };
+        std::atomic<unsigned int> nextWorker{ 0 };
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisScheduler)
+};
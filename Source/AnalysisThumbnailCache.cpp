@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    AnalysisThumbnailCache.cpp
+    Created: 19 Oct 2026 6:48:30pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "AnalysisThumbnailCache.h"
+
+AnalysisThumbnailCache::TrackInputSource::TrackInputSource(const juce::URL& _url, juce::uint64 _contentHash)
+                                                          : urlSource(_url),
+                                                            contentHash(_contentHash)
+{
+}
+
+juce::InputStream* AnalysisThumbnailCache::TrackInputSource::createInputStream()
+{
+    return urlSource.createInputStream();
+}
+
+juce::InputStream* AnalysisThumbnailCache::TrackInputSource::createInputStreamFor(const juce::String& relatedItemPath)
+{
+    return urlSource.createInputStreamFor(relatedItemPath);
+}
+
+juce::int64 AnalysisThumbnailCache::TrackInputSource::hashCode() const
+{
+    return contentHash != 0 ? (juce::int64) contentHash : urlSource.hashCode();
+}
+
+AnalysisThumbnailCache::AnalysisThumbnailCache(int maxNumThumbsToStore, AnalysisCache& _analysisCache)
+                                              : juce::AudioThumbnailCache(maxNumThumbsToStore),
+                                                analysisCache(_analysisCache)
+{
+}
+
+AnalysisThumbnailCache::~AnalysisThumbnailCache()
+{
+}
+
+bool AnalysisThumbnailCache::loadNewThumb(juce::AudioThumbnailBase& thumb, juce::int64 hashCode)
+{
+    juce::MemoryBlock data;
+
+    if (!analysisCache.readSection((juce::uint64) hashCode, AnalysisCache::thumbnail, thumbnailVersion, data))
+    {
+        return false;
+    }
+
+    juce::MemoryInputStream stream{ data, false };
+    return thumb.loadFrom(stream);
+}
+
+void AnalysisThumbnailCache::saveNewThumb(juce::AudioThumbnailBase& thumb, juce::int64 hashCode)
+{
+    // Called on the thumbnail thread once the whole waveform has been generated.
+    juce::MemoryOutputStream stream;
+    thumb.saveTo(stream);
+
+    analysisCache.writeSection((juce::uint64) hashCode,
+                               AnalysisCache::thumbnail,
+                               thumbnailVersion,
+                               stream.getData(),
+                               stream.getDataSize());
+}
@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    AnalysisThumbnailCache.h
+    Created: 19 Oct 2026 6:48:30pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "AnalysisCache.h"
+
+//==============================================================================
+/*
+    A juce AudioThumbnailCache that also keeps the waveform thumbnails in the
+    analysis cache, so a track's waveform is only generated the first time it
+    is loaded, even across sessions.
+
+    Thumbnails are looked up by the hash of their source, so sources must be
+    TrackInputSources, whose hash is the content hash of the track's file.
+*/
+class AnalysisThumbnailCache : public juce::AudioThumbnailCache
+{
+    public:
+        /** An input source for a track's file whose hash is the file's content hash. */
+        class TrackInputSource : public juce::InputSource
+        {
+            public:
+                /**
+                * PURPOSE: Creates the TrackInputSource object.
+                * INPUTS: The URL of the track and the content hash of its file (0 if unknown).
+                * OUTPUTS: None.
+                */
+                TrackInputSource(const juce::URL& _url, juce::uint64 _contentHash);
+
+                /**
+                * PURPOSE: Opens a stream to read the track. Implements juce InputSource.
+                * INPUTS: None.
+                * OUTPUTS: The stream, or nullptr if it can't be opened.
+                */
+                juce::InputStream* createInputStream() override;
+
+                /**
+                * PURPOSE: Opens a stream to a file relative to the track. Implements juce InputSource.
+                * INPUTS: The relative path of the file.
+                * OUTPUTS: The stream, or nullptr if it can't be opened.
+                */
+                juce::InputStream* createInputStreamFor(const juce::String& relatedItemPath) override;
+
+                /**
+                * PURPOSE: Gets the hash that identifies the track. Implements juce InputSource.
+                * INPUTS: None.
+                * OUTPUTS: The content hash, or a hash of the URL if the content hash is unknown.
+                */
+                juce::int64 hashCode() const override;
+
+            private:
+                /** DATA MEMBERS */
+                juce::URLInputSource urlSource;
+                juce::uint64 contentHash;
+        };
+
+        /**
+        * PURPOSE: Creates the AnalysisThumbnailCache object.
+        * INPUTS: The number of thumbnails to keep in memory and the analysis cache to store them in.
+        * OUTPUTS: None.
+        */
+        AnalysisThumbnailCache(int maxNumThumbsToStore, AnalysisCache& _analysisCache);
+
+        /**
+        * PURPOSE: Destroys the AnalysisThumbnailCache object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~AnalysisThumbnailCache() override;
+
+    protected:
+        /**
+        * PURPOSE: Loads a thumbnail that isn't in memory from the analysis cache.
+        *          Overrides juce AudioThumbnailCache virtual member function.
+        * INPUTS: The thumbnail to load into and the hash of its source.
+        * OUTPUTS: A boolean; true if the thumbnail was loaded and false if it wasn't cached.
+        */
+        bool loadNewThumb(juce::AudioThumbnailBase& thumb, juce::int64 hashCode) override;
+
+        /**
+        * PURPOSE: Stores a newly generated thumbnail in the analysis cache.
+        *          Overrides juce AudioThumbnailCache virtual member function.
+        * INPUTS: The thumbnail and the hash of its source.
+        * OUTPUTS: None.
+        */
+        void saveNewThumb(juce::AudioThumbnailBase& thumb, juce::int64 hashCode) override;
+
+    private:
+        /** DATA MEMBERS */
+
+        static constexpr juce::uint32 thumbnailVersion = 1;
+
+        AnalysisCache& analysisCache;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisThumbnailCache)
+};
@@ -0,0 +1,285 @@
+/*
+  ==============================================================================
+
+    BeatDetector.cpp
+    Created: 19 Oct 2026 8:21:37pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "BeatDetector.h"
+#include <algorithm>
+#include <cmath>
+
+BeatDetector::BeatDetector(double _sampleRate)
+                          : sampleRate(_sampleRate),
+                            decimation(juce::jmax(1, juce::roundToInt(_sampleRate / targetSampleRate))),
+                            envelopeRate(_sampleRate / juce::jmax(1, juce::roundToInt(_sampleRate / targetSampleRate)) / hopSize),
+                            frame((size_t) fftSize, 0.0f),
+                            fftData((size_t) (2 * fftSize), 0.0f),
+                            previousMagnitudes((size_t) (fftSize / 2 + 1), 0.0f)
+{
+    // About 86 frames per second, so a five minute track is under 30000 frames.
+    envelope.reserve((size_t) (envelopeRate * 600.0));
+}
+
+BeatDetector::~BeatDetector()
+{
+}
+
+void BeatDetector::process(const float* left, const float* right, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Mix down to mono and decimate by averaging, which is a good enough low pass for onsets.
+        decimationSum += 0.5f * (left[i] + right[i]);
+
+        if (++decimationCount < decimation)
+        {
+            continue;
+        }
+
+        frame[(size_t) frameFill++] = decimationSum / (float) decimation;
+        decimationSum = 0.0f;
+        decimationCount = 0;
+
+        if (frameFill == fftSize)
+        {
+            addEnvelopeFrame();
+
+            std::copy(frame.begin() + hopSize, frame.end(), frame.begin());
+            frameFill -= hopSize;
+        }
+    }
+}
+
+bool BeatDetector::findBeatGrid(BeatGrid& grid) const
+{
+    const int numFrames = (int) envelope.size();
+
+    if (numFrames < minSecondsToAnalyse * envelopeRate)
+    {
+        return false;
+    }
+
+    // Remove the local mean (over about half a second), so only the onsets stand out.
+    const int radius = juce::roundToInt(0.25 * envelopeRate);
+    std::vector<double> prefixSums((size_t) numFrames + 1, 0.0);
+
+    for (int i = 0; i < numFrames; ++i)
+    {
+        prefixSums[(size_t) i + 1] = prefixSums[(size_t) i] + envelope[(size_t) i];
+    }
+
+    std::vector<float> onsets((size_t) numFrames);
+
+    for (int i = 0; i < numFrames; ++i)
+    {
+        int start = juce::jmax(0, i - radius);
+        int end = juce::jmin(numFrames, i + radius + 1);
+        double localMean = (prefixSums[(size_t) end] - prefixSums[(size_t) start]) / (end - start);
+
+        onsets[(size_t) i] = (float) juce::jmax(0.0, envelope[(size_t) i] - localMean);
+    }
+
+    double period = findPeriod(onsets);
+
+    if (period <= 0.0)
+    {
+        return false;
+    }
+
+    // Refine the tempo to a hundredth of a BPM, within 2% of the autocorrelation's estimate.
+    const double roughBpm = 60.0 * envelopeRate / period;
+    double bestBpm = roughBpm;
+    double bestPhase = 0.0;
+    double bestScore = -1.0;
+
+    for (double bpm = std::floor(roughBpm * 98.0) / 100.0; bpm <= roughBpm * 1.02; bpm += 0.01)
+    {
+        double phase;
+        double score = scorePeriod(onsets, 60.0 * envelopeRate / bpm, phase);
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            bestBpm = bpm;
+            bestPhase = phase;
+        }
+    }
+
+    if (bestScore <= 0.0)
+    {
+        return false;
+    }
+
+    // A frame's flux belongs to the middle of its window.
+    const double beatSeconds = 60.0 / bestBpm;
+    const double firstOnsetSeconds = (bestPhase + fftSize / (2.0 * hopSize)) / envelopeRate;
+
+    grid.bpm = bestBpm;
+    grid.firstBeatSeconds = std::fmod(firstOnsetSeconds, beatSeconds);
+    grid.confidence = bestScore;
+    return true;
+}
+
+void BeatDetector::addEnvelopeFrame()
+{
+    std::copy(frame.begin(), frame.end(), fftData.begin());
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+    window.multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+    // Spectral flux: how much louder each bin got, on a log scale so quiet onsets count too.
+    // The bass band (kick drums) counts as much as the rest of the spectrum together, so the
+    // beats, rather than the hi-hats between them, set the phase.
+    const int numBassBins = juce::roundToInt(bassCutoffHz * fftSize * decimation / sampleRate);
+    float flux = 0.0f;
+    float bassFlux = 0.0f;
+
+    for (int bin = 1; bin <= fftSize / 2; ++bin)
+    {
+        float magnitude = std::log1p(fftData[(size_t) bin]);
+        float rise = juce::jmax(0.0f, magnitude - previousMagnitudes[(size_t) bin]);
+        previousMagnitudes[(size_t) bin] = magnitude;
+
+        flux += rise;
+
+        if (bin <= numBassBins)
+        {
+            bassFlux += rise;
+        }
+    }
+
+    envelope.push_back(flux + bassFlux * (float) (fftSize / 2) / (float) juce::jmax(1, numBassBins));
+}
+
+double BeatDetector::findPeriod(const std::vector<float>& onsets) const
+{
+    const int numFrames = (int) onsets.size();
+    const int minLag = (int) std::floor(60.0 * envelopeRate / maxBpm);
+    const int maxLag = (int) std::ceil(60.0 * envelopeRate / minBpm);
+    const int numMultiples = 4;
+
+    if (maxLag * numMultiples >= numFrames)
+    {
+        return 0.0;
+    }
+
+    // Onsets are a frame or two wide, so a period that falls between two lags would be missed:
+    // widen them first.
+    std::vector<float> smoothed((size_t) numFrames, 0.0f);
+    const float kernel[] = { 1.0f, 2.0f, 3.0f, 2.0f, 1.0f };
+
+    for (int i = 2; i < numFrames - 2; ++i)
+    {
+        for (int k = 0; k < 5; ++k)
+        {
+            smoothed[(size_t) i] += kernel[k] * onsets[(size_t) (i + k - 2)];
+        }
+    }
+
+    std::vector<double> autocorrelation((size_t) (maxLag * numMultiples + 2), 0.0);
+
+    for (int lag = minLag; lag <= maxLag * numMultiples + 1; ++lag)
+    {
+        double sum = 0.0;
+
+        for (int i = 0; i + lag < numFrames; ++i)
+        {
+            sum += smoothed[(size_t) i] * smoothed[(size_t) (i + lag)];
+        }
+
+        autocorrelation[(size_t) lag] = sum / (numFrames - lag);
+    }
+
+    auto autocorrelationAt = [&autocorrelation](double lag)
+    {
+        int index = (int) lag;
+        double fraction = lag - index;
+        return autocorrelation[(size_t) index] * (1.0 - fraction) + autocorrelation[(size_t) index + 1] * fraction;
+    };
+
+    // Comb filter: the true period also repeats at two, three and four times its lag. The
+    // log-Gaussian weight settles what is left of the choice between half and double tempo.
+    // Periods are rarely a whole number of frames, so lags are tried in quarter frames.
+    double bestPeriod = 0.0;
+    double bestScore = 0.0;
+
+    for (double lag = minLag; lag <= maxLag; lag += 0.25)
+    {
+        double comb = 0.0;
+
+        for (int multiple = 1; multiple <= numMultiples; ++multiple)
+        {
+            comb += autocorrelationAt(lag * multiple) / multiple;
+        }
+
+        double octaves = std::log2(60.0 * envelopeRate / lag / preferredBpm);
+        double score = comb * std::exp(-0.5 * octaves * octaves);
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            bestPeriod = lag;
+        }
+    }
+
+    return bestPeriod;
+}
+
+double BeatDetector::scorePeriod(const std::vector<float>& onsets, double period, double& phase)
+{
+    double bins[numPhaseBins] = {};
+    double total = 0.0;
+    double position = 0.0;
+    const double step = 1.0 / period;
+
+    // Fold the envelope at the period: onsets on the beat all land in the same bins.
+    for (float onset : onsets)
+    {
+        int bin = (int) (position * numPhaseBins);
+        bins[juce::jmin(bin, numPhaseBins - 1)] += onset;
+        total += onset;
+
+        position += step;
+
+        if (position >= 1.0)
+        {
+            position -= 1.0;
+        }
+    }
+
+    if (total <= 0.0)
+    {
+        phase = 0.0;
+        return 0.0;
+    }
+
+    double smoothed[numPhaseBins];
+    int bestBin = 0;
+
+    for (int i = 0; i < numPhaseBins; ++i)
+    {
+        smoothed[i] = 0.25 * bins[(i + numPhaseBins - 1) % numPhaseBins]
+                    + 0.5 * bins[i]
+                    + 0.25 * bins[(i + 1) % numPhaseBins];
+
+        if (smoothed[i] > smoothed[bestBin])
+        {
+            bestBin = i;
+        }
+    }
+
+    double before = smoothed[(bestBin + numPhaseBins - 1) % numPhaseBins];
+    double peak = smoothed[bestBin];
+    double after = smoothed[(bestBin + 1) % numPhaseBins];
+    double curvature = before - 2.0 * peak + after;
+    double offset = curvature < 0.0 ? 0.5 * (before - after) / curvature : 0.0;
+
+    phase = std::fmod((bestBin + 0.5 + offset) / numPhaseBins * period + period, period);
+
+    double mean = total / numPhaseBins;
+    return (peak - mean) / peak;
+}
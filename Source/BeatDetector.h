@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    BeatDetector.h
+    Created: 19 Oct 2026 8:21:37pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <vector>
+
+//==============================================================================
+/*
+    Finds the tempo and the position of the beats of a whole track, offline.
+
+    The track's audio is fed in blocks, from start to end. It is mixed down to
+    mono, decimated to about 11 kHz and turned into an onset envelope: the
+    spectral flux (the rise in log-magnitude, summed over the spectrum, with
+    the bass band weighted up) every 128 samples, with its local mean removed.
+
+    Once the whole track has been fed, the tempo is found by autocorrelating
+    the envelope and passing it through a comb filter (a lag also scores with
+    its multiples, which keeps half and double tempo errors down), weighted
+    towards 120 BPM. The tempo is then refined, together with the phase of the
+    beats, by folding the envelope at candidate periods around it and keeping
+    the period at which the onsets line up best.
+
+    The result is a constant tempo beat grid, which is what DJ tracks have.
+*/
+class BeatDetector
+{
+    public:
+        /** A constant tempo beat grid: beats fall every 60 / bpm seconds from firstBeatSeconds. */
+        struct BeatGrid
+        {
+            double bpm;
+            double firstBeatSeconds;
+            double confidence;
+        };
+
+        /**
+        * PURPOSE: Creates the BeatDetector object.
+        * INPUTS: The sample rate of the track.
+        * OUTPUTS: None.
+        */
+        BeatDetector(double _sampleRate);
+
+        /**
+        * PURPOSE: Destroys the BeatDetector object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~BeatDetector();
+
+        /**
+        * PURPOSE: Feeds the next block of the track.
+        * INPUTS: The left and right channels of the block and its number of samples.
+        * OUTPUTS: None.
+        */
+        void process(const float* left, const float* right, int numSamples);
+
+        /**
+        * PURPOSE: Finds the beat grid of everything fed so far.
+        * INPUTS: A reference to the beat grid to be filled.
+        * OUTPUTS: A boolean; true if a tempo was found and false if the track is too short or has no clear beat.
+        */
+        bool findBeatGrid(BeatGrid& grid) const;
+
+    private:
+        /**
+        * PURPOSE: Computes the spectral flux of the current frame and appends it to the onset envelope.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void addEnvelopeFrame();
+
+        /**
+        * PURPOSE: Finds the period that best explains the onset envelope by autocorrelation and comb filtering.
+        * INPUTS: The onset envelope with its local mean removed.
+        * OUTPUTS: The period in envelope frames (fractional), or 0 if no period stands out.
+        */
+        double findPeriod(const std::vector<float>& onsets) const;
+
+        /**
+        * PURPOSE: Scores how well the onsets line up when folded at a period.
+        * INPUTS: The onset envelope, the period in frames and a reference to store the phase of the
+        *         beats in (in frames, between 0 and the period).
+        * OUTPUTS: The score: how far the strongest phase stands above the average phase.
+        */
+        static double scorePeriod(const std::vector<float>& onsets, double period, double& phase);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int fftOrder = 9;
+        static constexpr int fftSize = 1 << fftOrder;
+        static constexpr int hopSize = 128;
+        static constexpr double targetSampleRate = 11025.0;
+        static constexpr double bassCutoffHz = 200.0;
+        static constexpr double minBpm = 70.0;
+        static constexpr double maxBpm = 180.0;
+        static constexpr double preferredBpm = 120.0;
+        static constexpr double minSecondsToAnalyse = 10.0;
+        static constexpr int numPhaseBins = 64;
+
+        double sampleRate;
+        int decimation;
+        double envelopeRate;
+
+        // Decimation state: the running sum of the samples of the current output sample.
+        float decimationSum = 0.0f;
+        int decimationCount = 0;
+
+        std::vector<float> frame;
+        int frameFill = 0;
+        juce::dsp::FFT fft{ fftOrder };
+        juce::dsp::WindowingFunction<float> window{ (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann };
+        std::vector<float> fftData;
+        std::vector<float> previousMagnitudes;
+        std::vector<float> envelope;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BeatDetector)
+};
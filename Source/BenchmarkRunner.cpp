@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    BenchmarkRunner.cpp
+    Created: 20 Oct 2026 9:14:52am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "BenchmarkRunner.h"
+#include <iostream>
+
+bool BenchmarkRunner::isRequested(const juce::String& commandLine, const Benchmark& benchmark)
+{
+    return getArguments(commandLine).contains(benchmark.option);
+}
+
+void BenchmarkRunner::launch(const juce::String& commandLine, const Benchmark& benchmark)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    juce::StringArray arguments = getArguments(commandLine);
+
+    auto runBenchmark = [arguments, benchmark]()
+    {
+        const int exitCode = runAndWriteResults(arguments, benchmark);
+
+        juce::MessageManager::callAsync([exitCode]()
+        {
+            juce::JUCEApplicationBase::getInstance()->setApplicationReturnValue(exitCode);
+            juce::JUCEApplicationBase::quit();
+        });
+    };
+
+    if (!juce::Thread::launch(runBenchmark))
+    {
+        runBenchmark();
+    }
+}
+
+juce::String BenchmarkRunner::getOption(const juce::StringArray& arguments, const juce::String& option)
+{
+    const int index = arguments.indexOf(option);
+    const juce::String& value = arguments[index + 1];
+
+    if (index < 0 || value.startsWith("--"))
+    {
+        return {};
+    }
+
+    return value.unquoted();
+}
+
+juce::File BenchmarkRunner::getFileOption(const juce::StringArray& arguments, const juce::String& option)
+{
+    juce::String path = getOption(arguments, option);
+
+    if (path.isEmpty())
+    {
+        return juce::File();
+    }
+
+    return juce::File::getCurrentWorkingDirectory().getChildFile(path);
+}
+
+std::vector<int> BenchmarkRunner::getSizesOption(const juce::StringArray& arguments,
+                                                 const juce::String& option,
+                                                 const std::vector<int>& defaultSizes,
+                                                 int maxSize)
+{
+    if (!arguments.contains(option))
+    {
+        return defaultSizes;
+    }
+
+    std::vector<int> sizes;
+
+    for (const auto& size : juce::StringArray::fromTokens(getOption(arguments, option), ",", ""))
+    {
+        if (size.getIntValue() > 0 && size.getIntValue() <= maxSize)
+        {
+            sizes.push_back(size.getIntValue());
+        }
+    }
+
+    return sizes;
+}
+
+juce::DynamicObject::Ptr BenchmarkRunner::createResults()
+{
+    juce::DynamicObject::Ptr results = new juce::DynamicObject();
+    results->setProperty("app", juce::String(ProjectInfo::projectName));
+    results->setProperty("version", juce::String(ProjectInfo::versionString));
+    results->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    results->setProperty("operatingSystem", juce::SystemStats::getOperatingSystemName());
+    results->setProperty("cpu", juce::SystemStats::getCpuModel());
+
+    return results;
+}
+
+int BenchmarkRunner::runAndWriteResults(const juce::StringArray& arguments, const Benchmark& benchmark)
+{
+    juce::var results = benchmark.run(arguments);
+    juce::String json = juce::JSON::toString(results);
+    const int exitCode = results.hasProperty("passed") && !(bool) results["passed"] ? 1 : 0;
+    juce::File outputFile = getFileOption(arguments, benchmark.option);
+
+    if (outputFile == juce::File())
+    {
+        std::cout << json << std::endl;
+        return exitCode;
+    }
+
+    return outputFile.replaceWithText(json) ? exitCode : 1;
+}
+
+juce::StringArray BenchmarkRunner::getArguments(const juce::String& commandLine)
+{
+    juce::StringArray arguments = juce::StringArray::fromTokens(commandLine, true);
+    arguments.trim();
+    arguments.removeEmptyStrings();
+
+    return arguments;
+}
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    BenchmarkRunner.h
+    Created: 20 Oct 2026 9:14:52am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <vector>
+
+//==============================================================================
+/*
+    Runs the benchmarks that the app can be launched into instead of opening a
+    window.
+
+    Every benchmark is asked for with its own option ("--dsp-benchmark"), which
+    may be followed by the file to write the results to; its other options are
+    read by the benchmark itself with the helpers below. The runner reads the
+    command line, runs the benchmark on a background thread, writes its
+    results as JSON (to the standard output if no file is given) and then
+    quits the app from the message thread. Running off the message thread
+    keeps the message loop going, so anything measured that answers through
+    it, like the library searcher, works as it does in the app.
+
+    The app exits with 1 if the results couldn't be written or, for the
+    benchmarks that check what they measure, if their "passed" result is
+    false.
+*/
+class BenchmarkRunner
+{
+    public:
+        /** A benchmark that the app can be launched into. */
+        struct Benchmark
+        {
+            /** The option that asks for the benchmark, e.g. "--dsp-benchmark". */
+            const char* option;
+
+            /** Runs the benchmark with the arguments of the command line and returns its results. */
+            juce::var (*run)(const juce::StringArray& arguments);
+        };
+
+        /**
+        * PURPOSE: Checks if the app was launched to run a benchmark.
+        * INPUTS: The command line the app was launched with and the benchmark.
+        * OUTPUTS: A boolean; true if the benchmark should be run and false if it shouldn't.
+        */
+        static bool isRequested(const juce::String& commandLine, const Benchmark& benchmark);
+
+        /**
+        * PURPOSE: Runs a benchmark on a background thread, writes out its results and then quits the app
+        *          with its exit code. Must be called on the message thread.
+        * INPUTS: The command line the app was launched with and the benchmark.
+        * OUTPUTS: None.
+        */
+        static void launch(const juce::String& commandLine, const Benchmark& benchmark);
+
+        /**
+        * PURPOSE: Gets the value given to an option on the command line.
+        * INPUTS: The arguments of the command line and the option.
+        * OUTPUTS: The argument after the option, or an empty string if the option wasn't given
+        *          or another option follows it.
+        */
+        static juce::String getOption(const juce::StringArray& arguments, const juce::String& option);
+
+        /**
+        * PURPOSE: Gets the file given to an option on the command line.
+        * INPUTS: The arguments of the command line and the option.
+        * OUTPUTS: The file, relative to the working directory, or juce::File() if none was given.
+        */
+        static juce::File getFileOption(const juce::StringArray& arguments, const juce::String& option);
+
+        /**
+        * PURPOSE: Gets the comma separated list of sizes given to an option on the command line.
+        * INPUTS: The arguments of the command line, the option, the sizes to use if it wasn't given
+        *         and the largest size allowed.
+        * OUTPUTS: The sizes from 1 up to the largest size allowed, in the order given.
+        */
+        static std::vector<int> getSizesOption(const juce::StringArray& arguments,
+                                               const juce::String& option,
+                                               const std::vector<int>& defaultSizes,
+                                               int maxSize);
+
+        /**
+        * PURPOSE: Creates the results object of a benchmark, holding what every set of results starts with:
+        *          the app, its version, the time and the machine it ran on.
+        * INPUTS: None.
+        * OUTPUTS: The results object, to add the benchmark's own results to.
+        */
+        static juce::DynamicObject::Ptr createResults();
+
+    private:
+        /**
+        * PURPOSE: Runs a benchmark and writes out its results.
+        * INPUTS: The arguments of the command line and the benchmark.
+        * OUTPUTS: The exit code of the app: 0 on success, and 1 if the benchmark failed or the results
+        *          couldn't be written.
+        */
+        static int runAndWriteResults(const juce::StringArray& arguments, const Benchmark& benchmark);
+
+        /**
+        * PURPOSE: Splits the command line into its arguments.
+        * INPUTS: The command line the app was launched with.
+        * OUTPUTS: The arguments.
+        */
+        static juce::StringArray getArguments(const juce::String& commandLine);
+};
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    CamelotKey.cpp
+    Created: 19 Oct 2026 9:41:06pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "CamelotKey.h"
+
+const std::array<juce::uint32, CamelotKey::numKeys> CamelotKey::compatibleKeys = CamelotKey::createCompatibleKeys();
+
+int CamelotKey::fromPitchClass(int tonic, bool isMinor)
+{
+    // A minor key shares its number with its relative major, a minor third up.
+    int majorTonic = ((isMinor ? tonic + 3 : tonic) % 12 + 12) % 12;
+
+    // C major is 8B, and each fifth up is one step round the wheel.
+    int number = (majorTonic * 7 + 7) % 12;
+
+    return number * 2 + (isMinor ? 0 : 1);
+}
+
+int CamelotKey::parse(const juce::String& text)
+{
+    juce::String keyText = text.trim().toLowerCase();
+
+    if (keyText.isEmpty())
+    {
+        return noKey;
+    }
+
+    // Camelot ("8A", "08a") and Open Key ("1m", "1d") names start with a number.
+    if (juce::CharacterFunctions::isDigit(keyText[0]))
+    {
+        int number = keyText.getIntValue();
+        juce::String letter = keyText.trimCharactersAtStart("0123456789");
+
+        if (number < 1 || number > 12 || letter.length() != 1)
+        {
+            return noKey;
+        }
+
+        switch (letter[0])
+        {
+            case 'a': return (number - 1) * 2;
+            case 'b': return (number - 1) * 2 + 1;
+            case 'm': return ((number + 6) % 12) * 2;
+            case 'd': return ((number + 6) % 12) * 2 + 1;
+            default:  return noKey;
+        }
+    }
+
+    const int naturalPitchClasses[] = { 9, 11, 0, 2, 4, 5, 7 };
+    juce::juce_wchar noteName = keyText[0];
+
+    if (noteName < 'a' || noteName > 'g')
+    {
+        return noKey;
+    }
+
+    int tonic = naturalPitchClasses[noteName - 'a'];
+    juce::String mode = keyText.substring(1);
+
+    // After the note name, a "b" can only be a flat: no mode starts with one.
+    if (mode.startsWithChar('#') || mode.startsWithChar(0x266f))
+    {
+        tonic++;
+        mode = mode.substring(1);
+    }
+    else if (mode.startsWithChar('b') || mode.startsWithChar(0x266d))
+    {
+        tonic--;
+        mode = mode.substring(1);
+    }
+
+    mode = mode.trim();
+
+    if (mode.isEmpty() || mode == "maj" || mode == "major")
+    {
+        return fromPitchClass(tonic, false);
+    }
+
+    if (mode == "m" || mode == "min" || mode == "minor")
+    {
+        return fromPitchClass(tonic, true);
+    }
+
+    return noKey;
+}
+
+juce::String CamelotKey::toString(int key)
+{
+    if (key < 0 || key >= numKeys)
+    {
+        return {};
+    }
+
+    return juce::String(key / 2 + 1) + (key % 2 == 0 ? "A" : "B");
+}
+
+bool CamelotKey::areCompatible(int firstKey, int secondKey)
+{
+    return secondKey >= 0 && (getCompatibleKeys(firstKey) & (1u << secondKey)) != 0;
+}
+
+juce::uint32 CamelotKey::getCompatibleKeys(int key)
+{
+    if (key < 0 || key >= numKeys)
+    {
+        return 0;
+    }
+
+    return compatibleKeys[(size_t) key];
+}
+
+std::array<juce::uint32, CamelotKey::numKeys> CamelotKey::createCompatibleKeys()
+{
+    std::array<juce::uint32, numKeys> table;
+
+    for (int key = 0; key < numKeys; ++key)
+    {
+        int number = key / 2;
+        int letter = key % 2;
+
+        // The same key, a step either way round the wheel and the relative major or minor.
+        table[(size_t) key] = (1u << key)
+                            | (1u << (((number + 1) % 12) * 2 + letter))
+                            | (1u << (((number + 11) % 12) * 2 + letter))
+                            | (1u << (number * 2 + 1 - letter));
+    }
+
+    return table;
+}
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    CamelotKey.h
+    Created: 19 Oct 2026 9:41:06pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <array>
+
+//==============================================================================
+/*
+    Musical keys as DJs use them: the 24 keys on the Camelot wheel.
+
+    A key is an index from 0 to 23 (-1 for no key), ordered around the wheel:
+    1A, 1B, 2A, 2B, ... 12B. "A" keys are minor and "B" keys are major; the
+    number moves a fifth at a time, so keys next to each other on the wheel
+    share all but one note.
+
+    Two tracks mix harmonically when their keys are the same, one step apart
+    with the same letter, or the same number with the other letter (relative
+    major and minor). Whether two keys are compatible is looked up in a table
+    of bit masks made once, so filtering a library by key costs one lookup per
+    track.
+*/
+class CamelotKey
+{
+    public:
+        /**
+        * PURPOSE: Gets the key with the given tonic and mode.
+        * INPUTS: The pitch class of the tonic (0 for C up to 11 for B) and a boolean; true for minor.
+        * OUTPUTS: The key.
+        */
+        static int fromPitchClass(int tonic, bool isMinor);
+
+        /**
+        * PURPOSE: Reads a key as written in tags: Camelot ("8A"), Open Key ("1m") or
+        *          standard notation ("Am", "F# minor", "Bb", "Db major").
+        * INPUTS: The text of the key.
+        * OUTPUTS: The key, or -1 if the text isn't a key.
+        */
+        static int parse(const juce::String& text);
+
+        /**
+        * PURPOSE: Gets the Camelot name of a key.
+        * INPUTS: The key.
+        * OUTPUTS: The name (e.g. "8A"), or an empty string for no key.
+        */
+        static juce::String toString(int key);
+
+        /**
+        * PURPOSE: Checks if two keys mix harmonically. Runs in constant time.
+        * INPUTS: The two keys.
+        * OUTPUTS: A boolean; true if they are compatible and false if they aren't or either is no key.
+        */
+        static bool areCompatible(int firstKey, int secondKey);
+
+        /**
+        * PURPOSE: Gets the keys that mix harmonically with a key.
+        * INPUTS: The key.
+        * OUTPUTS: A bit mask with bit k set for every compatible key k (0 for no key).
+        */
+        static juce::uint32 getCompatibleKeys(int key);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int numKeys = 24;
+        static constexpr int noKey = -1;
+
+    private:
+        /**
+        * PURPOSE: Makes the table of compatible keys.
+        * INPUTS: None.
+        * OUTPUTS: A bit mask of compatible keys for every key.
+        */
+        static std::array<juce::uint32, numKeys> createCompatibleKeys();
+
+
+        /** DATA MEMBERS */
+
+        static const std::array<juce::uint32, numKeys> compatibleKeys;
+};
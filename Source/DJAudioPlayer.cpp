@@ -12,29 +12,120 @@ Author:  Mary-Brenda Akoda
 
 DJAudioPlayer::DJAudioPlayer(juce::AudioFormatManager& _formatManager) 
                             : formatManager(_formatManager), 
-                              loopIsActivated(false),
-                              loopEnd(0.0),
-                              loopStart(0.0),
-                              loopSeconds(0.0),
-                              justLoaded(false)
+                              loopInSeconds(-1.0),
+                              loopStartSeconds(0.0),
+                              loopEndSeconds(0.0),
+                              justLoaded(false),
+                              outputSampleRate(44100.0),
+                              volumeGain(1.0),
+                              trimGain(1.0),
+                              samplesRendered(0),
+                              isSlipping(false),
+                              wasLooping(false)
 {
-    startTimer(500);
 }
 
 DJAudioPlayer::~DJAudioPlayer()
 {
-    stopTimer();
 }
 
 void DJAudioPlayer::prepareToPlay (int samplesPerBlockExpected, double sampleRate) 
 {
     transportSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
     resampleSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    equaliser.prepare(sampleRate);
+    effectsRack.prepare(sampleRate);
+    levelMeter.prepare(sampleRate);
+    scratchEngine.prepare(sampleRate);
+
+    outputSampleRate = sampleRate;
+    samplesRendered = 0;
 }
 
 void DJAudioPlayer::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
 {   
-    resampleSource.getNextAudioBlock(bufferToFill);
+    double ratio = speedRatio.load();
+    const double bpm = beatsPerMinute.load();
+    const double beat = (transportSource.getCurrentPosition() - firstBeatSeconds.load()) * bpm / 60.0;
+    const DJAudioPlayer* master = syncMaster.load();
+
+    if (master != nullptr && bpm > 0.0)
+    {
+        ratio = getSyncedRatio(*master, ratio, bpm, beat, samplesRendered);
+    }
+
+    // The speed is only ever changed here, so sync corrections land on block boundaries.
+    resampleSource.setResamplingRatio(ratio);
+
+    beatAtBlockStart = beat;
+    beatsPerSample = ratio * bpm / (60.0 * outputSampleRate);
+    blockStartSample = samplesRendered;
+    isPlaying = transportSource.isPlaying();
+
+    // While the disc is held or the deck plays in reverse, the scratch engine plays the track instead of the transport.
+    const bool shouldSlip = slipEnabled.load() || rolling.load();
+    const ScratchEngine::Source source = scratchEngine.beginBlock(bufferToFill.numSamples,
+                                                                  transportSource.getCurrentPosition(),
+                                                                  isPlaying.load() ? ratio : 0.0,
+                                                                  shouldSlip);
+
+    // In slip mode a shadow playhead runs on from where the scratch, reverse or loop started,
+    // at the speed the deck would have played.
+    const bool looping = looper.isLoopActive();
+    const bool slipping = shouldSlip && (source != ScratchEngine::transport || looping);
+
+    if (slipping && !isSlipping)
+    {
+        slipSeconds = transportSource.getCurrentPosition();
+    }
+
+    if (wasLooping && !looping && source == ScratchEngine::transport)
+    {
+        // A loop ended in slip mode, so carry on from where the track would have been. A scratch
+        // or reverse ending is handed back above instead, when the engine returns toTransport.
+        looper.crossfadeTo(slipSeconds.load());
+    }
+
+    if (source == ScratchEngine::toTransport)
+    {
+        // Pick up where the record was let go of, or where the track would have been.
+        transportSource.setPosition(slipping ? slipSeconds.load() : scratchEngine.getPlayheadSeconds());
+        resampleSource.flushBuffers();
+    }
+
+    if (source != ScratchEngine::scratch)
+    {
+        resampleSource.getNextAudioBlock(bufferToFill);
+    }
+
+    if (source != ScratchEngine::transport)
+    {
+        scratchEngine.render(bufferToFill, source, transportSource.getGain());
+    }
+
+    if (slipping && isPlaying.load())
+    {
+        slipSeconds = slipSeconds.load() + bufferToFill.numSamples * ratio / outputSampleRate;
+    }
+
+    isSlipping = slipping;
+    wasLooping = slipping && looping;
+
+    equaliser.process(bufferToFill);
+
+    // The echo and the flanger follow the tempo the track is heard at.
+    effectsRack.setTempo(ratio * bpm);
+    effectsRack.process(bufferToFill);
+    levelMeter.measure(bufferToFill);
+
+    SetRecorder* recorder = stemRecorder.load();
+
+    if (recorder != nullptr)
+    {
+        recorder->pushBlock(stemStream, bufferToFill);
+    }
+
+    samplesRendered += bufferToFill.numSamples;
 }
 
 void DJAudioPlayer::releaseResources()
@@ -53,14 +144,26 @@ void DJAudioPlayer::loadURL(juce::URL audioURL)
         (
             new juce::AudioFormatReaderSource (reader, true)
         ); 
-        transportSource.setSource (newSource.get(), 0, nullptr, reader->sampleRate);             
+        // The looper reads the track, so the transport lets go of it before the track is swapped.
+        transportSource.setSource (nullptr);
+        looper.setSource (newSource.get(), reader->sampleRate);
+        transportSource.setSource (&looper, 0, nullptr, reader->sampleRate);             
         readerSource.reset (newSource.release());          
+        loopInSeconds = -1.0;
+
+        // The scratch engine decodes on its own thread, so it gets a reader of its own.
+        scratchEngine.setSource(std::unique_ptr<juce::AudioFormatReader>(
+            formatManager.createReaderFor(audioURL.createInputStream(false))));
     }
     else
     {
         DBG("DJAudioPlayer::loadURL Bad audio file!");
     }
 
+    // Until the new track is analysed, a synced deck plays at its own speed and nothing is trimmed.
+    setBeatGrid(0.0, 0.0);
+    setLoudness(LoudnessMeter::silentLufs, LoudnessMeter::silentLufs);
+
     justLoaded = true;
 }
 
@@ -73,10 +176,25 @@ void DJAudioPlayer::setGain(double gain)
         std::cout << "DJAudioPlayer::setGain gain should be between 0 and 1" << std::endl;
     }
     else {
-        transportSource.setGain(gain);
+        volumeGain = gain;
+        applyGain();
     }
 }
 
+void DJAudioPlayer::setLoudness(double integratedLufs, double truePeakDb)
+{
+    double trimDb = 0.0;
+
+    if (integratedLufs > minLufsToTrim)
+    {
+        trimDb = juce::jlimit(-maxTrimDb, maxTrimDb, targetLufs - integratedLufs);
+        trimDb = juce::jmin(trimDb, maxTruePeakDb - truePeakDb);
+    }
+
+    trimGain = juce::Decibels::decibelsToGain(trimDb);
+    applyGain();
+}
+
 void DJAudioPlayer::setSpeed(double ratio)
 {
     if (ratio < 0 || ratio > 100.0)
@@ -85,8 +203,92 @@ void DJAudioPlayer::setSpeed(double ratio)
     }
     else 
     {
-        resampleSource.setResamplingRatio(ratio);
+        speedRatio = ratio;
+    }
+}
+
+void DJAudioPlayer::setEqGain(DeckEqualiser::Band band, double gainDb)
+{
+    equaliser.setBandGain(band, gainDb);
+}
+
+void DJAudioPlayer::setEqKill(DeckEqualiser::Band band, bool shouldBeKilled)
+{
+    equaliser.setBandKilled(band, shouldBeKilled);
+}
+
+void DJAudioPlayer::setFilter(double position)
+{
+    equaliser.setFilter(position);
+}
+
+void DJAudioPlayer::setEffectEnabled(EffectsRack::Effect effect, bool shouldBeEnabled)
+{
+    effectsRack.setEffectEnabled(effect, shouldBeEnabled);
+}
+
+void DJAudioPlayer::setEffectAmount(EffectsRack::Effect effect, double amount)
+{
+    effectsRack.setEffectAmount(effect, amount);
+}
+
+void DJAudioPlayer::setEchoBeats(double beats)
+{
+    effectsRack.setEchoBeats(beats);
+}
+
+LevelMeter* DJAudioPlayer::getLevelMeter()
+{
+    return &levelMeter;
+}
+
+float DJAudioPlayer::getFaderGain() const
+{
+    return faderGain.load();
+}
+
+void DJAudioPlayer::setCueEnabled(bool shouldBeCued)
+{
+    cueEnabled = shouldBeCued;
+}
+
+bool DJAudioPlayer::isCueEnabled() const
+{
+    return cueEnabled.load();
+}
+
+void DJAudioPlayer::setStemRecorder(SetRecorder* recorder, SetRecorder::Stream stream)
+{
+    // The stream is set before the recorder is published, so the audio thread never sees one without the other.
+    stemStream = stream;
+    stemRecorder = recorder;
+}
+
+void DJAudioPlayer::setBeatGrid(double bpm, double firstBeat)
+{
+    firstBeatSeconds = firstBeat;
+    beatsPerMinute = juce::jmax(0.0, bpm);
+}
+
+void DJAudioPlayer::setSyncMaster(DJAudioPlayer* master)
+{
+    if (master == this)
+    {
+        master = nullptr;
     }
+
+    // Two decks following each other would have no tempo to follow.
+    if (master != nullptr && master->getSyncMaster() == this)
+    {
+        master->setSyncMaster(nullptr);
+    }
+
+    syncMaster = master;
+}
+
+DJAudioPlayer* DJAudioPlayer::getSyncMaster() const
+{
+    return syncMaster.load();
 }
 
 void DJAudioPlayer::setPosition(double posInSecs)
@@ -109,38 +311,60 @@ void DJAudioPlayer::setPositionRelative(double pos)
     }
 }
 
-void DJAudioPlayer::setLoop(double seconds)
+void DJAudioPlayer::setBeatLoop(double beats)
+{
+    // Loops shorter than a beat start on a grid line of their own length, and longer ones on a beat.
+    const double startSeconds = snapToGrid(getPosInTrack(), juce::jmin(beats, 1.0), false);
+
+    setLoopPoints(startSeconds, startSeconds + beats * getBeatSeconds());
+    justLoaded = false;
+}
+
+void DJAudioPlayer::setLoopIn()
 {
-    if (seconds <= 0 || seconds > 16.0)
+    loopInSeconds = snapToGrid(getPosInTrack(), minLoopBeats, true);
+    justLoaded = false;
+}
+
+void DJAudioPlayer::setLoopOut()
+{
+    const double loopOutSeconds = snapToGrid(getPosInTrack(), minLoopBeats, true);
+
+    if (loopInSeconds >= 0.0 && loopOutSeconds > loopInSeconds)
     {
-        loopIsActivated = false;
-        std::cout << "DJAudioPlayer::setLoop seconds should be greater \
-                      than 0 and less than or equal to 16" << std::endl;
+        setLoopPoints(loopInSeconds, loopOutSeconds);
     }
-    else
+}
+
+void DJAudioPlayer::resizeLoop(double factor)
+{
+    if (isLooping() && factor > 0.0)
     {
-        loopIsActivated = true;
-        loopSeconds = seconds;
-        loopEnd = transportSource.getCurrentPosition();
-        loopStart = loopEnd - seconds;
+        setLoopPoints(loopStartSeconds, loopStartSeconds + (loopEndSeconds - loopStartSeconds) * factor);
     }
 }
 
-void DJAudioPlayer::timerCallback()
+void DJAudioPlayer::exitLoop()
 {
-    if (loopIsActivated)
-    {
-        if (transportSource.getCurrentPosition() >= loopEnd)
-        {
-            transportSource.setPosition(loopStart);
-        }
+    looper.clearLoop();
+}
 
-        if (loopSeconds == 0)
-        {
-            loopIsActivated = false;
-            return;
-        }
-    }
+void DJAudioPlayer::startLoopRoll(double beats)
+{
+    rolling = true;
+    setBeatLoop(beats);
+}
+
+void DJAudioPlayer::stopLoopRoll()
+{
+    // The loop goes first, so the audio thread still sees the roll slipping when the loop ends.
+    exitLoop();
+    rolling = false;
+}
+
+bool DJAudioPlayer::isLooping() const
+{
+    return looper.isLoopActive();
 }
 
 void DJAudioPlayer::start()
@@ -164,12 +388,54 @@ void DJAudioPlayer::stop()
 
 double DJAudioPlayer::getPosInTrack()
 {
+    if (scratchEngine.isScratching())
+    {
+        return scratchEngine.getPlayheadSeconds();
+    }
+
     return transportSource.getCurrentPosition();
 }
 
 double DJAudioPlayer::getPositionRelative()
 {
-    return transportSource.getCurrentPosition() / transportSource.getLengthInSeconds();
+    return getPosInTrack() / transportSource.getLengthInSeconds();
+}
+
+void DJAudioPlayer::setSlipEnabled(bool shouldSlip)
+{
+    slipEnabled = shouldSlip;
+}
+
+bool DJAudioPlayer::isSlipEnabled() const
+{
+    return slipEnabled.load();
+}
+
+void DJAudioPlayer::setReversed(bool shouldReverse)
+{
+    scratchEngine.setReversed(shouldReverse);
+    justLoaded = false;
+}
+
+bool DJAudioPlayer::isReversed() const
+{
+    return scratchEngine.isReversed();
+}
+
+void DJAudioPlayer::touchJog()
+{
+    scratchEngine.touch();
+    justLoaded = false;
+}
+
+void DJAudioPlayer::moveJog(double revolutions)
+{
+    scratchEngine.move(revolutions);
+}
+
+void DJAudioPlayer::releaseJog()
+{
+    scratchEngine.release();
 }
 
 bool DJAudioPlayer::fileJustLoaded()
@@ -181,4 +447,92 @@ bool DJAudioPlayer::fileJustLoaded()
     }
 
     return false;
-}
\ No newline at end of file
+}
+
+double DJAudioPlayer::getSyncedRatio(const DJAudioPlayer& master,
+                                     double ratio,
+                                     double bpm,
+                                     double beat,
+                                     juce::int64 blockStart) const
+{
+    const double masterBeatsPerSample = master.beatsPerSample.load();
+
+    if (masterBeatsPerSample <= 0.0)
+    {
+        return ratio;
+    }
+
+    // Both decks render every block of the mixer, so their sample counts share a timeline:
+    // the master's beat at the start of this block is its published beat, moved on by the
+    // samples it has rendered since (none if it has already rendered this block).
+    const double masterBeat = master.beatAtBlockStart.load()
+                            + (blockStart - master.blockStartSample.load()) * masterBeatsPerSample;
+
+    // Match the tempo, or half or double it when the two tracks are an octave apart.
+    double targetRatio = masterBeatsPerSample * 60.0 * outputSampleRate / bpm;
+    double beatsPerMasterBeat = 1.0;
+
+    while (targetRatio > 1.5)
+    {
+        targetRatio *= 0.5;
+        beatsPerMasterBeat *= 0.5;
+    }
+
+    while (targetRatio < 0.75)
+    {
+        targetRatio *= 2.0;
+        beatsPerMasterBeat *= 2.0;
+    }
+
+    if (!isPlaying.load() || !master.isPlaying.load())
+    {
+        return targetRatio;
+    }
+
+    // The phase error in beats, wrapped to the nearest beat, pulls this deck back onto the
+    // master's beat a little faster or slower.
+    double difference = masterBeat * beatsPerMasterBeat - beat;
+    double phaseError = difference - std::floor(difference + 0.5);
+    double nudge = juce::jlimit(-maxSyncNudge, maxSyncNudge, syncPhaseGain * phaseError);
+
+    return targetRatio * (1.0 + nudge);
+}
+
+double DJAudioPlayer::snapToGrid(double seconds, double beats, bool toNearest) const
+{
+    const double bpm = beatsPerMinute.load();
+    const double firstBeat = firstBeatSeconds.load();
+
+    if (bpm <= 0.0 || beats <= 0.0)
+    {
+        return seconds;
+    }
+
+    // A hair of tolerance, so a playhead sitting on a grid line isn't snapped back to the one before.
+    const double spacing = beats * 60.0 / bpm;
+    const double lines = (seconds - firstBeat) / spacing;
+
+    return firstBeat + (toNearest ? std::round(lines) : std::floor(lines + 1.0e-6)) * spacing;
+}
+
+double DJAudioPlayer::getBeatSeconds() const
+{
+    const double bpm = beatsPerMinute.load();
+
+    return bpm > 0.0 ? 60.0 / bpm : defaultBeatSeconds;
+}
+
+void DJAudioPlayer::setLoopPoints(double startSeconds, double endSeconds)
+{
+    loopStartSeconds = startSeconds;
+    loopEndSeconds = endSeconds;
+    looper.setLoop(startSeconds, endSeconds);
+}
+
+void DJAudioPlayer::applyGain()
+{
+    // The trim rides on the transport's gain, so it costs no extra pass over the samples. The
+    // fader is left to the mixer, so the cue bus can hear the deck before it.
+    transportSource.setGain((float) trimGain);
+    faderGain = (float) volumeGain;
+}
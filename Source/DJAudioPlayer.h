@@ -11,20 +11,27 @@
 #pragma once
 
 #include "../JuceLibraryCode/JuceHeader.h"
+#include "DeckEqualiser.h"
+#include "EffectsRack.h"
+#include "LevelMeter.h"
+#include "SetRecorder.h"
+#include "LoudnessMeter.h"
+#include "ScratchEngine.h"
+#include "LoopingAudioSource.h"
+#include <atomic>
 
-class DJAudioPlayer : public juce::AudioAppComponent, 
-                      public juce::Timer 
+class DJAudioPlayer : public juce::AudioAppComponent
 {
     public:
         /**
-        * PURPOSE: Creates the DJAudioPlayer object, initialises its data members, and starts a timer.
+        * PURPOSE: Creates the DJAudioPlayer object and initialises its data members.
         * INPUTS: A reference to the juce AudioFormatManager.
         * OUTPUTS: None.
         */
         DJAudioPlayer(juce::AudioFormatManager& _formatManager);
 
         /**
-        * PURPOSE: Destroys the DJAudioPlayer object and stops the timer.
+        * PURPOSE: Destroys the DJAudioPlayer object.
         * INPUTS: None.
         * OUTPUTS: None.
         */
@@ -64,12 +71,20 @@ class DJAudioPlayer : public juce::AudioAppComponent,
         void loadURL(juce::URL audioURL);
 
         /**
-        * PURPOSE: Sets the track's volume.
+        * PURPOSE: Sets the track's volume. The automatic trim of the track's loudness is applied on top.
         * INPUTS: The volume slider value to be set.
         * OUTPUTS: None.
         */
         void setGain(double gain);
 
+        /**
+        * PURPOSE: Sets the loudness of the loaded track, from which the deck works out the trim that
+        *          brings the track to the target loudness. Loading a track resets the trim to 0 dB.
+        * INPUTS: The integrated loudness of the track in LUFS and its true peak in dBTP.
+        * OUTPUTS: None.
+        */
+        void setLoudness(double integratedLufs, double truePeakDb);
+
         /**
         * PURPOSE: Sets the track's speed.
         * INPUTS: The speed slider ratio to be set.
@@ -77,6 +92,107 @@ class DJAudioPlayer : public juce::AudioAppComponent,
         */
         void setSpeed(double ratio);
 
+        /**
+        * PURPOSE: Sets the gain of a band of the deck's EQ.
+        * INPUTS: The band and its gain in dB.
+        * OUTPUTS: None.
+        */
+        void setEqGain(DeckEqualiser::Band band, double gainDb);
+
+        /**
+        * PURPOSE: Kills a band of the deck's EQ, or brings it back.
+        * INPUTS: The band and whether it should be killed.
+        * OUTPUTS: None.
+        */
+        void setEqKill(DeckEqualiser::Band band, bool shouldBeKilled);
+
+        /**
+        * PURPOSE: Sets the deck's filter knob.
+        * INPUTS: The position between -1 (low pass fully closed) and 1 (high pass fully closed);
+        *         0 turns the filter off.
+        * OUTPUTS: None.
+        */
+        void setFilter(double position);
+
+        /**
+        * PURPOSE: Switches one of the deck's effects on or off. An echo or reverb that is
+        *          switched off rings out.
+        * INPUTS: The effect and whether it should be on.
+        * OUTPUTS: None.
+        */
+        void setEffectEnabled(EffectsRack::Effect effect, bool shouldBeEnabled);
+
+        /**
+        * PURPOSE: Sets how much of one of the deck's effects is heard.
+        * INPUTS: The effect and the amount between 0 and 1.
+        * OUTPUTS: None.
+        */
+        void setEffectAmount(EffectsRack::Effect effect, double amount);
+
+        /**
+        * PURPOSE: Sets the time between the deck's echoes.
+        * INPUTS: The number of beats, between a quarter of a beat and one beat.
+        * OUTPUTS: None.
+        */
+        void setEchoBeats(double beats);
+
+        /**
+        * PURPOSE: Gets the meter measuring what the deck sends to the mixer.
+        * INPUTS: None.
+        * OUTPUTS: A pointer to the deck's LevelMeter.
+        */
+        LevelMeter* getLevelMeter();
+
+        /**
+        * PURPOSE: Gets the volume fader's gain, which the mixer applies after the deck's cue bus send.
+        * INPUTS: None.
+        * OUTPUTS: The gain, between 0 and 1.
+        */
+        float getFaderGain() const;
+
+        /**
+        * PURPOSE: Sends the deck to the headphone cue bus before its fader (PFL), or takes it off.
+        * INPUTS: A boolean; true to cue the deck and false not to.
+        * OUTPUTS: None.
+        */
+        void setCueEnabled(bool shouldBeCued);
+
+        /**
+        * PURPOSE: Checks if the deck is sent to the headphone cue bus.
+        * INPUTS: None.
+        * OUTPUTS: A boolean; true if it is cued and false if it isn't.
+        */
+        bool isCueEnabled() const;
+
+        /**
+        * PURPOSE: Sends what the deck plays to a recorder as a stem, whenever it is recording stems.
+        * INPUTS: A pointer to the SetRecorder and the stream the deck is recorded to.
+        * OUTPUTS: None.
+        */
+        void setStemRecorder(SetRecorder* recorder, SetRecorder::Stream stream);
+
+        /**
+        * PURPOSE: Sets the beat grid of the loaded track, which beat-sync needs. Loading a track clears it.
+        * INPUTS: The tempo of the track in BPM (0 if it has no beat) and the time of its first beat in seconds.
+        * OUTPUTS: None.
+        */
+        void setBeatGrid(double bpm, double firstBeat);
+
+        /**
+        * PURPOSE: Locks the track's tempo and beat phase to another deck's, or releases it. If the
+        *          other deck was synced to this one, it is released and becomes the master.
+        * INPUTS: A pointer to the master deck to follow, or nullptr to go back to the speed set by setSpeed().
+        * OUTPUTS: None.
+        */
+        void setSyncMaster(DJAudioPlayer* master);
+
+        /**
+        * PURPOSE: Gets the deck this deck is synced to.
+        * INPUTS: None.
+        * OUTPUTS: A pointer to the master deck, or nullptr if this deck isn't synced.
+        */
+        DJAudioPlayer* getSyncMaster() const;
+
         /**
         * PURPOSE: Sets the track's current position.
         * INPUTS: The current position of the track in seconds to be set.
@@ -92,20 +208,63 @@ class DJAudioPlayer : public juce::AudioAppComponent,
         void setPositionRelative(double pos);
 
         /**
-        * PURPOSE: Sets a section of the track to be played repeatedly.
-        * INPUTS: The last X number of seconds to start the replay 
-        *         from on reaching the current position.
+        * PURPOSE: Loops a number of beats from the last beat (or, for loops shorter than a beat, the last
+        *          grid line of their length) before the playhead. Until the track has been analysed, a
+        *          beat is defaultBeatSeconds long and the loop starts at the playhead.
+        * INPUTS: The length of the loop in beats.
+        * OUTPUTS: None.
+        */
+        void setBeatLoop(double beats);
+
+        /**
+        * PURPOSE: Marks the start of a loop at the playhead, snapped to the nearest minLoopBeats of the grid.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void setLoopIn();
+
+        /**
+        * PURPOSE: Marks the end of a loop at the playhead, snapped like the start, and loops from the
+        *          start marked by setLoopIn(). Does nothing if the end isn't after the start.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void setLoopOut();
+
+        /**
+        * PURPOSE: Changes the length of the loop, keeping its start. Does nothing if the deck isn't looping.
+        * INPUTS: The factor to change the length by (e.g. 0.5 to halve it and 2 to double it).
+        * OUTPUTS: None.
+        */
+        void resizeLoop(double factor);
+
+        /**
+        * PURPOSE: Stops looping. In slip mode the deck jumps to where the track would have been.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void exitLoop();
+
+        /**
+        * PURPOSE: Starts a loop roll: a beat loop in slip mode, whether slip mode is on or not.
+        * INPUTS: The length of the loop in beats.
         * OUTPUTS: None.
         */
-        void setLoop(double seconds);
-    
+        void startLoopRoll(double beats);
+
         /**
-        * PURPOSE: The user-defined callback routine that actually gets called periodically.
-        *          Implements juce Timer.
+        * PURPOSE: Ends a loop roll, and the deck carries on from where the track would have been.
         * INPUTS: None.
         * OUTPUTS: None.
         */
-        void timerCallback() override;
+        void stopLoopRoll();
+
+        /**
+        * PURPOSE: Checks if the deck is looping.
+        * INPUTS: None.
+        * OUTPUTS: A boolean; true if it is and false if it isn't.
+        */
+        bool isLooping() const;
 
         /**
         * PURPOSE: Plays the track.
@@ -142,6 +301,57 @@ class DJAudioPlayer : public juce::AudioAppComponent,
         */
         double getPositionRelative();
 
+        /**
+        * PURPOSE: Switches slip mode on or off. In slip mode the track runs on silently while the deck
+        *          is scratched, reversed or looped, and the deck jumps back to where it would have been
+        *          when they end.
+        * INPUTS: A boolean; true to switch slip mode on and false to switch it off.
+        * OUTPUTS: None.
+        */
+        void setSlipEnabled(bool shouldSlip);
+
+        /**
+        * PURPOSE: Checks if slip mode is on.
+        * INPUTS: None.
+        * OUTPUTS: A boolean; true if it is and false if it isn't.
+        */
+        bool isSlipEnabled() const;
+
+        /**
+        * PURPOSE: Plays the track backwards at the deck's speed, or forwards again.
+        * INPUTS: A boolean; true to play in reverse and false to play forwards.
+        * OUTPUTS: None.
+        */
+        void setReversed(bool shouldReverse);
+
+        /**
+        * PURPOSE: Checks if the deck is set to play in reverse.
+        * INPUTS: None.
+        * OUTPUTS: A boolean; true if it is and false if it isn't.
+        */
+        bool isReversed() const;
+
+        /**
+        * PURPOSE: Puts a hand on the disc, which holds the record until it is moved or let go of.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void touchJog();
+
+        /**
+        * PURPOSE: Moves the hand on the disc, which scratches the record along with it.
+        * INPUTS: How far the disc was turned, in revolutions (negative to turn it backwards).
+        * OUTPUTS: None.
+        */
+        void moveJog(double revolutions);
+
+        /**
+        * PURPOSE: Lets go of the disc, which spins back up to the deck's speed and plays on from there.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void releaseJog();
+
         /**
         * PURPOSE: Checks if a file has just been loaded and resets the fileJustLoaded flag.
         * INPUTS: None.
@@ -150,18 +360,106 @@ class DJAudioPlayer : public juce::AudioAppComponent,
         bool fileJustLoaded();
 
     private:
+        /**
+        * PURPOSE: Works out the speed that keeps the track on the master deck's beat: its tempo
+        *          times the tempo ratio of the two tracks, nudged by the phase error between them.
+        *          Called on the audio thread at the start of every block.
+        * INPUTS: The master deck, this deck's speed without sync, its tempo in BPM, its position in
+        *         beats and the number of samples it has rendered, all at the start of the block.
+        * OUTPUTS: The resampling ratio to play the block at.
+        */
+        double getSyncedRatio(const DJAudioPlayer& master, double ratio, double bpm, double beat, juce::int64 blockStart) const;
+
+        /**
+        * PURPOSE: Hands the loudness trim to the transport source, whose gain ramps smoothly to it
+        *          over the next block, and publishes the volume for the mixer's fader.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void applyGain();
+
+        /**
+        * PURPOSE: Snaps a position to the beat grid. Positions are left as they are until the track has been analysed.
+        * INPUTS: The position in seconds, the spacing of the grid lines in beats and a boolean; true to
+        *         snap to the nearest grid line and false to snap to the one at or before the position.
+        * OUTPUTS: The snapped position in seconds.
+        */
+        double snapToGrid(double seconds, double beats, bool toNearest) const;
+
+        /**
+        * PURPOSE: Gets the length of a beat of the loaded track.
+        * INPUTS: None.
+        * OUTPUTS: The length in seconds, or defaultBeatSeconds until the track has been analysed.
+        */
+        double getBeatSeconds() const;
+
+        /**
+        * PURPOSE: Loops a section of the track and remembers it for resizeLoop().
+        * INPUTS: The start and the end of the loop in seconds.
+        * OUTPUTS: None.
+        */
+        void setLoopPoints(double startSeconds, double endSeconds);
+
+
         /** DATA MEMBERS */
 
+        // The largest nudge of the speed, as a fraction of it, and the nudge per beat of phase error,
+        // which pulls the phase in with a time constant of about two beats.
+        static constexpr double maxSyncNudge = 0.04;
+        static constexpr double syncPhaseGain = 0.5;
+
+        // Tracks are trimmed towards the target loudness by up to 12 dB either way, but never
+        // so far up that their true peak goes over -1 dBTP.
+        static constexpr double targetLufs = -14.0;
+        static constexpr double maxTrimDb = 12.0;
+        static constexpr double maxTruePeakDb = -1.0;
+        static constexpr double minLufsToTrim = -70.0;
+
+        // A beat at 120 BPM, for loops on a track that hasn't been analysed yet.
+        static constexpr double defaultBeatSeconds = 0.5;
+        static constexpr double minLoopBeats = 0.125;
+
         juce::AudioFormatManager& formatManager;
         std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
+        LoopingAudioSource looper;
         juce::AudioTransportSource transportSource; 
         juce::ResamplingAudioSource resampleSource{&transportSource, false, 2};
+        DeckEqualiser equaliser;
+        EffectsRack effectsRack;
+        LevelMeter levelMeter;
+        ScratchEngine scratchEngine;
 
-        double loopStart;
-        double loopEnd;
-        double loopSeconds;
+        double loopInSeconds;
+        double loopStartSeconds;
+        double loopEndSeconds;
         bool justLoaded;
-        bool loopIsActivated;
+        double outputSampleRate;
+        double volumeGain;
+        double trimGain;
+
+        std::atomic<double> speedRatio{ 1.0 };
+        std::atomic<double> beatsPerMinute{ 0.0 };
+        std::atomic<double> firstBeatSeconds{ 0.0 };
+        std::atomic<DJAudioPlayer*> syncMaster{ nullptr };
+        std::atomic<float> faderGain{ 1.0f };
+        std::atomic<bool> cueEnabled{ false };
+        std::atomic<bool> slipEnabled{ false };
+        std::atomic<bool> rolling{ false };
+        std::atomic<SetRecorder*> stemRecorder{ nullptr };
+        SetRecorder::Stream stemStream = SetRecorder::master;
+
+        // Published by the audio thread at the start of every block, for the decks synced to this one.
+        std::atomic<double> beatAtBlockStart{ 0.0 };
+        std::atomic<double> beatsPerSample{ 0.0 };
+        std::atomic<juce::int64> blockStartSample{ 0 };
+        std::atomic<bool> isPlaying{ false };
+        juce::int64 samplesRendered;
+
+        // Where the track would have been in slip mode, run on by the audio thread while it slips,
+        // and whether the last block slipped at all or slipped through a loop.
+        std::atomic<double> slipSeconds{ 0.0 };
+        bool isSlipping;
+        bool wasLooping;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DJAudioPlayer)
 };
\ No newline at end of file
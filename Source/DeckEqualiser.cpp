@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+    DeckEqualiser.cpp
+    Created: 19 Oct 2026 10:41:27pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "DeckEqualiser.h"
+#include <cmath>
+#include <limits>
+
+DeckEqualiser::DeckEqualiser()
+                            : sampleRate(44100.0),
+                              rampSamples(0),
+                              appliedFilterPosition(0.0)
+{
+    for (int band = 0; band < numBands; ++band)
+    {
+        bandGainsDb[band] = 0.0;
+        bandsKilled[band] = false;
+    }
+
+    prepare(sampleRate);
+}
+
+DeckEqualiser::~DeckEqualiser()
+{
+}
+
+void DeckEqualiser::prepare(double _sampleRate)
+{
+    sampleRate = _sampleRate;
+    rampSamples = juce::roundToInt(rampSeconds * sampleRate);
+
+    // Nothing equals NaN, so every stage is designed afresh for the new sample rate.
+    for (int band = 0; band < numBands; ++band)
+    {
+        appliedGainsDb[band] = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    appliedFilterPosition = std::numeric_limits<double>::quiet_NaN();
+    updateStages(0);
+
+    for (auto& stage : stages)
+    {
+        stage.reset();
+    }
+}
+
+void DeckEqualiser::setBandGain(Band band, double gainDb)
+{
+    bandGainsDb[band] = juce::jlimit(minGainDb, maxGainDb, gainDb);
+}
+
+void DeckEqualiser::setBandKilled(Band band, bool shouldBeKilled)
+{
+    bandsKilled[band] = shouldBeKilled;
+}
+
+void DeckEqualiser::setFilter(double position)
+{
+    filterPosition = juce::jlimit(-1.0, 1.0, position);
+}
+
+void DeckEqualiser::process(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    juce::AudioBuffer<float>* buffer = bufferToFill.buffer;
+
+    if (buffer == nullptr || buffer->getNumChannels() == 0 || bufferToFill.numSamples <= 0)
+    {
+        return;
+    }
+
+    updateStages(rampSamples);
+
+    float* left = buffer->getWritePointer(0, bufferToFill.startSample);
+    float* right = buffer->getNumChannels() > 1 ? buffer->getWritePointer(1, bufferToFill.startSample) : left;
+
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        // A flat stage that has finished ramping passes the signal unchanged, so it is skipped.
+        if (!stagesAreFlat[stage] || stages[stage].isRamping())
+        {
+            stages[stage].process(left, right, left, right, bufferToFill.numSamples);
+        }
+    }
+}
+
+StereoBiquad::Coefficients DeckEqualiser::makeBandCoefficients(Band band, double gainDb) const
+{
+    if (gainDb == 0.0)
+    {
+        return StereoBiquad::Coefficients::makePassThrough();
+    }
+
+    switch (band)
+    {
+        case low:
+            return StereoBiquad::Coefficients::makeLowShelf(sampleRate, lowFrequency, shelfQ, gainDb);
+        case mid:
+            return StereoBiquad::Coefficients::makePeak(sampleRate, midFrequency, midQ, gainDb);
+        case high:
+            return StereoBiquad::Coefficients::makeHighShelf(sampleRate, highFrequency, shelfQ, gainDb);
+        default:
+            return StereoBiquad::Coefficients::makePassThrough();
+    }
+}
+
+StereoBiquad::Coefficients DeckEqualiser::makeFilterCoefficients(double position) const
+{
+    if (std::abs(position) < filterDeadZone)
+    {
+        return StereoBiquad::Coefficients::makePassThrough();
+    }
+
+    // How far the filter is closed, from 0 at the edge of the dead zone to 1 at the end of the knob.
+    const double amount = (std::abs(position) - filterDeadZone) / (1.0 - filterDeadZone);
+
+    if (position < 0.0)
+    {
+        double cutoff = lowPassOpenHz * std::pow(lowPassClosedHz / lowPassOpenHz, amount);
+        return StereoBiquad::Coefficients::makeLowPass(sampleRate, juce::jmin(cutoff, 0.45 * sampleRate), filterQ);
+    }
+
+    double cutoff = highPassOpenHz * std::pow(highPassClosedHz / highPassOpenHz, amount);
+    return StereoBiquad::Coefficients::makeHighPass(sampleRate, juce::jmin(cutoff, 0.45 * sampleRate), filterQ);
+}
+
+void DeckEqualiser::updateStages(int rampLength)
+{
+    // The bands and their stages share their numbering.
+    for (int band = 0; band < numBands; ++band)
+    {
+        double gainDb = bandsKilled[band].load() ? killGainDb : bandGainsDb[band].load();
+
+        if (gainDb != appliedGainsDb[band])
+        {
+            stages[band].rampToCoefficients(makeBandCoefficients((Band) band, gainDb), rampLength);
+            appliedGainsDb[band] = gainDb;
+            stagesAreFlat[band] = gainDb == 0.0;
+        }
+    }
+
+    double position = filterPosition.load();
+
+    if (std::abs(position) < filterDeadZone)
+    {
+        position = 0.0;
+    }
+
+    if (position != appliedFilterPosition)
+    {
+        stages[filterStage].rampToCoefficients(makeFilterCoefficients(position), rampLength);
+        appliedFilterPosition = position;
+        stagesAreFlat[filterStage] = position == 0.0;
+    }
+}
@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+    DeckEqualiser.h
+    Created: 19 Oct 2026 10:41:27pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "StereoBiquad.h"
+#include <atomic>
+
+//==============================================================================
+/*
+    The tone controls of a deck: a three band EQ with a kill switch on every
+    band, followed by a sweepable filter.
+
+    The EQ is a low shelf, a peak in the middle and a high shelf; a killed
+    band is cut as far as it goes. The filter is one knob: turned left of
+    centre it is a low pass that closes down towards the bass, turned right a
+    high pass that closes up towards the treble, and in the middle it is off.
+
+    Every stage is a StereoBiquad, so both channels are filtered together in
+    one SIMD register. The controls are set from the message thread through
+    atomics and picked up by the audio thread at the start of the next block;
+    the new coefficients are ramped to over a few milliseconds, sample by
+    sample, so sweeping a knob never clicks. Stages that are flat and settled
+    are skipped, so a deck with its EQ untouched costs nothing. Nothing is
+    allocated after construction.
+*/
+class DeckEqualiser
+{
+    public:
+        /** The bands of the EQ. */
+        enum Band
+        {
+            low = 0,
+            mid,
+            high,
+            numBands
+        };
+
+        /**
+        * PURPOSE: Creates the DeckEqualiser object with every band flat and the filter off.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        DeckEqualiser();
+
+        /**
+        * PURPOSE: Destroys the DeckEqualiser object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~DeckEqualiser();
+
+        /**
+        * PURPOSE: Gets the filters ready for a sample rate and clears their memory of past samples.
+        *          Must not be called while process() is running.
+        * INPUTS: The sample rate.
+        * OUTPUTS: None.
+        */
+        void prepare(double sampleRate);
+
+        /**
+        * PURPOSE: Sets the gain of a band. Safe to call from any thread.
+        * INPUTS: The band and its gain in dB, limited to the range of the EQ knobs.
+        * OUTPUTS: None.
+        */
+        void setBandGain(Band band, double gainDb);
+
+        /**
+        * PURPOSE: Kills a band, or brings it back to its gain. Safe to call from any thread.
+        * INPUTS: The band and whether it should be killed.
+        * OUTPUTS: None.
+        */
+        void setBandKilled(Band band, bool shouldBeKilled);
+
+        /**
+        * PURPOSE: Sets the position of the filter knob. Safe to call from any thread.
+        * INPUTS: The position between -1 (low pass fully closed) and 1 (high pass fully
+        *         closed); 0 turns the filter off.
+        * OUTPUTS: None.
+        */
+        void setFilter(double position);
+
+        /**
+        * PURPOSE: Filters a block of audio in place. Called on the audio thread.
+        * INPUTS: The block, as handed to an audio source; a mono block is filtered as a stereo
+        *         block with the same signal in both channels.
+        * OUTPUTS: None.
+        */
+        void process(const juce::AudioSourceChannelInfo& bufferToFill);
+
+
+        /** DATA MEMBERS */
+
+        // The range of the EQ knobs in dB.
+        static constexpr double minGainDb = -26.0;
+        static constexpr double maxGainDb = 6.0;
+
+    private:
+        /** The filter stages, in the order the signal goes through them. */
+        enum Stage
+        {
+            lowShelfStage = 0,
+            midPeakStage,
+            highShelfStage,
+            filterStage,
+            numStages
+        };
+
+        /**
+        * PURPOSE: Designs the coefficients of a band of the EQ.
+        * INPUTS: The band and its gain in dB.
+        * OUTPUTS: The coefficients.
+        */
+        StereoBiquad::Coefficients makeBandCoefficients(Band band, double gainDb) const;
+
+        /**
+        * PURPOSE: Designs the coefficients of the filter.
+        * INPUTS: The position of the filter knob.
+        * OUTPUTS: The coefficients.
+        */
+        StereoBiquad::Coefficients makeFilterCoefficients(double position) const;
+
+        /**
+        * PURPOSE: Picks up the controls that have changed since the last block and starts ramping
+        *          their stages to them.
+        * INPUTS: The length of the ramps in samples (0 to set the coefficients at once).
+        * OUTPUTS: None.
+        */
+        void updateStages(int rampLength);
+
+
+        /** DATA MEMBERS */
+
+        // A killed band is cut by this much, which takes it below the noise of any track.
+        static constexpr double killGainDb = -60.0;
+
+        // The shelves meet the peak roughly where DJ mixers split their bands.
+        static constexpr double lowFrequency = 250.0;
+        static constexpr double midFrequency = 1000.0;
+        static constexpr double highFrequency = 4000.0;
+        static constexpr double shelfQ = 0.7071;
+        static constexpr double midQ = 0.7;
+
+        // The filter sweeps exponentially between these cutoffs, with a little resonance,
+        // and is off within the dead zone around the centre of the knob.
+        static constexpr double lowPassOpenHz = 20000.0;
+        static constexpr double lowPassClosedHz = 80.0;
+        static constexpr double highPassOpenHz = 20.0;
+        static constexpr double highPassClosedHz = 10000.0;
+        static constexpr double filterQ = 1.0;
+        static constexpr double filterDeadZone = 0.02;
+
+        static constexpr double rampSeconds = 0.02;
+
+        double sampleRate;
+        int rampSamples;
+        StereoBiquad stages[numStages];
+
+        // Set from the message thread.
+        std::atomic<double> bandGainsDb[numBands];
+        std::atomic<bool> bandsKilled[numBands];
+        std::atomic<double> filterPosition{ 0.0 };
+
+        // What the stages were last set to, on the audio thread.
+        double appliedGainsDb[numBands];
+        double appliedFilterPosition;
+        bool stagesAreFlat[numStages];
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DeckEqualiser)
+};
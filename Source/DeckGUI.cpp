@@ -15,15 +15,23 @@
 DeckGUI::DeckGUI(DJAudioPlayer* _player, 
                  juce::AudioFormatManager & formatManagerToUse,
                  juce::AudioThumbnailCache & cacheToUse,
+                 TrackAnalyser & analyserToUse,
                  juce::Colour& colourToUse,
                  juce::TooltipWindow* _tooltipWindow
                 ) : player(_player), 
                     formatManager(formatManagerToUse),
+                    metadataScanner(formatManagerToUse),
+                    trackAnalyser(analyserToUse),
                     waveformDisplay(formatManagerToUse, cacheToUse, colourToUse),
                     accentColour(colourToUse),
                     tooltipWindow(_tooltipWindow),
                     isLoaded(false),
-                    userExperienceLevel(0)
+                    userExperienceLevel(0),
+                    loadedContentHash(0),
+                    loadedKey(CamelotKey::noKey),
+                    echoBeatsIndex(2),
+                    isJogging(false),
+                    lastJogAngle(0.0)
 {
     // Get disc record image to display.
     disc = getImageFromResources("disc-record-resized-207.png");
@@ -34,14 +42,45 @@ DeckGUI::DeckGUI(DJAudioPlayer* _player,
     addAndMakeVisible(loadButton);
     addAndMakeVisible(posSlider);
     addAndMakeVisible(waveformDisplay);
+    addAndMakeVisible(echoButton);
+    addAndMakeVisible(reverbButton);
+    addAndMakeVisible(flangerButton);
+    addAndMakeVisible(crushButton);
+    addAndMakeVisible(echoBeatsButton);
+    addAndMakeVisible(effectAmountKnob);
+    addAndMakeVisible(vinylButton);
+    addAndMakeVisible(slipButton);
+    addAndMakeVisible(reverseButton);
 
     playButton.addListener(this);
     pauseButton.addListener(this);
     stopButton.addListener(this);
     loadButton.addListener(this);
     posSlider.addListener(this);
+    echoButton.addListener(this);
+    reverbButton.addListener(this);
+    flangerButton.addListener(this);
+    crushButton.addListener(this);
+    echoBeatsButton.addListener(this);
+    effectAmountKnob.addListener(this);
+    vinylButton.addListener(this);
+    slipButton.addListener(this);
+    reverseButton.addListener(this);
   
     posSlider.setRange(0.0, 1.0);
+    effectAmountKnob.setRange(0.0, 1.0);
+    effectAmountKnob.setValue(0.5);
+    effectAmountKnob.setDoubleClickReturnValue(true, 0.5);
+
+    echoButton.setClickingTogglesState(true);
+    reverbButton.setClickingTogglesState(true);
+    flangerButton.setClickingTogglesState(true);
+    crushButton.setClickingTogglesState(true);
+    vinylButton.setClickingTogglesState(true);
+    slipButton.setClickingTogglesState(true);
+    reverseButton.setClickingTogglesState(true);
+
+    trackAnalyser.addListener(this);
 
     startTimer(500);
 }
@@ -49,11 +88,11 @@ DeckGUI::DeckGUI(DJAudioPlayer* _player,
 DeckGUI::~DeckGUI()
 {
     stopTimer();
+    trackAnalyser.removeListener(this);
 }
 
 void DeckGUI::paint (juce::Graphics& g)
 {
-    double layoutH = (double) (getHeight() / 3);
     double rowH = (double) (getHeight() / 8);
     double buttonW = (double) (getWidth() / 10);
 
@@ -88,8 +127,8 @@ void DeckGUI::paint (juce::Graphics& g)
     }
 
     // Set position and transform for disc image.
-    g.setOrigin(((getWidth() / static_cast<double>(4)) - rowH / 2) + ((getWidth() / 1.5) - 5)/2, 
-                (layoutH - 10) + ((getHeight() - (layoutH - rowH / 2)) / 1.5)/2);
+    juce::Point<double> discCentre = getDiscCentre();
+    g.setOrigin((int) discCentre.x, (int) discCentre.y);
 
     // Position origin of disc rotation.
     juce::AffineTransform transform(AffineTransform::translation((float)(disc.getWidth() / -2),
@@ -127,6 +166,30 @@ void DeckGUI::resized()
                                   true);
 
     waveformDisplay.setBounds(0, 0, getWidth(), layoutH - rowH / 2);
+
+    // Effect switches down the left of the disc, and their amount and the echo's beats down the right.
+    styleEffectButton(echoButton, rowH * 2.2);
+    styleEffectButton(reverbButton, rowH * 3.1);
+    styleEffectButton(flangerButton, rowH * 4.0);
+    styleEffectButton(crushButton, rowH * 4.9);
+
+    effectAmountKnob.setBounds(getWidth() - rowW + 4, rowH * 2.2, rowW - 8, rowH * 1.2);
+    effectAmountKnob.setSliderStyle(juce::Slider::SliderStyle::RotaryVerticalDrag);
+    effectAmountKnob.setTextBoxStyle(juce::Slider::TextEntryBoxPosition::NoTextBox, true, 0, 0);
+    effectAmountKnob.setPopupDisplayEnabled(true, true, this);
+    effectAmountKnob.setMouseCursor(juce::MouseCursor::UpDownResizeCursor);
+    effectAmountKnob.setColour(juce::Slider::ColourIds::thumbColourId, accentColour);
+    effectAmountKnob.setColour(juce::Slider::ColourIds::rotarySliderFillColourId, juce::Colours::yellowgreen);
+
+    echoBeatsButton.setBounds(getWidth() - rowW + 4, rowH * 3.6, rowW - 8, rowH * 0.8);
+    echoBeatsButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+    echoBeatsButton.setColour(juce::TextButton::ColourIds::textColourOffId, accentColour);
+    echoBeatsButton.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+
+    // The playback modes down the right, under the echo's beats.
+    styleModeButton(vinylButton, rowH * 4.5);
+    styleModeButton(slipButton, rowH * 5.3);
+    styleModeButton(reverseButton, rowH * 6.1);
 }
 
 void DeckGUI::buttonClicked(juce::Button* button)
@@ -170,6 +233,53 @@ void DeckGUI::buttonClicked(juce::Button* button)
         }
     }
     
+    // The effect switches toggle themselves before they are reported.
+    if (button == &echoButton)
+    {
+        player->setEffectEnabled(EffectsRack::echo, echoButton.getToggleState());
+    }
+
+    if (button == &reverbButton)
+    {
+        player->setEffectEnabled(EffectsRack::reverb, reverbButton.getToggleState());
+    }
+
+    if (button == &flangerButton)
+    {
+        player->setEffectEnabled(EffectsRack::flanger, flangerButton.getToggleState());
+    }
+
+    if (button == &crushButton)
+    {
+        player->setEffectEnabled(EffectsRack::bitcrush, crushButton.getToggleState());
+    }
+
+    if (button == &echoBeatsButton)
+    {
+        // Step through a quarter, a half, three quarters and a whole beat.
+        const char* beatNames[] = { "1/4", "1/2", "3/4", "1" };
+        echoBeatsIndex = (echoBeatsIndex + 1) % 4;
+
+        player->setEchoBeats((echoBeatsIndex + 1) * 0.25);
+        echoBeatsButton.setButtonText(beatNames[echoBeatsIndex]);
+    }
+
+    if (button == &vinylButton)
+    {
+        // In vinyl mode the disc is scratched by hand, so the clicks go past the position slider.
+        posSlider.setInterceptsMouseClicks(!vinylButton.getToggleState(), false);
+    }
+
+    if (button == &slipButton)
+    {
+        player->setSlipEnabled(slipButton.getToggleState());
+    }
+
+    if (button == &reverseButton)
+    {
+        player->setReversed(reverseButton.getToggleState());
+    }
+
     if (button == &loadButton)
     {
         if (isLoaded)
@@ -189,22 +299,22 @@ void DeckGUI::buttonClicked(juce::Button* button)
             juce::String trackLength = getSongLength(trackFile);
             juce::URL trackPath = juce::URL{ trackFile };
 
-            player->loadURL(trackPath);
-            waveformDisplay.loadFile(trackName, trackLength, trackPath);
-            
-            isLoaded = true;
-            playButton.setToggleState(false, juce::NotificationType::dontSendNotification);
-            pauseButton.setToggleState(false, juce::NotificationType::dontSendNotification);
-            stopButton.setToggleState(false, juce::NotificationType::dontSendNotification);
-            loadButton.setToggleState(false, juce::NotificationType::dontSendNotification);
-            
-            userExperienceLevel++;
+            loadTrack(trackName, trackLength, trackPath, Track::createContentHash(trackFile));
         }
     }
 }
 
 void DeckGUI::sliderValueChanged (juce::Slider *slider)
 {
+    if (slider == &effectAmountKnob)
+    {
+        // One knob sets how much of every effect is heard.
+        for (int effect = 0; effect < EffectsRack::numEffects; ++effect)
+        {
+            player->setEffectAmount((EffectsRack::Effect) effect, slider->getValue());
+        }
+    }
+
     if (slider == &posSlider)
     {
         double sliderValue = slider->getValue();
@@ -222,6 +332,50 @@ void DeckGUI::sliderValueChanged (juce::Slider *slider)
     }
 }
 
+void DeckGUI::mouseDown (const juce::MouseEvent& event)
+{
+    juce::Point<double> position = event.position.toDouble();
+    double discRadius = disc.getWidth() / 2.0;
+
+    if (vinylButton.getToggleState() && isLoaded && position.getDistanceFrom(getDiscCentre()) <= discRadius)
+    {
+        isJogging = true;
+        lastJogAngle = getDiscAngle(position);
+        player->touchJog();
+    }
+}
+
+void DeckGUI::mouseDrag (const juce::MouseEvent& event)
+{
+    if (isJogging)
+    {
+        double angle = getDiscAngle(event.position.toDouble());
+        double turn = angle - lastJogAngle;
+
+        // Take the short way round, where the angle wraps from pi to -pi.
+        if (turn > juce::MathConstants<double>::pi)
+        {
+            turn -= juce::MathConstants<double>::twoPi;
+        }
+        else if (turn < -juce::MathConstants<double>::pi)
+        {
+            turn += juce::MathConstants<double>::twoPi;
+        }
+
+        lastJogAngle = angle;
+        player->moveJog(turn / juce::MathConstants<double>::twoPi);
+    }
+}
+
+void DeckGUI::mouseUp (const juce::MouseEvent& event)
+{
+    if (isJogging)
+    {
+        isJogging = false;
+        player->releaseJog();
+    }
+}
+
 bool DeckGUI::isInterestedInFileDrag (const juce::StringArray &files)
 {
   return true; 
@@ -234,16 +388,8 @@ void DeckGUI::filesDropped (const juce::StringArray &files, int x, int y)
         juce::String trackName = getSongTitle(juce::File{ files[0] });
         juce::String trackLength = getSongLength(juce::File{ files[0] });
         juce::URL trackPath = juce::URL{ juce::File{files[0]} };
-        player->loadURL(trackPath);
-        waveformDisplay.loadFile(trackName, trackLength, trackPath);
-
-        isLoaded = true;
-        playButton.setToggleState(false, juce::NotificationType::dontSendNotification);
-        pauseButton.setToggleState(false, juce::NotificationType::dontSendNotification);
-        stopButton.setToggleState(false, juce::NotificationType::dontSendNotification);
-        loadButton.setToggleState(false, juce::NotificationType::dontSendNotification);
-        
-        userExperienceLevel++;
+
+        loadTrack(trackName, trackLength, trackPath, Track::createContentHash(juce::File{ files[0] }));
     }
 }
 
@@ -261,17 +407,49 @@ void DeckGUI::timerCallback()
     if (userExperienceLevel <= 2)
     {
         posSlider.setTooltip("Click and drag disc to the right or \nleft to change the current position.");
+        echoButton.setTooltip("Click to switch the echo on. \nSwitched off, the echoes ring out.");
+        effectAmountKnob.setTooltip("Turn to set how much of the effects is heard.");
+        echoBeatsButton.setTooltip("Click to change the beats between echoes.");
+        vinylButton.setTooltip("Click for vinyl mode, then hold the disc \nand turn it either way to scratch.");
+        slipButton.setTooltip("Click for slip mode: after a scratch, reverse or loop, \nthe track carries on from where it would have been.");
+        reverseButton.setTooltip("Click to play the track backwards.");
     }
     else
     {
         posSlider.setTooltip("");
+        echoButton.setTooltip("");
+        effectAmountKnob.setTooltip("");
+        echoBeatsButton.setTooltip("");
+        vinylButton.setTooltip("");
+        slipButton.setTooltip("");
+        reverseButton.setTooltip("");
     }
 }
 
-void DeckGUI::loadTrack(juce::String trackName, juce::String trackLength, juce::URL trackPath)
+void DeckGUI::tracksAnalysed(const std::vector<TrackAnalyser::Result>& results)
+{
+    for (const auto& result : results)
+    {
+        if (result.contentHash == loadedContentHash && loadedContentHash != 0)
+        {
+            waveformDisplay.setBeatGrid(result.beatGrid);
+            player->setBeatGrid(result.beatGrid.bpm, result.beatGrid.firstBeatSeconds);
+            player->setLoudness(result.loudness.integratedLufs, result.loudness.truePeakDb);
+            loadedKey = result.key.key;
+            sendChangeMessage();
+        }
+    }
+}
+
+void DeckGUI::loadTrack(juce::String trackName, juce::String trackLength, juce::URL trackPath, juce::uint64 contentHash)
 {
     player->loadURL(trackPath);
-    waveformDisplay.loadFile(trackName, trackLength, trackPath);
+    waveformDisplay.loadFile(trackName, trackLength, trackPath, contentHash);
+
+    // The track on the deck is analysed before anything queued for the library.
+    loadedContentHash = contentHash;
+    loadedKey = CamelotKey::noKey;
+    trackAnalyser.analyseTrack(trackPath, contentHash, AnalysisScheduler::Priority::interactive);
 
     isLoaded = true;
     playButton.setToggleState(false, juce::NotificationType::dontSendNotification);
@@ -280,46 +458,34 @@ void DeckGUI::loadTrack(juce::String trackName, juce::String trackLength, juce::
     loadButton.setToggleState(false, juce::NotificationType::dontSendNotification);
     
     userExperienceLevel++;
+    sendChangeMessage();
 }
 
-juce::String DeckGUI::getSongTitle(juce::File songFile)
+juce::uint64 DeckGUI::getLoadedContentHash() const
 {
-    juce::String songTitle{ songFile.getFileNameWithoutExtension() };
-    return songTitle;
+    return loadedContentHash;
 }
 
-juce::String DeckGUI::getSongLength(juce::File songFile)
+int DeckGUI::getLoadedKey() const
 {
-    int numSamples{0};
-    double sampleRate{0.0};
-    double lengthInSecs{0.0};
-    auto* reader = formatManager.createReaderFor(juce::URL{ songFile }.createInputStream(false));
-
-    if (reader != nullptr) // good file!
-    {
-        numSamples = reader->lengthInSamples;
-        sampleRate = reader->sampleRate;
-        lengthInSecs = numSamples / sampleRate;
-    }
-
-    // Delete reader after use to prevent memory leaks.
-    delete reader;
+    return loadedKey;
+}
 
-    int minutes = floor(lengthInSecs / 60.0);
-    int seconds = floor(lengthInSecs - (minutes * 60));
+juce::String DeckGUI::getSongTitle(juce::File songFile)
+{
+    Track track{ "", juce::URL{ songFile }.toString(false) };
+    metadataScanner.scan(songFile, track);
 
-    juce::String songLength;
+    return track.getDisplayName();
+}
 
-    if (seconds >= 0 && seconds < 10)
-    {
-        songLength = juce::String{ minutes } + ":0" + juce::String{ seconds };
-    }
-    else
-    {
-        songLength = juce::String{ minutes } + ":" + juce::String{ seconds };
-    }
+juce::String DeckGUI::getSongLength(juce::File songFile)
+{
+    // The length comes from the file's headers, so the audio isn't opened for it.
+    Track track{ "", juce::URL{ songFile }.toString(false) };
+    metadataScanner.scan(songFile, track);
 
-    return songLength;
+    return track.getLengthText();
 }
 
 inline std::unique_ptr<juce::InputStream> DeckGUI::createImgFileInputStream(const char* resourcePath)
@@ -369,10 +535,53 @@ void DeckGUI::styleButton(juce::TextButton& button, double x)
     button.setMouseCursor(juce::MouseCursor::PointingHandCursor);
 }
 
+void DeckGUI::styleEffectButton(juce::TextButton& button, double y)
+{
+    double rowH = (double) (getHeight() / 8);
+    double rowW = (double) (getWidth() / 8);
+
+    button.setBounds(4, y, rowW - 8, rowH * 0.8);
+    button.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+    button.setColour(juce::TextButton::ColourIds::buttonOnColourId, accentColour);
+    button.setColour(juce::TextButton::ColourIds::textColourOffId, accentColour);
+    button.setColour(juce::TextButton::ColourIds::textColourOnId, juce::Colours::black);
+    button.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+}
+
+void DeckGUI::styleModeButton(juce::TextButton& button, double y)
+{
+    double rowH = (double) (getHeight() / 8);
+    double rowW = (double) (getWidth() / 8);
+
+    button.setBounds(getWidth() - rowW + 4, y, rowW - 8, rowH * 0.7);
+    button.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+    button.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::yellowgreen);
+    button.setColour(juce::TextButton::ColourIds::textColourOffId, accentColour);
+    button.setColour(juce::TextButton::ColourIds::textColourOnId, juce::Colours::black);
+    button.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+}
+
 juce::AffineTransform DeckGUI::getTransform()
 {
     juce::AffineTransform t;
-    t = t.rotated(fmod(0.15 * player->getPosInTrack(), 2.0) * juce::MathConstants<float>::twoPi);
+    // The disc turns as a record would under the needle, so it keeps up with a hand scratching it.
+    t = t.rotated(fmod(player->getPosInTrack() / ScratchEngine::secondsPerRevolution, 1.0) * juce::MathConstants<float>::twoPi);
 
     return t;
+}
+
+juce::Point<double> DeckGUI::getDiscCentre()
+{
+    double layoutH = (double) (getHeight() / 3);
+    double rowH = (double) (getHeight() / 8);
+
+    return { ((getWidth() / static_cast<double>(4)) - rowH / 2) + ((getWidth() / 1.5) - 5)/2,
+             (layoutH - 10) + ((getHeight() - (layoutH - rowH / 2)) / 1.5)/2 };
+}
+
+double DeckGUI::getDiscAngle(juce::Point<double> position)
+{
+    juce::Point<double> discCentre = getDiscCentre();
+
+    return std::atan2(position.y - discCentre.y, position.x - discCentre.x);
 }
\ No newline at end of file
@@ -13,6 +13,9 @@
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "DJAudioPlayer.h"
 #include "WaveformDisplay.h"
+#include "TrackMetadataScanner.h"
+#include "TrackAnalyser.h"
+#include "CamelotKey.h"
 
 //==============================================================================
 /*
@@ -21,24 +24,28 @@ class DeckGUI    : public Component,
                    public Button::Listener, 
                    public Slider::Listener, 
                    public FileDragAndDropTarget, 
-                   public Timer
+                   public Timer,
+                   public TrackAnalyser::Listener,
+                   public juce::ChangeBroadcaster
 {
     public:
         /**
         * PURPOSE: Creates the DeckGUI object, initialises its data members 
                    (including adding listeners) and starts a timer.
         * INPUTS: Pointers to DJAudioPlayer and juce TooltipWindow and references to 
-                  juce AudioFormatManager, juce AudioThumbnailCache, and an RGBA colour for styling.
+                  juce AudioFormatManager, juce AudioThumbnailCache, the TrackAnalyser, 
+                  and an RGBA colour for styling.
         * OUTPUTS: None.
         */
         DeckGUI(DJAudioPlayer* _player, 
                 juce::AudioFormatManager& formatManagerToUse,
                 juce::AudioThumbnailCache& cacheToUse, 
+                TrackAnalyser& analyserToUse,
                 juce::Colour& colourToUse,
                 juce::TooltipWindow* _tooltipWindow);
 
         /**
-        * PURPOSE: Destroys the DeckGUI object and stops the timer.
+        * PURPOSE: Destroys the DeckGUI object, stops the timer and stops listening to the TrackAnalyser.
         * INPUTS: None.
         * OUTPUTS: None.
         */
@@ -73,6 +80,28 @@ class DeckGUI    : public Component,
         */
         void sliderValueChanged (juce::Slider *slider) override;
 
+        /**
+        * PURPOSE: Puts a hand on the disc if it is clicked in vinyl mode. Overrides juce Component member function.
+        * INPUTS: The details of the mouse event.
+        * OUTPUTS: None.
+        */
+        void mouseDown (const juce::MouseEvent& event) override;
+
+        /**
+        * PURPOSE: Scratches the record by however far the hand turned the disc around its centre.
+        *          Overrides juce Component member function.
+        * INPUTS: The details of the mouse event.
+        * OUTPUTS: None.
+        */
+        void mouseDrag (const juce::MouseEvent& event) override;
+
+        /**
+        * PURPOSE: Lets go of the disc. Overrides juce Component member function.
+        * INPUTS: The details of the mouse event.
+        * OUTPUTS: None.
+        */
+        void mouseUp (const juce::MouseEvent& event) override;
+
         /**
         * PURPOSE: Callback to check whether this target is interested in the set of files being offered.
         *          Implements juce FileDragAndDropTarget (i.e. function is pure virtual).
@@ -101,21 +130,46 @@ class DeckGUI    : public Component,
         void timerCallback() override;
 
         /**
-        * PURPOSE: Loads the track to be played.
-        * INPUTS: The track name and track length as juce strings, and the track file path as a juce URL.
+        * PURPOSE: Shows the beat grid of the loaded track once it has been analysed, hands it and
+        *          the track's loudness to the player for beat-sync and the loudness trim, and
+        *          records the track's key. Sends a change message.
+        *          Implements TrackAnalyser::Listener (i.e. function is pure virtual).
+        * INPUTS: The results of the analyses.
+        * OUTPUTS: None.
+        */
+        void tracksAnalysed(const std::vector<TrackAnalyser::Result>& results) override;
+
+        /**
+        * PURPOSE: Loads the track to be played. Sends a change message.
+        * INPUTS: The track name and track length as juce strings, the track file path as a juce URL
+        *         and the content hash of the track's file.
         * OUTPUTS: None.
         */
-        void loadTrack(juce::String trackName, juce::String trackLength, juce::URL trackPath);
+        void loadTrack(juce::String trackName, juce::String trackLength, juce::URL trackPath, juce::uint64 contentHash);
+
+        /**
+        * PURPOSE: Gets the content hash of the loaded track.
+        * INPUTS: None.
+        * OUTPUTS: The content hash, or 0 if no track is loaded.
+        */
+        juce::uint64 getLoadedContentHash() const;
+
+        /**
+        * PURPOSE: Gets the detected key of the loaded track.
+        * INPUTS: None.
+        * OUTPUTS: The key as a CamelotKey index, or CamelotKey::noKey until the track has been analysed.
+        */
+        int getLoadedKey() const;
 
         /**
-        * PURPOSE: Gets the song title from the song file.
+        * PURPOSE: Gets the song title from the song file's tags (or its name if it has no title tag).
         * INPUTS: The song file as a juce File.
-        * OUTPUTS: The title of the song as a juce string.
+        * OUTPUTS: The title of the song (with the artist, if known) as a juce string.
         */
-        static juce::String getSongTitle(juce::File songFile);
+        juce::String getSongTitle(juce::File songFile);
 
         /**
-        * PURPOSE: Calculates the song length from the song file.
+        * PURPOSE: Reads the song length from the song file's headers.
         * INPUTS: The song file as a juce File.
         * OUTPUTS: The length of the song converted to juce string format.
         */
@@ -143,6 +197,20 @@ class DeckGUI    : public Component,
         */
         void styleButton(juce::TextButton& button, double x);
 
+        /**
+        * PURPOSE: Styles and places an effect switch in the strip of effect switches beside the disc.
+        * INPUTS: The button to be styled and its preferred y position.
+        * OUTPUTS: None.
+        */
+        void styleEffectButton(juce::TextButton& button, double y);
+
+        /**
+        * PURPOSE: Styles and places a playback mode switch (vinyl, slip or reverse) down the right of the disc.
+        * INPUTS: The button to be styled and its preferred y position.
+        * OUTPUTS: None.
+        */
+        void styleModeButton(juce::TextButton& button, double y);
+
         /**
         * PURPOSE: Applies a rotation to the disc record as a function of the track's current position.
         * INPUTS: None.
@@ -150,6 +218,20 @@ class DeckGUI    : public Component,
         */
         juce::AffineTransform getTransform();
 
+        /**
+        * PURPOSE: Gets the centre of the disc record, which it is drawn and turned around.
+        * INPUTS: None.
+        * OUTPUTS: The centre of the disc in the component's coordinates.
+        */
+        juce::Point<double> getDiscCentre();
+
+        /**
+        * PURPOSE: Gets the angle of a point around the centre of the disc.
+        * INPUTS: The point in the component's coordinates.
+        * OUTPUTS: The angle in radians, increasing clockwise.
+        */
+        double getDiscAngle(juce::Point<double> position);
+
 
         /** DATA MEMBERS */
 
@@ -157,13 +239,29 @@ class DeckGUI    : public Component,
         juce::TextButton pauseButton{"PAUSE"};
         juce::TextButton stopButton{"STOP"};
         juce::TextButton loadButton{"LOAD"};
+        juce::TextButton echoButton{"ECHO"};
+        juce::TextButton reverbButton{"VERB"};
+        juce::TextButton flangerButton{"FLNG"};
+        juce::TextButton crushButton{"CRSH"};
+        juce::TextButton echoBeatsButton{"3/4"};
+        juce::TextButton vinylButton{"VINYL"};
+        juce::TextButton slipButton{"SLIP"};
+        juce::TextButton reverseButton{"REV"};
         juce::Slider posSlider;
+        juce::Slider effectAmountKnob;
         juce::Image disc;
         juce::Colour accentColour;
         bool isLoaded;
         int userExperienceLevel;
+        juce::uint64 loadedContentHash;
+        int loadedKey;
+        int echoBeatsIndex;
+        bool isJogging;
+        double lastJogAngle;
 
         juce::AudioFormatManager& formatManager;
+        TrackMetadataScanner metadataScanner;
+        TrackAnalyser& trackAnalyser;
         WaveformDisplay waveformDisplay;
         DJAudioPlayer* player;
         juce::TooltipWindow* tooltipWindow;
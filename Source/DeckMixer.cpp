@@ -0,0 +1,233 @@
+/*
+  ==============================================================================
+
+    DeckMixer.cpp
+    Created: 20 Oct 2026 1:44:05am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "DeckMixer.h"
+
+DeckMixer::DeckMixer()
+                    : numDecks(0),
+                      rowLength(0)
+{
+    for (int deck = 0; deck < maxDecks; ++deck)
+    {
+        decks[deck] = nullptr;
+        faderGains[deck] = 1.0f;
+        cuesEnabled[deck] = false;
+        masterGains[deck] = 1.0f;
+        cueGains[deck] = 0.0f;
+    }
+
+    for (int row = 0; row < numRows; ++row)
+    {
+        rows[row] = nullptr;
+    }
+
+    for (size_t element = 0; element < Vector::SIMDNumElements; ++element)
+    {
+        ramp.set(element, (float) element);
+    }
+}
+
+DeckMixer::~DeckMixer()
+{
+}
+
+int DeckMixer::addDeck(juce::AudioSource* deck)
+{
+    if (deck == nullptr || numDecks == maxDecks)
+    {
+        return -1;
+    }
+
+    decks[numDecks] = deck;
+    return numDecks++;
+}
+
+void DeckMixer::setFaderGain(int deck, float gain)
+{
+    faderGains[deck] = juce::jlimit(0.0f, 1.0f, gain);
+}
+
+void DeckMixer::setCueEnabled(int deck, bool shouldBeCued)
+{
+    cuesEnabled[deck] = shouldBeCued;
+}
+
+void DeckMixer::setCueMix(float mix)
+{
+    cueMix = juce::jlimit(0.0f, 1.0f, mix);
+}
+
+void DeckMixer::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+{
+    // Whole registers per row, so every row starts on a SIMD boundary if the first does.
+    const int width = (int) Vector::SIMDNumElements;
+    rowLength = (juce::jmax(samplesPerBlockExpected, 1) + width - 1) / width * width;
+
+    storage.allocate((size_t) (numRows * rowLength + width), true);
+    layOutBuffers();
+
+    const float blend = cueMix.load();
+
+    for (int deck = 0; deck < numDecks; ++deck)
+    {
+        decks[deck]->prepareToPlay(samplesPerBlockExpected, sampleRate);
+
+        // Start at the current settings rather than ramping to them.
+        masterGains[deck] = faderGains[deck].load();
+        cueGains[deck] = blend * masterGains[deck] + (1.0f - blend) * (cuesEnabled[deck].load() ? 1.0f : 0.0f);
+    }
+}
+
+void DeckMixer::releaseResources()
+{
+    for (int deck = 0; deck < numDecks; ++deck)
+    {
+        decks[deck]->releaseResources();
+    }
+}
+
+void DeckMixer::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    if (rowLength == 0)
+    {
+        bufferToFill.clearActiveBufferRegion();
+        return;
+    }
+
+    // The device can ask for more than it said it would, so render in parts the buffers hold.
+    for (int done = 0; done < bufferToFill.numSamples; done += rowLength)
+    {
+        renderPart(bufferToFill, bufferToFill.startSample + done, juce::jmin(rowLength, bufferToFill.numSamples - done));
+    }
+}
+
+void DeckMixer::renderPart(const juce::AudioSourceChannelInfo& bufferToFill, int startSample, int numSamples)
+{
+    for (int deck = 0; deck < numDecks; ++deck)
+    {
+        juce::AudioSourceChannelInfo deckToFill(&deckBuffers[deck], 0, numSamples);
+        decks[deck]->getNextAudioBlock(deckToFill);
+    }
+
+    mix(numSamples);
+
+    juce::AudioBuffer<float>* buffer = bufferToFill.buffer;
+
+    for (int channel = 0; channel < buffer->getNumChannels(); ++channel)
+    {
+        if (channel < numOutputs)
+        {
+            buffer->copyFrom(channel, startSample, rows[firstOutputRow + channel], numSamples);
+        }
+        else
+        {
+            buffer->clear(channel, startSample, numSamples);
+        }
+    }
+}
+
+void DeckMixer::mix(int numSamples)
+{
+    const int width = (int) Vector::SIMDNumElements;
+    const float blend = cueMix.load();
+    float masterSteps[maxDecks];
+    float cueSteps[maxDecks];
+    float masterTargets[maxDecks];
+    float cueTargets[maxDecks];
+
+    for (int deck = 0; deck < numDecks; ++deck)
+    {
+        // The cue bus hears the deck before its fader if PFL is on, crossfaded with the master.
+        masterTargets[deck] = faderGains[deck].load();
+        cueTargets[deck] = blend * masterTargets[deck] + (1.0f - blend) * (cuesEnabled[deck].load() ? 1.0f : 0.0f);
+        masterSteps[deck] = (masterTargets[deck] - masterGains[deck]) / numSamples;
+        cueSteps[deck] = (cueTargets[deck] - cueGains[deck]) / numSamples;
+    }
+
+    for (int channel = 0; channel < numDeckChannels; ++channel)
+    {
+        float* master = rows[firstOutputRow + masterLeft + channel];
+        float* cue = rows[firstOutputRow + cueLeft + channel];
+
+        Vector masterGainVectors[maxDecks];
+        Vector cueGainVectors[maxDecks];
+        Vector masterStepVectors[maxDecks];
+        Vector cueStepVectors[maxDecks];
+
+        for (int deck = 0; deck < numDecks; ++deck)
+        {
+            masterGainVectors[deck] = Vector::expand(masterGains[deck]) + ramp * Vector::expand(masterSteps[deck]);
+            cueGainVectors[deck] = Vector::expand(cueGains[deck]) + ramp * Vector::expand(cueSteps[deck]);
+            masterStepVectors[deck] = Vector::expand(masterSteps[deck] * width);
+            cueStepVectors[deck] = Vector::expand(cueSteps[deck] * width);
+        }
+
+        int i = 0;
+
+        // A register of samples at a time, with both buses built up across every deck before they are stored.
+        for (; i + width <= numSamples; i += width)
+        {
+            Vector masterSum = Vector::expand(0.0f);
+            Vector cueSum = Vector::expand(0.0f);
+
+            for (int deck = 0; deck < numDecks; ++deck)
+            {
+                const Vector x = Vector::fromRawArray(rows[deck * numDeckChannels + channel] + i);
+
+                masterSum += x * masterGainVectors[deck];
+                cueSum += x * cueGainVectors[deck];
+                masterGainVectors[deck] += masterStepVectors[deck];
+                cueGainVectors[deck] += cueStepVectors[deck];
+            }
+
+            masterSum.copyToRawArray(master + i);
+            cueSum.copyToRawArray(cue + i);
+        }
+
+        for (; i < numSamples; ++i)
+        {
+            float masterSum = 0.0f;
+            float cueSum = 0.0f;
+
+            for (int deck = 0; deck < numDecks; ++deck)
+            {
+                const float x = rows[deck * numDeckChannels + channel][i];
+
+                masterSum += x * (masterGains[deck] + masterSteps[deck] * i);
+                cueSum += x * (cueGains[deck] + cueSteps[deck] * i);
+            }
+
+            master[i] = masterSum;
+            cue[i] = cueSum;
+        }
+    }
+
+    for (int deck = 0; deck < numDecks; ++deck)
+    {
+        masterGains[deck] = masterTargets[deck];
+        cueGains[deck] = cueTargets[deck];
+    }
+}
+
+void DeckMixer::layOutBuffers()
+{
+    float* row = Vector::getNextSIMDAlignedPtr(storage.get());
+
+    for (int index = 0; index < numRows; ++index)
+    {
+        rows[index] = row;
+        row += rowLength;
+    }
+
+    for (int deck = 0; deck < maxDecks; ++deck)
+    {
+        deckBuffers[deck].setDataToReferTo(rows + deck * numDeckChannels, numDeckChannels, rowLength);
+    }
+}
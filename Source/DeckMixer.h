@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+    DeckMixer.h
+    Created: 20 Oct 2026 1:44:05am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <atomic>
+
+//==============================================================================
+/*
+    Mixes the decks into the master bus on outputs 1/2 and a headphone cue
+    bus on outputs 3/4.
+
+    Each deck is rendered before its fader into a buffer of its own. One
+    pass over the samples then adds every deck into both buses at once: the
+    master gets the deck times its fader, and the cue bus gets the deck
+    times a gain that blends its PFL (pre-fader listen) button with the
+    master, as the cue/master knob sets. So the cue bus costs no pass of its
+    own, and each extra deck costs one more load and two multiply-adds per
+    register of samples. The gains ramp across each block, so moving a fader
+    or pressing PFL never clicks.
+
+    The buffers are laid out so every row starts on a SIMD boundary. On an
+    interface with only two outputs, the cue bus is mixed but not heard.
+*/
+class DeckMixer : public juce::AudioSource
+{
+    public:
+        /** The output channels, in the order they are sent to the interface. */
+        enum Output
+        {
+            masterLeft = 0,
+            masterRight,
+            cueLeft,
+            cueRight,
+            numOutputs
+        };
+
+        /**
+        * PURPOSE: Creates the DeckMixer object with no decks, every fader up and nothing cued.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        DeckMixer();
+
+        /**
+        * PURPOSE: Destroys the DeckMixer object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~DeckMixer() override;
+
+        /**
+        * PURPOSE: Adds a deck to the mix. Called before the audio starts.
+        * INPUTS: A pointer to the deck's audio source, which the DeckMixer doesn't own.
+        * OUTPUTS: The number of the deck, or -1 if there are already maxDecks.
+        */
+        int addDeck(juce::AudioSource* deck);
+
+        /**
+        * PURPOSE: Sets a deck's fader, which sets how loud it is on the master bus.
+        * INPUTS: The number of the deck and its gain (0 to 1).
+        * OUTPUTS: None.
+        */
+        void setFaderGain(int deck, float gain);
+
+        /**
+        * PURPOSE: Sends a deck to the cue bus before its fader, or takes it off.
+        * INPUTS: The number of the deck and a boolean; true to cue it and false not to.
+        * OUTPUTS: None.
+        */
+        void setCueEnabled(int deck, bool shouldBeCued);
+
+        /**
+        * PURPOSE: Sets how much of the master is heard on the cue bus.
+        * INPUTS: The blend, from 0 (only the cued decks) to 1 (only the master).
+        * OUTPUTS: None.
+        */
+        void setCueMix(float mix);
+
+        /**
+        * PURPOSE: Tells the source to prepare for playing. Sets up the buffers and prepares every deck.
+        *          Implements juce AudioSource (i.e. function is pure virtual).
+        * INPUTS: The number of samples that the source will be expected to supply each time
+        *         its getNextAudioBlock() method is called and the sample rate that the output
+        *         will be used at.
+        * OUTPUTS: None.
+        */
+        void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+
+        /**
+        * PURPOSE: Allows the source to release anything it no longer needs after playback has stopped.
+        *          Implements juce AudioSource (i.e. function is pure virtual).
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void releaseResources() override;
+
+        /**
+        * PURPOSE: Renders every deck and mixes them into the master and cue buses.
+        *          Implements juce AudioSource (i.e. function is pure virtual).
+        * INPUTS: A reference to the buffer to be filled. Its first two channels get the master bus,
+        *         the next two the cue bus and any others are cleared.
+        * OUTPUTS: None.
+        */
+        void getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int maxDecks = 4;
+
+    private:
+        using Vector = juce::dsp::SIMDRegister<float>;
+
+        /**
+        * PURPOSE: Renders and mixes a part of the block no longer than the buffers.
+        * INPUTS: A reference to the buffer to be filled, where the part starts in it and its length.
+        * OUTPUTS: None.
+        */
+        void renderPart(const juce::AudioSourceChannelInfo& bufferToFill, int startSample, int numSamples);
+
+        /**
+        * PURPOSE: Adds every deck's buffer into both buses in one pass, ramping each deck's gains
+        *          from where the last part left them to where they are now.
+        * INPUTS: The number of samples to mix.
+        * OUTPUTS: None.
+        */
+        void mix(int numSamples);
+
+        /**
+        * PURPOSE: Points every deck's buffer and the buses at their rows of the storage.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void layOutBuffers();
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int numDeckChannels = 2;
+        static constexpr int firstOutputRow = maxDecks * numDeckChannels;
+        static constexpr int numRows = firstOutputRow + numOutputs;
+
+        juce::AudioSource* decks[maxDecks];
+        int numDecks;
+
+        std::atomic<float> faderGains[maxDecks];
+        std::atomic<bool> cuesEnabled[maxDecks];
+        std::atomic<float> cueMix{ 0.0f };
+
+        // The gains each deck was last mixed at, so the next part ramps on from them.
+        float masterGains[maxDecks];
+        float cueGains[maxDecks];
+
+        // One row per deck channel and per output, each starting on a SIMD boundary.
+        juce::HeapBlock<float> storage;
+        float* rows[numRows];
+        int rowLength;
+
+        juce::AudioBuffer<float> deckBuffers[maxDecks];
+
+        // 0, 1, 2, ... across a register, for ramping a gain within it.
+        Vector ramp;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DeckMixer)
+};
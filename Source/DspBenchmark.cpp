@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+
+    DspBenchmark.cpp
+    Created: 19 Oct 2026 10:58:03pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "DspBenchmark.h"
+#include "BenchmarkRunner.h"
+#include <algorithm>
+#include <cmath>
+
+DspBenchmark::DspBenchmark()
+                          : random(20261019),
+                            noise(2, noiseLength)
+{
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        for (int i = 0; i < noiseLength; ++i)
+        {
+            noise.setSample(channel, i, 0.5f * (random.nextFloat() * 2.0f - 1.0f));
+        }
+    }
+}
+
+DspBenchmark::~DspBenchmark()
+{
+}
+
+juce::var DspBenchmark::runFromCommandLine(const juce::StringArray& arguments)
+{
+    DspBenchmark benchmark;
+
+    return benchmark.run(BenchmarkRunner::getSizesOption(arguments, "--block-sizes", { 64, 256, 512, 1024 }, noiseLength));
+}
+
+juce::var DspBenchmark::run(const std::vector<int>& blockSizes)
+{
+    juce::Array<juce::var> blocks;
+
+    for (int blockSize : blockSizes)
+    {
+        blocks.add(benchmarkBlockSize(blockSize));
+    }
+
+    juce::DynamicObject::Ptr results = BenchmarkRunner::createResults();
+    results->setProperty("sampleRate", sampleRate);
+    results->setProperty("deckDsp", blocks);
+
+    return juce::var(results.get());
+}
+
+juce::var DspBenchmark::benchmarkBlockSize(int blockSize)
+{
+    juce::DynamicObject::Ptr result = new juce::DynamicObject();
+    result->setProperty("blockSize", blockSize);
+    result->setProperty("blockMs", 1000.0 * blockSize / sampleRate);
+
+    {
+        DeckEqualiser equaliser;
+        equaliser.prepare(sampleRate);
+        result->setProperty("eqUntouched", timeEqualiser(equaliser, blockSize, false));
+    }
+
+    {
+        DeckEqualiser equaliser;
+        equaliser.prepare(sampleRate);
+        setUpAllStages(equaliser);
+        result->setProperty("eqAllStages", timeEqualiser(equaliser, blockSize, false));
+    }
+
+    {
+        DeckEqualiser equaliser;
+        equaliser.prepare(sampleRate);
+        setUpAllStages(equaliser);
+        result->setProperty("eqTurningKnobs", timeEqualiser(equaliser, blockSize, true));
+    }
+
+    result->setProperty("scalarReference", timeScalarReference(blockSize));
+
+    return juce::var(result.get());
+}
+
+juce::var DspBenchmark::timeEqualiser(DeckEqualiser& equaliser, int blockSize, bool shouldTurnKnobs)
+{
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::AudioSourceChannelInfo bufferToFill(&buffer, 0, blockSize);
+    std::vector<double> timesUs;
+    timesUs.reserve(numBlocks);
+
+    for (int block = 0; block < numWarmUpBlocks + numBlocks; ++block)
+    {
+        fillBlock(buffer, block);
+
+        if (shouldTurnKnobs)
+        {
+            // A slow wobble on every knob, so every stage is always ramping to a new target.
+            double phase = block * 0.05;
+            equaliser.setBandGain(DeckEqualiser::low, -10.0 + 8.0 * std::sin(phase));
+            equaliser.setBandGain(DeckEqualiser::mid, -10.0 + 8.0 * std::sin(phase + 1.0));
+            equaliser.setBandGain(DeckEqualiser::high, -10.0 + 8.0 * std::sin(phase + 2.0));
+            equaliser.setFilter(0.5 * std::sin(phase) - 0.5);
+        }
+
+        juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+        equaliser.process(bufferToFill);
+        juce::int64 endTicks = juce::Time::getHighResolutionTicks();
+
+        if (block >= numWarmUpBlocks)
+        {
+            timesUs.push_back(1.0e6 * juce::Time::highResolutionTicksToSeconds(endTicks - startTicks));
+        }
+    }
+
+    return summarise(timesUs, blockSize);
+}
+
+juce::var DspBenchmark::timeScalarReference(int blockSize)
+{
+    const StereoBiquad::Coefficients designs[] =
+    {
+        StereoBiquad::Coefficients::makeLowShelf(sampleRate, 250.0, 0.7071, 3.0),
+        StereoBiquad::Coefficients::makePeak(sampleRate, 1000.0, 0.7, -6.0),
+        StereoBiquad::Coefficients::makeHighShelf(sampleRate, 4000.0, 0.7071, 4.0),
+        StereoBiquad::Coefficients::makeLowPass(sampleRate, 2000.0, 1.0)
+    };
+
+    juce::IIRFilter filters[2][4];
+
+    for (auto& channelFilters : filters)
+    {
+        for (int stage = 0; stage < 4; ++stage)
+        {
+            const StereoBiquad::Coefficients& c = designs[stage];
+            channelFilters[stage].setCoefficients(juce::IIRCoefficients(c.b0, c.b1, c.b2, 1.0, c.a1, c.a2));
+        }
+    }
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    std::vector<double> timesUs;
+    timesUs.reserve(numBlocks);
+
+    for (int block = 0; block < numWarmUpBlocks + numBlocks; ++block)
+    {
+        fillBlock(buffer, block);
+
+        juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            for (auto& filter : filters[channel])
+            {
+                filter.processSamples(buffer.getWritePointer(channel), blockSize);
+            }
+        }
+
+        juce::int64 endTicks = juce::Time::getHighResolutionTicks();
+
+        if (block >= numWarmUpBlocks)
+        {
+            timesUs.push_back(1.0e6 * juce::Time::highResolutionTicksToSeconds(endTicks - startTicks));
+        }
+    }
+
+    return summarise(timesUs, blockSize);
+}
+
+void DspBenchmark::setUpAllStages(DeckEqualiser& equaliser)
+{
+    equaliser.setBandGain(DeckEqualiser::low, 3.0);
+    equaliser.setBandGain(DeckEqualiser::mid, -6.0);
+    equaliser.setBandGain(DeckEqualiser::high, 4.0);
+    equaliser.setFilter(-0.5);
+}
+
+void DspBenchmark::fillBlock(juce::AudioBuffer<float>& buffer, int blockNumber) const
+{
+    const int numSamples = buffer.getNumSamples();
+    const int start = (int) (((juce::int64) blockNumber * numSamples) % (noiseLength - numSamples + 1));
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        buffer.copyFrom(channel, 0, noise, channel, start, numSamples);
+    }
+}
+
+juce::var DspBenchmark::summarise(std::vector<double>& timesUs, int blockSize)
+{
+    juce::DynamicObject::Ptr summary = new juce::DynamicObject();
+    std::sort(timesUs.begin(), timesUs.end());
+
+    auto percentile = [&timesUs](double fraction)
+    {
+        if (timesUs.empty())
+        {
+            return 0.0;
+        }
+
+        return timesUs[juce::jmin(timesUs.size() - 1, (size_t) (fraction * timesUs.size()))];
+    };
+
+    const double blockUs = 1.0e6 * blockSize / sampleRate;
+
+    summary->setProperty("p50Us", percentile(0.5));
+    summary->setProperty("p90Us", percentile(0.9));
+    summary->setProperty("p99Us", percentile(0.99));
+    summary->setProperty("maxUs", percentile(1.0));
+    summary->setProperty("nsPerSample", 1000.0 * percentile(0.5) / blockSize);
+    summary->setProperty("shareOfBlockP50", percentile(0.5) / blockUs);
+    summary->setProperty("shareOfBlockP99", percentile(0.99) / blockUs);
+
+    return juce::var(summary.get());
+}
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    DspBenchmark.h
+    Created: 19 Oct 2026 10:58:03pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "DeckEqualiser.h"
+#include "StereoBiquad.h"
+#include <vector>
+
+//==============================================================================
+/*
+    Measures what the audio processing of one deck costs per block.
+
+    Every measurement runs a deck's processing over thousands of blocks of
+    stereo noise and times each block on its own, so the percentiles show the
+    odd slow block as well as the typical one. Each cost is also given as a
+    share of the time the block lasts at 44.1 kHz, which is the budget the
+    audio thread has to render it in.
+
+    The EQ is measured untouched (every stage skipped), with every band and
+    the filter set, and with every knob turning every block so the
+    coefficients of all four stages are always ramping. The same four
+    biquads run one channel at a time through juce::IIRFilter are measured
+    too, as the scalar baseline the SIMD stages are there to beat.
+
+    Run the app with "--dsp-benchmark [output.json] [--block-sizes 64,256,512]"
+    to run it without opening a window; the results are written as JSON (to
+    the standard output if no file is given).
+*/
+class DspBenchmark
+{
+    public:
+        /**
+        * PURPOSE: Creates the DspBenchmark object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        DspBenchmark();
+
+        /**
+        * PURPOSE: Destroys the DspBenchmark object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~DspBenchmark();
+
+        /**
+        * PURPOSE: Runs the benchmark with the options given on the command line.
+        * INPUTS: The arguments of the command line.
+        * OUTPUTS: The results, as a juce var holding a JSON object.
+        */
+        static juce::var runFromCommandLine(const juce::StringArray& arguments);
+
+        /**
+        * PURPOSE: Runs the benchmark for each block size.
+        * INPUTS: The block sizes in samples.
+        * OUTPUTS: The results, as a juce var holding a JSON object.
+        */
+        juce::var run(const std::vector<int>& blockSizes);
+
+    private:
+        /**
+        * PURPOSE: Runs every measurement at one block size.
+        * INPUTS: The block size in samples.
+        * OUTPUTS: The results as an object.
+        */
+        juce::var benchmarkBlockSize(int blockSize);
+
+        /**
+        * PURPOSE: Times the EQ of a deck block by block.
+        * INPUTS: The EQ, set up as it should be measured, the block size and whether to turn
+        *         every knob a little before every block.
+        * OUTPUTS: The timings as an object.
+        */
+        juce::var timeEqualiser(DeckEqualiser& equaliser, int blockSize, bool shouldTurnKnobs);
+
+        /**
+        * PURPOSE: Times the same stages as the fully set EQ, run one channel at a time through juce::IIRFilter.
+        * INPUTS: The block size.
+        * OUTPUTS: The timings as an object.
+        */
+        juce::var timeScalarReference(int blockSize);
+
+        /**
+        * PURPOSE: Sets every band of an EQ and its filter, so that none of its stages is skipped.
+        * INPUTS: The EQ.
+        * OUTPUTS: None.
+        */
+        static void setUpAllStages(DeckEqualiser& equaliser);
+
+        /**
+        * PURPOSE: Copies the next block of the noise into the buffer to be processed.
+        * INPUTS: The buffer and the number of the block.
+        * OUTPUTS: None.
+        */
+        void fillBlock(juce::AudioBuffer<float>& buffer, int blockNumber) const;
+
+        /**
+        * PURPOSE: Summarises a set of block timings as percentiles and as shares of the block's duration.
+        * INPUTS: The timings in microseconds (sorted in place) and the block size.
+        * OUTPUTS: The summary as an object.
+        */
+        static juce::var summarise(std::vector<double>& timesUs, int blockSize);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr double sampleRate = 44100.0;
+        static constexpr int numBlocks = 5000;
+        static constexpr int numWarmUpBlocks = 100;
+        static constexpr int noiseLength = 1 << 16;
+
+        juce::Random random;
+        juce::AudioBuffer<float> noise;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DspBenchmark)
+};
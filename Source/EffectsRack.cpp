@@ -0,0 +1,382 @@
+/*
+  ==============================================================================
+
+    EffectsRack.cpp
+    Created: 19 Oct 2026 11:24:36pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "EffectsRack.h"
+#include <cmath>
+
+EffectsRack::EffectsRack()
+                        : sampleRate(44100.0),
+                          tempo(0.0),
+                          crushedLeft(0.0f),
+                          crushedRight(0.0f),
+                          crushHoldCounter(0),
+                          flangerWritePosition(0),
+                          flangerPhase(0.0),
+                          echoWritePosition(0),
+                          echoDelaySamples(1.0)
+{
+    for (int index = 0; index < numEffects; ++index)
+    {
+        effectsEnabled[index] = false;
+        effectAmounts[index] = 0.5;
+    }
+
+    juce::Reverb::Parameters parameters;
+    parameters.roomSize = 0.8f;
+    parameters.damping = 0.4f;
+    parameters.wetLevel = 0.33f;
+    parameters.dryLevel = 0.0f;
+    parameters.width = 1.0f;
+    reverbTank.setParameters(parameters);
+
+    prepare(sampleRate);
+}
+
+EffectsRack::~EffectsRack()
+{
+}
+
+void EffectsRack::prepare(double _sampleRate)
+{
+    sampleRate = _sampleRate;
+
+    // Everything the effects will ever need is allocated here, up front.
+    flangerLine.setSize(2, (int) std::ceil(maxFlangerMs * 0.001 * sampleRate) + 2);
+    echoLine.setSize(2, (int) std::ceil(maxEchoSeconds * sampleRate) + 2);
+    reverbChunk.setSize(2, reverbChunkSize);
+    reverbTank.setSampleRate(sampleRate);
+
+    echoDelaySamples = echoBeats.load() * 60.0 / defaultBpm * sampleRate;
+
+    for (int index = 0; index < numEffects; ++index)
+    {
+        clearEffect((Effect) index);
+        states[index] = EffectState::idle;
+        silentSamples[index] = 0;
+        mixes[index].reset(sampleRate, mixRampSeconds);
+    }
+}
+
+void EffectsRack::setEffectEnabled(Effect effect, bool shouldBeEnabled)
+{
+    effectsEnabled[effect] = shouldBeEnabled;
+}
+
+bool EffectsRack::isEffectEnabled(Effect effect) const
+{
+    return effectsEnabled[effect].load();
+}
+
+void EffectsRack::setEffectAmount(Effect effect, double amount)
+{
+    effectAmounts[effect] = juce::jlimit(0.0, 1.0, amount);
+}
+
+void EffectsRack::setEchoBeats(double beats)
+{
+    echoBeats = juce::jlimit(0.25, 1.0, beats);
+}
+
+void EffectsRack::setTempo(double bpm)
+{
+    tempo = bpm;
+}
+
+void EffectsRack::process(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    juce::AudioBuffer<float>* buffer = bufferToFill.buffer;
+
+    if (buffer == nullptr || buffer->getNumChannels() == 0 || bufferToFill.numSamples <= 0)
+    {
+        return;
+    }
+
+    float* left = buffer->getWritePointer(0, bufferToFill.startSample);
+    float* right = buffer->getNumChannels() > 1 ? buffer->getWritePointer(1, bufferToFill.startSample) : left;
+    const int numSamples = bufferToFill.numSamples;
+
+    for (int index = 0; index < numEffects; ++index)
+    {
+        const Effect effect = (Effect) index;
+        const bool isEnabled = effectsEnabled[index].load();
+        EffectState& state = states[index];
+
+        if (isEnabled && state != EffectState::on)
+        {
+            if (state == EffectState::idle)
+            {
+                // Fade in from silence rather than jumping to the effect's full level.
+                mixes[index].setCurrentAndTargetValue(0.0f);
+            }
+
+            state = EffectState::on;
+        }
+        else if (!isEnabled && state == EffectState::on)
+        {
+            state = EffectState::stopping;
+            silentSamples[index] = 0;
+        }
+
+        if (state == EffectState::idle)
+        {
+            continue;
+        }
+
+        // A tail rings out at the level it was playing at; the other effects fade to nothing.
+        const bool isFed = state == EffectState::on || !hasTail(effect);
+        const float level = effect == bitcrush ? 1.0f : (float) effectAmounts[index].load();
+        mixes[index].setTargetValue(state == EffectState::stopping && !hasTail(effect) ? 0.0f : level);
+
+        float peak = 0.0f;
+
+        switch (effect)
+        {
+            case bitcrush:
+                peak = processBitcrush(left, right, numSamples);
+                break;
+            case flanger:
+                peak = processFlanger(left, right, numSamples, isFed);
+                break;
+            case echo:
+                peak = processEcho(left, right, numSamples, isFed);
+                break;
+            case reverb:
+                peak = processReverb(left, right, numSamples, isFed);
+                break;
+            default:
+                break;
+        }
+
+        if (state == EffectState::stopping)
+        {
+            silentSamples[index] = peak < silenceThreshold ? silentSamples[index] + numSamples : 0;
+
+            bool isFinished = hasTail(effect) ? silentSamples[index] >= getTailSamples(effect)
+                                              : !mixes[index].isSmoothing();
+
+            if (isFinished)
+            {
+                clearEffect(effect);
+                state = EffectState::idle;
+            }
+        }
+    }
+}
+
+float EffectsRack::processBitcrush(float* left, float* right, int numSamples)
+{
+    // From 16 bits at the full sample rate down to 4 bits at a sixteenth of it.
+    const double amount = effectAmounts[bitcrush].load();
+    const float steps = (float) std::pow(2.0, 15.0 - 12.0 * amount);
+    const int holdLength = 1 + juce::roundToInt(amount * 15.0);
+    float peak = 0.0f;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float inLeft = left[i];
+        const float inRight = right[i];
+
+        if (--crushHoldCounter <= 0)
+        {
+            crushedLeft = std::round(inLeft * steps) / steps;
+            crushedRight = std::round(inRight * steps) / steps;
+            crushHoldCounter = holdLength;
+        }
+
+        const float mix = mixes[bitcrush].getNextValue();
+        left[i] = inLeft + mix * (crushedLeft - inLeft);
+        right[i] = inRight + mix * (crushedRight - inRight);
+
+        peak = juce::jmax(peak, std::abs(crushedLeft), std::abs(crushedRight));
+    }
+
+    return peak;
+}
+
+float EffectsRack::processFlanger(float* left, float* right, int numSamples, bool isFed)
+{
+    const int length = flangerLine.getNumSamples();
+    float* lineLeft = flangerLine.getWritePointer(0);
+    float* lineRight = flangerLine.getWritePointer(1);
+
+    const double sweepSeconds = tempo > 0.0 ? flangerBeatsPerSweep * 60.0 / tempo : 8.0;
+    const double phaseStep = 1.0 / (sweepSeconds * sampleRate);
+    const double minDelay = minFlangerMs * 0.001 * sampleRate;
+    const double sweepDepth = (maxFlangerMs - minFlangerMs) * 0.001 * sampleRate;
+    const double twoPi = juce::MathConstants<double>::twoPi;
+    float peak = 0.0f;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // The right channel's sweep is a quarter of a turn ahead, which widens the image.
+        const double delayLeft = minDelay + sweepDepth * (0.5 - 0.5 * std::cos(twoPi * flangerPhase));
+        const double delayRight = minDelay + sweepDepth * (0.5 - 0.5 * std::cos(twoPi * (flangerPhase + 0.25)));
+
+        const float wetLeft = readDelayLine(lineLeft, length, flangerWritePosition - delayLeft);
+        const float wetRight = readDelayLine(lineRight, length, flangerWritePosition - delayRight);
+        const float inLeft = left[i];
+        const float inRight = right[i];
+
+        lineLeft[flangerWritePosition] = (isFed ? inLeft : 0.0f) + (float) flangerFeedback * wetLeft;
+        lineRight[flangerWritePosition] = (isFed ? inRight : 0.0f) + (float) flangerFeedback * wetRight;
+
+        const float mix = mixes[flanger].getNextValue();
+        left[i] = inLeft + mix * wetLeft;
+        right[i] = inRight + mix * wetRight;
+
+        peak = juce::jmax(peak, std::abs(wetLeft), std::abs(wetRight));
+
+        flangerWritePosition = flangerWritePosition + 1 < length ? flangerWritePosition + 1 : 0;
+        flangerPhase += phaseStep;
+
+        if (flangerPhase >= 1.0)
+        {
+            flangerPhase -= 1.0;
+        }
+    }
+
+    return peak;
+}
+
+float EffectsRack::processEcho(float* left, float* right, int numSamples, bool isFed)
+{
+    const int length = echoLine.getNumSamples();
+    float* lineLeft = echoLine.getWritePointer(0);
+    float* lineRight = echoLine.getWritePointer(1);
+
+    const double bpm = tempo > 0.0 ? tempo : defaultBpm;
+    const double targetDelay = juce::jlimit(1.0, length - 2.0, echoBeats.load() * 60.0 / bpm * sampleRate);
+    const double glide = 1.0 - std::exp(-1.0 / (echoGlideSeconds * sampleRate));
+    float peak = 0.0f;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // A tempo change glides the delay rather than jumping it, which would click.
+        echoDelaySamples += (targetDelay - echoDelaySamples) * glide;
+
+        const float wetLeft = readDelayLine(lineLeft, length, echoWritePosition - echoDelaySamples);
+        const float wetRight = readDelayLine(lineRight, length, echoWritePosition - echoDelaySamples);
+        const float inLeft = left[i];
+        const float inRight = right[i];
+
+        lineLeft[echoWritePosition] = (isFed ? inLeft : 0.0f) + (float) echoFeedback * wetLeft;
+        lineRight[echoWritePosition] = (isFed ? inRight : 0.0f) + (float) echoFeedback * wetRight;
+
+        const float mix = mixes[echo].getNextValue();
+        left[i] = inLeft + mix * wetLeft;
+        right[i] = inRight + mix * wetRight;
+
+        peak = juce::jmax(peak, std::abs(wetLeft), std::abs(wetRight));
+
+        echoWritePosition = echoWritePosition + 1 < length ? echoWritePosition + 1 : 0;
+    }
+
+    return peak;
+}
+
+float EffectsRack::processReverb(float* left, float* right, int numSamples, bool isFed)
+{
+    float* chunkLeft = reverbChunk.getWritePointer(0);
+    float* chunkRight = reverbChunk.getWritePointer(1);
+    float peak = 0.0f;
+
+    for (int start = 0; start < numSamples; start += reverbChunkSize)
+    {
+        const int numInChunk = juce::jmin(reverbChunkSize, numSamples - start);
+
+        if (isFed)
+        {
+            juce::FloatVectorOperations::copy(chunkLeft, left + start, numInChunk);
+            juce::FloatVectorOperations::copy(chunkRight, right + start, numInChunk);
+        }
+        else
+        {
+            juce::FloatVectorOperations::clear(chunkLeft, numInChunk);
+            juce::FloatVectorOperations::clear(chunkRight, numInChunk);
+        }
+
+        reverbTank.processStereo(chunkLeft, chunkRight, numInChunk);
+
+        for (int i = 0; i < numInChunk; ++i)
+        {
+            const float inLeft = left[start + i];
+            const float inRight = right[start + i];
+            const float mix = mixes[reverb].getNextValue();
+
+            left[start + i] = inLeft + mix * chunkLeft[i];
+            right[start + i] = inRight + mix * chunkRight[i];
+
+            peak = juce::jmax(peak, std::abs(chunkLeft[i]), std::abs(chunkRight[i]));
+        }
+    }
+
+    return peak;
+}
+
+bool EffectsRack::hasTail(Effect effect)
+{
+    return effect == echo || effect == reverb;
+}
+
+int EffectsRack::getTailSamples(Effect effect) const
+{
+    switch (effect)
+    {
+        case echo:
+            return (int) echoDelaySamples + 1;
+        case reverb:
+            return juce::roundToInt(reverbTailSeconds * sampleRate);
+        case flanger:
+            return flangerLine.getNumSamples();
+        default:
+            return 0;
+    }
+}
+
+void EffectsRack::clearEffect(Effect effect)
+{
+    switch (effect)
+    {
+        case bitcrush:
+            crushHoldCounter = 0;
+            break;
+        case flanger:
+            flangerLine.clear();
+            break;
+        case echo:
+            echoLine.clear();
+            break;
+        case reverb:
+            reverbTank.reset();
+            break;
+        default:
+            break;
+    }
+}
+
+float EffectsRack::readDelayLine(const float* line, int length, double position)
+{
+    while (position < 0.0)
+    {
+        position += length;
+    }
+
+    // A position a hair below 0 can round up to the length itself.
+    if (position >= length)
+    {
+        position -= length;
+    }
+
+    const int index = (int) position;
+    const int nextIndex = index + 1 < length ? index + 1 : 0;
+    const float fraction = (float) (position - index);
+
+    return line[index] + fraction * (line[nextIndex] - line[index]);
+}
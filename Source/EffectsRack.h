@@ -0,0 +1,225 @@
+/*
+  ==============================================================================
+
+    EffectsRack.h
+    Created: 19 Oct 2026 11:24:36pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <atomic>
+
+//==============================================================================
+/*
+    The insert effects of a deck: a bitcrusher, a flanger, a beat-synced echo
+    and a reverb, in that order.
+
+    Every delay line and the reverb's tank are allocated in prepare(), so the
+    audio thread never allocates. The effects are switched and set from the
+    message thread through atomics, and the audio thread picks the changes up
+    at the start of the next block.
+
+    Switching the echo or the reverb off stops feeding it, but lets what is
+    already in it ring out, the way a DJ echoes out of a track. The flanger
+    and the bitcrusher fade out over a few milliseconds instead. An effect
+    that is off and has gone quiet is skipped, so it costs nothing.
+*/
+class EffectsRack
+{
+    public:
+        /** The effects, in the order the signal goes through them. */
+        enum Effect
+        {
+            bitcrush = 0,
+            flanger,
+            echo,
+            reverb,
+            numEffects
+        };
+
+        /**
+        * PURPOSE: Creates the EffectsRack object with every effect switched off.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        EffectsRack();
+
+        /**
+        * PURPOSE: Destroys the EffectsRack object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~EffectsRack();
+
+        /**
+        * PURPOSE: Allocates the delay lines and the reverb for a sample rate and clears them.
+        *          Must not be called while process() is running.
+        * INPUTS: The sample rate.
+        * OUTPUTS: None.
+        */
+        void prepare(double sampleRate);
+
+        /**
+        * PURPOSE: Switches an effect on or off. Safe to call from any thread.
+        * INPUTS: The effect and whether it should be on.
+        * OUTPUTS: None.
+        */
+        void setEffectEnabled(Effect effect, bool shouldBeEnabled);
+
+        /**
+        * PURPOSE: Checks if an effect is switched on (it may still be ringing out if it isn't).
+        * INPUTS: The effect.
+        * OUTPUTS: A boolean; true if the effect is on and false if it is off.
+        */
+        bool isEffectEnabled(Effect effect) const;
+
+        /**
+        * PURPOSE: Sets how much of an effect is heard: the level of the echoes, the reverb and
+        *          the flanging, or how hard the bitcrusher crushes. Safe to call from any thread.
+        * INPUTS: The effect and the amount between 0 and 1.
+        * OUTPUTS: None.
+        */
+        void setEffectAmount(Effect effect, double amount);
+
+        /**
+        * PURPOSE: Sets the time between echoes, in beats of the track. Safe to call from any thread.
+        * INPUTS: The number of beats, between a quarter of a beat and one beat.
+        * OUTPUTS: None.
+        */
+        void setEchoBeats(double beats);
+
+        /**
+        * PURPOSE: Sets the tempo the deck is playing at, which the echo and the flanger follow.
+        *          Called on the audio thread before process().
+        * INPUTS: The tempo in BPM, or 0 if the track has no known tempo.
+        * OUTPUTS: None.
+        */
+        void setTempo(double bpm);
+
+        /**
+        * PURPOSE: Runs the effects over a block of audio in place. Called on the audio thread.
+        * INPUTS: The block, as handed to an audio source; a mono block is processed as a stereo
+        *         block with the same signal in both channels.
+        * OUTPUTS: None.
+        */
+        void process(const juce::AudioSourceChannelInfo& bufferToFill);
+
+    private:
+        /** Where an effect is in its life on the audio thread. */
+        enum class EffectState
+        {
+            idle,
+            on,
+            stopping
+        };
+
+        /**
+        * PURPOSE: Crushes a block to fewer bits and a lower sample rate.
+        * INPUTS: The left and right channels and the number of samples.
+        * OUTPUTS: The peak of the effect's own output in the block.
+        */
+        float processBitcrush(float* left, float* right, int numSamples);
+
+        /**
+        * PURPOSE: Flanges a block with a short delay swept by a slow sine, with feedback.
+        * INPUTS: The left and right channels, the number of samples and whether the effect is being fed.
+        * OUTPUTS: The peak of the effect's own output in the block.
+        */
+        float processFlanger(float* left, float* right, int numSamples, bool isFed);
+
+        /**
+        * PURPOSE: Adds the echoes to a block; the delay follows the tempo, gliding when it changes.
+        * INPUTS: The left and right channels, the number of samples and whether the effect is being fed.
+        * OUTPUTS: The peak of the effect's own output in the block.
+        */
+        float processEcho(float* left, float* right, int numSamples, bool isFed);
+
+        /**
+        * PURPOSE: Adds the reverb to a block.
+        * INPUTS: The left and right channels, the number of samples and whether the effect is being fed.
+        * OUTPUTS: The peak of the effect's own output in the block.
+        */
+        float processReverb(float* left, float* right, int numSamples, bool isFed);
+
+        /**
+        * PURPOSE: Checks if an effect rings out when switched off, rather than fading out.
+        * INPUTS: The effect.
+        * OUTPUTS: A boolean; true if the effect has a tail and false if it hasn't.
+        */
+        static bool hasTail(Effect effect);
+
+        /**
+        * PURPOSE: Works out how long an effect must be silent before everything in it is silent.
+        * INPUTS: The effect.
+        * OUTPUTS: The number of samples.
+        */
+        int getTailSamples(Effect effect) const;
+
+        /**
+        * PURPOSE: Empties an effect's delay lines, so that it starts from silence when next switched on.
+        * INPUTS: The effect.
+        * OUTPUTS: None.
+        */
+        void clearEffect(Effect effect);
+
+        /**
+        * PURPOSE: Reads a delay line between two samples, interpolating linearly.
+        * INPUTS: The delay line, its length and the position to read.
+        * OUTPUTS: The sample.
+        */
+        static float readDelayLine(const float* line, int length, double position);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr double maxEchoSeconds = 2.0;
+        static constexpr double echoFeedback = 0.5;
+        static constexpr double echoGlideSeconds = 0.05;
+        static constexpr double defaultBpm = 120.0;
+
+        // The flanger sweeps between these delays once every 16 beats (or 8 seconds).
+        static constexpr double minFlangerMs = 0.5;
+        static constexpr double maxFlangerMs = 6.0;
+        static constexpr double flangerFeedback = 0.6;
+        static constexpr double flangerBeatsPerSweep = 16.0;
+
+        static constexpr double reverbTailSeconds = 0.25;
+        static constexpr int reverbChunkSize = 512;
+
+        static constexpr double mixRampSeconds = 0.02;
+        static constexpr float silenceThreshold = 1.0e-4f;
+
+        double sampleRate;
+        double tempo;
+
+        // Set from the message thread.
+        std::atomic<bool> effectsEnabled[numEffects];
+        std::atomic<double> effectAmounts[numEffects];
+        std::atomic<double> echoBeats{ 0.75 };
+
+        // The state of the effects, on the audio thread.
+        EffectState states[numEffects];
+        int silentSamples[numEffects];
+        juce::SmoothedValue<float> mixes[numEffects];
+
+        float crushedLeft;
+        float crushedRight;
+        int crushHoldCounter;
+
+        juce::AudioBuffer<float> flangerLine;
+        int flangerWritePosition;
+        double flangerPhase;
+
+        juce::AudioBuffer<float> echoLine;
+        int echoWritePosition;
+        double echoDelaySamples;
+
+        juce::Reverb reverbTank;
+        juce::AudioBuffer<float> reverbChunk;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EffectsRack)
+};
@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+    KeyDetector.cpp
+    Created: 19 Oct 2026 9:41:06pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "KeyDetector.h"
+#include <algorithm>
+#include <cmath>
+
+KeyDetector::KeyDetector(double _sampleRate)
+                        : decimation(juce::jmax(1, juce::roundToInt(_sampleRate / targetSampleRate))),
+                          frame((size_t) fftSize, 0.0f),
+                          fftData((size_t) (2 * fftSize), 0.0f),
+                          binPitchClasses((size_t) (fftSize / 2 + 1), -1)
+{
+    const double decimatedRate = _sampleRate / decimation;
+    const double cutoff = juce::jmin(maxFrequency * 1.4, 0.45 * decimatedRate);
+
+    for (auto& filter : antiAliasingFilters)
+    {
+        filter.setCoefficients(juce::IIRCoefficients::makeLowPass(_sampleRate, cutoff));
+    }
+
+    // Every bin between A1 and E6 counts towards the pitch class it is nearest to.
+    for (int bin = 1; bin <= fftSize / 2; ++bin)
+    {
+        double frequency = bin * decimatedRate / fftSize;
+
+        if (frequency >= minFrequency && frequency <= maxFrequency)
+        {
+            int midiNote = juce::roundToInt(69.0 + 12.0 * std::log2(frequency / 440.0));
+            binPitchClasses[(size_t) bin] = midiNote % 12;
+        }
+    }
+}
+
+KeyDetector::~KeyDetector()
+{
+}
+
+void KeyDetector::process(const float* left, const float* right, int numSamples)
+{
+    if ((int) monoBuffer.size() < numSamples)
+    {
+        monoBuffer.resize((size_t) numSamples);
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        monoBuffer[(size_t) i] = 0.5f * (left[i] + right[i]);
+    }
+
+    for (auto& filter : antiAliasingFilters)
+    {
+        filter.processSamples(monoBuffer.data(), numSamples);
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        if (++decimationCount < decimation)
+        {
+            continue;
+        }
+
+        decimationCount = 0;
+        frame[(size_t) frameFill++] = monoBuffer[(size_t) i];
+
+        if (frameFill == fftSize)
+        {
+            addChromaFrame();
+
+            std::copy(frame.begin() + hopSize, frame.end(), frame.begin());
+            frameFill -= hopSize;
+        }
+    }
+}
+
+bool KeyDetector::findKey(KeyEstimate& estimate) const
+{
+    if (numFrames < minFramesToAnalyse)
+    {
+        return false;
+    }
+
+    // Krumhansl and Kessler's probe tone ratings of the 12 pitch classes, from the tonic up.
+    const double majorProfile[12] = { 6.35, 2.23, 3.48, 2.33, 4.38, 4.09, 2.52, 5.19, 2.39, 3.66, 2.29, 2.88 };
+    const double minorProfile[12] = { 6.33, 2.68, 3.52, 5.38, 2.60, 3.53, 2.54, 4.75, 3.98, 2.69, 3.34, 3.17 };
+
+    int bestKey = CamelotKey::noKey;
+    double bestScore = -2.0;
+    double secondBestScore = -2.0;
+
+    for (int tonic = 0; tonic < 12; ++tonic)
+    {
+        for (bool isMinor : { false, true })
+        {
+            double score = correlate(chroma, isMinor ? minorProfile : majorProfile, tonic);
+
+            if (score > bestScore)
+            {
+                secondBestScore = bestScore;
+                bestScore = score;
+                bestKey = CamelotKey::fromPitchClass(tonic, isMinor);
+            }
+            else if (score > secondBestScore)
+            {
+                secondBestScore = score;
+            }
+        }
+    }
+
+    if (bestKey == CamelotKey::noKey || bestScore <= 0.0)
+    {
+        return false;
+    }
+
+    estimate.key = bestKey;
+    estimate.confidence = bestScore - secondBestScore;
+    return true;
+}
+
+void KeyDetector::addChromaFrame()
+{
+    std::copy(frame.begin(), frame.end(), fftData.begin());
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+    window.multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+    double frameChroma[12] = {};
+
+    for (int bin = 1; bin <= fftSize / 2; ++bin)
+    {
+        int pitchClass = binPitchClasses[(size_t) bin];
+
+        if (pitchClass >= 0)
+        {
+            frameChroma[pitchClass] += fftData[(size_t) bin];
+        }
+    }
+
+    double strongest = *std::max_element(frameChroma, frameChroma + 12);
+
+    // Silence (and near silence) would only add noise.
+    if (strongest < silenceThreshold * fftSize)
+    {
+        return;
+    }
+
+    for (int pitchClass = 0; pitchClass < 12; ++pitchClass)
+    {
+        chroma[pitchClass] += frameChroma[pitchClass] / strongest;
+    }
+
+    numFrames++;
+}
+
+double KeyDetector::correlate(const double* pitchClasses, const double* profile, int tonic)
+{
+    double chromaMean = 0.0;
+    double profileMean = 0.0;
+
+    for (int i = 0; i < 12; ++i)
+    {
+        chromaMean += pitchClasses[i] / 12.0;
+        profileMean += profile[i] / 12.0;
+    }
+
+    double covariance = 0.0;
+    double chromaVariance = 0.0;
+    double profileVariance = 0.0;
+
+    for (int i = 0; i < 12; ++i)
+    {
+        // The profile's first entry is the tonic's.
+        double chromaDeviation = pitchClasses[(tonic + i) % 12] - chromaMean;
+        double profileDeviation = profile[i] - profileMean;
+
+        covariance += chromaDeviation * profileDeviation;
+        chromaVariance += chromaDeviation * chromaDeviation;
+        profileVariance += profileDeviation * profileDeviation;
+    }
+
+    if (chromaVariance <= 0.0)
+    {
+        return 0.0;
+    }
+
+    return covariance / std::sqrt(chromaVariance * profileVariance);
+}
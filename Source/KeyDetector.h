@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    KeyDetector.h
+    Created: 19 Oct 2026 9:41:06pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "CamelotKey.h"
+#include <vector>
+
+//==============================================================================
+/*
+    Finds the musical key of a whole track, offline.
+
+    The track's audio is fed in blocks, from start to end. It is mixed down to
+    mono, low-pass filtered and decimated to about 5.5 kHz, and every 2048
+    samples (about a third of a second) the spectrum of a 4096 sample frame is
+    folded onto the 12 pitch classes between A1 and E6: a chromagram. Each
+    frame is normalised to its strongest pitch class, so quiet passages count
+    as much as loud ones, and the frames are summed over the whole track.
+
+    Once the whole track has been fed, the summed chroma is correlated with
+    the Krumhansl-Kessler major and minor key profiles in all 12 transpositions,
+    and the best match is the key. The confidence is how far the best match
+    stands above the runner up.
+*/
+class KeyDetector
+{
+    public:
+        /** A detected key. */
+        struct KeyEstimate
+        {
+            int key;
+            double confidence;
+        };
+
+        /**
+        * PURPOSE: Creates the KeyDetector object.
+        * INPUTS: The sample rate of the track.
+        * OUTPUTS: None.
+        */
+        KeyDetector(double _sampleRate);
+
+        /**
+        * PURPOSE: Destroys the KeyDetector object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~KeyDetector();
+
+        /**
+        * PURPOSE: Feeds the next block of the track.
+        * INPUTS: The left and right channels of the block and its number of samples.
+        * OUTPUTS: None.
+        */
+        void process(const float* left, const float* right, int numSamples);
+
+        /**
+        * PURPOSE: Finds the key of everything fed so far.
+        * INPUTS: A reference to the estimate to be filled.
+        * OUTPUTS: A boolean; true if a key was found and false if the track is too short or has no pitched content.
+        */
+        bool findKey(KeyEstimate& estimate) const;
+
+    private:
+        /**
+        * PURPOSE: Computes the chroma of the current frame and adds it to the track's chroma.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void addChromaFrame();
+
+        /**
+        * PURPOSE: Computes the Pearson correlation of a chroma vector with a rotated key profile.
+        * INPUTS: The chroma to match, the key profile and the pitch class of the profile's tonic.
+        * OUTPUTS: The correlation, between -1 and 1.
+        */
+        static double correlate(const double* pitchClasses, const double* profile, int tonic);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int fftOrder = 12;
+        static constexpr int fftSize = 1 << fftOrder;
+        static constexpr int hopSize = 2048;
+        static constexpr double targetSampleRate = 5512.5;
+        static constexpr double minFrequency = 53.4;
+        static constexpr double maxFrequency = 1357.0;
+        static constexpr float silenceThreshold = 1.0e-3f;
+        static constexpr int minFramesToAnalyse = 16;
+
+        int decimation;
+
+        // Two cascaded low-pass filters (a fourth order Butterworth) keep what the decimation
+        // would fold down out of the chroma.
+        juce::IIRFilter antiAliasingFilters[2];
+        std::vector<float> monoBuffer;
+        int decimationCount = 0;
+
+        std::vector<float> frame;
+        int frameFill = 0;
+        juce::dsp::FFT fft{ fftOrder };
+        juce::dsp::WindowingFunction<float> window{ (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann };
+        std::vector<float> fftData;
+        std::vector<int> binPitchClasses;
+        double chroma[12] = {};
+        int numFrames = 0;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KeyDetector)
+};
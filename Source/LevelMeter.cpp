@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    LevelMeter.cpp
+    Created: 20 Oct 2026 12:14:26am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "LevelMeter.h"
+#include <cmath>
+
+LevelMeter::LevelMeter()
+                      : sampleRate(44100.0)
+{
+    prepare(sampleRate);
+}
+
+LevelMeter::~LevelMeter()
+{
+}
+
+void LevelMeter::prepare(double _sampleRate)
+{
+    sampleRate = _sampleRate;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        meanSquares[channel] = 0.0;
+        peaks[channel] = 0.0f;
+        rmsLevels[channel] = 0.0f;
+    }
+}
+
+void LevelMeter::measure(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    juce::AudioBuffer<float>* buffer = bufferToFill.buffer;
+
+    if (buffer == nullptr || buffer->getNumChannels() == 0 || bufferToFill.numSamples <= 0)
+    {
+        return;
+    }
+
+    const float* channels[numChannels] =
+    {
+        buffer->getReadPointer(0, bufferToFill.startSample),
+        buffer->getReadPointer(buffer->getNumChannels() > 1 ? 1 : 0, bufferToFill.startSample)
+    };
+
+    // How much of the running mean square is left after a block this long.
+    const double decay = std::exp(-bufferToFill.numSamples / (rmsSeconds * sampleRate));
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        float peak = 0.0f;
+        double sumOfSquares = 0.0;
+        reduce(channels[channel], bufferToFill.numSamples, peak, sumOfSquares);
+
+        meanSquares[channel] = meanSquares[channel] * decay
+                             + (1.0 - decay) * sumOfSquares / bufferToFill.numSamples;
+        rmsLevels[channel] = (float) std::sqrt(meanSquares[channel]);
+
+        // Keep the highest peak until the GUI takes it.
+        float publishedPeak = peaks[channel].load();
+
+        while (peak > publishedPeak && !peaks[channel].compare_exchange_weak(publishedPeak, peak))
+        {
+        }
+    }
+}
+
+float LevelMeter::getPeak(int channel)
+{
+    return peaks[channel].exchange(0.0f);
+}
+
+float LevelMeter::getRms(int channel) const
+{
+    return rmsLevels[channel].load();
+}
+
+void LevelMeter::reduce(const float* samples, int numSamples, float& peak, double& sumOfSquares)
+{
+    float smallest = 0.0f;
+    float largest = 0.0f;
+    float squares = 0.0f;
+    int i = 0;
+
+    // Up to the first aligned sample one at a time, then a register at a time, then the rest.
+    for (; i < numSamples && !Vector::isSIMDAligned(samples + i); ++i)
+    {
+        smallest = juce::jmin(smallest, samples[i]);
+        largest = juce::jmax(largest, samples[i]);
+        squares += samples[i] * samples[i];
+    }
+
+    Vector smallestVector = Vector::expand(0.0f);
+    Vector largestVector = Vector::expand(0.0f);
+    Vector squaresVector = Vector::expand(0.0f);
+
+    for (; i + (int) Vector::SIMDNumElements <= numSamples; i += (int) Vector::SIMDNumElements)
+    {
+        const Vector x = Vector::fromRawArray(samples + i);
+
+        smallestVector = Vector::min(smallestVector, x);
+        largestVector = Vector::max(largestVector, x);
+        squaresVector += x * x;
+    }
+
+    for (; i < numSamples; ++i)
+    {
+        smallest = juce::jmin(smallest, samples[i]);
+        largest = juce::jmax(largest, samples[i]);
+        squares += samples[i] * samples[i];
+    }
+
+    for (size_t element = 0; element < Vector::SIMDNumElements; ++element)
+    {
+        smallest = juce::jmin(smallest, smallestVector.get(element));
+        largest = juce::jmax(largest, largestVector.get(element));
+    }
+
+    peak = juce::jmax(largest, -smallest);
+    sumOfSquares = (double) squares + squaresVector.sum();
+}
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    LevelMeter.h
+    Created: 20 Oct 2026 12:14:26am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <atomic>
+
+//==============================================================================
+/*
+    Measures the peak and RMS levels of a stereo signal on the audio thread,
+    for a LevelMeterDisplay to show.
+
+    Each block is reduced to its peak and its sum of squares in one pass,
+    several samples at a time in SIMD registers. The RMS level is the mean
+    square of the blocks, averaged over about 300 ms. Both levels are handed
+    over through atomics: the audio thread never waits for the GUI or tells
+    it anything, and the GUI picks the levels up whenever it next repaints.
+*/
+class LevelMeter
+{
+    public:
+        /**
+        * PURPOSE: Creates the LevelMeter object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        LevelMeter();
+
+        /**
+        * PURPOSE: Destroys the LevelMeter object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~LevelMeter();
+
+        /**
+        * PURPOSE: Sets the sample rate the RMS level is averaged at and forgets the levels so far.
+        *          Must not be called while measure() is running.
+        * INPUTS: The sample rate.
+        * OUTPUTS: None.
+        */
+        void prepare(double sampleRate);
+
+        /**
+        * PURPOSE: Measures a block of audio. Called on the audio thread.
+        * INPUTS: The block, as handed to an audio source; a mono block is measured as a stereo
+        *         block with the same signal in both channels.
+        * OUTPUTS: None.
+        */
+        void measure(const juce::AudioSourceChannelInfo& bufferToFill);
+
+        /**
+        * PURPOSE: Gets the highest peak of a channel since this was last called, and starts again.
+        *          Called from the message thread.
+        * INPUTS: The channel; 0 for left and 1 for right.
+        * OUTPUTS: The peak, as a gain.
+        */
+        float getPeak(int channel);
+
+        /**
+        * PURPOSE: Gets the latest RMS level of a channel. Safe to call from any thread.
+        * INPUTS: The channel; 0 for left and 1 for right.
+        * OUTPUTS: The RMS level, as a gain.
+        */
+        float getRms(int channel) const;
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int numChannels = 2;
+
+    private:
+        using Vector = juce::dsp::SIMDRegister<float>;
+
+        /**
+        * PURPOSE: Finds the peak and the sum of squares of a channel's samples in one pass.
+        * INPUTS: The samples, the number of samples and references to the peak and the sum
+        *         of squares to be filled.
+        * OUTPUTS: None.
+        */
+        static void reduce(const float* samples, int numSamples, float& peak, double& sumOfSquares);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr double rmsSeconds = 0.3;
+
+        double sampleRate;
+
+        // The mean square of each channel, on the audio thread.
+        double meanSquares[numChannels];
+
+        // Published to the GUI.
+        std::atomic<float> peaks[numChannels];
+        std::atomic<float> rmsLevels[numChannels];
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelMeter)
+};
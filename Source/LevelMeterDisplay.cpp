@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    LevelMeterDisplay.cpp
+    Created: 20 Oct 2026 12:14:26am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "LevelMeterDisplay.h"
+
+//==============================================================================
+LevelMeterDisplay::LevelMeterDisplay(LevelMeter* _meter)
+                                    : meter(_meter)
+{
+    for (int channel = 0; channel < LevelMeter::numChannels; ++channel)
+    {
+        peaksDb[channel] = minDb;
+        rmsLevelsDb[channel] = minDb;
+        heldPeaksDb[channel] = minDb;
+        holdTicksLeft[channel] = 0;
+    }
+
+    setInterceptsMouseClicks(false, false);
+    startTimerHz(refreshRateHz);
+}
+
+LevelMeterDisplay::~LevelMeterDisplay()
+{
+}
+
+void LevelMeterDisplay::paint (juce::Graphics& g)
+{
+    float barW = (getWidth() - 1) / 2.0f;
+    float h = (float) getHeight();
+
+    for (int channel = 0; channel < LevelMeter::numChannels; ++channel)
+    {
+        juce::Rectangle<float> bar(channel * (barW + 1), 0, barW, h);
+
+        g.setColour(juce::Colour::fromRGBA(35, 36, 40, 255));
+        g.fillRect(bar);
+
+        // Peak faded behind, RMS solid in front.
+        g.setColour(juce::Colours::yellowgreen.withAlpha(0.4f));
+        g.fillRect(bar.withTop(h * (1 - toProportion(peaksDb[channel]))));
+        g.setColour(juce::Colours::yellowgreen);
+        g.fillRect(bar.withTop(h * (1 - toProportion(rmsLevelsDb[channel]))));
+
+        if (heldPeaksDb[channel] > minDb)
+        {
+            // The held peak turns red once it reaches full scale.
+            g.setColour(heldPeaksDb[channel] >= -0.1f ? juce::Colours::indianred : juce::Colours::white);
+            g.fillRect(bar.withTop(h * (1 - toProportion(heldPeaksDb[channel]))).withHeight(2));
+        }
+    }
+}
+
+void LevelMeterDisplay::resized()
+{
+}
+
+void LevelMeterDisplay::timerCallback()
+{
+    bool hasChanged = false;
+
+    for (int channel = 0; channel < LevelMeter::numChannels; ++channel)
+    {
+        float peakDb = juce::Decibels::gainToDecibels(meter->getPeak(channel), minDb);
+        float rmsDb = juce::Decibels::gainToDecibels(meter->getRms(channel), minDb);
+
+        // Jump up to a new peak, but fall back at a readable rate.
+        float newPeakDb = juce::jmax(peakDb, peaksDb[channel] - peakFallDbPerSecond / refreshRateHz, minDb);
+        float newHeldDb = heldPeaksDb[channel];
+
+        if (newPeakDb >= heldPeaksDb[channel])
+        {
+            newHeldDb = newPeakDb;
+            holdTicksLeft[channel] = holdTicks;
+        }
+        else if (holdTicksLeft[channel] > 0)
+        {
+            --holdTicksLeft[channel];
+        }
+        else
+        {
+            newHeldDb = juce::jmax(newPeakDb, heldPeaksDb[channel] - peakFallDbPerSecond / refreshRateHz);
+        }
+
+        hasChanged = hasChanged || newPeakDb != peaksDb[channel] || rmsDb != rmsLevelsDb[channel]
+                                || newHeldDb != heldPeaksDb[channel];
+
+        peaksDb[channel] = newPeakDb;
+        rmsLevelsDb[channel] = rmsDb;
+        heldPeaksDb[channel] = newHeldDb;
+    }
+
+    if (hasChanged)
+    {
+        repaint();
+    }
+}
+
+float LevelMeterDisplay::toProportion(float levelDb)
+{
+    return juce::jlimit(0.0f, 1.0f, 1.0f - levelDb / minDb);
+}
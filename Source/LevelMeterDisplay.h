@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    LevelMeterDisplay.h
+    Created: 20 Oct 2026 12:14:26am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "LevelMeter.h"
+
+//==============================================================================
+/*
+    Draws a LevelMeter as a pair of vertical bars: the RMS level solid, the
+    peak level faded above it and a line at the highest recent peak.
+
+    A timer at the screen's refresh rate picks the levels up from the meter,
+    so the meter moves as smoothly as the screen allows and the audio thread
+    doesn't have to tell the GUI anything.
+*/
+class LevelMeterDisplay  : public juce::Component,
+                           public juce::Timer
+{
+    public:
+        /**
+        * PURPOSE: Creates the LevelMeterDisplay object and starts a timer.
+        * INPUTS: A pointer to the LevelMeter to show.
+        * OUTPUTS: None.
+        */
+        LevelMeterDisplay(LevelMeter* _meter);
+
+        /**
+        * PURPOSE: Destroys the LevelMeterDisplay object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~LevelMeterDisplay() override;
+
+        /**
+        * PURPOSE: Draws the component's contents. Overrides juce Component member function.
+        * INPUTS: The graphics context that must be used to do the drawing operations.
+        * OUTPUTS: None.
+        */
+        void paint (juce::Graphics& g) override;
+
+        /**
+        * PURPOSE: Layouts the component's children when its width or height changes.
+        *          Overrides juce Component member function.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void resized() override;
+
+        /**
+        * PURPOSE: The user-defined callback routine that actually gets called periodically.
+        *          Implements juce Timer.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void timerCallback() override;
+
+    private:
+        /**
+        * PURPOSE: Works out how far up the meter a level is.
+        * INPUTS: The level in dB.
+        * OUTPUTS: The proportion of the meter's height, between 0 and 1.
+        */
+        static float toProportion(float levelDb);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int refreshRateHz = 60;
+        static constexpr float minDb = -48.0f;
+        static constexpr float peakFallDbPerSecond = 24.0f;
+        static constexpr int holdTicks = refreshRateHz * 3 / 2;
+
+        LevelMeter* meter;
+
+        float peaksDb[LevelMeter::numChannels];
+        float rmsLevelsDb[LevelMeter::numChannels];
+        float heldPeaksDb[LevelMeter::numChannels];
+        int holdTicksLeft[LevelMeter::numChannels];
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelMeterDisplay)
+};
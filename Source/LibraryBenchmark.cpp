@@ -0,0 +1,366 @@
+/*
+  ==============================================================================
+
+    LibraryBenchmark.cpp
+    Created: 19 Oct 2026 4:12:05pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "LibraryBenchmark.h"
+#include "BenchmarkRunner.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <memory>
+
+#if JUCE_MAC
+ #include <mach/mach.h>
+#endif
+
+LibraryBenchmark::LibraryBenchmark()
+                                  : random(20261019)
+{
+    // A fixed vocabulary of made up words, so that every run searches the same kind of text.
+    const char* syllables[] = { "ka", "lo", "mi", "ra", "ne", "to", "su", "vi",
+                                "de", "ba", "zo", "le", "po", "fi", "gu", "ye" };
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        juce::String word;
+        int numSyllables = 1 + random.nextInt(3);
+
+        for (int j = 0; j < numSyllables; ++j)
+        {
+            word += syllables[random.nextInt(16)];
+        }
+
+        words.add(word);
+    }
+}
+
+LibraryBenchmark::~LibraryBenchmark()
+{
+}
+
+juce::var LibraryBenchmark::runFromCommandLine(const juce::StringArray& arguments)
+{
+    LibraryBenchmark benchmark;
+
+    return benchmark.run(BenchmarkRunner::getSizesOption(arguments, "--sizes", { 10000, 100000, 1000000 },
+                                                         std::numeric_limits<int>::max()));
+}
+
+juce::var LibraryBenchmark::run(const std::vector<int>& librarySizes)
+{
+    juce::Array<juce::var> libraries;
+
+    for (int numTracks : librarySizes)
+    {
+        libraries.add(benchmarkLibrary(numTracks));
+    }
+
+    juce::DynamicObject::Ptr results = BenchmarkRunner::createResults();
+    results->setProperty("libraries", libraries);
+
+    return juce::var(results.get());
+}
+
+juce::var LibraryBenchmark::benchmarkLibrary(int numTracks)
+{
+    juce::DynamicObject::Ptr result = new juce::DynamicObject();
+    result->setProperty("tracks", numTracks);
+
+    juce::TemporaryFile playlistFile{ ".txt" };
+    std::string filePath = playlistFile.getFile().getFullPathName().toStdString();
+
+    // Generate the library file.
+    double startMs = juce::Time::getMillisecondCounterHiRes();
+
+    {
+        std::ofstream stream{ filePath };
+
+        for (int i = 0; i < numTracks; ++i)
+        {
+            PlaylistFileProcessor::writeTrack(stream, createSyntheticTrack(i));
+        }
+    }
+
+    result->setProperty("generateMs", juce::Time::getMillisecondCounterHiRes() - startMs);
+    result->setProperty("fileSizeBytes", playlistFile.getFile().getSize());
+
+    // Cold load: the first time the file is read and parsed by this process
+    // (the OS may still have it cached from being written). The memory the loaded
+    // library takes is measured around it, before anything has been freed that a
+    // later load could reuse without the process growing.
+    PlaylistFileProcessor fileProcessor;
+    juce::int64 memoryBeforeLoad = getResidentMemoryBytes();
+
+    {
+        TrackStore coldStore;
+        startMs = juce::Time::getMillisecondCounterHiRes();
+        loadLibrary(fileProcessor, filePath, coldStore);
+        result->setProperty("coldLoadMs", juce::Time::getMillisecondCounterHiRes() - startMs);
+
+        juce::int64 memoryAfterColdLoad = getResidentMemoryBytes();
+        result->setProperty("residentMemoryBytes", memoryAfterColdLoad);
+        result->setProperty("libraryMemoryBytes", memoryBeforeLoad >= 0 ? memoryAfterColdLoad - memoryBeforeLoad : -1);
+    }
+
+    // Warm load.
+    TrackStore store;
+    startMs = juce::Time::getMillisecondCounterHiRes();
+    loadLibrary(fileProcessor, filePath, store);
+    result->setProperty("warmLoadMs", juce::Time::getMillisecondCounterHiRes() - startMs);
+
+    juce::int64 memoryAfterLoad = getResidentMemoryBytes();
+    result->setProperty("searchMs", benchmarkSearch(store));
+
+    // Sorting the whole library: the first sort builds the cached rank columns.
+    std::vector<juce::uint32> rows(store.getNumRows());
+
+    for (juce::uint32 row = 0; row < store.getNumRows(); ++row)
+    {
+        rows[row] = row;
+    }
+
+    juce::DynamicObject::Ptr sortResults = new juce::DynamicObject();
+    std::vector<TrackStore::SortKey> byTitle{ { TrackStore::SortColumn::title, true } };
+    std::vector<TrackStore::SortKey> byArtistThenTitle{ { TrackStore::SortColumn::artist, true },
+                                                        { TrackStore::SortColumn::title, true } };
+    std::vector<TrackStore::SortKey> byBpmDescending{ { TrackStore::SortColumn::bpm, false } };
+
+    startMs = juce::Time::getMillisecondCounterHiRes();
+    store.sortRows(rows, byTitle);
+    sortResults->setProperty("firstTitleSort", juce::Time::getMillisecondCounterHiRes() - startMs);
+
+    startMs = juce::Time::getMillisecondCounterHiRes();
+    store.sortRows(rows, byTitle);
+    sortResults->setProperty("titleSort", juce::Time::getMillisecondCounterHiRes() - startMs);
+
+    store.sortRows(rows, byArtistThenTitle);
+    startMs = juce::Time::getMillisecondCounterHiRes();
+    store.sortRows(rows, byArtistThenTitle);
+    sortResults->setProperty("artistThenTitleSort", juce::Time::getMillisecondCounterHiRes() - startMs);
+
+    store.sortRows(rows, byBpmDescending);
+    startMs = juce::Time::getMillisecondCounterHiRes();
+    store.sortRows(rows, byBpmDescending);
+    sortResults->setProperty("bpmDescendingSort", juce::Time::getMillisecondCounterHiRes() - startMs);
+
+    result->setProperty("sortMs", juce::var(sortResults.get()));
+
+    // What the cached rank columns of the sorts above add on top of the loaded library.
+    juce::int64 memoryAfterSort = getResidentMemoryBytes();
+    result->setProperty("sortCacheMemoryBytes", memoryAfterLoad >= 0 ? memoryAfterSort - memoryAfterLoad : -1);
+
+    // Bulk append, one playlist file write per track as when importing files.
+    const int numAppends = juce::jmin(numTracks, (int) maxAppends);
+    startMs = juce::Time::getMillisecondCounterHiRes();
+
+    for (int i = 0; i < numAppends; ++i)
+    {
+        fileProcessor.appendData(createSyntheticTrack(numTracks + i));
+    }
+
+    double appendMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+    result->setProperty("appends", numAppends);
+    result->setProperty("appendMsPerTrack", numAppends > 0 ? appendMs / numAppends : 0.0);
+
+    // Random deletes, then the load that replays them (and compacts them out of the file
+    // once the journal is a good part of it).
+    const int numDeletes = juce::jmin(numTracks, (int) maxDeletes);
+    startMs = juce::Time::getMillisecondCounterHiRes();
+
+    for (int i = 0; i < numDeletes; ++i)
+    {
+        juce::uint32 row = (juce::uint32) random.nextInt((int) store.getNumRows());
+        fileProcessor.deleteData(store.getTrack(row).id);
+    }
+
+    double deleteMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+    result->setProperty("deletes", numDeletes);
+    result->setProperty("deleteMsPerTrack", numDeletes > 0 ? deleteMs / numDeletes : 0.0);
+
+    {
+        TrackStore compactedStore;
+        startMs = juce::Time::getMillisecondCounterHiRes();
+        loadLibrary(fileProcessor, filePath, compactedStore);
+        result->setProperty("compactingLoadMs", juce::Time::getMillisecondCounterHiRes() - startMs);
+    }
+
+    return juce::var(result.get());
+}
+
+void LibraryBenchmark::loadLibrary(PlaylistFileProcessor& fileProcessor, const std::string& filePath, TrackStore& store)
+{
+    for (const auto& track : fileProcessor.loadData(filePath))
+    {
+        store.add(track);
+    }
+}
+
+Track LibraryBenchmark::createSyntheticTrack(int trackNumber)
+{
+    static const char* genres[] = { "House", "Techno", "Hip-Hop", "Drum & Bass", "Pop", "Afrobeats", "Jazz", "Rock" };
+    static const char* keys[] = { "Am", "C", "Em", "G", "Bm", "D", "F#m", "A", "Dm", "F", "Gm", "Bb" };
+
+    auto randomWords = [this](int maxWords)
+    {
+        juce::StringArray chosenWords;
+        int numWords = 1 + random.nextInt(maxWords);
+
+        for (int i = 0; i < numWords; ++i)
+        {
+            const juce::String& word = words[random.nextInt(words.size())];
+            chosenWords.add(word.substring(0, 1).toUpperCase() + word.substring(1));
+        }
+
+        return chosenWords.joinIntoString(" ");
+    };
+
+    juce::String artist = randomWords(2);
+    juce::String path = "file:///music/" + artist.replaceCharacter(' ', '_')
+                        + "/" + juce::String(trackNumber) + ".mp3";
+
+    Track track{ randomWords(4), path, (juce::uint64) random.nextInt64() | 1 };
+    track.artist = artist;
+    track.album = randomWords(3);
+    track.genre = genres[random.nextInt(8)];
+    track.key = keys[random.nextInt(12)];
+    track.bpm = 70.0f + random.nextInt(111);
+    track.sampleRate = 44100.0;
+    track.lengthInSamples = (juce::int64) (120 + random.nextInt(360)) * 44100;
+
+    return track;
+}
+
+juce::var LibraryBenchmark::benchmarkSearch(const TrackStore& store)
+{
+    jassert(!juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+    // Prefixes of words picked from random tracks, from 1 to 6 characters.
+    std::vector<double> firstChunkTimesMs;
+    std::vector<double> lastChunkTimesMs;
+    juce::int64 numMatches = 0;
+
+    SearchTimer timer;
+    auto searcher = std::make_unique<TrackSearcher>(store, timer);
+
+    for (int i = 0; i < numSearches && store.getNumRows() > 0; ++i)
+    {
+        const Track& track = store.getTrack((juce::uint32) random.nextInt((int) store.getNumRows()));
+        juce::StringArray keyWords = juce::StringArray::fromTokens((track.title + " " + track.artist).toLowerCase(), false);
+        juce::String keyword = keyWords[random.nextInt(keyWords.size())].substring(0, 1 + i % 6);
+
+        timer.start();
+        searcher->setQuery(keyword);
+
+        if (!timer.waitForResults(searchTimeoutMs))
+        {
+            break;
+        }
+
+        firstChunkTimesMs.push_back(timer.firstChunkMs - timer.startMs);
+        lastChunkTimesMs.push_back(timer.lastChunkMs - timer.startMs);
+        numMatches += timer.numMatches;
+    }
+
+    {
+        // Delete the searcher between messages, so that none of its results is being delivered as it goes.
+        const juce::MessageManagerLock messageManagerLock;
+        searcher.reset();
+    }
+
+    const int numQueries = (int) firstChunkTimesMs.size();
+    juce::var searchResults = getPercentiles(firstChunkTimesMs);
+    searchResults.getDynamicObject()->setProperty("queries", numQueries);
+    searchResults.getDynamicObject()->setProperty("debounceMs", TrackSearcher::debounceMs);
+    searchResults.getDynamicObject()->setProperty("lastChunkMs", getPercentiles(lastChunkTimesMs));
+    searchResults.getDynamicObject()->setProperty("averageMatches", numQueries == 0 ? 0.0
+                                                                    : (double) numMatches / numQueries);
+
+    return searchResults;
+}
+
+void LibraryBenchmark::SearchTimer::start()
+{
+    lastChunkArrived.reset();
+    numMatches = 0;
+    startMs = juce::Time::getMillisecondCounterHiRes();
+}
+
+bool LibraryBenchmark::SearchTimer::waitForResults(int timeoutMs)
+{
+    return lastChunkArrived.wait(timeoutMs);
+}
+
+void LibraryBenchmark::SearchTimer::searchResultsArrived(const std::vector<juce::uint32>& rows,
+                                                         bool isFirstChunk,
+                                                         bool isLastChunk)
+{
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+
+    if (isFirstChunk)
+    {
+        firstChunkMs = nowMs;
+    }
+
+    numMatches += (juce::int64) rows.size();
+
+    if (isLastChunk)
+    {
+        lastChunkMs = nowMs;
+        lastChunkArrived.signal();
+    }
+}
+
+juce::var LibraryBenchmark::getPercentiles(std::vector<double>& timesMs)
+{
+    juce::DynamicObject::Ptr percentiles = new juce::DynamicObject();
+    std::sort(timesMs.begin(), timesMs.end());
+
+    auto percentile = [&timesMs](double fraction)
+    {
+        if (timesMs.empty())
+        {
+            return 0.0;
+        }
+
+        return timesMs[juce::jmin(timesMs.size() - 1, (size_t) (fraction * timesMs.size()))];
+    };
+
+    percentiles->setProperty("p50", percentile(0.5));
+    percentiles->setProperty("p90", percentile(0.9));
+    percentiles->setProperty("p99", percentile(0.99));
+    percentiles->setProperty("max", percentile(1.0));
+
+    return juce::var(percentiles.get());
+}
+
+juce::int64 LibraryBenchmark::getResidentMemoryBytes()
+{
+   #if JUCE_LINUX
+    std::ifstream status{ "/proc/self/status" };
+    std::string line;
+
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, 6, "VmRSS:") == 0)
+        {
+            return juce::String(line.substr(6)).trim().getLargeIntValue() * 1024;
+        }
+    }
+   #elif JUCE_MAC
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t) &info, &count) == KERN_SUCCESS)
+    {
+        return (juce::int64) info.resident_size;
+    }
+   #endif
+
+    return -1;
+}
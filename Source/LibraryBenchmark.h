@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    LibraryBenchmark.h
+    Created: 19 Oct 2026 4:12:05pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "PlaylistFileProcessor.h"
+#include "TrackStore.h"
+#include "TrackSearcher.h"
+#include <vector>
+
+//==============================================================================
+/*
+    Measures how the music library scales, on synthetic libraries of any size.
+
+    For every library size, a playlist file of generated tracks is written to a
+    temporary folder and the benchmark times: the first (cold) and a repeated
+    (warm) load of the file into a TrackStore, random queries typed into a
+    TrackSearcher, sorting the whole library, bulk appends, random deletes and
+    the load that compacts them away. The resident memory of the loaded library
+    is recorded too, from before the first load so it counts every allocation.
+
+    Search latency runs from the query being set to its first chunk of results
+    reaching the message thread, as the search bar sees it, so it includes the
+    searcher's debounce (reported alongside it).
+
+    Run the app with "--benchmark [output.json] [--sizes 10000,100000]" to run it
+    without opening a window; the results are written as JSON (to the standard
+    output if no file is given) so they can be compared between builds.
+*/
+class LibraryBenchmark
+{
+    public:
+        /**
+        * PURPOSE: Creates the LibraryBenchmark object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        LibraryBenchmark();
+
+        /**
+        * PURPOSE: Destroys the LibraryBenchmark object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~LibraryBenchmark();
+
+        /**
+        * PURPOSE: Runs the benchmark with the options given on the command line.
+        * INPUTS: The arguments of the command line.
+        * OUTPUTS: The results, as a juce var holding a JSON object.
+        */
+        static juce::var runFromCommandLine(const juce::StringArray& arguments);
+
+        /**
+        * PURPOSE: Runs all the library benchmarks for each library size.
+        * INPUTS: The numbers of tracks of the synthetic libraries.
+        * OUTPUTS: The results, as an object holding one result object per library size.
+        */
+        juce::var run(const std::vector<int>& librarySizes);
+
+    private:
+        /** Records when the results of a TrackSearcher's query arrive on the message thread. */
+        class SearchTimer : public TrackSearcher::Listener
+        {
+            public:
+                /**
+                * PURPOSE: Starts timing a query. Called just before the query is set.
+                * INPUTS: None.
+                * OUTPUTS: None.
+                */
+                void start();
+
+                /**
+                * PURPOSE: Waits for the last chunk of results of the query being timed.
+                * INPUTS: The longest time to wait in milliseconds.
+                * OUTPUTS: A boolean; true if the results arrived and false if the wait timed out.
+                */
+                bool waitForResults(int timeoutMs);
+
+                /**
+                * PURPOSE: Records the time a chunk of results arrived.
+                *          Implements TrackSearcher Listener (i.e. function is pure virtual).
+                * INPUTS: The rows found and the first/last chunk flags.
+                * OUTPUTS: None.
+                */
+                void searchResultsArrived(const std::vector<juce::uint32>& rows,
+                                          bool isFirstChunk,
+                                          bool isLastChunk) override;
+
+
+                /** DATA MEMBERS */
+
+                double startMs = 0.0;
+                double firstChunkMs = 0.0;
+                double lastChunkMs = 0.0;
+                juce::int64 numMatches = 0;
+
+            private:
+                juce::WaitableEvent lastChunkArrived;
+        };
+
+        /**
+        * PURPOSE: Runs all the library benchmarks on one synthetic library.
+        * INPUTS: The number of tracks in the library.
+        * OUTPUTS: The results as an object.
+        */
+        juce::var benchmarkLibrary(int numTracks);
+
+        /**
+        * PURPOSE: Loads a playlist file into a new track store, as the playlist component does.
+        * INPUTS: The playlist file processor, the path of the playlist file and the store to fill.
+        * OUTPUTS: None.
+        */
+        static void loadLibrary(PlaylistFileProcessor& fileProcessor, const std::string& filePath, TrackStore& store);
+
+        /**
+        * PURPOSE: Generates a random track with a plausible title, artist and tags.
+        * INPUTS: The number of the track (used to make its path unique).
+        * OUTPUTS: The generated track.
+        */
+        Track createSyntheticTrack(int trackNumber);
+
+        /**
+        * PURPOSE: Times searches of the store through a TrackSearcher, as the search bar runs them:
+        *          from the query being set to its first and its last chunk of results arriving.
+        *          Must be called off the message thread, which delivers the results.
+        * INPUTS: The store.
+        * OUTPUTS: The results as an object.
+        */
+        juce::var benchmarkSearch(const TrackStore& store);
+
+        /**
+        * PURPOSE: Summarises a set of timings as percentiles.
+        * INPUTS: The timings in milliseconds (sorted in place).
+        * OUTPUTS: An object holding the 50th, 90th, 99th percentile and maximum timings.
+        */
+        static juce::var getPercentiles(std::vector<double>& timesMs);
+
+        /**
+        * PURPOSE: Gets the amount of physical memory used by the process.
+        * INPUTS: None.
+        * OUTPUTS: The resident memory in bytes, or -1 if it can't be read on this platform.
+        */
+        static juce::int64 getResidentMemoryBytes();
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int numSearches = 200;
+        static constexpr int searchTimeoutMs = 10000;
+        static constexpr int maxAppends = 10000;
+        static constexpr int maxDeletes = 1000;
+
+        juce::Random random;
+        juce::StringArray words;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LibraryBenchmark)
+};
@@ -0,0 +1,365 @@
+/*
+  ==============================================================================
+
+    LibraryWatcher.cpp
+    Created: 19 Oct 2026 5:03:41pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "LibraryWatcher.h"
+#include <map>
+
+#if JUCE_LINUX
+ #include <poll.h>
+ #include <sys/inotify.h>
+ #include <unistd.h>
+#endif
+
+LibraryWatcher::LibraryWatcher(Listener& _listener)
+                              : juce::Thread("Library watcher"),
+                                listener(_listener)
+{
+}
+
+LibraryWatcher::~LibraryWatcher()
+{
+    stopThread(4000);
+    cancelPendingUpdate();
+}
+
+void LibraryWatcher::watchFolders(const juce::Array<juce::File>& folders, const juce::String& fileWildcard)
+{
+    stopThread(4000);
+
+    {
+        const juce::ScopedLock sl(lock);
+        watchedFolders = folders;
+        musicFilePatterns = juce::StringArray::fromTokens(fileWildcard, ";", "");
+        musicFilePatterns.trim();
+        musicFilePatterns.removeEmptyStrings();
+    }
+
+    if (!folders.isEmpty())
+    {
+        // Low priority: watching must never get in the way of playback.
+        startThread(2);
+    }
+}
+
+juce::Array<juce::File> LibraryWatcher::getFolders() const
+{
+    const juce::ScopedLock sl(lock);
+    return watchedFolders;
+}
+
+void LibraryWatcher::run()
+{
+    juce::Array<juce::File> folders = getFolders();
+
+   #if JUCE_LINUX
+    watchWithInotify(folders);
+   #else
+    watchByPolling(folders);
+   #endif
+}
+
+LibraryWatcher::FileState LibraryWatcher::getFileState(const juce::File& file)
+{
+    bool exists = file.existsAsFile();
+
+    return { file,
+             exists,
+             exists ? file.getSize() : 0,
+             exists ? file.getLastModificationTime().toMilliseconds() : 0 };
+}
+
+void LibraryWatcher::handleAsyncUpdate()
+{
+    std::vector<Update> updates;
+
+    {
+        const juce::ScopedLock sl(lock);
+        updates.swap(pendingUpdates);
+    }
+
+    for (const auto& update : updates)
+    {
+        if (update.isFolderScan)
+        {
+            listener.watchedFolderScanned(update.folder, update.files);
+        }
+        else
+        {
+            listener.watchedFilesChanged(update.files);
+        }
+    }
+}
+
+void LibraryWatcher::scanFolder(const juce::File& folder, std::vector<FileState>& files) const
+{
+    for (const auto& entry : juce::RangedDirectoryIterator(folder, true, "*", juce::File::findFiles))
+    {
+        if (threadShouldExit())
+        {
+            return;
+        }
+
+        if (isMusicFile(entry.getFile()))
+        {
+            files.push_back({ entry.getFile(),
+                              true,
+                              entry.getFileSize(),
+                              entry.getModificationTime().toMilliseconds() });
+        }
+    }
+}
+
+bool LibraryWatcher::isMusicFile(const juce::File& file) const
+{
+    juce::String fileName = file.getFileName();
+
+    for (const auto& pattern : musicFilePatterns)
+    {
+        if (fileName.matchesWildcard(pattern, true))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void LibraryWatcher::scanAllFolders(const juce::Array<juce::File>& folders)
+{
+    for (const auto& folder : folders)
+    {
+        // A missing folder (e.g. on an unplugged drive) is left alone rather than reported empty.
+        if (folder.isDirectory())
+        {
+            Update update{ true, folder, {} };
+            scanFolder(folder, update.files);
+            postUpdate(std::move(update));
+        }
+    }
+}
+
+void LibraryWatcher::postChanges(std::set<juce::String>& changedPaths)
+{
+    Update update{ false, {}, {} };
+
+    for (const auto& path : changedPaths)
+    {
+        juce::File file{ path };
+
+        if (file.isDirectory())
+        {
+            // A folder was created or moved in: all its files are new.
+            scanFolder(file, update.files);
+        }
+        else if (!file.exists() || isMusicFile(file))
+        {
+            update.files.push_back(getFileState(file));
+        }
+    }
+
+    changedPaths.clear();
+
+    if (!update.files.empty())
+    {
+        postUpdate(std::move(update));
+    }
+}
+
+void LibraryWatcher::postUpdate(Update update)
+{
+    if (threadShouldExit())
+    {
+        return;
+    }
+
+    {
+        const juce::ScopedLock sl(lock);
+        pendingUpdates.push_back(std::move(update));
+    }
+
+    triggerAsyncUpdate();
+}
+
+#if JUCE_LINUX
+void LibraryWatcher::watchWithInotify(const juce::Array<juce::File>& folders)
+{
+    int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (inotifyFd < 0)
+    {
+        watchByPolling(folders);
+        return;
+    }
+
+    // Watch first, then scan, so that nothing changed during the scan is missed.
+    std::unordered_map<int, juce::File> watchedDirs;
+
+    for (const auto& folder : folders)
+    {
+        addWatches(inotifyFd, folder, watchedDirs);
+    }
+
+    scanAllFolders(folders);
+
+    std::set<juce::String> changedPaths;
+    double lastEventMs = 0.0;
+    alignas(struct inotify_event) char buffer[16 * 1024];
+
+    while (!threadShouldExit())
+    {
+        pollfd pollFd{ inotifyFd, POLLIN, 0 };
+        poll(&pollFd, 1, waitForEventsMs);
+
+        ssize_t numBytes;
+
+        while ((numBytes = read(inotifyFd, buffer, sizeof(buffer))) > 0)
+        {
+            for (char* p = buffer; p < buffer + numBytes;)
+            {
+                auto* event = reinterpret_cast<struct inotify_event*>(p);
+                p += sizeof(struct inotify_event) + event->len;
+
+                if ((event->mask & IN_Q_OVERFLOW) != 0)
+                {
+                    // Events were lost, so walk everything again.
+                    changedPaths.clear();
+                    scanAllFolders(folders);
+                    continue;
+                }
+
+                auto dir = watchedDirs.find(event->wd);
+
+                if (dir == watchedDirs.end())
+                {
+                    continue;
+                }
+
+                if ((event->mask & IN_IGNORED) != 0)
+                {
+                    watchedDirs.erase(dir);
+                    continue;
+                }
+
+                juce::File changedFile = event->len > 0 ? dir->second.getChildFile(juce::String::fromUTF8(event->name))
+                                                        : dir->second;
+
+                if ((event->mask & IN_ISDIR) != 0 && (event->mask & (IN_CREATE | IN_MOVED_TO)) != 0)
+                {
+                    addWatches(inotifyFd, changedFile, watchedDirs);
+                }
+
+                changedPaths.insert(changedFile.getFullPathName());
+                lastEventMs = juce::Time::getMillisecondCounterHiRes();
+            }
+        }
+
+        // Coalesce bursts of events until the folders have been quiet for a moment.
+        if (!changedPaths.empty() && juce::Time::getMillisecondCounterHiRes() - lastEventMs >= coalesceMs)
+        {
+            postChanges(changedPaths);
+        }
+    }
+
+    close(inotifyFd);
+}
+
+void LibraryWatcher::addWatches(int inotifyFd, const juce::File& folder, std::unordered_map<int, juce::File>& watchedDirs)
+{
+    const juce::uint32 mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO
+                              | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+    int watchDescriptor = inotify_add_watch(inotifyFd, folder.getFullPathName().toRawUTF8(), mask);
+
+    if (watchDescriptor < 0)
+    {
+        return;
+    }
+
+    watchedDirs[watchDescriptor] = folder;
+
+    for (const auto& entry : juce::RangedDirectoryIterator(folder, false, "*", juce::File::findDirectories))
+    {
+        addWatches(inotifyFd, entry.getFile(), watchedDirs);
+    }
+}
+#endif
+
+void LibraryWatcher::watchByPolling(const juce::Array<juce::File>& folders)
+{
+    std::map<juce::String, FileState> previousFiles;
+
+    auto scanAll = [this, &folders](std::map<juce::String, FileState>& filesByPath, bool isFirstScan)
+    {
+        for (const auto& folder : folders)
+        {
+            if (!folder.isDirectory())
+            {
+                continue;
+            }
+
+            Update update{ true, folder, {} };
+            scanFolder(folder, update.files);
+
+            for (const auto& file : update.files)
+            {
+                filesByPath.emplace(file.file.getFullPathName(), file);
+            }
+
+            if (isFirstScan)
+            {
+                postUpdate(std::move(update));
+            }
+        }
+    };
+
+    scanAll(previousFiles, true);
+
+    while (!threadShouldExit())
+    {
+        wait(pollIntervalMs);
+
+        std::map<juce::String, FileState> currentFiles;
+        scanAll(currentFiles, false);
+
+        if (threadShouldExit())
+        {
+            return;
+        }
+
+        Update update{ false, {}, {} };
+
+        for (const auto& current : currentFiles)
+        {
+            auto previous = previousFiles.find(current.first);
+
+            if (previous == previousFiles.end()
+                || previous->second.size != current.second.size
+                || previous->second.modificationTime != current.second.modificationTime)
+            {
+                update.files.push_back(current.second);
+            }
+        }
+
+        for (const auto& previous : previousFiles)
+        {
+            if (currentFiles.count(previous.first) == 0)
+            {
+                update.files.push_back({ previous.second.file, false, 0, 0 });
+            }
+        }
+
+        if (!update.files.empty())
+        {
+            postUpdate(std::move(update));
+        }
+
+        previousFiles.swap(currentFiles);
+    }
+}
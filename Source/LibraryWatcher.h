@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+    LibraryWatcher.h
+    Created: 19 Oct 2026 5:03:41pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+//==============================================================================
+/*
+    Watches music folders for files that are added, changed, moved or deleted,
+    so the music library can follow the disk without rescanning everything.
+
+    Runs on a background thread. When it starts, every watched folder is walked
+    once and reported as a whole, so that changes made while the app was closed
+    are picked up. After that, only changes are reported: on Linux they come
+    from inotify, elsewhere from comparing a new walk of the folders with the
+    previous one every few seconds. Bursts of changes (e.g. copying an album)
+    are coalesced until the folders have been quiet for a moment, and each
+    changed file is reported once with its size and modification time.
+*/
+class LibraryWatcher : public juce::Thread,
+                       private juce::AsyncUpdater
+{
+    public:
+        /** The state of a file on disk when it was looked at. */
+        struct FileState
+        {
+            juce::File file;
+            bool exists;
+            juce::int64 size;
+            juce::int64 modificationTime;
+        };
+
+        /** Receives the changes found in the watched folders on the message thread. */
+        class Listener
+        {
+            public:
+                virtual ~Listener() = default;
+
+                /**
+                * PURPOSE: Called with every music file in a watched folder when watching starts.
+                * INPUTS: The watched folder and the music files found in it (and its subfolders).
+                * OUTPUTS: None.
+                */
+                virtual void watchedFolderScanned(const juce::File& folder, const std::vector<FileState>& files) = 0;
+
+                /**
+                * PURPOSE: Called when music files in the watched folders have changed.
+                * INPUTS: The changed files. A file that doesn't exist any more may also be a
+                *         folder that was deleted or moved away, with all the files in it.
+                * OUTPUTS: None.
+                */
+                virtual void watchedFilesChanged(const std::vector<FileState>& changes) = 0;
+        };
+
+        /**
+        * PURPOSE: Creates the LibraryWatcher object.
+        * INPUTS: The listener that receives the changes.
+        * OUTPUTS: None.
+        */
+        LibraryWatcher(Listener& _listener);
+
+        /**
+        * PURPOSE: Destroys the LibraryWatcher object, stopping the watching thread.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~LibraryWatcher() override;
+
+        /**
+        * PURPOSE: Sets the folders to be watched and (re)starts watching them.
+        * INPUTS: The folders to be watched and the file patterns of music files (e.g. "*.mp3;*.wav").
+        * OUTPUTS: None.
+        */
+        void watchFolders(const juce::Array<juce::File>& folders, const juce::String& fileWildcard);
+
+        /**
+        * PURPOSE: Gets the folders being watched.
+        * INPUTS: None.
+        * OUTPUTS: The watched folders.
+        */
+        juce::Array<juce::File> getFolders() const;
+
+        /**
+        * PURPOSE: The background thread's main loop. Implements juce Thread (i.e. function is pure virtual).
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void run() override;
+
+        /**
+        * PURPOSE: Looks at a file on disk.
+        * INPUTS: The file.
+        * OUTPUTS: Whether the file exists, its size and its modification time (in milliseconds since 1970).
+        */
+        static FileState getFileState(const juce::File& file);
+
+    private:
+        /** A batch of changes waiting to be delivered to the listener. */
+        struct Update
+        {
+            bool isFolderScan;
+            juce::File folder;
+            std::vector<FileState> files;
+        };
+
+        /**
+        * PURPOSE: Delivers the waiting updates to the listener.
+        *          Implements juce AsyncUpdater (i.e. function is pure virtual).
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void handleAsyncUpdate() override;
+
+        /**
+        * PURPOSE: Walks a folder and its subfolders, looking at every music file in it.
+        * INPUTS: The folder and the vector to add the state of the music files to.
+        * OUTPUTS: None.
+        */
+        void scanFolder(const juce::File& folder, std::vector<FileState>& files) const;
+
+        /**
+        * PURPOSE: Checks if a file is a music file, from its name.
+        * INPUTS: The file.
+        * OUTPUTS: A boolean; true if it is a music file and false if it isn't.
+        */
+        bool isMusicFile(const juce::File& file) const;
+
+        /**
+        * PURPOSE: Walks all the watched folders and delivers their files to the listener.
+        * INPUTS: The watched folders.
+        * OUTPUTS: None.
+        */
+        void scanAllFolders(const juce::Array<juce::File>& folders);
+
+        /**
+        * PURPOSE: Looks at the coalesced changed paths and queues their states for the listener.
+        * INPUTS: The changed paths (cleared afterwards).
+        * OUTPUTS: None.
+        */
+        void postChanges(std::set<juce::String>& changedPaths);
+
+        /**
+        * PURPOSE: Queues an update for the listener.
+        * INPUTS: The update.
+        * OUTPUTS: None.
+        */
+        void postUpdate(Update update);
+
+       #if JUCE_LINUX
+        /**
+        * PURPOSE: Waits for inotify events in the watched folders until the thread is stopped.
+        * INPUTS: The watched folders.
+        * OUTPUTS: None.
+        */
+        void watchWithInotify(const juce::Array<juce::File>& folders);
+
+        /**
+        * PURPOSE: Adds an inotify watch to a folder and all its subfolders.
+        * INPUTS: The inotify file descriptor, the folder and the map of watch descriptors to folders.
+        * OUTPUTS: None.
+        */
+        static void addWatches(int inotifyFd, const juce::File& folder, std::unordered_map<int, juce::File>& watchedDirs);
+       #endif
+
+        /**
+        * PURPOSE: Walks the watched folders every few seconds and reports the files that changed
+        *          since the previous walk, until the thread is stopped.
+        * INPUTS: The watched folders.
+        * OUTPUTS: None.
+        */
+        void watchByPolling(const juce::Array<juce::File>& folders);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int coalesceMs = 500;
+        static constexpr int pollIntervalMs = 5000;
+        static constexpr int waitForEventsMs = 200;
+
+        Listener& listener;
+
+        juce::CriticalSection lock;
+        juce::Array<juce::File> watchedFolders;
+        juce::StringArray musicFilePatterns;
+        std::vector<Update> pendingUpdates;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LibraryWatcher)
+};
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+    LoopingAudioSource.cpp
+    Created: 20 Oct 2026 2:41:07am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "LoopingAudioSource.h"
+
+LoopingAudioSource::LoopingAudioSource()
+                                      : source(nullptr),
+                                        sourceSampleRate(0.0),
+                                        fadeBuffer(2, fadeSamples),
+                                        appliedVersion(0),
+                                        loopActive(false),
+                                        loopStart(0),
+                                        loopEnd(0),
+                                        fadeFrom(0),
+                                        fadeRemaining(0)
+{
+}
+
+LoopingAudioSource::~LoopingAudioSource()
+{
+}
+
+void LoopingAudioSource::setSource(juce::PositionableAudioSource* newSource, double _sourceSampleRate)
+{
+    source = newSource;
+    sourceSampleRate = _sourceSampleRate;
+    position = 0;
+    fadeRemaining = 0;
+    clearLoop();
+}
+
+void LoopingAudioSource::setLoop(double startSeconds, double endSeconds)
+{
+    ++loopVersion;
+    requestedStart = startSeconds;
+    requestedEnd = endSeconds;
+    requestedActive = true;
+    ++loopVersion;
+}
+
+void LoopingAudioSource::clearLoop()
+{
+    ++loopVersion;
+    requestedActive = false;
+    ++loopVersion;
+}
+
+bool LoopingAudioSource::isLoopActive() const
+{
+    return requestedActive.load();
+}
+
+void LoopingAudioSource::crossfadeTo(double seconds)
+{
+    const juce::int64 target = juce::jlimit((juce::int64) 0, getTotalLength(), (juce::int64) (seconds * sourceSampleRate));
+
+    fadeFrom = position.load();
+    fadeRemaining = fadeSamples;
+    position = target;
+}
+
+void LoopingAudioSource::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+{
+    if (source != nullptr)
+    {
+        source->prepareToPlay(samplesPerBlockExpected, sampleRate);
+    }
+}
+
+void LoopingAudioSource::releaseResources()
+{
+    if (source != nullptr)
+    {
+        source->releaseResources();
+    }
+}
+
+void LoopingAudioSource::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    if (source == nullptr)
+    {
+        bufferToFill.clearActiveBufferRegion();
+        return;
+    }
+
+    updateLoop();
+
+    juce::AudioBuffer<float>& buffer = *bufferToFill.buffer;
+    const int numChannels = juce::jmin(buffer.getNumChannels(), fadeBuffer.getNumChannels());
+    juce::int64 readPosition = position.load();
+    int done = 0;
+
+    while (done < bufferToFill.numSamples)
+    {
+        // Past the end of the loop (it may just have been shortened), so go round to the start.
+        if (loopActive && readPosition >= loopEnd)
+        {
+            fadeFrom = readPosition;
+            fadeRemaining = fadeSamples;
+            readPosition = loopStart + (readPosition - loopEnd) % (loopEnd - loopStart);
+        }
+
+        int numSamples = bufferToFill.numSamples - done;
+
+        if (loopActive)
+        {
+            numSamples = (int) juce::jmin((juce::int64) numSamples, loopEnd - readPosition);
+        }
+
+        if (fadeRemaining > 0)
+        {
+            numSamples = juce::jmin(numSamples, fadeRemaining);
+        }
+
+        const int startSample = bufferToFill.startSample + done;
+        readSource(buffer, startSample, numSamples, readPosition);
+
+        if (fadeRemaining > 0)
+        {
+            // What would have followed fades out as the new position fades in.
+            readSource(fadeBuffer, 0, numSamples, fadeFrom);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                float* samples = buffer.getWritePointer(channel, startSample);
+                const float* fading = fadeBuffer.getReadPointer(channel);
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const float fadeIn = (float) (fadeSamples - fadeRemaining + i + 1) / (fadeSamples + 1);
+                    samples[i] = fading[i] + (samples[i] - fading[i]) * fadeIn;
+                }
+            }
+
+            fadeFrom += numSamples;
+            fadeRemaining -= numSamples;
+        }
+
+        readPosition += numSamples;
+        done += numSamples;
+    }
+
+    position = readPosition;
+}
+
+void LoopingAudioSource::setNextReadPosition (juce::int64 newPosition)
+{
+    position = newPosition;
+}
+
+juce::int64 LoopingAudioSource::getNextReadPosition() const
+{
+    return position.load();
+}
+
+juce::int64 LoopingAudioSource::getTotalLength() const
+{
+    return source != nullptr ? source->getTotalLength() : 0;
+}
+
+bool LoopingAudioSource::isLooping() const
+{
+    return false;
+}
+
+void LoopingAudioSource::updateLoop()
+{
+    const int version = loopVersion.load();
+
+    if ((version & 1) != 0 || version == appliedVersion)
+    {
+        return;
+    }
+
+    const double startSeconds = requestedStart.load();
+    const double endSeconds = requestedEnd.load();
+    const bool active = requestedActive.load();
+
+    if (loopVersion.load() != version)
+    {
+        return;
+    }
+
+    appliedVersion = version;
+    loopStart = juce::jlimit((juce::int64) 0, getTotalLength(), (juce::int64) (startSeconds * sourceSampleRate));
+    loopEnd = juce::jlimit((juce::int64) 0, getTotalLength(), (juce::int64) (endSeconds * sourceSampleRate));
+
+    // A loop needs room for at least one crossfade.
+    loopActive = active && loopEnd - loopStart > fadeSamples;
+}
+
+void LoopingAudioSource::readSource(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, juce::int64 from)
+{
+    source->setNextReadPosition(from);
+    source->getNextAudioBlock(juce::AudioSourceChannelInfo(&buffer, startSample, numSamples));
+}
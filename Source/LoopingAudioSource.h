@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+    LoopingAudioSource.h
+    Created: 20 Oct 2026 2:41:07am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <atomic>
+
+//==============================================================================
+/*
+    Sits between a deck's track and its transport and keeps playback inside
+    a loop, to the sample.
+
+    Reads that would cross the end of the loop are split there, and the
+    read carries on from the start of it. So a loop is exactly as long as
+    it was set to be, whatever the block size or the deck's speed. The
+    wrap is crossfaded over a few milliseconds: the start of the loop fades
+    in while what follows its end fades out, so it never clicks.
+
+    The loop is set from the message thread and taken up by the audio thread
+    at the start of its next read. The audio thread can also jump the
+    playhead with the same crossfade, for slip mode to return to where the
+    track would have been once a loop ends.
+*/
+class LoopingAudioSource : public juce::PositionableAudioSource
+{
+    public:
+        /**
+        * PURPOSE: Creates the LoopingAudioSource object with no source and no loop.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        LoopingAudioSource();
+
+        /**
+        * PURPOSE: Destroys the LoopingAudioSource object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~LoopingAudioSource() override;
+
+        /**
+        * PURPOSE: Sets the track to read from and clears the loop. Must only be called while the
+        *          transport has no source, so nothing is reading.
+        * INPUTS: A pointer to the track's source, which the LoopingAudioSource doesn't own, or nullptr,
+        *         and the track's sample rate.
+        * OUTPUTS: None.
+        */
+        void setSource(juce::PositionableAudioSource* newSource, double _sourceSampleRate);
+
+        /**
+        * PURPOSE: Loops a section of the track. Called from the message thread.
+        * INPUTS: The start and the end of the loop in seconds.
+        * OUTPUTS: None.
+        */
+        void setLoop(double startSeconds, double endSeconds);
+
+        /**
+        * PURPOSE: Stops looping, so playback carries on past the end of the loop. Called from the message thread.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void clearLoop();
+
+        /**
+        * PURPOSE: Checks if a loop is set.
+        * INPUTS: None.
+        * OUTPUTS: A boolean; true if it is and false if it isn't.
+        */
+        bool isLoopActive() const;
+
+        /**
+        * PURPOSE: Jumps to a position with the same crossfade as the loop's wrap. Called on the audio
+        *          thread before the transport reads its block.
+        * INPUTS: The position in seconds.
+        * OUTPUTS: None.
+        */
+        void crossfadeTo(double seconds);
+
+        /**
+        * PURPOSE: Prepares the source and the buffer the crossfades are read into.
+        *          Implements juce AudioSource (i.e. function is pure virtual).
+        * INPUTS: The number of samples that the source will be expected to supply each time
+        *         its getNextAudioBlock() method is called and the sample rate.
+        * OUTPUTS: None.
+        */
+        void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+
+        /**
+        * PURPOSE: Releases the source's resources. Implements juce AudioSource (i.e. function is pure virtual).
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void releaseResources() override;
+
+        /**
+        * PURPOSE: Reads the next block of the track, wrapping at the end of the loop.
+        *          Implements juce AudioSource (i.e. function is pure virtual).
+        * INPUTS: A reference to the buffer to be filled.
+        * OUTPUTS: None.
+        */
+        void getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+        /**
+        * PURPOSE: Sets where the next block is read from, without a crossfade.
+        *          Implements juce PositionableAudioSource (i.e. function is pure virtual).
+        * INPUTS: The position in samples.
+        * OUTPUTS: None.
+        */
+        void setNextReadPosition (juce::int64 newPosition) override;
+
+        /**
+        * PURPOSE: Gets where the next block is read from. Implements juce PositionableAudioSource
+        *          (i.e. function is pure virtual).
+        * INPUTS: None.
+        * OUTPUTS: The position in samples.
+        */
+        juce::int64 getNextReadPosition() const override;
+
+        /**
+        * PURPOSE: Gets the length of the track. Implements juce PositionableAudioSource
+        *          (i.e. function is pure virtual).
+        * INPUTS: None.
+        * OUTPUTS: The length in samples, or 0 if there is no track.
+        */
+        juce::int64 getTotalLength() const override;
+
+        /**
+        * PURPOSE: Says the track doesn't wrap at its end, so the transport stops there. Implements juce
+        *          PositionableAudioSource (i.e. function is pure virtual).
+        * INPUTS: None.
+        * OUTPUTS: A boolean; always false.
+        */
+        bool isLooping() const override;
+
+
+        /** DATA MEMBERS */
+
+        // The length of the crossfade at a wrap or a jump, about 6 ms at 44.1 kHz.
+        static constexpr int fadeSamples = 256;
+
+    private:
+        /**
+        * PURPOSE: Takes up the loop last set on the message thread, if it was set completely.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void updateLoop();
+
+        /**
+        * PURPOSE: Reads a stretch of the track from a position into the buffer.
+        * INPUTS: The buffer, where to start in it, the number of samples and the position to read from.
+        * OUTPUTS: None.
+        */
+        void readSource(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, juce::int64 from);
+
+
+        /** DATA MEMBERS */
+
+        juce::PositionableAudioSource* source;
+        double sourceSampleRate;
+        juce::AudioBuffer<float> fadeBuffer;
+
+        std::atomic<juce::int64> position{ 0 };
+
+        // The loop as set by the message thread. The version is odd while it is being written, so the
+        // audio thread never takes up a start from one loop with the end of another.
+        std::atomic<int> loopVersion{ 0 };
+        std::atomic<double> requestedStart{ 0.0 };
+        std::atomic<double> requestedEnd{ 0.0 };
+        std::atomic<bool> requestedActive{ false };
+
+        // Only touched by the audio thread.
+        int appliedVersion;
+        bool loopActive;
+        juce::int64 loopStart;
+        juce::int64 loopEnd;
+        juce::int64 fadeFrom;
+        int fadeRemaining;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoopingAudioSource)
+};
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.cpp
+    Created: 19 Oct 2026 10:12:44pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "LoudnessMeter.h"
+#include <cmath>
+
+LoudnessMeter::LoudnessMeter(double _sampleRate)
+                            : weightedLeft((size_t) chunkSize),
+                              weightedRight((size_t) chunkSize),
+                              samplesPerStep(juce::jmax(1, juce::roundToInt(_sampleRate * stepSeconds)))
+{
+    shelfFilter.setCoefficients(StereoBiquad::Coefficients::makeKWeightingShelf(_sampleRate));
+    highPassFilter.setCoefficients(StereoBiquad::Coefficients::makeKWeightingHighPass(_sampleRate));
+
+    // A five minute track is 3000 steps.
+    stepSums.reserve(4096);
+}
+
+LoudnessMeter::~LoudnessMeter()
+{
+}
+
+void LoudnessMeter::process(const float* left, const float* right, int numSamples)
+{
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const int numInChunk = juce::jmin(chunkSize, numSamples - start);
+
+        shelfFilter.process(left + start, right + start, weightedLeft.data(), weightedRight.data(), numInChunk);
+        highPassFilter.process(weightedLeft.data(), weightedRight.data(), weightedLeft.data(), weightedRight.data(), numInChunk);
+
+        for (int i = 0; i < numInChunk; ++i)
+        {
+            stepSum += (double) weightedLeft[(size_t) i] * weightedLeft[(size_t) i]
+                     + (double) weightedRight[(size_t) i] * weightedRight[(size_t) i];
+
+            if (++stepFill == samplesPerStep)
+            {
+                stepSums.push_back(stepSum);
+                stepSum = 0.0;
+                stepFill = 0;
+            }
+
+            truePeak = juce::jmax(truePeak, truePeakDetector.process(left[start + i], right[start + i]));
+        }
+    }
+}
+
+bool LoudnessMeter::getLoudness(Loudness& loudness) const
+{
+    const int numBlocks = (int) stepSums.size() - stepsPerBlock + 1;
+
+    if (numBlocks <= 0)
+    {
+        return false;
+    }
+
+    // The mean square of each 400 ms block, which starts every 100 ms.
+    std::vector<double> blockPowers((size_t) numBlocks);
+    double windowSum = 0.0;
+
+    for (int step = 0; step < (int) stepSums.size(); ++step)
+    {
+        windowSum += stepSums[(size_t) step];
+
+        if (step >= stepsPerBlock)
+        {
+            windowSum -= stepSums[(size_t) (step - stepsPerBlock)];
+        }
+
+        if (step >= stepsPerBlock - 1)
+        {
+            blockPowers[(size_t) (step - stepsPerBlock + 1)] = juce::jmax(0.0, windowSum) / (samplesPerStep * stepsPerBlock);
+        }
+    }
+
+    auto toLufs = [](double power)
+    {
+        return -0.691 + 10.0 * std::log10(power);
+    };
+
+    auto meanPowerAbove = [&blockPowers, &toLufs](double gateLufs, double& meanPower)
+    {
+        double sum = 0.0;
+        int count = 0;
+
+        for (double power : blockPowers)
+        {
+            if (power > 0.0 && toLufs(power) > gateLufs)
+            {
+                sum += power;
+                count++;
+            }
+        }
+
+        meanPower = count > 0 ? sum / count : 0.0;
+        return count > 0;
+    };
+
+    double ungatedPower;
+
+    if (!meanPowerAbove(absoluteGateLufs, ungatedPower))
+    {
+        return false;
+    }
+
+    double gatedPower;
+
+    if (!meanPowerAbove(toLufs(ungatedPower) + relativeGateLu, gatedPower))
+    {
+        gatedPower = ungatedPower;
+    }
+
+    loudness.integratedLufs = toLufs(gatedPower);
+    loudness.truePeakDb = juce::Decibels::gainToDecibels(truePeak, -200.0f);
+    return true;
+}
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.h
+    Created: 19 Oct 2026 10:12:44pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "StereoBiquad.h"
+#include "TruePeakDetector.h"
+#include <vector>
+
+//==============================================================================
+/*
+    Measures the integrated loudness and the true peak of a whole track,
+    offline, as EBU R128 (ITU-R BS.1770-4) defines them.
+
+    The track's audio is fed in blocks, from start to end. Loudness is the
+    mean square of the K-weighted signal (a high shelf and a high pass, run on
+    both channels at once by a StereoBiquad) over 400 ms blocks that overlap
+    by 75%. Blocks below -70 LUFS are gated out, and then so are blocks more
+    than 10 LU below the loudness of the rest, so silences and breakdowns
+    don't drag a track's loudness down.
+
+    The true peak is the largest sample after upsampling by four, which
+    catches the peaks between samples that a converter will reconstruct; a
+    TruePeakDetector finds it.
+*/
+class LoudnessMeter
+{
+    public:
+        /** The loudness of a track. */
+        struct Loudness
+        {
+            double integratedLufs;
+            double truePeakDb;
+        };
+
+        /**
+        * PURPOSE: Creates the LoudnessMeter object.
+        * INPUTS: The sample rate of the track.
+        * OUTPUTS: None.
+        */
+        LoudnessMeter(double _sampleRate);
+
+        /**
+        * PURPOSE: Destroys the LoudnessMeter object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~LoudnessMeter();
+
+        /**
+        * PURPOSE: Feeds the next block of the track.
+        * INPUTS: The left and right channels of the block and its number of samples.
+        * OUTPUTS: None.
+        */
+        void process(const float* left, const float* right, int numSamples);
+
+        /**
+        * PURPOSE: Works out the loudness of everything fed so far.
+        * INPUTS: A reference to the loudness to be filled.
+        * OUTPUTS: A boolean; true if the loudness was measured and false if the track is shorter
+        *          than one block or silent throughout.
+        */
+        bool getLoudness(Loudness& loudness) const;
+
+
+        /** DATA MEMBERS */
+
+        // The loudness given to tracks that are silent throughout.
+        static constexpr double silentLufs = -200.0;
+
+    private:
+        /** DATA MEMBERS */
+
+        static constexpr double stepSeconds = 0.1;
+        static constexpr int stepsPerBlock = 4;
+        static constexpr double absoluteGateLufs = -70.0;
+        static constexpr double relativeGateLu = -10.0;
+        static constexpr int chunkSize = 1024;
+
+        StereoBiquad shelfFilter;
+        StereoBiquad highPassFilter;
+        std::vector<float> weightedLeft;
+        std::vector<float> weightedRight;
+
+        // The sum of the squared K-weighted samples of both channels over each 100 ms step.
+        int samplesPerStep;
+        int stepFill = 0;
+        double stepSum = 0.0;
+        std::vector<double> stepSums;
+
+        TruePeakDetector truePeakDetector;
+        float truePeak = 0.0f;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoudnessMeter)
+};
@@ -10,6 +10,12 @@
 
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "MainComponent.h"
+#include "BenchmarkRunner.h"
+#include "LibraryBenchmark.h"
+#include "AnalysisBenchmark.h"
+#include "DspBenchmark.h"
+#include "RecorderBenchmark.h"
+#include "MixerBenchmark.h"
 
 //==============================================================================
 class OtoDecksApplication  : public JUCEApplication
@@ -26,6 +32,25 @@ public:
     {
         // This method is where you should put your application's initialisation code..
 
+        // Benchmark mode: run the benchmark asked for without opening a window.
+        const BenchmarkRunner::Benchmark benchmarks[] =
+        {
+            { "--benchmark", LibraryBenchmark::runFromCommandLine },
+            { "--analysis-benchmark", AnalysisBenchmark::runFromCommandLine },
+            { "--dsp-benchmark", DspBenchmark::runFromCommandLine },
+            { "--record-benchmark", RecorderBenchmark::runFromCommandLine },
+            { "--mixer-benchmark", MixerBenchmark::runFromCommandLine }
+        };
+
+        for (const auto& benchmark : benchmarks)
+        {
+            if (BenchmarkRunner::isRequested(commandLine, benchmark))
+            {
+                BenchmarkRunner::launch(commandLine, benchmark);
+                return;
+            }
+        }
+
         mainWindow.reset (new MainWindow (getApplicationName()));
     }
 
@@ -15,17 +15,25 @@ MainComponent::MainComponent()
     // adding any child components.
     setSize (850, 650);
 
+    // Each deck hands its output to the recorder, for the stems.
+    player1.setStemRecorder(&recorder, SetRecorder::deck1);
+    player2.setStemRecorder(&recorder, SetRecorder::deck2);
+
+    deckMixer.addDeck(&player1);
+    deckMixer.addDeck(&player2);
+
     // Some platforms require permissions to open input channels so request that here
     if (juce::RuntimePermissions::isRequired (juce::RuntimePermissions::recordAudio)
         && ! juce::RuntimePermissions::isGranted (juce::RuntimePermissions::recordAudio))
     {
         juce::RuntimePermissions::request (juce::RuntimePermissions::recordAudio,
-                                     [&] (bool granted) { if (granted)  setAudioChannels (2, 2); });
+                                     [&] (bool granted) { if (granted)  setAudioChannels (2, 4); });
     }  
     else
     {
-        // Specify the number of input and output channels that we want to open.
-        setAudioChannels (0, 2);
+        // Specify the number of input and output channels that we want to open: the master
+        // on outputs 1/2 and the headphone cue bus on 3/4, where the interface has them.
+        setAudioChannels (0, 4);
     }  
 
     addAndMakeVisible(deckGUI1); 
@@ -33,6 +41,7 @@ MainComponent::MainComponent()
     addAndMakeVisible(middleGUI1);
     addAndMakeVisible(middleGUI2);
     addAndMakeVisible(playlistComponent);
+    addAndMakeVisible(masterGUI);
 
     formatManager.registerBasicFormats();
 }
@@ -46,19 +55,28 @@ MainComponent::~MainComponent()
 //==============================================================================
 void MainComponent::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
 {
-    player1.prepareToPlay(samplesPerBlockExpected, sampleRate);
-    player2.prepareToPlay(samplesPerBlockExpected, sampleRate);
-    
-    mixerSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-
-    mixerSource.addInputSource(&player1, false);
-    mixerSource.addInputSource(&player2, false);
-
+    // The mixer prepares the decks.
+    deckMixer.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    masterLimiter.prepare(sampleRate);
+    masterLevelMeter.prepare(sampleRate);
+    spectrumAnalyser.prepare(sampleRate);
+    recorder.prepare(sampleRate);
 }
 
 void MainComponent::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
 {
-    mixerSource.getNextAudioBlock(bufferToFill);
+    // The faders and PFL buttons belong to the decks; the mixer picks them up every block.
+    deckMixer.setFaderGain(0, player1.getFaderGain());
+    deckMixer.setFaderGain(1, player2.getFaderGain());
+    deckMixer.setCueEnabled(0, player1.isCueEnabled());
+    deckMixer.setCueEnabled(1, player2.isCueEnabled());
+    deckMixer.getNextAudioBlock(bufferToFill);
+
+    // Keep the sum of both decks under the ceiling, however hot they are.
+    masterLimiter.process(bufferToFill);
+    masterLevelMeter.measure(bufferToFill);
+    spectrumAnalyser.pushSamples(bufferToFill);
+    recorder.pushBlock(SetRecorder::master, bufferToFill);
 }
 
 void MainComponent::releaseResources()
@@ -67,9 +85,7 @@ void MainComponent::releaseResources()
     // restarted due to a setting change.
 
     // For more details, see the help for AudioProcessor::releaseResources()
-    player1.releaseResources();
-    player2.releaseResources();
-    mixerSource.releaseResources();
+    deckMixer.releaseResources();
 }
 
 //==============================================================================
@@ -88,5 +104,6 @@ void MainComponent::resized()
     deckGUI2.setBounds(rowW * 5, 0, rowW * 3, (rowH * 3) - rowH / 2);
     middleGUI1.setBounds(rowW * 3, 0, rowW, (rowH * 3) - rowH / 2);
     middleGUI2.setBounds(rowW * 4, 0, rowW, (rowH * 3) - rowH / 2);
-    playlistComponent.setBounds(0, (rowH * 3) - rowH / 2, getWidth(), rowH + rowH / 2);
+    playlistComponent.setBounds(0, (rowH * 3) - rowH / 2, rowW * 5, rowH + rowH / 2);
+    masterGUI.setBounds(rowW * 5, (rowH * 3) - rowH / 2, getWidth() - rowW * 5, rowH + rowH / 2);
 }
\ No newline at end of file
@@ -10,9 +10,18 @@
 
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "DJAudioPlayer.h"
+#include "DeckMixer.h"
 #include "DeckGUI.h"
 #include "MiddleGUI.h"
+#include "MasterGUI.h"
+#include "MasterLimiter.h"
+#include "SetRecorder.h"
+#include "SpectrumAnalyser.h"
 #include "PlaylistComponent.h"
+#include "AnalysisCache.h"
+#include "AnalysisThumbnailCache.h"
+#include "AnalysisScheduler.h"
+#include "TrackAnalyser.h"
 
 
 //==============================================================================
@@ -87,21 +96,29 @@ class MainComponent   : public juce::AudioAppComponent
         //==============================================================================
 
         juce::AudioFormatManager formatManager;
-        juce::AudioThumbnailCache thumbCache{100}; 
+        AnalysisCache analysisCache{ AnalysisCache::getDefaultDirectory() };
+        AnalysisThumbnailCache thumbCache{ 100, analysisCache };
+        AnalysisScheduler analysisScheduler;
+        TrackAnalyser trackAnalyser{ formatManager, analysisCache, analysisScheduler };
 
         DJAudioPlayer player1{formatManager};
         juce::Colour blueDeckColour{ juce::Colour::fromRGBA(37, 136, 238, 255) };
-        DeckGUI deckGUI1{&player1, formatManager, thumbCache, blueDeckColour, &tooltipWindow };
-        MiddleGUI middleGUI1{ &player1, &tooltipWindow };
+        DeckGUI deckGUI1{&player1, formatManager, thumbCache, trackAnalyser, blueDeckColour, &tooltipWindow };
+        MiddleGUI middleGUI1{ &player1, &player2, &tooltipWindow };
 
         DJAudioPlayer player2{formatManager};
         juce::Colour redDeckColour{ juce::Colour::fromRGBA(146, 14, 27, 255) };
-        DeckGUI deckGUI2{&player2, formatManager, thumbCache, redDeckColour, &tooltipWindow };
-        MiddleGUI middleGUI2{ &player2, &tooltipWindow };
+        DeckGUI deckGUI2{&player2, formatManager, thumbCache, trackAnalyser, redDeckColour, &tooltipWindow };
+        MiddleGUI middleGUI2{ &player2, &player1, &tooltipWindow };
 
-        juce::MixerAudioSource mixerSource; 
+        DeckMixer deckMixer;
+        MasterLimiter masterLimiter;
+        LevelMeter masterLevelMeter;
+        SpectrumAnalyser spectrumAnalyser;
+        SetRecorder recorder;
+        MasterGUI masterGUI{ &masterLimiter, &masterLevelMeter, &spectrumAnalyser, &recorder, &deckMixer };
 
-        PlaylistComponent playlistComponent{ formatManager, &deckGUI1, &deckGUI2 };
+        PlaylistComponent playlistComponent{ formatManager, analysisScheduler, trackAnalyser, &deckGUI1, &deckGUI2 };
         juce::TooltipWindow tooltipWindow{ this, 700 };
     
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainComponent)
@@ -0,0 +1,254 @@
+/*
+  ==============================================================================
+
+    MasterGUI.cpp
+    Created: 19 Oct 2026 11:58:47pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "MasterGUI.h"
+
+//==============================================================================
+MasterGUI::MasterGUI(MasterLimiter* _limiter, LevelMeter* _levelMeter, SpectrumAnalyser* _analyser,
+                     SetRecorder* _recorder, DeckMixer* _mixer)
+                    : limiter(_limiter),
+                      recorder(_recorder),
+                      mixer(_mixer),
+                      levelMeterDisplay(_levelMeter),
+                      spectrumDisplay(_analyser),
+                      displayedReductionDb(0.0f),
+                      clipTicksLeft(0),
+                      samplesDropped(0)
+{
+    addAndMakeVisible(levelMeterDisplay);
+    addAndMakeVisible(spectrumDisplay);
+    addAndMakeVisible(recordButton);
+    addAndMakeVisible(stemsButton);
+    addAndMakeVisible(cueMixSlider);
+
+    recordButton.setClickingTogglesState(true);
+    stemsButton.setClickingTogglesState(true);
+    recordButton.addListener(this);
+
+    // The headphones start on the cued decks alone.
+    cueMixSlider.setRange(0.0, 1.0);
+    cueMixSlider.setValue(0.0);
+    cueMixSlider.setDoubleClickReturnValue(true, 0.5);
+    cueMixSlider.addListener(this);
+
+    setTooltip("LEVEL: what goes out to the speakers.\n LIMIT: how far the master bus is being turned down to stay under "
+               + juce::String(MasterLimiter::ceilingDb, 1) + " dBTP. CLIP lights if it had to clip.\n"
+               + " REC: record the set to a WAV or FLAC file, and each deck to a file of its own if STEMS is on.\n"
+               + " CUE/MASTER: blend the decks with PFL on into the master, in the headphones (outputs 3/4).");
+
+    startTimerHz(refreshRateHz);
+}
+
+MasterGUI::~MasterGUI()
+{
+}
+
+void MasterGUI::paint (juce::Graphics& g)
+{
+    double rowH = getHeight() / 8.0;
+    juce::Rectangle<float> strip = getStripArea();
+
+    // Fill background.
+    g.fillAll(juce::Colour::fromRGBA(55, 56, 60, 255));
+
+    g.setColour(juce::Colours::white);
+    g.setFont(16.0f);
+    g.drawText("MASTER", strip.withHeight(rowH), juce::Justification::centred, false);
+
+    // Recording length, turning red if the disk fell behind and samples were lost.
+    g.setFont(13.0f);
+    g.setColour(samplesDropped > 0 ? juce::Colours::indianred : juce::Colours::white);
+    g.drawText(recordingText, getRecordingTextArea(), juce::Justification::centredRight, true);
+
+    // Cue Mix Labels, either side of the slider.
+    g.setColour(juce::Colours::white);
+    g.drawText("CUE", juce::Rectangle<float>(10, rowH * 6.7, 40, rowH), juce::Justification::centredLeft, false);
+    g.drawText("MASTER", juce::Rectangle<float>(strip.getX() - 60, rowH * 6.7, 55, rowH),
+               juce::Justification::centredRight, false);
+
+    g.setFont(13.0f);
+    g.drawText("LEVEL", strip.withTop(rowH * 7).withHeight(rowH).withWidth(strip.getWidth() / 2),
+               juce::Justification::centred, false);
+    g.drawText("LIMIT", strip.withTop(rowH * 7).withHeight(rowH).withTrimmedLeft(strip.getWidth() / 2),
+               juce::Justification::centred, false);
+
+    // Gain reduction meter, which grows down from the top as the limiter works harder.
+    juce::Rectangle<float> meterArea = getMeterArea();
+    float fill = juce::jlimit(0.0f, 1.0f, displayedReductionDb / meterRangeDb);
+
+    g.setColour(juce::Colour::fromRGBA(35, 36, 40, 255));
+    g.fillRoundedRectangle(meterArea, 3);
+    g.setColour(juce::Colour::fromRGBA(102, 94, 199, 255));
+    g.fillRect(meterArea.withHeight(meterArea.getHeight() * fill));
+    g.setColour(juce::Colours::yellowgreen);
+    g.drawRoundedRectangle(meterArea, 3, 1);
+
+    // A tick every 3 dB.
+    for (float db = 3.0f; db < meterRangeDb; db += 3.0f)
+    {
+        float y = meterArea.getY() + meterArea.getHeight() * db / meterRangeDb;
+        g.drawHorizontalLine((int) y, meterArea.getX(), meterArea.getX() + 4);
+    }
+
+    g.setColour(clipTicksLeft > 0 ? juce::Colours::indianred : juce::Colours::grey);
+    g.drawText("CLIP", strip.withTop(rowH).withHeight(rowH), juce::Justification::centred, false);
+}
+
+void MasterGUI::resized()
+{
+    double rowH = getHeight() / 8.0;
+
+    // The level meter sits in the left half of the strip, as the limiter's meter does in the right.
+    levelMeterDisplay.setBounds(getMeterArea().translated(-getStripArea().getWidth() / 2, 0).toNearestInt());
+
+    // Spectrum, left of the strip.
+    spectrumDisplay.setBounds(10, rowH, getStripArea().getX() - 10, rowH * 5.5);
+
+    // Cue Mix Slider, below the spectrum.
+    cueMixSlider.setBounds(45, rowH * 6.7, getStripArea().getX() - 110, rowH);
+    cueMixSlider.setSliderStyle(juce::Slider::SliderStyle::LinearHorizontal);
+    cueMixSlider.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+    cueMixSlider.setMouseCursor(juce::MouseCursor::DraggingHandCursor);
+    cueMixSlider.setColour(juce::Slider::ColourIds::trackColourId, juce::Colours::yellowgreen);
+    cueMixSlider.setColour(juce::Slider::ColourIds::thumbColourId, juce::Colour::fromRGBA(102, 94, 199, 255));
+
+    // Record and Stems Buttons, above the spectrum.
+    recordButton.setBounds(10, 2, 40, rowH - 4);
+    recordButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+    recordButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::indianred);
+    recordButton.setColour(juce::TextButton::ColourIds::textColourOnId, juce::Colours::black);
+    recordButton.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+
+    stemsButton.setBounds(54, 2, 50, rowH - 4);
+    stemsButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+    stemsButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::yellowgreen);
+    stemsButton.setColour(juce::TextButton::ColourIds::textColourOnId, juce::Colours::black);
+    stemsButton.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+}
+
+void MasterGUI::buttonClicked(juce::Button* button)
+{
+    if (button == &recordButton)
+    {
+        if (recordButton.getToggleState())
+        {
+            if (!startRecording())
+            {
+                recordButton.setToggleState(false, juce::NotificationType::dontSendNotification);
+            }
+        }
+        else
+        {
+            // Returns once everything recorded is on disk.
+            recorder->stopRecording();
+        }
+
+        // Stems can only be switched on or off between recordings.
+        stemsButton.setEnabled(!recorder->isRecording());
+    }
+}
+
+void MasterGUI::sliderValueChanged(juce::Slider* slider)
+{
+    if (slider == &cueMixSlider)
+    {
+        mixer->setCueMix((float) slider->getValue());
+    }
+}
+
+void MasterGUI::timerCallback()
+{
+    // Jump up to the deepest reduction since the last tick, but fall back gently.
+    float reductionDb = limiter->getGainReductionDb();
+    float fallenDb = displayedReductionDb - meterFallDbPerSecond / refreshRateHz;
+    float newReductionDb = juce::jmax(reductionDb, fallenDb, 0.0f);
+
+    int newClipTicksLeft = limiter->getAndClearClipped() ? clipHoldTicks : juce::jmax(0, clipTicksLeft - 1);
+
+    if (newReductionDb != displayedReductionDb || newClipTicksLeft != clipTicksLeft)
+    {
+        displayedReductionDb = newReductionDb;
+        clipTicksLeft = newClipTicksLeft;
+        repaint(getStripArea().toNearestInt());
+    }
+
+    // The last recording's length and losses stay up until the next one starts.
+    juce::String newRecordingText;
+    juce::int64 newSamplesDropped = 0;
+
+    for (int stream = 0; stream < SetRecorder::numStreams; ++stream)
+    {
+        newSamplesDropped += recorder->getStats((SetRecorder::Stream) stream).samplesDropped;
+    }
+
+    int seconds = (int) recorder->getRecordedSeconds();
+
+    if (seconds > 0 || recorder->isRecording())
+    {
+        newRecordingText = juce::String::formatted("%02d:%02d", seconds / 60, seconds % 60);
+    }
+
+    if (newSamplesDropped > 0)
+    {
+        newRecordingText << "  " << newSamplesDropped << " lost";
+    }
+
+    if (newRecordingText != recordingText || newSamplesDropped != samplesDropped)
+    {
+        recordingText = newRecordingText;
+        samplesDropped = newSamplesDropped;
+        repaint(getRecordingTextArea());
+    }
+}
+
+juce::Rectangle<float> MasterGUI::getStripArea() const
+{
+    double stripW = juce::jmin(getWidth() / 3.0, 120.0);
+
+    return juce::Rectangle<float>(getWidth() - stripW, 0, stripW, getHeight());
+}
+
+juce::Rectangle<float> MasterGUI::getMeterArea() const
+{
+    juce::Rectangle<float> strip = getStripArea();
+    double rowH = getHeight() / 8.0;
+    float meterWidth = juce::jmin(strip.getWidth() * 0.3f, 24.0f);
+
+    return juce::Rectangle<float>(strip.getX() + strip.getWidth() * 0.75 - meterWidth / 2, rowH * 2, meterWidth, rowH * 5);
+}
+
+juce::Rectangle<int> MasterGUI::getRecordingTextArea() const
+{
+    int rowH = getHeight() / 8;
+
+    return juce::Rectangle<int>(108, 0, (int) getStripArea().getX() - 108, rowH);
+}
+
+bool MasterGUI::startRecording()
+{
+    juce::FileChooser chooser{ "Record the set to...",
+                               juce::File::getSpecialLocation(juce::File::userMusicDirectory).getChildFile("Set.wav"),
+                               "*.wav;*.flac" };
+
+    if (!chooser.browseForFileToSave(true))
+    {
+        return false;
+    }
+
+    juce::String error;
+
+    if (!recorder->startRecording(chooser.getResult(), stemsButton.getToggleState(), error))
+    {
+        juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon, "Recording", error);
+        return false;
+    }
+
+    return true;
+}
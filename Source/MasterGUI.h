@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    MasterGUI.h
+    Created: 19 Oct 2026 11:58:47pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "DeckMixer.h"
+#include "LevelMeterDisplay.h"
+#include "MasterLimiter.h"
+#include "SetRecorder.h"
+#include "SpectrumDisplay.h"
+
+//==============================================================================
+/*
+    The master section: shows the spectrum and the level of what goes out
+    to the speakers and how hard the master bus limiter is working, and
+    flashes when the limiter's safety clipper has had to step in. The REC
+    button records the set to disk, with a stem of each deck if STEMS is on,
+    and the CUE/MASTER slider blends the master into the headphones.
+
+    The limiter and recorder are polled by a timer on the message thread, so
+    the audio thread never waits on the GUI.
+*/
+class MasterGUI  : public juce::Component,
+                   public juce::SettableTooltipClient,
+                   public juce::Button::Listener,
+                   public juce::Slider::Listener,
+                   public juce::Timer
+{
+    public:
+        /**
+        * PURPOSE: Creates the MasterGUI object, sets its tooltip and starts a timer.
+        * INPUTS: Pointers to the master bus MasterLimiter, LevelMeter, SpectrumAnalyser and SetRecorder,
+        *         and to the DeckMixer whose cue bus the headphones hear.
+        * OUTPUTS: None.
+        */
+        MasterGUI(MasterLimiter* _limiter, LevelMeter* _levelMeter, SpectrumAnalyser* _analyser,
+                  SetRecorder* _recorder, DeckMixer* _mixer);
+
+        /**
+        * PURPOSE: Destroys the MasterGUI object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~MasterGUI() override;
+
+        /**
+        * PURPOSE: Draws the component's contents. Overrides juce Component member function.
+        * INPUTS: The graphics context that must be used to do the drawing operations.
+        * OUTPUTS: None.
+        */
+        void paint (juce::Graphics& g) override;
+
+        /**
+        * PURPOSE: Layouts the component's children when its width or height changes.
+        *          Overrides juce Component member function.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void resized() override;
+
+        /**
+        * PURPOSE: Implements juce Button::Listener.
+        * INPUTS: A pointer to the juce button that was clicked.
+        * OUTPUTS: None.
+        */
+        void buttonClicked(juce::Button* button) override;
+
+        /**
+        * PURPOSE: Implements juce Slider::Listener.
+        * INPUTS: A pointer to the juce slider that had its value changed.
+        * OUTPUTS: None.
+        */
+        void sliderValueChanged(juce::Slider* slider) override;
+
+        /**
+        * PURPOSE: The user-defined callback routine that actually gets called periodically.
+        *          Implements juce Timer.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void timerCallback() override;
+
+    private:
+        /**
+        * PURPOSE: Works out where the strip of meters on the right is.
+        * INPUTS: None.
+        * OUTPUTS: The strip's area.
+        */
+        juce::Rectangle<float> getStripArea() const;
+
+        /**
+        * PURPOSE: Works out where the gain reduction meter is drawn.
+        * INPUTS: None.
+        * OUTPUTS: The meter's area.
+        */
+        juce::Rectangle<float> getMeterArea() const;
+
+        /**
+        * PURPOSE: Works out where the recording's length is written.
+        * INPUTS: None.
+        * OUTPUTS: The text's area.
+        */
+        juce::Rectangle<int> getRecordingTextArea() const;
+
+        /**
+        * PURPOSE: Asks where to save the set and starts recording it there.
+        * INPUTS: None.
+        * OUTPUTS: A boolean; true if recording started and false if it didn't.
+        */
+        bool startRecording();
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int refreshRateHz = 30;
+        static constexpr float meterRangeDb = 12.0f;
+        static constexpr float meterFallDbPerSecond = 20.0f;
+        static constexpr int clipHoldTicks = refreshRateHz;
+
+        MasterLimiter* limiter;
+        SetRecorder* recorder;
+        DeckMixer* mixer;
+        LevelMeterDisplay levelMeterDisplay;
+        SpectrumDisplay spectrumDisplay;
+
+        juce::TextButton recordButton{ "REC" };
+        juce::TextButton stemsButton{ "STEMS" };
+        juce::Slider cueMixSlider;
+
+        float displayedReductionDb;
+        int clipTicksLeft;
+        juce::String recordingText;
+        juce::int64 samplesDropped;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MasterGUI)
+};
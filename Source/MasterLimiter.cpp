@@ -0,0 +1,193 @@
+/*
+  ==============================================================================
+
+    MasterLimiter.cpp
+    Created: 19 Oct 2026 11:52:10pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "MasterLimiter.h"
+#include <cmath>
+#include <numeric>
+
+MasterLimiter::MasterLimiter()
+                            : ceiling(juce::Decibels::decibelsToGain(ceilingDb)),
+                              lookahead(1),
+                              releaseCoefficient(0.0f),
+                              delayPosition(0),
+                              windowFront(0),
+                              windowSize(0),
+                              time(0),
+                              releasedGain(1.0f),
+                              averagePosition(0),
+                              averageSum(1.0)
+{
+    prepare(44100.0);
+}
+
+MasterLimiter::~MasterLimiter()
+{
+}
+
+void MasterLimiter::prepare(double sampleRate)
+{
+    lookahead = juce::jmax(1, juce::roundToInt(lookaheadSeconds * sampleRate));
+    releaseCoefficient = (float) (1.0 - std::exp(-1.0 / (releaseSeconds * sampleRate)));
+
+    // Everything the limiter will ever need is allocated here, up front.
+    delayLeft.assign((size_t) getLatencySamples(), 0.0f);
+    delayRight.assign((size_t) getLatencySamples(), 0.0f);
+    delayPosition = 0;
+
+    // The window holds the gains needed over the lookahead and the sample after it.
+    windowGains.assign((size_t) lookahead + 1, 1.0f);
+    windowTimes.assign((size_t) lookahead + 1, 0);
+    windowFront = 0;
+    windowSize = 0;
+    time = 0;
+
+    releasedGain = 1.0f;
+
+    averageHistory.assign((size_t) lookahead, 1.0f);
+    averagePosition = 0;
+    averageSum = lookahead;
+
+    detector.reset();
+}
+
+void MasterLimiter::process(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    juce::AudioBuffer<float>* buffer = bufferToFill.buffer;
+
+    if (buffer == nullptr || buffer->getNumChannels() == 0 || bufferToFill.numSamples <= 0)
+    {
+        return;
+    }
+
+    const bool isStereo = buffer->getNumChannels() > 1;
+    float* left = buffer->getWritePointer(0, bufferToFill.startSample);
+    float* right = isStereo ? buffer->getWritePointer(1, bufferToFill.startSample) : left;
+    const int length = (int) delayLeft.size();
+
+    float smallestGain = 1.0f;
+    bool hasClipped = false;
+
+    for (int i = 0; i < bufferToFill.numSamples; ++i)
+    {
+        const float gain = computeGain(detector.process(left[i], right[i]));
+        smallestGain = juce::jmin(smallestGain, gain);
+
+        float outLeft = delayLeft[(size_t) delayPosition] * gain;
+        float outRight = delayRight[(size_t) delayPosition] * gain;
+        delayLeft[(size_t) delayPosition] = left[i];
+        delayRight[(size_t) delayPosition] = right[i];
+        delayPosition = delayPosition + 1 < length ? delayPosition + 1 : 0;
+
+        if (std::abs(outLeft) > ceiling || std::abs(outRight) > ceiling)
+        {
+            outLeft = juce::jlimit(-ceiling, ceiling, outLeft);
+            outRight = juce::jlimit(-ceiling, ceiling, outRight);
+            hasClipped = true;
+        }
+
+        left[i] = outLeft;
+
+        if (isStereo)
+        {
+            right[i] = outRight;
+        }
+    }
+
+    // Keep the deepest reduction until the GUI takes it, without ever waiting on the GUI.
+    const float reductionDb = -juce::Decibels::gainToDecibels(smallestGain, -100.0f);
+    float publishedDb = gainReductionDb.load();
+
+    while (reductionDb > publishedDb && !gainReductionDb.compare_exchange_weak(publishedDb, reductionDb))
+    {
+    }
+
+    if (hasClipped)
+    {
+        clipped = true;
+    }
+}
+
+float MasterLimiter::getGainReductionDb()
+{
+    return gainReductionDb.exchange(0.0f);
+}
+
+bool MasterLimiter::getAndClearClipped()
+{
+    return clipped.exchange(false);
+}
+
+int MasterLimiter::getLatencySamples() const
+{
+    return lookahead + TruePeakDetector::latencySamples;
+}
+
+float MasterLimiter::computeGain(float peak)
+{
+    // Aim a hair under the ceiling, so that rounding in the gain leaves nothing for the clipper.
+    const float target = ceiling * targetMargin;
+    const float neededGain = peak > target ? target / peak : 1.0f;
+    const int capacity = (int) windowGains.size();
+
+    // The front is the smallest; drop it once it falls out of the window. This happens before the
+    // new gain goes in, so the ring never holds more than the lookahead and the sample after it.
+    if (windowSize > 0 && windowTimes[(size_t) windowFront] < time - lookahead)
+    {
+        windowFront = (windowFront + 1) % capacity;
+        --windowSize;
+    }
+
+    // Gains behind the new one that are no smaller can never be the minimum again.
+    while (windowSize > 0)
+    {
+        const int back = (windowFront + windowSize - 1) % capacity;
+
+        if (windowGains[(size_t) back] < neededGain)
+        {
+            break;
+        }
+
+        --windowSize;
+    }
+
+    const int newBack = (windowFront + windowSize) % capacity;
+    windowGains[(size_t) newBack] = neededGain;
+    windowTimes[(size_t) newBack] = time;
+    ++windowSize;
+    jassert(windowSize <= capacity);
+
+    ++time;
+
+    const float windowGain = windowGains[(size_t) windowFront];
+
+    // Clamp down at once and recover slowly, so the gain doesn't pump between peaks.
+    if (windowGain < releasedGain)
+    {
+        releasedGain = windowGain;
+    }
+    else
+    {
+        releasedGain += (windowGain - releasedGain) * releaseCoefficient;
+    }
+
+    // Averaging over the lookahead turns each drop into a ramp that ends at the peak, which the
+    // window made sure was already seen when the ramp began.
+    averageSum += releasedGain - averageHistory[(size_t) averagePosition];
+    averageHistory[(size_t) averagePosition] = releasedGain;
+
+    if (++averagePosition == lookahead)
+    {
+        // Start the sum again from the history now and then, so rounding errors can't build up.
+        averagePosition = 0;
+        averageSum = std::accumulate(averageHistory.begin(), averageHistory.end(), 0.0);
+    }
+
+    return (float) (averageSum / lookahead);
+}
@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    MasterLimiter.h
+    Created: 19 Oct 2026 11:52:10pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "TruePeakDetector.h"
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+/*
+    A lookahead true-peak limiter for the master bus, so that two hot decks
+    at full volume are turned down smoothly instead of clipping the output.
+
+    Each sample's true peak (from a TruePeakDetector) gives the gain that
+    would keep it under the ceiling. The gain applied is the smallest of
+    those gains over the next 2 ms, found with a sliding-window minimum that
+    costs amortised O(1) per sample, released slowly and then averaged over
+    2 ms so it ramps down ahead of a peak rather than jumping. The audio is delayed by
+    the lookahead (and the detector's latency) to line up with its gain.
+    Whatever still gets past, such as the first samples after a sample rate
+    change, is clipped hard at the ceiling.
+
+    Every buffer is allocated in prepare(), so the audio thread never
+    allocates. The deepest gain reduction since the GUI last looked is
+    published through an atomic.
+*/
+class MasterLimiter
+{
+    public:
+        /**
+        * PURPOSE: Creates the MasterLimiter object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        MasterLimiter();
+
+        /**
+        * PURPOSE: Destroys the MasterLimiter object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~MasterLimiter();
+
+        /**
+        * PURPOSE: Allocates the delay line and the gain computer for a sample rate and clears them.
+        *          Must not be called while process() is running.
+        * INPUTS: The sample rate.
+        * OUTPUTS: None.
+        */
+        void prepare(double sampleRate);
+
+        /**
+        * PURPOSE: Limits a block of audio in place. Called on the audio thread.
+        * INPUTS: The block, as handed to an audio source; only its first two channels are limited.
+        * OUTPUTS: None.
+        */
+        void process(const juce::AudioSourceChannelInfo& bufferToFill);
+
+        /**
+        * PURPOSE: Gets the deepest gain reduction since this was last called, and starts again.
+        *          Called from the message thread.
+        * INPUTS: None.
+        * OUTPUTS: The gain reduction in dB, as a positive number (0 when the limiter is idle).
+        */
+        float getGainReductionDb();
+
+        /**
+        * PURPOSE: Checks if a sample had to be clipped since this was last called, and starts again.
+        *          Called from the message thread.
+        * INPUTS: None.
+        * OUTPUTS: A boolean; true if a sample was clipped and false if none was.
+        */
+        bool getAndClearClipped();
+
+        /**
+        * PURPOSE: Gets how far the limiter delays the audio.
+        * INPUTS: None.
+        * OUTPUTS: The delay in samples.
+        */
+        int getLatencySamples() const;
+
+
+        /** DATA MEMBERS */
+
+        static constexpr float ceilingDb = -1.0f;
+
+    private:
+        /**
+        * PURPOSE: Works out the gain to apply to the sample leaving the delay line next.
+        * INPUTS: The true peak of the sample entering the gain computer.
+        * OUTPUTS: The gain.
+        */
+        float computeGain(float peak);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr double lookaheadSeconds = 0.002;
+        static constexpr double releaseSeconds = 0.15;
+        static constexpr float targetMargin = 0.9999f;
+
+        float ceiling;
+        int lookahead;
+        float releaseCoefficient;
+
+        TruePeakDetector detector;
+
+        // The audio, delayed by the lookahead and the detector's latency.
+        std::vector<float> delayLeft;
+        std::vector<float> delayRight;
+        int delayPosition;
+
+        // The sliding-window minimum: a ring of gains that rise from front to back, each
+        // with the sample it was needed at. A new gain drops every larger one behind it.
+        std::vector<float> windowGains;
+        std::vector<juce::int64> windowTimes;
+        int windowFront;
+        int windowSize;
+        juce::int64 time;
+
+        float releasedGain;
+
+        // The running average of the released gain over the lookahead.
+        std::vector<float> averageHistory;
+        int averagePosition;
+        double averageSum;
+
+        std::atomic<float> gainReductionDb{ 0.0f };
+        std::atomic<bool> clipped{ false };
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MasterLimiter)
+};
@@ -13,47 +13,109 @@
 
 //==============================================================================
 MiddleGUI::MiddleGUI(DJAudioPlayer* _player, 
+                     DJAudioPlayer* _otherPlayer,
                      juce::TooltipWindow* _tooltipWindow)
                     : player(_player),
+                      otherPlayer(_otherPlayer),
                       tooltipWindow(_tooltipWindow),
                       cuePosition1(-1.0),
                       cuePosition2(-1.0),
                       cuePosition3(-1.0),
                       cuePosition4(-1.0),
-                      experienceLevel(0)
+                      experienceLevel(0),
+                      loopBeats(4.0),
+                      isRolling(false),
+                      levelMeterDisplay(_player->getLevelMeter())
 {
     addAndMakeVisible(volSlider);
     addAndMakeVisible(speedSlider);
     addAndMakeVisible(loopSlider);
+    addAndMakeVisible(lowEqKnob);
+    addAndMakeVisible(midEqKnob);
+    addAndMakeVisible(highEqKnob);
+    addAndMakeVisible(filterSlider);
+    addAndMakeVisible(levelMeterDisplay);
 
     addAndMakeVisible(cueButton1);
     addAndMakeVisible(cueButton2);
     addAndMakeVisible(cueButton3);
     addAndMakeVisible(cueButton4);
+    addAndMakeVisible(syncButton);
+    addAndMakeVisible(pflButton);
+    addAndMakeVisible(lowKillButton);
+    addAndMakeVisible(midKillButton);
+    addAndMakeVisible(highKillButton);
+    addAndMakeVisible(loopInButton);
+    addAndMakeVisible(loopOutButton);
+    addAndMakeVisible(loopButton);
+    addAndMakeVisible(rollButton);
 
     volSlider.setRange(0, 100);
     speedSlider.setRange(0.0, 2.0);
-    loopSlider.setRange(0.0, 16.0, 1.0);
+    loopSlider.setRange(0.0, 8.0, 1.0);
+    filterSlider.setRange(-1.0, 1.0);
+
+    // The loop slider steps through powers of two, so its arrows halve and double the loop.
+    loopSlider.textFromValueFunction = [](double value)
+    {
+        const char* beatNames[] = { "1/8", "1/4", "1/2", "1", "2", "4", "8", "16", "32" };
+        return juce::String(beatNames[juce::jlimit(0, 8, (int) value)]) + (value < 4.0 ? " beat" : " beats");
+    };
 
     volSlider.setValue(50);
     speedSlider.setValue(1.0);
+    loopSlider.setValue(5.0);
+    filterSlider.setValue(0.0);
+    filterSlider.setDoubleClickReturnValue(true, 0.0);
+
+    for (juce::Slider* eqKnob : { &lowEqKnob, &midEqKnob, &highEqKnob })
+    {
+        // 0 dB sits at the top of the knob, however lopsided the range.
+        eqKnob->setRange(DeckEqualiser::minGainDb, DeckEqualiser::maxGainDb);
+        eqKnob->setSkewFactorFromMidPoint(0.0);
+        eqKnob->setValue(0.0);
+        eqKnob->setDoubleClickReturnValue(true, 0.0);
+        eqKnob->setTextValueSuffix(" dB");
+        eqKnob->addListener(this);
+    }
+
+    for (juce::TextButton* killButton : { &lowKillButton, &midKillButton, &highKillButton })
+    {
+        killButton->setClickingTogglesState(true);
+        killButton->addListener(this);
+    }
 
     volSlider.setTextValueSuffix("%");
     speedSlider.setTextValueSuffix(" x");
-    loopSlider.setTextValueSuffix(" s");
 
     volSlider.addListener(this);
     speedSlider.addListener(this);
     loopSlider.addListener(this);
+    filterSlider.addListener(this);
     cueButton1.addListener(this);
     cueButton2.addListener(this);
     cueButton3.addListener(this);
     cueButton4.addListener(this);
+    syncButton.addListener(this);
+    pflButton.setClickingTogglesState(true);
+    pflButton.addListener(this);
+    loopInButton.addListener(this);
+    loopOutButton.addListener(this);
+    loopButton.addListener(this);
+    rollButton.addListener(this);
 
     if (experienceLevel <= 2)
     {
-        loopSlider.setTooltip("Select how many seconds from the \ncurrent position backwards to play repeatedly.");
+        loopSlider.setTooltip("Select how many beats to loop. \nWhile looping, the arrows halve or double the loop.");
+        loopButton.setTooltip("Click to loop from the last beat, snapped to the beat grid.\n Click again to carry on.");
+        rollButton.setTooltip("Hold to roll a loop. Let go and the track carries on \nfrom where it would have been.");
+        loopInButton.setTooltip("Click IN and then OUT to loop between the two.");
         cueButton1.setTooltip("Click to save the current position for easy callback.\n CTRL + click to cancel previously saved position.");
+        syncButton.setTooltip("Click to lock this deck's tempo and beats to the other deck.");
+        pflButton.setTooltip("Click to hear this deck in the headphones (outputs 3/4), whatever its volume.");
+        lowEqKnob.setTooltip("Turn to cut or boost the bass. Double-click to reset.");
+        lowKillButton.setTooltip("Click to cut this band out completely.\n Click again to bring it back.");
+        filterSlider.setTooltip("Slide left for a low-pass filter and right for a high-pass filter.\n Double-click to turn it off.");
     }
 }
 
@@ -85,10 +147,6 @@ void MiddleGUI::paint (juce::Graphics& g)
     g.setColour (Colours::white);
     g.setFont (16.0f);
 
-    // Loop Label
-    juce::Rectangle<float> loopArea(15, rowH * 2.12, getWidth() - 30, (rowH / 2) - 0.5);
-    g.drawText("LOOP", loopArea, juce::Justification::centred, false);
-
     // Hot Cues Label
     juce::Rectangle<float> cuesArea(0, rowH * 2.9, getWidth(), rowH / 2);
     g.drawText("HOT CUES", cuesArea, juce::Justification::centred, false);
@@ -117,7 +175,18 @@ void MiddleGUI::paint (juce::Graphics& g)
 
         volSlider.setValue(50);
         speedSlider.setValue(1.0);
-        loopSlider.setValue(0);
+        loopSlider.setValue(5.0);
+        lowEqKnob.setValue(0.0);
+        midEqKnob.setValue(0.0);
+        highEqKnob.setValue(0.0);
+        filterSlider.setValue(0.0);
+
+        lowKillButton.setToggleState(false, juce::NotificationType::dontSendNotification);
+        midKillButton.setToggleState(false, juce::NotificationType::dontSendNotification);
+        highKillButton.setToggleState(false, juce::NotificationType::dontSendNotification);
+        player->setEqKill(DeckEqualiser::low, false);
+        player->setEqKill(DeckEqualiser::mid, false);
+        player->setEqKill(DeckEqualiser::high, false);
 
         experienceLevel++;
 
@@ -125,7 +194,15 @@ void MiddleGUI::paint (juce::Graphics& g)
         {
             // Remove tooltips.
             loopSlider.setTooltip("");
+            loopButton.setTooltip("");
+            rollButton.setTooltip("");
+            loopInButton.setTooltip("");
             cueButton1.setTooltip("");
+            syncButton.setTooltip("");
+            pflButton.setTooltip("");
+            lowEqKnob.setTooltip("");
+            lowKillButton.setTooltip("");
+            filterSlider.setTooltip("");
 
             // Reset loop tooltip to appear after 1 hour 
             // (bug fix for JUCE inc/dec slider tooltip issue).
@@ -133,6 +210,14 @@ void MiddleGUI::paint (juce::Graphics& g)
         }
     }
 
+    // Syncing this deck releases the other one, so the button follows the player.
+    bool isSynced = player->getSyncMaster() != nullptr;
+    syncButton.setToggleState(isSynced, juce::NotificationType::dontSendNotification);
+    speedSlider.setEnabled(!isSynced);
+
+    // So does the loop button, as a roll or a new track ends the loop too.
+    loopButton.setToggleState(player->isLooping(), juce::NotificationType::dontSendNotification);
+
     repaint();
 }
 
@@ -144,7 +229,7 @@ void MiddleGUI::resized()
 
     // Volume Slider
     volSlider.setNumDecimalPlacesToDisplay(0);
-    volSlider.setBounds(rowW - 13, getHeight() / 15, 35, rowH * 2);
+    volSlider.setBounds(rowW - 13, getHeight() / 15, 35, rowH);
     volSlider.setSliderStyle(juce::Slider::SliderStyle::LinearVertical);
     volSlider.setTextBoxStyle(juce::Slider::TextBoxAbove, false, 510, 20);
     volSlider.setMouseCursor(juce::MouseCursor::DraggingHandCursor);
@@ -157,7 +242,7 @@ void MiddleGUI::resized()
 
     // Speed Slider
     speedSlider.setNumDecimalPlacesToDisplay(1);
-    speedSlider.setBounds((rowW * 2) + 7, getHeight() / 15, 35, rowH * 2);
+    speedSlider.setBounds((rowW * 2) + 7, getHeight() / 15, 35, rowH);
     speedSlider.setSliderStyle(juce::Slider::SliderStyle::LinearVertical);
     speedSlider.setTextBoxStyle(juce::Slider::TextBoxAbove, false, 510, 20);
     speedSlider.setMouseCursor(juce::MouseCursor::DraggingHandCursor);
@@ -168,9 +253,68 @@ void MiddleGUI::resized()
     speedSlider.setColour(juce::Slider::ColourIds::textBoxBackgroundColourId,
                           juce::Colour::fromRGBA(102, 94, 199, 255));
 
+    // Level Meter, between the volume and speed sliders and level with their tracks.
+    levelMeterDisplay.setBounds(rowW + 23, getHeight() / 15 + 20, rowW - 17, rowH - 20);
+
+    // EQ Knobs and Kill Buttons
+    double eqW = (getWidth() - 30) / 3.0;
+    juce::Slider* eqKnobs[] = { &lowEqKnob, &midEqKnob, &highEqKnob };
+    juce::TextButton* killButtons[] = { &lowKillButton, &midKillButton, &highKillButton };
+
+    for (int band = 0; band < DeckEqualiser::numBands; ++band)
+    {
+        eqKnobs[band]->setBounds(15 + eqW * band, rowH * 1.3, eqW, rowH * 0.32);
+        eqKnobs[band]->setSliderStyle(juce::Slider::SliderStyle::RotaryVerticalDrag);
+        eqKnobs[band]->setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+        eqKnobs[band]->setPopupDisplayEnabled(true, true, this);
+        eqKnobs[band]->setMouseCursor(juce::MouseCursor::UpDownResizeCursor);
+        eqKnobs[band]->setColour(juce::Slider::ColourIds::rotarySliderFillColourId,
+                                 juce::Colours::yellowgreen);
+        eqKnobs[band]->setColour(juce::Slider::ColourIds::thumbColourId,
+                                 juce::Colour::fromRGBA(102, 94, 199, 255));
+
+        killButtons[band]->setBounds(15 + eqW * band, rowH * 1.63, eqW, rowH * 0.14);
+        killButtons[band]->setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::indianred);
+        killButtons[band]->setColour(juce::TextButton::ColourIds::textColourOnId, juce::Colours::black);
+        killButtons[band]->setMouseCursor(juce::MouseCursor::PointingHandCursor);
+    }
+
+    // Filter Slider
+    filterSlider.setBounds(15, rowH * 1.78, getWidth() - 30, rowH * 0.14);
+    filterSlider.setSliderStyle(juce::Slider::SliderStyle::LinearHorizontal);
+    filterSlider.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+    filterSlider.setMouseCursor(juce::MouseCursor::DraggingHandCursor);
+    filterSlider.setColour(juce::Slider::ColourIds::trackColourId, 
+                           juce::Colours::yellowgreen);
+    filterSlider.setColour(juce::Slider::ColourIds::thumbColourId, 
+                           juce::Colour::fromRGBA(102, 94, 199, 255));
+
+    // Sync and PFL Buttons
+    syncButton.setBounds(15, rowH * 1.93, (getWidth() - 30) / 2, rowH * 0.2);
+    syncButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::yellowgreen);
+    syncButton.setColour(juce::TextButton::ColourIds::textColourOnId, juce::Colours::black);
+    syncButton.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+
+    pflButton.setBounds(15 + (getWidth() - 30) / 2, rowH * 1.93, (getWidth() - 30) / 2, rowH * 0.2);
+    pflButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::yellowgreen);
+    pflButton.setColour(juce::TextButton::ColourIds::textColourOnId, juce::Colours::black);
+    pflButton.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+
+    // Loop Buttons
+    double loopButtonW = (getWidth() - 30) / 4.0;
+    juce::TextButton* loopButtons[] = { &loopInButton, &loopOutButton, &loopButton, &rollButton };
+
+    for (int index = 0; index < 4; ++index)
+    {
+        loopButtons[index]->setBounds(15 + loopButtonW * index, rowH * 2.16, loopButtonW, rowH * 0.2);
+        loopButtons[index]->setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::yellowgreen);
+        loopButtons[index]->setColour(juce::TextButton::ColourIds::textColourOnId, juce::Colours::black);
+        loopButtons[index]->setMouseCursor(juce::MouseCursor::PointingHandCursor);
+    }
+
     // Loop Slider
     loopSlider.setSliderStyle(juce::Slider::IncDecButtons);
-    loopSlider.setTextBoxStyle(juce::Slider::TextBoxAbove, false, 50, 20);
+    loopSlider.setTextBoxStyle(juce::Slider::TextBoxAbove, true, 70, 20);
     loopSlider.setBounds(15, rowH * 3 - (rowH * 0.5), getWidth() - 30, (rowH / 2) - 0.5);
     loopSlider.setColour(juce::Slider::ColourIds::textBoxBackgroundColourId, 
                          juce::Colour::fromRGBA(102, 94, 199, 255));
@@ -214,7 +358,30 @@ void MiddleGUI::sliderValueChanged(juce::Slider* slider)
 
     if (slider == &loopSlider)
     {
-        player->setLoop(slider->getValue());
+        // Stepping the length while looping halves or doubles the loop.
+        double newLoopBeats = getLoopBeats();
+        player->resizeLoop(newLoopBeats / loopBeats);
+        loopBeats = newLoopBeats;
+    }
+
+    if (slider == &lowEqKnob)
+    {
+        player->setEqGain(DeckEqualiser::low, slider->getValue());
+    }
+
+    if (slider == &midEqKnob)
+    {
+        player->setEqGain(DeckEqualiser::mid, slider->getValue());
+    }
+
+    if (slider == &highEqKnob)
+    {
+        player->setEqGain(DeckEqualiser::high, slider->getValue());
+    }
+
+    if (slider == &filterSlider)
+    {
+        player->setFilter(slider->getValue());
     }
 }
 
@@ -315,6 +482,84 @@ void MiddleGUI::buttonClicked(juce::Button* button)
             cueButton4.setToggleState(false, juce::NotificationType::dontSendNotification);
         }
     }
+
+    // The kill buttons toggle themselves before they are reported.
+    if (button == &lowKillButton)
+    {
+        player->setEqKill(DeckEqualiser::low, lowKillButton.getToggleState());
+    }
+
+    if (button == &midKillButton)
+    {
+        player->setEqKill(DeckEqualiser::mid, midKillButton.getToggleState());
+    }
+
+    if (button == &highKillButton)
+    {
+        player->setEqKill(DeckEqualiser::high, highKillButton.getToggleState());
+    }
+
+    if (button == &syncButton)
+    {
+        // Follow the other deck, or go back to the speed slider.
+        player->setSyncMaster(player->getSyncMaster() == nullptr ? otherPlayer : nullptr);
+        syncButton.setToggleState(player->getSyncMaster() != nullptr, juce::NotificationType::dontSendNotification);
+    }
+
+    if (button == &pflButton)
+    {
+        player->setCueEnabled(pflButton.getToggleState());
+    }
+
+    if (button == &loopInButton)
+    {
+        player->setLoopIn();
+    }
+
+    if (button == &loopOutButton)
+    {
+        player->setLoopOut();
+    }
+
+    if (button == &loopButton)
+    {
+        // Loop the selected number of beats, or carry on out of the loop.
+        if (player->isLooping())
+        {
+            player->exitLoop();
+        }
+        else
+        {
+            player->setBeatLoop(getLoopBeats());
+        }
+
+        loopButton.setToggleState(player->isLooping(), juce::NotificationType::dontSendNotification);
+    }
+}
+
+void MiddleGUI::buttonStateChanged(juce::Button* button)
+{
+    if (button == &rollButton)
+    {
+        if (rollButton.isDown() && !isRolling)
+        {
+            isRolling = true;
+            player->startLoopRoll(getLoopBeats());
+        }
+        else if (!rollButton.isDown() && isRolling)
+        {
+            isRolling = false;
+            player->stopLoopRoll();
+        }
+
+        rollButton.setToggleState(isRolling, juce::NotificationType::dontSendNotification);
+    }
+}
+
+double MiddleGUI::getLoopBeats() const
+{
+    // 1/8 of a beat at the bottom of the slider, doubling at each step up to 32.
+    return std::pow(2.0, loopSlider.getValue() - 3.0);
 }
 
 bool MiddleGUI::isCommandDown() const noexcept
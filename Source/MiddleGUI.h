@@ -12,6 +12,7 @@
 
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "DJAudioPlayer.h"
+#include "LevelMeterDisplay.h"
 
 //==============================================================================
 /*
@@ -25,10 +26,11 @@ class MiddleGUI  : public juce::Component,
         /**
         * PURPOSE: Creates the MiddleGUI object, initialises its data members
         *          (including adding listeners and setting tooltips).
-        * INPUTS: Pointers to DJAudioPlayer and juce TooltipWindow.
+        * INPUTS: Pointers to this deck's DJAudioPlayer, the other deck's DJAudioPlayer
+        *         (the master when this deck is synced) and juce TooltipWindow.
         * OUTPUTS: None.
         */
-        MiddleGUI(DJAudioPlayer* _player, juce::TooltipWindow* _tooltipWindow);
+        MiddleGUI(DJAudioPlayer* _player, DJAudioPlayer* _otherPlayer, juce::TooltipWindow* _tooltipWindow);
 
         /**
         * PURPOSE: Destroys the MiddleGUI object.
@@ -66,6 +68,14 @@ class MiddleGUI  : public juce::Component,
         */
         void buttonClicked(juce::Button* button) override;
 
+        /**
+        * PURPOSE: Starts a loop roll while the roll button is held down and ends it when it is let go of.
+        *          Overrides juce Button::Listener member function.
+        * INPUTS: A pointer to the juce button whose state changed.
+        * OUTPUTS: None.
+        */
+        void buttonStateChanged(juce::Button* button) override;
+
         /**
         * PURPOSE: Checks whether the 'command' key flag is set (or 'CTRL' on Windows/Linux).
         *          In other words, checks if user is holding down the command/CTRL key.
@@ -76,23 +86,48 @@ class MiddleGUI  : public juce::Component,
         bool isCommandDown() const noexcept;
 
     private:
+        /**
+        * PURPOSE: Gets the loop length the loop slider is set to.
+        * INPUTS: None.
+        * OUTPUTS: The length in beats, from 1/8 to 32.
+        */
+        double getLoopBeats() const;
+
         juce::Slider volSlider;
         juce::Slider speedSlider;
         juce::Slider loopSlider;
+        juce::Slider lowEqKnob;
+        juce::Slider midEqKnob;
+        juce::Slider highEqKnob;
+        juce::Slider filterSlider;
 
         juce::TextButton cueButton1{ "1" };
         juce::TextButton cueButton2{ "2" };
         juce::TextButton cueButton3{ "3" };
         juce::TextButton cueButton4{ "4" };
+        juce::TextButton syncButton{ "SYNC" };
+        juce::TextButton pflButton{ "PFL" };
+        juce::TextButton lowKillButton{ "LOW" };
+        juce::TextButton midKillButton{ "MID" };
+        juce::TextButton highKillButton{ "HI" };
+        juce::TextButton loopInButton{ "IN" };
+        juce::TextButton loopOutButton{ "OUT" };
+        juce::TextButton loopButton{ "LOOP" };
+        juce::TextButton rollButton{ "ROLL" };
     
         double cuePosition1;
         double cuePosition2;
         double cuePosition3;
         double cuePosition4;
         int experienceLevel;
+        double loopBeats;
+        bool isRolling;
 
         DJAudioPlayer* player;
+        DJAudioPlayer* otherPlayer;
         juce::TooltipWindow* tooltipWindow;
 
+        LevelMeterDisplay levelMeterDisplay;
+
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MiddleGUI)
 };
\ No newline at end of file
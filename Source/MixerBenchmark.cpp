@@ -0,0 +1,251 @@
+/*
+  ==============================================================================
+
+    MixerBenchmark.cpp
+    Created: 20 Oct 2026 1:58:31am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "MixerBenchmark.h"
+#include "BenchmarkRunner.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+MixerBenchmark::MixerBenchmark()
+                              : random(20261020),
+                                noise(2, noiseLength)
+{
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        for (int i = 0; i < noiseLength; ++i)
+        {
+            noise.setSample(channel, i, 0.5f * (random.nextFloat() * 2.0f - 1.0f));
+        }
+    }
+}
+
+MixerBenchmark::~MixerBenchmark()
+{
+}
+
+juce::var MixerBenchmark::runFromCommandLine(const juce::StringArray& arguments)
+{
+    int blockSize = BenchmarkRunner::getOption(arguments, "--block-size").getIntValue();
+
+    MixerBenchmark benchmark;
+
+    return benchmark.run(blockSize > 0 ? juce::jmin(blockSize, noiseLength) : 512);
+}
+
+juce::var MixerBenchmark::run(int blockSize)
+{
+    juce::Array<juce::var> checks;
+    bool hasPassed = true;
+
+    // Master and cue pairs, as an interface with headphone outputs opens them, then master only.
+    for (int numChannels : { 4, 2 })
+    {
+        juce::var check = checkOutputs(blockSize, numChannels);
+        hasPassed = hasPassed && (bool) check["passed"];
+        checks.add(check);
+    }
+
+    juce::Array<juce::var> timings;
+
+    for (int numDecks = 1; numDecks <= DeckMixer::maxDecks; ++numDecks)
+    {
+        timings.add(timeMixer(blockSize, numDecks));
+    }
+
+    // What one more deck adds, from the cheapest and the dearest mix.
+    const double extraDeckUs = ((double) timings.getLast()["p50Us"] - (double) timings.getFirst()["p50Us"])
+                             / (DeckMixer::maxDecks - 1);
+
+    juce::DynamicObject::Ptr results = BenchmarkRunner::createResults();
+    results->setProperty("sampleRate", sampleRate);
+    results->setProperty("blockSize", blockSize);
+    results->setProperty("blockMs", 1000.0 * blockSize / sampleRate);
+    results->setProperty("checks", checks);
+    results->setProperty("timings", timings);
+    results->setProperty("extraDeckP50Us", extraDeckUs);
+    results->setProperty("passed", hasPassed);
+
+    return juce::var(results.get());
+}
+
+juce::var MixerBenchmark::checkOutputs(int blockSize, int numChannels)
+{
+    const int numCheckBlocks = 16;
+    const float faders[] = { 0.5f, 0.8f };
+    const bool cues[] = { true, false };
+    const float cueMix = 0.25f;
+
+    // The decks and, playing the same noise, the references they are checked against.
+    NoiseDeck deck1(noise, 0);
+    NoiseDeck deck2(noise, noiseLength / 3);
+    NoiseDeck reference1(noise, 0);
+    NoiseDeck reference2(noise, noiseLength / 3);
+    NoiseDeck* references[] = { &reference1, &reference2 };
+
+    DeckMixer mixer;
+    mixer.addDeck(&deck1);
+    mixer.addDeck(&deck2);
+
+    for (int deck = 0; deck < 2; ++deck)
+    {
+        mixer.setFaderGain(deck, faders[deck]);
+        mixer.setCueEnabled(deck, cues[deck]);
+    }
+
+    mixer.setCueMix(cueMix);
+    mixer.prepareToPlay(blockSize, sampleRate);
+
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+    juce::AudioSourceChannelInfo bufferToFill(&buffer, 0, blockSize);
+    juce::AudioBuffer<float> referenceBuffers[] = { juce::AudioBuffer<float>(2, blockSize),
+                                                    juce::AudioBuffer<float>(2, blockSize) };
+
+    float masterGains[] = { faders[0], faders[1] };
+    float maxError = 0.0f;
+
+    for (int block = 0; block < numCheckBlocks; ++block)
+    {
+        // Halfway through, pull the second fader down, which the mixer ramps across the block.
+        float newMasterGains[] = { faders[0], block < numCheckBlocks / 2 ? faders[1] : 0.2f };
+        mixer.setFaderGain(1, newMasterGains[1]);
+
+        // Anything the mixer doesn't write would show up as an error.
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            juce::FloatVectorOperations::fill(buffer.getWritePointer(channel), 1.0f, blockSize);
+        }
+
+        mixer.getNextAudioBlock(bufferToFill);
+
+        for (int deck = 0; deck < 2; ++deck)
+        {
+            juce::AudioSourceChannelInfo referenceToFill(&referenceBuffers[deck], 0, blockSize);
+            references[deck]->getNextAudioBlock(referenceToFill);
+        }
+
+        for (int i = 0; i < blockSize; ++i)
+        {
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                float expectedMaster = 0.0f;
+                float expectedCue = 0.0f;
+
+                for (int deck = 0; deck < 2; ++deck)
+                {
+                    const float x = referenceBuffers[deck].getSample(channel, i);
+                    const float oldCueGain = cueMix * masterGains[deck] + (1.0f - cueMix) * (cues[deck] ? 1.0f : 0.0f);
+                    const float newCueGain = cueMix * newMasterGains[deck] + (1.0f - cueMix) * (cues[deck] ? 1.0f : 0.0f);
+                    const float ramp = (float) i / blockSize;
+
+                    expectedMaster += x * (masterGains[deck] + (newMasterGains[deck] - masterGains[deck]) * ramp);
+                    expectedCue += x * (oldCueGain + (newCueGain - oldCueGain) * ramp);
+                }
+
+                maxError = juce::jmax(maxError, std::abs(buffer.getSample(DeckMixer::masterLeft + channel, i) - expectedMaster));
+
+                if (numChannels > DeckMixer::cueLeft + channel)
+                {
+                    maxError = juce::jmax(maxError, std::abs(buffer.getSample(DeckMixer::cueLeft + channel, i) - expectedCue));
+                }
+            }
+        }
+
+        masterGains[1] = newMasterGains[1];
+    }
+
+    mixer.releaseResources();
+
+    juce::DynamicObject::Ptr result = new juce::DynamicObject();
+    result->setProperty("numChannels", numChannels);
+    result->setProperty("maxError", maxError);
+    result->setProperty("passed", maxError < tolerance);
+
+    return juce::var(result.get());
+}
+
+juce::var MixerBenchmark::timeMixer(int blockSize, int numDecks)
+{
+    std::vector<std::unique_ptr<NoiseDeck>> decks;
+    DeckMixer mixer;
+
+    for (int deck = 0; deck < numDecks; ++deck)
+    {
+        decks.emplace_back(new NoiseDeck(noise, deck * noiseLength / DeckMixer::maxDecks));
+        mixer.addDeck(decks.back().get());
+        mixer.setCueEnabled(deck, true);
+    }
+
+    mixer.setCueMix(0.5f);
+    mixer.prepareToPlay(blockSize, sampleRate);
+
+    juce::AudioBuffer<float> buffer(DeckMixer::numOutputs, blockSize);
+    juce::AudioSourceChannelInfo bufferToFill(&buffer, 0, blockSize);
+    std::vector<double> timesUs;
+    timesUs.reserve(numBlocks);
+
+    for (int block = 0; block < numWarmUpBlocks + numBlocks; ++block)
+    {
+        // Keep a fader moving, so the gains always ramp.
+        mixer.setFaderGain(0, 0.5f + 0.5f * (float) std::sin(block * 0.01));
+
+        juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+        mixer.getNextAudioBlock(bufferToFill);
+        juce::int64 endTicks = juce::Time::getHighResolutionTicks();
+
+        if (block >= numWarmUpBlocks)
+        {
+            timesUs.push_back(1.0e6 * juce::Time::highResolutionTicksToSeconds(endTicks - startTicks));
+        }
+    }
+
+    mixer.releaseResources();
+    std::sort(timesUs.begin(), timesUs.end());
+
+    juce::DynamicObject::Ptr result = new juce::DynamicObject();
+    result->setProperty("numDecks", numDecks);
+    result->setProperty("p50Us", timesUs[timesUs.size() / 2]);
+    result->setProperty("p99Us", timesUs[timesUs.size() * 99 / 100]);
+    result->setProperty("maxUs", timesUs.back());
+    result->setProperty("p50UsPerDeck", timesUs[timesUs.size() / 2] / numDecks);
+
+    return juce::var(result.get());
+}
+
+MixerBenchmark::NoiseDeck::NoiseDeck(const juce::AudioBuffer<float>& _noise, int _position)
+                                    : noise(_noise),
+                                      position(_position)
+{
+}
+
+void MixerBenchmark::NoiseDeck::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+{
+}
+
+void MixerBenchmark::NoiseDeck::releaseResources()
+{
+}
+
+void MixerBenchmark::NoiseDeck::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    for (int done = 0; done < bufferToFill.numSamples;)
+    {
+        const int numSamples = juce::jmin(bufferToFill.numSamples - done, noise.getNumSamples() - position);
+
+        for (int channel = 0; channel < bufferToFill.buffer->getNumChannels(); ++channel)
+        {
+            bufferToFill.buffer->copyFrom(channel, bufferToFill.startSample + done,
+                                          noise, juce::jmin(channel, 1), position, numSamples);
+        }
+
+        done += numSamples;
+        position = (position + numSamples) % noise.getNumSamples();
+    }
+}
@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    MixerBenchmark.h
+    Created: 20 Oct 2026 1:58:31am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "DeckMixer.h"
+#include <vector>
+
+//==============================================================================
+/*
+    Checks and times the DeckMixer without an audio device.
+
+    The mixer is driven the way the audio device drives it, block by block,
+    into a four channel buffer laid out as an interface with a headphone
+    pair would be (master on 1/2, cue on 3/4), and again into a two channel
+    one. Each deck plays its own stretch of noise, so every output can be
+    checked against the same decks mixed one sample at a time: the master
+    against the faders, and the cue bus against the PFL buttons blended
+    with the master.
+
+    The mixer is then timed with one deck up to DeckMixer::maxDecks, all of
+    them cued, to show what each extra deck costs.
+
+    Run the app with "--mixer-benchmark [output.json] [--block-size 512]" to
+    run it without opening a window; the results are written as JSON (to
+    the standard output if no file is given).
+*/
+class MixerBenchmark
+{
+    public:
+        /**
+        * PURPOSE: Creates the MixerBenchmark object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        MixerBenchmark();
+
+        /**
+        * PURPOSE: Destroys the MixerBenchmark object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~MixerBenchmark();
+
+        /**
+        * PURPOSE: Runs the benchmark with the options given on the command line.
+        * INPUTS: The arguments of the command line.
+        * OUTPUTS: The results, as a juce var holding a JSON object; "passed" is true if every output was right.
+        */
+        static juce::var runFromCommandLine(const juce::StringArray& arguments);
+
+        /**
+        * PURPOSE: Checks the outputs of the mixer and times it.
+        * INPUTS: The block size in samples.
+        * OUTPUTS: The results, as a juce var holding a JSON object.
+        */
+        juce::var run(int blockSize);
+
+    private:
+        /** A deck that plays the benchmark's noise from its own starting point. */
+        class NoiseDeck : public juce::AudioSource
+        {
+            public:
+                /**
+                * PURPOSE: Creates the NoiseDeck object.
+                * INPUTS: The noise to play and where in it to start.
+                * OUTPUTS: None.
+                */
+                NoiseDeck(const juce::AudioBuffer<float>& _noise, int _position);
+
+                /**
+                * PURPOSE: Does nothing; the noise is ready. Implements juce AudioSource.
+                * INPUTS: The block size and the sample rate.
+                * OUTPUTS: None.
+                */
+                void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+
+                /**
+                * PURPOSE: Does nothing. Implements juce AudioSource.
+                * INPUTS: None.
+                * OUTPUTS: None.
+                */
+                void releaseResources() override;
+
+                /**
+                * PURPOSE: Copies the next stretch of the noise into the buffer. Implements juce AudioSource.
+                * INPUTS: A reference to the buffer to be filled.
+                * OUTPUTS: None.
+                */
+                void getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+            private:
+                /** DATA MEMBERS */
+                const juce::AudioBuffer<float>& noise;
+                int position;
+        };
+
+        /**
+        * PURPOSE: Mixes two decks into a buffer with the given number of channels and compares every
+        *          output with the decks mixed one sample at a time.
+        * INPUTS: The block size and the number of output channels.
+        * OUTPUTS: The result of the check as an object.
+        */
+        juce::var checkOutputs(int blockSize, int numChannels);
+
+        /**
+        * PURPOSE: Times the mixer block by block with a number of decks, all of them cued.
+        * INPUTS: The block size and the number of decks.
+        * OUTPUTS: The timings as an object.
+        */
+        juce::var timeMixer(int blockSize, int numDecks);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr double sampleRate = 44100.0;
+        static constexpr int numBlocks = 5000;
+        static constexpr int numWarmUpBlocks = 100;
+        static constexpr int noiseLength = 1 << 16;
+        static constexpr float tolerance = 1.0e-5f;
+
+        juce::Random random;
+        juce::AudioBuffer<float> noise;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MixerBenchmark)
+};
@@ -13,50 +13,105 @@
 
 //==============================================================================
 PlaylistComponent::PlaylistComponent(juce::AudioFormatManager& _formatManager,
+                                     AnalysisScheduler& _analysisScheduler,
+                                     TrackAnalyser& _trackAnalyser,
                                      DeckGUI* deckGUI1, 
                                      DeckGUI* deckGUI2)
                                     : formatManager(_formatManager),
+                                      analysisScheduler(_analysisScheduler),
+                                      trackAnalyser(_trackAnalyser),
                                       leftDeck(deckGUI1),
                                       rightDeck(deckGUI2)
 {
+    trackAnalyser.addListener(this);
+
     if (playlistFileExists())
     {
         std::string playlistFilePath = getPlaylistFilePath();
-        tracksToDisplay = fileProcessor.loadData(playlistFilePath);
-        allTracks = fileProcessor.loadData(playlistFilePath);
+
+        for (const auto& track : fileProcessor.loadData(playlistFilePath))
+        {
+            addTrackToLibrary(track);
+        }
+
         tableComponent.updateContent();
     }
 
     tableComponent.getHeader().addColumn("Track title", 1, 
-                                         510, 200, 900,
+                                         310, 200, 900,
+                                         juce::TableHeaderComponent::defaultFlags);
+    tableComponent.getHeader().addColumn("Artist", 6,
+                                         240, 100, 600,
                                          juce::TableHeaderComponent::defaultFlags);
     tableComponent.getHeader().addColumn("Length", 2,
-                                         200, 150, 450,
+                                         80, 60, 450,
+                                         juce::TableHeaderComponent::defaultFlags);
+    tableComponent.getHeader().addColumn("BPM", 7,
+                                         80, 50, 200,
+                                         juce::TableHeaderComponent::defaultFlags);
+    tableComponent.getHeader().addColumn("Key", 8,
+                                         60, 40, 150,
                                          juce::TableHeaderComponent::defaultFlags);
     tableComponent.getHeader().addColumn("L", 3, 
                                          40, 20, 70,
-                                         juce::TableHeaderComponent::defaultFlags, 0);
+                                         juce::TableHeaderComponent::defaultFlags 
+                                         | juce::TableHeaderComponent::notSortable, 0);
     tableComponent.getHeader().addColumn("R", 4,
                                          40, 20, 70,
-                                         juce::TableHeaderComponent::defaultFlags, 1);
+                                         juce::TableHeaderComponent::defaultFlags 
+                                         | juce::TableHeaderComponent::notSortable, 1);
     tableComponent.getHeader().addColumn("Delete", 5,
                                          50, 20, 70,
-                                         juce::TableHeaderComponent::defaultFlags);
+                                         juce::TableHeaderComponent::defaultFlags 
+                                         | juce::TableHeaderComponent::notSortable);
 
     tableComponent.setModel(this);
 
     addAndMakeVisible(addToLibraryBtn);
+    addAndMakeVisible(findDuplicatesBtn);
+    addAndMakeVisible(watchFolderBtn);
     addAndMakeVisible(searchBar);
+    addAndMakeVisible(keyFilterBox);
     addAndMakeVisible(tableComponent);
 
     addToLibraryBtn.addListener(this);
+    findDuplicatesBtn.addListener(this);
+    findDuplicatesBtn.setTooltip("Highlight tracks that are the same recording in different files.");
+    watchFolderBtn.addListener(this);
+    watchFolderBtn.setTooltip("Keep the library in step with a music folder as files are added, changed or removed.");
     searchBar.addListener(this);
 
+    keyFilterBox.addItem("All keys", 1);
+    keyFilterBox.addItem("Mixes with left deck", 2);
+    keyFilterBox.addItem("Mixes with right deck", 3);
+    keyFilterBox.setSelectedId(1, juce::NotificationType::dontSendNotification);
+    keyFilterBox.setTooltip("Show only the tracks whose key mixes harmonically with the track on a deck.");
+    keyFilterBox.addListener(this);
+    leftDeck->addChangeListener(this);
+    rightDeck->addChangeListener(this);
+
     searchBar.setTextToShowWhenEmpty("Search Tracks", juce::Colours::white);
+
+    // Start watching and analysing once the app has finished starting up, as the
+    // audio formats are registered after this component is created.
+    juce::Component::SafePointer<PlaylistComponent> safeThis{ this };
+
+    juce::MessageManager::callAsync([safeThis]()
+    {
+        if (safeThis != nullptr)
+        {
+            safeThis->startWatchingFolders(loadWatchedFolders());
+            safeThis->rehashLibrary();
+            safeThis->analyseLibrary();
+        }
+    });
 }
 
 PlaylistComponent::~PlaylistComponent()
 {
+    leftDeck->removeChangeListener(this);
+    rightDeck->removeChangeListener(this);
+    trackAnalyser.removeListener(this);
 } 
 
 void PlaylistComponent::paint (juce::Graphics& g)
@@ -69,18 +124,27 @@ void PlaylistComponent::resized()
     double rowH = getHeight() / 8.0;
     double rowW = getWidth() / 8.0;
     
-    searchBar.setBounds(5, 5, (rowW * 6) - 5, rowH);
+    searchBar.setBounds(5, 5, (rowW * 3) - 5, rowH);
     searchBar.setJustification(juce::Justification::centredLeft);
     addToLibraryBtn.setMouseCursor(juce::MouseCursor::PointingHandCursor);
     addToLibraryBtn.setColour(juce::TextButton::ColourIds::buttonColourId, 
                               juce::Colour::fromRGBA(102, 94, 199, 255));
     addToLibraryBtn.setBounds((rowW * 6) + 5, 5, (rowW * 2) - 10, rowH);
+    findDuplicatesBtn.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+    findDuplicatesBtn.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+    findDuplicatesBtn.setBounds((rowW * 5) + 5, 5, rowW - 5, rowH);
+    watchFolderBtn.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+    watchFolderBtn.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+    watchFolderBtn.setBounds((rowW * 4) + 5, 5, rowW - 5, rowH);
+    keyFilterBox.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+    keyFilterBox.setColour(juce::ComboBox::ColourIds::backgroundColourId, juce::Colours::black);
+    keyFilterBox.setBounds((rowW * 3) + 5, 5, rowW - 5, rowH);
     tableComponent.setBounds(0, rowH + 10, getWidth(), getHeight() - (rowH + 10));
 }
 
 int PlaylistComponent::getNumRows()
 {
-    return tracksToDisplay.size();
+    return (int) rowsToDisplay.size();
 }
 
 void PlaylistComponent::paintRowBackground(juce::Graphics& g,
@@ -97,6 +161,11 @@ void PlaylistComponent::paintRowBackground(juce::Graphics& g,
     {
         g.fillAll(juce::Colour::fromRGBA(102, 94, 199, 255));
     }
+    else if (rowNumber < getNumRows() && duplicateRecordings.count(getDisplayedTrack(rowNumber).id) > 0)
+    {
+        // Highlight tracks found to be the same recording as another track.
+        g.fillAll(juce::Colours::darkorange.withAlpha(0.35f));
+    }
     else if (rowNumber % 2)
     {
         g.fillAll(alternateColour);
@@ -117,7 +186,15 @@ void PlaylistComponent::paintCell(juce::Graphics& g,
     {
         if (columnId == 1)
         {
-            g.drawText(tracksToDisplay[rowNumber].title,
+            g.drawText(getDisplayedTrack(rowNumber).title,
+                5, 0,
+                width - 4, height,
+                juce::Justification::centredLeft,
+                true);
+        }
+        if (columnId == 6)
+        {
+            g.drawText(getDisplayedTrack(rowNumber).artist,
                 5, 0,
                 width - 4, height,
                 juce::Justification::centredLeft,
@@ -125,22 +202,92 @@ void PlaylistComponent::paintCell(juce::Graphics& g,
         }
         if (columnId == 2)
         {
-            g.drawText(tracksToDisplay[rowNumber].length,
+            g.drawText(getDisplayedTrack(rowNumber).getLengthText(),
             5, 0,
             width - 4, height,
             juce::Justification::centredLeft,
             true);
         }
+        if (columnId == 7 && store.getBpm(rowsToDisplay[rowNumber]) > 0.0f)
+        {
+            g.drawText(juce::String(store.getBpm(rowsToDisplay[rowNumber]), 1),
+                5, 0,
+                width - 4, height,
+                juce::Justification::centredLeft,
+                true);
+        }
+        if (columnId == 8)
+        {
+            // Keys are shown in Camelot notation; a tag that isn't a key is shown as it is.
+            int key = store.getKey(rowsToDisplay[rowNumber]);
+
+            g.drawText(key != CamelotKey::noKey ? CamelotKey::toString(key) : getDisplayedTrack(rowNumber).key,
+                5, 0,
+                width - 4, height,
+                juce::Justification::centredLeft,
+                true);
+        }
     }
     g.setColour(getLookAndFeel().findColour(juce::ListBox::backgroundColourId));
     g.fillRect(width - 1, 0, 1, height);
 }
 
+void PlaylistComponent::sortOrderChanged(int newSortColumnId, bool isForwards)
+{
+    TrackStore::SortColumn column;
+
+    switch (newSortColumnId)
+    {
+        case 1:  column = TrackStore::SortColumn::title;  break;
+        case 6:  column = TrackStore::SortColumn::artist; break;
+        case 2:  column = TrackStore::SortColumn::length; break;
+        case 7:  column = TrackStore::SortColumn::bpm;    break;
+        case 8:  column = TrackStore::SortColumn::key;    break;
+        default: return;
+    }
+
+    // The clicked column becomes the primary sort column and the previous
+    // ones break its ties, e.g. clicking "Title" then "Artist" sorts by
+    // artist and then by title.
+    auto sameColumn = std::find_if(sortKeys.begin(), sortKeys.end(), [column](const TrackStore::SortKey& sortKey)
+    {
+        return sortKey.column == column;
+    });
+
+    if (sameColumn != sortKeys.end())
+    {
+        sortKeys.erase(sameColumn);
+    }
+
+    sortKeys.insert(sortKeys.begin(), TrackStore::SortKey{ column, isForwards });
+
+    if (sortKeys.size() > maxSortColumns)
+    {
+        sortKeys.pop_back();
+    }
+
+    sortDisplayedRows();
+    tableComponent.updateContent();
+    tableComponent.repaint();
+}
+
 juce::Component* PlaylistComponent::refreshComponentForCell(int rowNumber,
                                                             int columnId,
                                                             bool isRowSelected,
                                                             juce::Component* existingComponentToUpdate)
 {
+    if (rowNumber >= getNumRows())
+    {
+        // Rows past the end of the table have no buttons.
+        if (existingComponentToUpdate != nullptr)
+        {
+            rowButtons.erase(static_cast<juce::Button*>(existingComponentToUpdate));
+            delete existingComponentToUpdate;
+        }
+
+        return 0;
+    }
+
     if (columnId == 3)
     {
         juce::TextButton* loadLeftBtn = (juce::TextButton*)existingComponentToUpdate;
@@ -150,8 +297,7 @@ juce::Component* PlaylistComponent::refreshComponentForCell(int rowNumber,
             loadLeftBtn = new juce::TextButton();
         }
         
-        juce::String id{ rowNumber };
-        loadLeftBtn->setComponentID(id);
+        rowButtons[loadLeftBtn] = { getDisplayedTrack(rowNumber).id, columnId };
         loadLeftBtn->setButtonText("<");
         loadLeftBtn->setMouseCursor(juce::MouseCursor::PointingHandCursor);
         loadLeftBtn->setColour(juce::TextButton::ColourIds::buttonColourId,
@@ -170,8 +316,7 @@ juce::Component* PlaylistComponent::refreshComponentForCell(int rowNumber,
             loadRightBtn = new juce::TextButton();
         }
         
-        juce::String id{ "0." + std::to_string(rowNumber) };
-        loadRightBtn->setComponentID(id);
+        rowButtons[loadRightBtn] = { getDisplayedTrack(rowNumber).id, columnId };
         loadRightBtn->setButtonText(">");
         loadRightBtn->setMouseCursor(juce::MouseCursor::PointingHandCursor);
         loadRightBtn->setColour(juce::TextButton::ColourIds::buttonColourId,
@@ -190,8 +335,7 @@ juce::Component* PlaylistComponent::refreshComponentForCell(int rowNumber,
             deleteTrackBtn = new juce::TextButton();
         }
         
-        juce::String id{ "X" + std::to_string(rowNumber) };
-        deleteTrackBtn->setComponentID(id);
+        rowButtons[deleteTrackBtn] = { getDisplayedTrack(rowNumber).id, columnId };
         deleteTrackBtn->setButtonText("X");
         deleteTrackBtn->setMouseCursor(juce::MouseCursor::PointingHandCursor);
         deleteTrackBtn->setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
@@ -215,71 +359,70 @@ void PlaylistComponent::buttonClicked(juce::Button* button)
         {
             for (const auto& result : chooser.getResults())
             {
-                juce::File songFile{ result };
-                juce::String songTitle = leftDeck->getSongTitle(songFile);
-                juce::String songLength = rightDeck->getSongLength(songFile);
-                juce::String songPath = juce::URL{ songFile }.toString(false);
+                importFile(result);
+            }
+        }
+    }
+    else if (button == &findDuplicatesBtn)
+    {
+        std::vector<AcousticFingerprinter::Candidate> candidates;
+        candidates.reserve(allRows.size());
 
-                if (playlistFileExists())
-                {
-                    // Append track data to playlist file and 
-                    // append the created track to tracksToDisplay vector.
-
-                    if (songIsDuplicate(songTitle) == false)
-                    {
-                        Track trackToAdd{ songTitle, songLength, songPath };
-                        fileProcessor.appendData(songTitle, songLength, songPath);
-                        tracksToDisplay.push_back(trackToAdd);
-                        allTracks.push_back(trackToAdd);
-                    }
-                }
-                else
-                {
-                    // Create file to store tracksToDisplay.
-                    fileProcessor.createPlaylistFile("playlist.txt");
-
-                    // Append track data to playlist file and 
-                    // append the created track to tracksToDisplay vector.
-                    Track trackToAdd{ songTitle, songLength, songPath };
-                    fileProcessor.appendData(songTitle, songLength, songPath);
-                    tracksToDisplay.push_back(trackToAdd);
-                    allTracks.push_back(trackToAdd);
-                }
+        for (juce::uint32 row : allRows)
+        {
+            const Track& track = store.getTrack(row);
+            candidates.push_back({ track.id, track.path });
+        }
 
-                tableComponent.updateContent();
-            }
+        findDuplicatesBtn.setButtonText("SEARCHING...");
+        fingerprinter.findDuplicates(std::move(candidates));
+    }
+    else if (button == &watchFolderBtn)
+    {
+        juce::FileChooser chooser{ "Watch a music folder..." };
+
+        if (chooser.browseForDirectory())
+        {
+            juce::Array<juce::File> folders = watcher.getFolders();
+            folders.addIfNotAlreadyThere(chooser.getResult());
+            saveWatchedFolders(folders);
+            startWatchingFolders(folders);
         }
     }
     else
     {
-        std::string componentID = button->getComponentID().toStdString();
+        // Find the track (and action) of the row button that was clicked.
+        auto rowButton = rowButtons.find(button);
+        juce::uint32 row;
 
-        if (componentID.find('.') != std::string::npos) // since it's not equal to no pos, it's found!
+        if (rowButton == rowButtons.end() || !store.findRow(rowButton->second.trackId, row))
         {
-            int start = componentID.find_first_of('.', 0);
-            int rightBtnId = std::stoi(componentID.substr(start+1));
-            juce::URL pathURL{ tracksToDisplay[rightBtnId].path };
-            rightDeck->loadTrack(tracksToDisplay[rightBtnId].title, 
-                                 tracksToDisplay[rightBtnId].length, 
-                                 pathURL);
+            return;
         }
-        if (componentID.find('X') != std::string::npos)
+
+        const Track& track = store.getTrack(row);
+
+        if (rowButton->second.columnId == 3)
         {
-            int start = componentID.find_first_of('X', 0);
-            int deleteTrackBtnId = std::stoi(componentID.substr(start + 1));
-            tracksToDisplay.erase(tracksToDisplay.begin() + deleteTrackBtnId);
-            allTracks.erase(allTracks.begin() + deleteTrackBtnId);
-            fileProcessor.deleteData(deleteTrackBtnId);
-            tableComponent.updateContent();
+            juce::URL pathURL{ track.path };
+            leftDeck->loadTrack(track.getDisplayName(), 
+                      track.getLengthText(), 
+                      pathURL,
+                      track.contentHash);
         }
-        else if (componentID.find('.') == std::string::npos && 
-                 componentID.find('X') == std::string::npos)
+        if (rowButton->second.columnId == 4)
         {
-            int leftBtnId = std::stoi(componentID);
-            juce::URL pathURL{ tracksToDisplay[leftBtnId].path };
-            leftDeck->loadTrack(tracksToDisplay[leftBtnId].title, 
-                      tracksToDisplay[leftBtnId].length, 
-                      pathURL);
+            juce::URL pathURL{ track.path };
+            rightDeck->loadTrack(track.getDisplayName(), 
+                                 track.getLengthText(), 
+                                 pathURL,
+                                 track.contentHash);
+        }
+        if (rowButton->second.columnId == 5)
+        {
+            removeTrack(row);
+            removeDeletedRows();
+            tableComponent.updateContent();
         }
     }
 }
@@ -288,29 +431,72 @@ void PlaylistComponent::textEditorTextChanged(juce::TextEditor& editor)
 {
     if (editor.isEmpty() == false)
     {
-        std::vector<Track> results;
-        juce::String keyword = editor.getText();
+        // The search runs in the background and streams its results
+        // to searchResultsArrived, so typing never waits for it.
+        searcher.setQuery(editor.getText());
+    }
+    else
+    {
+        searcher.cancelQuery();
+        showAllRows();
+        sortDisplayedRows();
+        tableComponent.updateContent();
+    }
+}
 
-        for (unsigned int i = 0; i < allTracks.size(); ++i)
-        {
-            juce::String songTitle{ allTracks[i].title };
-            songTitle = songTitle.toLowerCase();
-            keyword = keyword.toLowerCase();
+void PlaylistComponent::comboBoxChanged(juce::ComboBox* comboBoxThatHasChanged)
+{
+    if (comboBoxThatHasChanged == &keyFilterBox)
+    {
+        updateKeyFilter();
+    }
+}
 
-            if (songTitle.startsWith(keyword))
-            {
-                results.push_back(allTracks[i]);
-            }
+void PlaylistComponent::changeListenerCallback(juce::ChangeBroadcaster* source)
+{
+    if (keyFilterDeck != nullptr && source == keyFilterDeck)
+    {
+        updateKeyFilter();
+    }
+}
+
+void PlaylistComponent::searchResultsArrived(const std::vector<juce::uint32>& rows, bool isFirstChunk, bool isLastChunk)
+{
+    if (isFirstChunk)
+    {
+        rowsToDisplay.clear();
+    }
+
+    for (juce::uint32 row : rows)
+    {
+        // Skip tracks deleted while the search was running.
+        if (store.isAlive(row) && isShownByKeyFilter(row))
+        {
+            rowsToDisplay.push_back(row);
         }
+    }
 
-        tracksToDisplay = results;
-        tableComponent.updateContent();
+    // Results arrive best match first; once they are all in, apply the chosen sort.
+    if (isLastChunk)
+    {
+        sortDisplayedRows();
     }
-    else
+
+    tableComponent.updateContent();
+    tableComponent.repaint();
+}
+
+void PlaylistComponent::duplicateRecordingsFound(const std::vector<std::vector<TrackId>>& groups)
+{
+    duplicateRecordings.clear();
+
+    for (const auto& group : groups)
     {
-        tracksToDisplay = allTracks;
-        tableComponent.updateContent();
+        duplicateRecordings.insert(group.begin(), group.end());
     }
+
+    findDuplicatesBtn.setButtonText("FIND DUPLICATES");
+    tableComponent.repaint();
 }
 
 bool PlaylistComponent::isInterestedInFileDrag(const juce::StringArray& files)
@@ -322,38 +508,185 @@ void PlaylistComponent::filesDropped(const juce::StringArray& files, int x, int
 {
     for (const auto& file : files)
     {
-        juce::File songFile{ file };
-        juce::String songTitle = leftDeck->getSongTitle(songFile);
-        juce::String songLength = rightDeck->getSongLength(songFile);
-        juce::String songPath = juce::URL{ songFile }.toString(false);
+        importFile(juce::File{ file });
+    }
+}
 
-        if (playlistFileExists())
+void PlaylistComponent::watchedFolderScanned(const juce::File& folder,
+                                             const std::vector<LibraryWatcher::FileState>& files)
+{
+    std::unordered_set<TrackId> idsOnDisk;
+    idsOnDisk.reserve(files.size());
+
+    for (const auto& file : files)
+    {
+        idsOnDisk.insert(Track::createId(juce::URL{ file.file }.toString(false)));
+    }
+
+    // Remove the tracks of this folder whose files went away while the app wasn't running.
+    juce::String folderPath = juce::URL{ folder }.toString(false) + "/";
+
+    for (juce::uint32 row : allRows)
+    {
+        const Track& track = store.getTrack(row);
+
+        if (track.path.startsWith(folderPath) && idsOnDisk.count(track.id) == 0)
+        {
+            removeTrack(row);
+        }
+    }
+
+    for (const auto& file : files)
+    {
+        updateTrackFromDisk(file);
+    }
+
+    finishLibraryUpdate();
+}
+
+void PlaylistComponent::watchedFilesChanged(const std::vector<LibraryWatcher::FileState>& changes)
+{
+    juce::StringArray removedPaths;
+
+    for (const auto& change : changes)
+    {
+        if (change.exists)
+        {
+            updateTrackFromDisk(change);
+        }
+        else
         {
-            // Append track data to playlist file and append the created track to tracksToDisplay vector.
-            unsigned int songID = allTracks.size();
+            removedPaths.add(juce::URL{ change.file }.toString(false));
+        }
+    }
 
-            if (songIsDuplicate(songTitle) == false)
+    if (!removedPaths.isEmpty())
+    {
+        // A removed path may be a folder, so remove the tracks under it too.
+        for (juce::uint32 row : allRows)
+        {
+            const Track& track = store.getTrack(row);
+
+            if (!store.isAlive(row))
             {
-                Track trackToAdd{ songTitle, songLength, songPath };
-                fileProcessor.appendData(songTitle, songLength, songPath);
-                tracksToDisplay.push_back(trackToAdd);
-                allTracks.push_back(trackToAdd);
+                continue;
+            }
+
+            for (const auto& removedPath : removedPaths)
+            {
+                if (track.path == removedPath || track.path.startsWith(removedPath + "/"))
+                {
+                    removeTrack(row);
+                    break;
+                }
             }
         }
-        else
+    }
+
+    finishLibraryUpdate();
+}
+
+void PlaylistComponent::tracksAnalysed(const std::vector<TrackAnalyser::Result>& results)
+{
+    std::vector<PlaylistFileProcessor::AnalysisUpdate> updates;
+    std::vector<juce::uint32> rows;
+    const juce::uint32 analysisVersion = TrackAnalyser::getAnalysisVersion();
+
+    for (const auto& result : results)
+    {
+        // Every copy of the track gets the results, as they share its contents.
+        store.findRowsByContent(result.contentHash, rows);
+
+        for (juce::uint32 row : rows)
         {
-            // Create file to store tracksToDisplay.
-            fileProcessor.createPlaylistFile("playlist.txt");
-
-            // Append track data to playlist file and append the created track to tracksToDisplay vector.
-            unsigned int songID = allTracks.size();
-            Track trackToAdd{ songTitle, songLength, songPath };
-            fileProcessor.appendData(songTitle, songLength, songPath);
-            tracksToDisplay.push_back(trackToAdd);
-            allTracks.push_back(trackToAdd);
+            if (store.setAnalysis(row, (float) result.beatGrid.bpm, result.key.key, analysisVersion))
+            {
+                updates.push_back({ store.getTrack(row).id, (float) result.beatGrid.bpm, result.key.key, analysisVersion });
+            }
         }
+    }
 
-        tableComponent.updateContent();
+    if (updates.empty())
+    {
+        return;
+    }
+
+    // The whole batch is journalled with one append, rather than rewriting the file.
+    fileProcessor.appendAnalysis(updates);
+    tableComponent.repaint();
+
+    // The harmonic filter and the BPM and key orders may have changed too, but results keep
+    // arriving while the library is analysed, so the table is re-sorted at most once in a while
+    // rather than moving rows around under the user with every batch.
+    if (!isTimerRunning())
+    {
+        startTimer(resortIntervalMs);
+    }
+}
+
+void PlaylistComponent::tracksRead(const std::vector<Track>& tracks)
+{
+    if (!playlistFileExists())
+    {
+        // Create file to store the library.
+        fileProcessor.createPlaylistFile("playlist.txt");
+    }
+
+    std::vector<Track> tracksToAdd;
+
+    for (const auto& track : tracks)
+    {
+        juce::uint32 row;
+        bool isReplacement = false;
+
+        if (store.findRow(track.id, row))
+        {
+            const Track& oldTrack = store.getTrack(row);
+
+            // The file may have been queued twice, or changed back, before it was read. A track
+            // without a content hash was queued to be hashed again, so it is always replaced.
+            if (oldTrack.contentHash != 0 && oldTrack.fileSize == track.fileSize
+                && oldTrack.modificationTime == track.modificationTime)
+            {
+                continue;
+            }
+
+            removeTrack(row);
+            isReplacement = true;
+        }
+
+        // Only new files are left out as copies; a track already in the library stays in it.
+        if (!isReplacement && store.findRowByContent(track.contentHash, row))
+        {
+            continue;
+        }
+
+        tracksToAdd.push_back(track);
+        addTrackToLibrary(track);
+        trackAnalyser.analyseTrack(juce::URL{ track.path }, track.contentHash, AnalysisScheduler::Priority::background);
+    }
+
+    // Append the whole batch to the playlist file at once.
+    if (!tracksToAdd.empty())
+    {
+        fileProcessor.appendData(tracksToAdd);
+    }
+
+    finishLibraryUpdate();
+}
+
+void PlaylistComponent::timerCallback()
+{
+    stopTimer();
+
+    if (keyFilterDeck != nullptr)
+    {
+        updateKeyFilter();
+    }
+    else
+    {
+        sortDisplayedRows();
+        tableComponent.repaint();
     }
 }
 
@@ -394,15 +727,213 @@ std::string PlaylistComponent::getPlaylistFilePath()
     return filePath;
 }
 
-bool PlaylistComponent::songIsDuplicate(juce::String songTitle)
+void PlaylistComponent::importFile(const juce::File& songFile)
+{
+    juce::uint32 existingRow;
+
+    // Copies of files already in the library are only caught once the file has been read.
+    if (!store.findRow(Track::createId(juce::URL{ songFile }.toString(false)), existingRow))
+    {
+        importer.importFile(songFile);
+    }
+}
+
+void PlaylistComponent::addTrackToLibrary(const Track& track)
+{
+    juce::uint32 row = store.add(track);
+    allRows.push_back(row);
+
+    // While searching, the searcher decides whether the track is shown.
+    if (searchBar.isEmpty() && isShownByKeyFilter(row))
+    {
+        rowsToDisplay.push_back(row);
+    }
+}
+
+void PlaylistComponent::updateTrackFromDisk(const LibraryWatcher::FileState& state)
 {
-    for (const auto& song : allTracks)
+    juce::uint32 row;
+
+    if (store.findRow(Track::createId(juce::URL{ state.file }.toString(false)), row))
     {
-        if (song.title == songTitle)
+        const Track& track = store.getTrack(row);
+
+        // Only files whose size or modification time changed are read again.
+        if (track.fileSize == state.size && track.modificationTime == state.modificationTime)
         {
-            return true;
+            return;
         }
     }
 
-    return false;
+    // The old track stays in the library until the file has been read again.
+    importer.importFile(state.file);
+}
+
+void PlaylistComponent::removeTrack(juce::uint32 row)
+{
+    TrackId id = store.getTrack(row).id;
+    store.remove(row);
+    fileProcessor.deleteData(id);
+}
+
+void PlaylistComponent::removeDeletedRows()
+{
+    auto isDeleted = [this](juce::uint32 row)
+    {
+        return !store.isAlive(row);
+    };
+
+    allRows.erase(std::remove_if(allRows.begin(), allRows.end(), isDeleted), allRows.end());
+    rowsToDisplay.erase(std::remove_if(rowsToDisplay.begin(), rowsToDisplay.end(), isDeleted), rowsToDisplay.end());
+}
+
+void PlaylistComponent::finishLibraryUpdate()
+{
+    removeDeletedRows();
+    sortDisplayedRows();
+    tableComponent.updateContent();
+    searcher.libraryChanged();
+}
+
+juce::Array<juce::File> PlaylistComponent::loadWatchedFolders()
+{
+    juce::StringArray lines;
+    juce::File{ getPlaylistFilePath() }.getSiblingFile("watched_folders.txt").readLines(lines);
+
+    juce::Array<juce::File> folders;
+
+    for (const auto& line : lines)
+    {
+        if (juce::File::isAbsolutePath(line.trim()))
+        {
+            folders.add(juce::File{ line.trim() });
+        }
+    }
+
+    return folders;
+}
+
+void PlaylistComponent::saveWatchedFolders(const juce::Array<juce::File>& folders)
+{
+    juce::StringArray lines;
+
+    for (const auto& folder : folders)
+    {
+        lines.add(folder.getFullPathName());
+    }
+
+    juce::File{ getPlaylistFilePath() }.getSiblingFile("watched_folders.txt")
+                                     .replaceWithText(lines.joinIntoString("\n"));
+}
+
+void PlaylistComponent::startWatchingFolders(const juce::Array<juce::File>& folders)
+{
+    watcher.watchFolders(folders, formatManager.getWildcardForAllFormats());
+}
+
+void PlaylistComponent::rehashLibrary()
+{
+    // Tracks stored without a content hash (or with one from an older version) are read again
+    // in the background, so duplicates are caught and analysis results can be found for them.
+    // Missing files are dropped by the import job, so the disk isn't touched here.
+    for (juce::uint32 row : allRows)
+    {
+        const Track& track = store.getTrack(row);
+
+        if (track.contentHash == 0 && juce::URL{ track.path }.isLocalFile())
+        {
+            importer.importFile(juce::URL{ track.path }.getLocalFile());
+        }
+    }
+}
+
+void PlaylistComponent::analyseLibrary()
+{
+    // Tracks whose results the library already has from the current analysers are left alone,
+    // so a launch doesn't queue (and read the cache for) the whole library again.
+    for (juce::uint32 row : allRows)
+    {
+        const Track& track = store.getTrack(row);
+
+        if (track.contentHash != 0 && store.getAnalysisVersion(row) != TrackAnalyser::getAnalysisVersion())
+        {
+            trackAnalyser.analyseTrack(juce::URL{ track.path }, track.contentHash, AnalysisScheduler::Priority::background);
+        }
+    }
+}
+
+int PlaylistComponent::getDeckKey(const DeckGUI* deck) const
+{
+    juce::uint32 row;
+
+    if (store.findRowByContent(deck->getLoadedContentHash(), row) && store.getKey(row) != CamelotKey::noKey)
+    {
+        return store.getKey(row);
+    }
+
+    return deck->getLoadedKey();
+}
+
+void PlaylistComponent::updateKeyFilter()
+{
+    switch (keyFilterBox.getSelectedId())
+    {
+        case 2:  keyFilterDeck = leftDeck;  break;
+        case 3:  keyFilterDeck = rightDeck; break;
+        default: keyFilterDeck = nullptr;   break;
+    }
+
+    // A deck without a known key mixes with nothing, so the table is empty until it is analysed.
+    compatibleKeys = keyFilterDeck != nullptr ? CamelotKey::getCompatibleKeys(getDeckKey(keyFilterDeck)) : 0;
+
+    if (searchBar.isEmpty())
+    {
+        showAllRows();
+        sortDisplayedRows();
+        tableComponent.updateContent();
+        tableComponent.repaint();
+    }
+    else
+    {
+        // The search runs again, and its results are filtered as they arrive.
+        searcher.setQuery(searchBar.getText());
+    }
+}
+
+bool PlaylistComponent::isShownByKeyFilter(juce::uint32 row) const
+{
+    if (keyFilterDeck == nullptr)
+    {
+        return true;
+    }
+
+    int key = store.getKey(row);
+
+    return key != CamelotKey::noKey && (compatibleKeys & (1u << key)) != 0;
+}
+
+void PlaylistComponent::showAllRows()
+{
+    rowsToDisplay.clear();
+
+    for (juce::uint32 row : allRows)
+    {
+        if (isShownByKeyFilter(row))
+        {
+            rowsToDisplay.push_back(row);
+        }
+    }
+}
+
+void PlaylistComponent::sortDisplayedRows()
+{
+    if (!sortKeys.empty())
+    {
+        store.sortRows(rowsToDisplay, sortKeys);
+    }
+}
+
+const Track& PlaylistComponent::getDisplayedTrack(int rowNumber) const
+{
+    return store.getTrack(rowsToDisplay[rowNumber]);
 }
\ No newline at end of file
@@ -15,8 +15,19 @@
 #include "DeckGUI.h"
 #include "PlaylistFileProcessor.h"
 #include "Track.h"
+#include "TrackStore.h"
+#include "TrackSearcher.h"
+#include "AcousticFingerprinter.h"
+#include "TrackImporter.h"
+#include "LibraryWatcher.h"
+#include "AnalysisScheduler.h"
+#include "TrackAnalyser.h"
+#include "CamelotKey.h"
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 
 //==============================================================================
 /*
@@ -25,16 +36,29 @@ class PlaylistComponent  : public juce::Component,
                            public juce::TableListBoxModel,
                            public juce::Button::Listener,
                            public juce::TextEditor::Listener,
-                           public juce::FileDragAndDropTarget
+                           public juce::ComboBox::Listener,
+                           public juce::ChangeListener,
+                           public juce::FileDragAndDropTarget,
+                           public juce::Timer,
+                           public TrackSearcher::Listener,
+                           public AcousticFingerprinter::Listener,
+                           public LibraryWatcher::Listener,
+                           public TrackAnalyser::Listener,
+                           public TrackImporter::Listener
 {
     public:
         /**
         * PURPOSE: Creates the PlaylistComponent object, loads the music library database if existent, 
         *          and initialises its data members (including adding listeners and setting the table headers).
-        * INPUTS: A reference to the juce AudioFormatManager and pointers to both decks.
+        * INPUTS: A reference to the juce AudioFormatManager, references to the AnalysisScheduler and
+        *         TrackAnalyser that run background work, and pointers to both decks.
         * OUTPUTS: None.
         */
-        PlaylistComponent(juce::AudioFormatManager& _formatManager, DeckGUI* deckGUI1, DeckGUI* deckGUI2);
+        PlaylistComponent(juce::AudioFormatManager& _formatManager,
+                          AnalysisScheduler& _analysisScheduler,
+                          TrackAnalyser& _trackAnalyser,
+                          DeckGUI* deckGUI1,
+                          DeckGUI* deckGUI2);
         
         /**
         * PURPOSE: Destroys the PlaylistComponent object.
@@ -93,6 +117,15 @@ class PlaylistComponent  : public juce::Component,
                        int height, 
                        bool rowIsSelected) override;
 
+        /**
+        * PURPOSE: Sorts the table when a column header is clicked. Earlier sort columns are kept
+        *          (up to three) to break ties in the new one.
+        *          Overrides juce TableListBoxModel virtual member function.
+        * INPUTS: The column id of the clicked header and a boolean; true for ascending order.
+        * OUTPUTS: None.
+        */
+        void sortOrderChanged(int newSortColumnId, bool isForwards) override;
+
         /**
         * PURPOSE: Creates or updates a custom component to go in a cell.
         *          Overrides juce TableListBoxModel virtual member function.
@@ -119,6 +152,40 @@ class PlaylistComponent  : public juce::Component,
         */
         void textEditorTextChanged(juce::TextEditor& editor);
 
+        /**
+        * PURPOSE: Shows only the tracks that mix harmonically with the chosen deck, or all tracks.
+        *          Implements juce ComboBox::Listener (i.e. function is pure virtual).
+        * INPUTS: A pointer to the juce combo box that had its selection changed.
+        * OUTPUTS: None.
+        */
+        void comboBoxChanged(juce::ComboBox* comboBoxThatHasChanged) override;
+
+        /**
+        * PURPOSE: Updates the harmonic filter when the deck it follows loads or analyses a track.
+        *          Implements juce ChangeListener (i.e. function is pure virtual).
+        * INPUTS: A pointer to the deck that sent the change message.
+        * OUTPUTS: None.
+        */
+        void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
+        /**
+        * PURPOSE: Receives a chunk of search results from the background searcher and shows it in the table.
+        *          Implements TrackSearcher::Listener (i.e. function is pure virtual).
+        * INPUTS: The store rows that match the search, a boolean that is true for the first
+        *         chunk of a search and a boolean that is true for its last chunk.
+        * OUTPUTS: None.
+        */
+        void searchResultsArrived(const std::vector<juce::uint32>& rows, bool isFirstChunk, bool isLastChunk) override;
+
+        /**
+        * PURPOSE: Receives the tracks that the background duplicate search found to be the
+        *          same recording and highlights them in the table.
+        *          Implements AcousticFingerprinter::Listener (i.e. function is pure virtual).
+        * INPUTS: Groups of IDs of tracks that are the same recording.
+        * OUTPUTS: None.
+        */
+        void duplicateRecordingsFound(const std::vector<std::vector<TrackId>>& groups) override;
+
         /**
         * PURPOSE: Callback to check whether this target is interested in the set of files being offered.
         *          Implements juce FileDragAndDropTarget (i.e. function is pure virtual).
@@ -138,6 +205,48 @@ class PlaylistComponent  : public juce::Component,
         */
         void filesDropped(const juce::StringArray& files, int x, int y) override;
 
+        /**
+        * PURPOSE: Brings the library in step with a watched folder when watching starts: tracks whose
+        *          files are gone are removed, and new or changed files are (re)imported.
+        *          Implements LibraryWatcher::Listener (i.e. function is pure virtual).
+        * INPUTS: The watched folder and the music files in it.
+        * OUTPUTS: None.
+        */
+        void watchedFolderScanned(const juce::File& folder, const std::vector<LibraryWatcher::FileState>& files) override;
+
+        /**
+        * PURPOSE: Updates the library for files that were added, changed or removed in a watched folder.
+        *          Implements LibraryWatcher::Listener (i.e. function is pure virtual).
+        * INPUTS: The changed files.
+        * OUTPUTS: None.
+        */
+        void watchedFilesChanged(const std::vector<LibraryWatcher::FileState>& changes) override;
+
+        /**
+        * PURPOSE: Stores the detected BPM and key of analysed tracks in the library, where they are used
+        *          if the tracks' tags don't give them. A batch of results is journalled to the playlist file
+        *          with one append. Implements TrackAnalyser::Listener (i.e. function is pure virtual).
+        * INPUTS: The results of the analyses.
+        * OUTPUTS: None.
+        */
+        void tracksAnalysed(const std::vector<TrackAnalyser::Result>& results) override;
+
+        /**
+        * PURPOSE: Adds the tracks read from imported files to the library, creating the playlist file
+        *          if it doesn't exist yet. A changed file replaces its track, and a new file whose
+        *          contents are already in the library is left out. Implements TrackImporter::Listener (i.e. function is pure virtual).
+        * INPUTS: The tracks read from the files.
+        * OUTPUTS: None.
+        */
+        void tracksRead(const std::vector<Track>& tracks) override;
+
+        /**
+        * PURPOSE: Re-sorts and re-filters the table after analysis results have come in. Implements juce Timer.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void timerCallback() override;
+
     private:
         /**
         * PURPOSE: Checks if there is already a music library database stored as a file.
@@ -154,28 +263,172 @@ class PlaylistComponent  : public juce::Component,
         static std::string getPlaylistFilePath();
 
         /**
-        * PURPOSE: Checks the song title against all the titles in the
-        *          music library to determine if it is a duplicate.
-        * INPUTS: The title of the song as a juce string.
-        * OUTPUTS: A boolean. True if the song is a duplicate and false if it isn't.
+        * PURPOSE: Queues a music file to be read into the library in the background, unless its path
+        *          is already in it. The track is added when it arrives in tracksRead().
+        * INPUTS: The music file to be imported.
+        * OUTPUTS: None.
+        */
+        void importFile(const juce::File& songFile);
+
+        /**
+        * PURPOSE: Adds a track to the track store and to the rows of the library and the table.
+        * INPUTS: The track to be added.
+        * OUTPUTS: None.
+        */
+        void addTrackToLibrary(const Track& track);
+
+        /**
+        * PURPOSE: Queues a file found in a watched folder to be read in the background, unless it is already
+        *          in the library with the same size and modification time. A changed file replaces its track.
+        * INPUTS: The state of the file on disk.
+        * OUTPUTS: None.
         */
-        bool songIsDuplicate(juce::String songTitle);
+        void updateTrackFromDisk(const LibraryWatcher::FileState& state);
 
+        /**
+        * PURPOSE: Deletes a track from the track store and the playlist file. The rows of the
+        *          library and the table are updated by removeDeletedRows().
+        * INPUTS: The store row of the track.
+        * OUTPUTS: None.
+        */
+        void removeTrack(juce::uint32 row);
+
+        /**
+        * PURPOSE: Removes the rows of deleted tracks from the rows of the library and the table.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void removeDeletedRows();
+
+        /**
+        * PURPOSE: Refreshes the rows of the library, the table and any search in progress
+        *          after tracks were added or removed.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void finishLibraryUpdate();
+
+        /**
+        * PURPOSE: Reads the list of watched folders stored next to the playlist file.
+        * INPUTS: None.
+        * OUTPUTS: The watched folders.
+        */
+        static juce::Array<juce::File> loadWatchedFolders();
+
+        /**
+        * PURPOSE: Stores the list of watched folders next to the playlist file.
+        * INPUTS: The watched folders.
+        * OUTPUTS: None.
+        */
+        static void saveWatchedFolders(const juce::Array<juce::File>& folders);
+
+        /**
+        * PURPOSE: Starts watching the given music folders for changes.
+        * INPUTS: The folders to be watched.
+        * OUTPUTS: None.
+        */
+        void startWatchingFolders(const juce::Array<juce::File>& folders);
+
+        /**
+        * PURPOSE: Queues the tracks of the library that have no content hash to be read again, which
+        *          replaces them with tracks that have one.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void rehashLibrary();
+
+        /**
+        * PURPOSE: Queues the tracks of the library that have no results from the current analysers
+        *          for background analysis.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void analyseLibrary();
+
+        /**
+        * PURPOSE: Gets the key of the track loaded on a deck: the key in the library if the track
+        *          is in it, otherwise the key the deck's analysis found.
+        * INPUTS: The deck.
+        * OUTPUTS: The key as a CamelotKey index, or CamelotKey::noKey if it isn't known.
+        */
+        int getDeckKey(const DeckGUI* deck) const;
+
+        /**
+        * PURPOSE: Works out the keys the harmonic filter lets through from the key of its deck,
+        *          and filters the table again.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void updateKeyFilter();
+
+        /**
+        * PURPOSE: Checks if a track passes the harmonic filter. Runs in constant time.
+        * INPUTS: The store row of the track.
+        * OUTPUTS: A boolean; true if the track is shown and false if it is filtered out.
+        */
+        bool isShownByKeyFilter(juce::uint32 row) const;
+
+        /**
+        * PURPOSE: Shows every track of the library that passes the harmonic filter, as when not searching.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void showAllRows();
+
+        /**
+        * PURPOSE: Sorts the rows shown in the table by the chosen sort columns, if any.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void sortDisplayedRows();
+
+        /**
+        * PURPOSE: Gets the track shown in a row of the table.
+        * INPUTS: The row number in the table.
+        * OUTPUTS: A reference to the track.
+        */
+        const Track& getDisplayedTrack(int rowNumber) const;
+
+
+        /** The track and column of a button shown in a row of the table. */
+        struct RowButton
+        {
+            TrackId trackId;
+            int columnId;
+        };
 
         /** DATA MEMBERS */
 
+        static constexpr size_t maxSortColumns = 3;
+        static constexpr int resortIntervalMs = 2000;
+
         juce::TextButton addToLibraryBtn{ "+ ADD TO LIBRARY" };
+        juce::TextButton findDuplicatesBtn{ "FIND DUPLICATES" };
+        juce::TextButton watchFolderBtn{ "WATCH FOLDER" };
         juce::TextEditor searchBar { "Search", 0 };
-        std::vector<Track> tracksToDisplay;
-        std::vector<Track> allTracks;
+        juce::ComboBox keyFilterBox;
+        TrackStore store;
+        std::vector<juce::uint32> rowsToDisplay;
+        std::vector<juce::uint32> allRows;
+        std::unordered_map<juce::Button*, RowButton> rowButtons;
+        std::unordered_set<TrackId> duplicateRecordings;
+        std::vector<TrackStore::SortKey> sortKeys;
+        const DeckGUI* keyFilterDeck = nullptr;
+        juce::uint32 compatibleKeys = 0;
 
         juce::TableListBox tableComponent;
         juce::AudioFormatManager& formatManager;
+        AnalysisScheduler& analysisScheduler;
+        TrackAnalyser& trackAnalyser;
 
         DJAudioPlayer* player;
         DeckGUI* leftDeck;
         DeckGUI* rightDeck;
         PlaylistFileProcessor fileProcessor;
+        TrackImporter importer{ formatManager, analysisScheduler, *this };
+        TrackSearcher searcher{ store, *this };
+        AcousticFingerprinter fingerprinter{ formatManager, analysisScheduler, *this };
+        LibraryWatcher watcher{ *this };
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PlaylistComponent)
 };
\ No newline at end of file
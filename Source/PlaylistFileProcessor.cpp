@@ -9,6 +9,8 @@
 */
 
 #include "PlaylistFileProcessor.h"
+#include "CamelotKey.h"
+#include <algorithm>
 
 PlaylistFileProcessor::PlaylistFileProcessor()
 {
@@ -51,37 +53,126 @@ std::vector<Track> PlaylistFileProcessor::loadData(std::string filePath)
     playlistFilePath = filePath;
 
     std::vector<Track> tracks;
-    std::ifstream playlistFile{filePath};
-    std::string line;
+    std::vector<bool> deleted;
+    std::unordered_map<TrackId, size_t> indexById;
+    int numDeletions = 0;
+    int numAnalysisUpdates = 0;
+    int numBadLines = 0;
 
-    if (playlistFile.is_open())
     {
-        while (std::getline(playlistFile, line))
+        // Map the whole file into memory and split its lines in place, without copying them.
+        juce::MemoryMappedFile mappedFile{ juce::File{ filePath }, juce::MemoryMappedFile::readOnly };
+        const char* data = static_cast<const char*>(mappedFile.getData());
+        const char* end = data + mappedFile.getSize();
+
+        if (data != nullptr)
         {
-            try
+            size_t numLines = (size_t) std::count(data, end, '\n') + 1;
+            tracks.reserve(numLines);
+            deleted.reserve(numLines);
+            indexById.reserve(numLines);
+
+            Field fields[maxFieldsPerLine + 1];
+            const char* lineStart = data;
+
+            while (lineStart < end)
             {
-                Track newTrack = stringsToTrack(tokenise(line, '|'));
-                tracks.push_back(newTrack);
+                auto* lineEnd = static_cast<const char*>(memchr(lineStart, '\n', (size_t) (end - lineStart)));
+                lineEnd = lineEnd != nullptr ? lineEnd : end;
+
+                int numFields = splitLine(lineStart, lineEnd, fields);
+                lineStart = lineEnd + 1;
+
+                TrackId deletedId;
+                AnalysisUpdate analysisUpdate;
+                LineType lineType = parseLine(fields, numFields, tracks, deletedId, analysisUpdate);
+
+                if (lineType == LineType::deletion)
+                {
+                    // Replay the deletion of an earlier line.
+                    auto it = indexById.find(deletedId);
+
+                    if (it != indexById.end())
+                    {
+                        deleted[it->second] = true;
+                        indexById.erase(it);
+                    }
+
+                    numDeletions++;
+                }
+                else if (lineType == LineType::analysis)
+                {
+                    // Replay analysis results found after the track's line was written.
+                    auto it = indexById.find(analysisUpdate.id);
+
+                    if (it != indexById.end())
+                    {
+                        Track& track = tracks[it->second];
+                        track.detectedBpm = analysisUpdate.detectedBpm;
+                        track.detectedKey = analysisUpdate.detectedKey;
+                        track.analysisVersion = analysisUpdate.analysisVersion;
+                    }
+
+                    numAnalysisUpdates++;
+                }
+                else if (lineType == LineType::track)
+                {
+                    // Keep only the first line of each track.
+                    if (indexById.emplace(tracks.back().id, tracks.size() - 1).second)
+                    {
+                        deleted.push_back(false);
+                    }
+                    else
+                    {
+                        tracks.pop_back();
+                    }
+                }
+                else if (lineType == LineType::bad)
+                {
+                    numBadLines++;
+                }
             }
-            catch (const std::exception& e)
+        }
+        else
+        {
+            DBG("Playlist file not open.");
+        }
+    }
+
+    if (numBadLines > 0)
+    {
+        DBG("PlaylistFileProcessor::loadData skipped " << numBadLines << " bad lines");
+    }
+
+    if (numDeletions > 0)
+    {
+        std::vector<Track> remainingTracks;
+        remainingTracks.reserve(tracks.size());
+
+        for (size_t i = 0; i < tracks.size(); ++i)
+        {
+            if (!deleted[i])
             {
-                DBG("PlaylistFileProcessor::loadData bad data");
+                remainingTracks.push_back(std::move(tracks[i]));
             }
         }
 
-        playlistFile.close();
+        tracks.swap(remainingTracks);
     }
-    else
+
+    // The journal is replayed cheaply on every load, so the whole file is only rewritten
+    // once the journal makes up a good part of it.
+    const juce::int64 numJournalLines = numDeletions + numAnalysisUpdates;
+
+    if (numJournalLines > 0 && numJournalLines * tracksPerJournalLine >= (juce::int64) tracks.size())
     {
-        DBG("Playlist file not open.");
+        rewriteData(tracks);
     }
 
     return tracks;
 }
 
-void PlaylistFileProcessor::appendData(juce::String title,
-                                       juce::String length, 
-                                       juce::String path)
+void PlaylistFileProcessor::appendData(const Track& track)
 {
     mStream.open(playlistFilePath, std::fstream::app);
 
@@ -91,77 +182,412 @@ void PlaylistFileProcessor::appendData(juce::String title,
         throw std::iostream::failure("Cannot append to file " + playlistFilePath);
     }
 
-    mStream << title << "|" << length << "|" << path << std::endl;
+    writeTrack(mStream, track);
     mStream.close();
 }
 
-std::vector<std::string> PlaylistFileProcessor::tokenise(std::string line, char separator)
+void PlaylistFileProcessor::appendData(const std::vector<Track>& tracks)
 {
-    std::vector<std::string> tokens;
-    signed int start;
-    signed int end;
-    std::string token;
+    mStream.open(playlistFilePath, std::fstream::app);
 
-    start = line.find_first_not_of(separator, 0);
-    do {
-        end = line.find_first_of(separator, start);
+    if (mStream.fail())
+    {
+        // Throw error if file doesn't open.
+        throw std::iostream::failure("Cannot append to file " + playlistFilePath);
+    }
 
-        if (start == line.length() || start == end) break;
-        if (end >= 0) token = line.substr(start, end - start);
-        else token = line.substr(start, line.length() - start);
-        
-        tokens.push_back(token);
-        start = end + 1;
-    } while (end > 0);
+    for (const Track& track : tracks)
+    {
+        writeTrack(mStream, track);
+    }
 
-    return tokens;
+    mStream.close();
 }
 
-Track PlaylistFileProcessor::stringsToTrack(std::vector<std::string> tokens)
+int PlaylistFileProcessor::splitLine(const char* start, const char* end, Field* fields)
 {
-    if (tokens.size() != 3) // bad
+    // Lines written on Windows end with "\r\n".
+    if (end > start && end[-1] == '\r')
     {
-        DBG("Bad line ");
-        throw std::exception{};
+        --end;
     }
 
-    // We have 3 tokens.
-    Track newTrack{tokens[0], tokens[1], tokens[2]};
+    if (start == end)
+    {
+        return 0;
+    }
 
-    return newTrack;
+    int numFields = 0;
+
+    for (;;)
+    {
+        auto* separator = static_cast<const char*>(memchr(start, '|', (size_t) (end - start)));
+        const char* fieldEnd = separator != nullptr ? separator : end;
+
+        if (numFields > maxFieldsPerLine)
+        {
+            return numFields; // too many fields, i.e. a bad line
+        }
+
+        fields[numFields++] = { start, (size_t) (fieldEnd - start) };
+
+        if (separator == nullptr)
+        {
+            return numFields;
+        }
+
+        start = separator + 1;
+    }
 }
 
-void PlaylistFileProcessor::deleteData(int lineNumber)
+PlaylistFileProcessor::LineType PlaylistFileProcessor::parseLine(const Field* fields,
+                                                                 int numFields,
+                                                                 std::vector<Track>& tracks,
+                                                                 TrackId& deletedId,
+                                                                 AnalysisUpdate& analysisUpdate)
 {
-    std::ifstream playlistFile{ playlistFilePath };
-    std::string line;
-    int lineNum = 0;
-    std::vector<std::string> tempPlaylist;
+    if (numFields == 0)
+    {
+        return LineType::empty;
+    }
+
+    if (numFields == 2 && fields[0].length == 1 && fields[0].data[0] == '-')
+    {
+        return parseHex(fields[1], deletedId) ? LineType::deletion : LineType::bad;
+    }
+
+    if (numFields == numAnalysisFields && fields[0].length == 1 && fields[0].data[0] == '~')
+    {
+        // "~|ID|detected BPM|detected key|analysis version", appended when a track is analysed.
+        double detectedBpm = 0.0;
+        juce::int64 analysisVersion = 0;
+
+        if (!parseHex(fields[1], analysisUpdate.id)
+            || (fields[2].length > 0 && !parseNumber(fields[2], detectedBpm))
+            || !parseInteger(fields[4], analysisVersion))
+        {
+            return LineType::bad;
+        }
+
+        analysisUpdate.detectedBpm = (float) detectedBpm;
+        analysisUpdate.detectedKey = CamelotKey::parse(toString(fields[3]));
+        analysisUpdate.analysisVersion = (juce::uint32) analysisVersion;
+
+        return LineType::analysis;
+    }
+
+    if (numFields != 3 && numFields != 4 && numFields != numFieldsWithTags && numFields != numFieldsWithId
+        && numFields != numFieldsWithFileState && numFields != numFieldsWithAnalysis
+        && numFields != numFieldsWithAnalysisVersion && numFields != maxFieldsPerLine)
+    {
+        return LineType::bad;
+    }
+
+    // Older lines have 3 fields, plus the content hash on some.
+    juce::uint64 contentHash = 0;
+
+    if (numFields >= 4 && fields[3].length > 0 && !parseHex(fields[3], contentHash))
+    {
+        return LineType::bad;
+    }
+
+    // A hash made by an older version of Track::createContentHash() can't be compared with
+    // new ones, so it is dropped and the track is hashed again.
+    juce::int64 contentHashVersion = 0;
+
+    if (numFields == maxFieldsPerLine && !parseInteger(fields[17], contentHashVersion))
+    {
+        return LineType::bad;
+    }
+
+    if (contentHashVersion != Track::contentHashVersion)
+    {
+        contentHash = 0;
+    }
 
-    if (playlistFile.is_open())
+    TrackId id = 0;
+
+    if (numFields >= numFieldsWithId)
     {
-        while (std::getline(playlistFile, line))
+        // The stored ID saves normalising every path while loading.
+        if (!parseHex(fields[11], id))
         {
-            if (lineNum != lineNumber)
+            return LineType::bad;
+        }
+
+        tracks.emplace_back(id, toString(fields[0]), toString(fields[2]), contentHash);
+    }
+    else
+    {
+        tracks.emplace_back(toString(fields[0]), toString(fields[2]), contentHash);
+    }
+
+    Track& newTrack = tracks.back();
+
+    if (numFields >= numFieldsWithTags)
+    {
+        double bpm = 0.0;
+
+        if ((fields[7].length > 0 && !parseNumber(fields[7], bpm))
+            || !parseInteger(fields[9], newTrack.lengthInSamples)
+            || !parseNumber(fields[10], newTrack.sampleRate))
+        {
+            tracks.pop_back();
+            return LineType::bad;
+        }
+
+        newTrack.artist = toString(fields[4]);
+        newTrack.album = toString(fields[5]);
+        newTrack.genre = toString(fields[6]);
+        newTrack.bpm = (float) bpm;
+        newTrack.key = toString(fields[8]);
+    }
+    else
+    {
+        // Only the formatted length (m:ss) is known; store it in milliseconds.
+        const Field& length = fields[1];
+        auto* colon = static_cast<const char*>(memchr(length.data, ':', length.length));
+        juce::int64 minutes = 0;
+        juce::int64 seconds = 0;
+
+        if (colon != nullptr)
+        {
+            parseInteger({ length.data, (size_t) (colon - length.data) }, minutes);
+            parseInteger({ colon + 1, (size_t) (length.data + length.length - colon - 1) }, seconds);
+        }
+
+        newTrack.lengthInSamples = (minutes * 60 + seconds) * 1000;
+        newTrack.sampleRate = 1000.0;
+    }
+
+    if (numFields >= numFieldsWithFileState)
+    {
+        // The file's size and modification time when its tags were read.
+        if (!parseInteger(fields[12], newTrack.fileSize) || !parseInteger(fields[13], newTrack.modificationTime))
+        {
+            tracks.pop_back();
+            return LineType::bad;
+        }
+    }
+
+    if (numFields >= numFieldsWithAnalysis)
+    {
+        double detectedBpm = 0.0;
+
+        if (fields[14].length > 0 && !parseNumber(fields[14], detectedBpm))
+        {
+            tracks.pop_back();
+            return LineType::bad;
+        }
+
+        newTrack.detectedBpm = (float) detectedBpm;
+        newTrack.detectedKey = CamelotKey::parse(toString(fields[15]));
+    }
+
+    if (numFields >= numFieldsWithAnalysisVersion)
+    {
+        // The version of the analysis the detected BPM and key came from.
+        juce::int64 analysisVersion = 0;
+
+        if (!parseInteger(fields[16], analysisVersion))
+        {
+            tracks.pop_back();
+            return LineType::bad;
+        }
+
+        newTrack.analysisVersion = (juce::uint32) analysisVersion;
+    }
+
+    return LineType::track;
+}
+
+bool PlaylistFileProcessor::parseHex(const Field& field, juce::uint64& value)
+{
+    if (field.length == 0 || field.length > 16)
+    {
+        return false;
+    }
+
+    value = 0;
+
+    for (size_t i = 0; i < field.length; ++i)
+    {
+        int digit = juce::CharacterFunctions::getHexDigitValue((juce::juce_wchar) (juce::uint8) field.data[i]);
+
+        if (digit < 0)
+        {
+            return false;
+        }
+
+        value = (value << 4) | (juce::uint64) digit;
+    }
+
+    return true;
+}
+
+bool PlaylistFileProcessor::parseInteger(const Field& field, juce::int64& value)
+{
+    size_t i = (field.length > 0 && field.data[0] == '-') ? 1 : 0;
+    bool isNegative = i == 1;
+
+    if (i == field.length || field.length > 19)
+    {
+        return false;
+    }
+
+    value = 0;
+
+    for (; i < field.length; ++i)
+    {
+        if (field.data[i] < '0' || field.data[i] > '9')
+        {
+            return false;
+        }
+
+        value = value * 10 + (field.data[i] - '0');
+    }
+
+    value = isNegative ? -value : value;
+    return true;
+}
+
+bool PlaylistFileProcessor::parseNumber(const Field& field, double& value)
+{
+    // Copy to a terminated buffer on the stack, as the file data isn't terminated.
+    char buffer[32];
+
+    if (field.length == 0 || field.length >= sizeof(buffer))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < field.length; ++i)
+    {
+        char c = field.data[i];
+
+        if (!((c >= '0' && c <= '9') || c == '.' || c == '-' || c == '+' || c == 'e' || c == 'E'))
+        {
+            return false;
+        }
+
+        buffer[i] = c;
+    }
+
+    buffer[field.length] = 0;
+    value = juce::CharacterFunctions::readDoubleValue(juce::CharPointer_ASCII(buffer));
+    return true;
+}
+
+juce::String PlaylistFileProcessor::toString(const Field& field)
+{
+    if (memchr(field.data, '\\', field.length) == nullptr)
+    {
+        return juce::String::fromUTF8(field.data, (int) field.length);
+    }
+
+    std::string text;
+    text.reserve(field.length);
+
+    for (size_t i = 0; i < field.length; ++i)
+    {
+        char c = field.data[i];
+
+        if (c == '\\' && i + 1 < field.length)
+        {
+            // Anything else after a backslash was written before text was escaped, so it is kept as it is.
+            switch (field.data[i + 1])
             {
-                tempPlaylist.push_back(line);
+                case '\\': c = '\\'; ++i; break;
+                case 'p':  c = '|';  ++i; break;
+                case 'n':  c = '\n'; ++i; break;
+                case 'r':  c = '\r'; ++i; break;
+                default: break;
             }
-            lineNum++;
         }
 
-        playlistFile.close();
+        text += c;
     }
-    else
+
+    return juce::String::fromUTF8(text.data(), (int) text.size());
+}
+
+juce::String PlaylistFileProcessor::escape(const juce::String& text)
+{
+    // Almost no tag needs escaping, so those are written without a copy.
+    if (!text.containsAnyOf("\\|\n\r"))
+    {
+        return text;
+    }
+
+    return text.replace("\\", "\\\\").replace("|", "\\p").replace("\n", "\\n").replace("\r", "\\r");
+}
+
+void PlaylistFileProcessor::deleteData(TrackId id)
+{
+    mStream.open(playlistFilePath, std::fstream::app);
+
+    if (mStream.fail())
+    {
+        // Throw error if file doesn't open.
+        throw std::iostream::failure("Cannot append to file " + playlistFilePath);
+    }
+
+    mStream << "-|" << juce::String::toHexString((juce::int64) id) << '\n';
+    mStream.close();
+}
+
+void PlaylistFileProcessor::appendAnalysis(const std::vector<AnalysisUpdate>& updates)
+{
+    mStream.open(playlistFilePath, std::fstream::app);
+
+    if (mStream.fail())
     {
-        DBG("Playlist file not open.");
+        // Throw error if file doesn't open.
+        throw std::iostream::failure("Cannot append to file " + playlistFilePath);
     }
 
+    for (const AnalysisUpdate& update : updates)
+    {
+        mStream << "~|" << juce::String::toHexString((juce::int64) update.id) << "|"
+                << (update.detectedBpm > 0.0f ? juce::String(update.detectedBpm, 2) : juce::String()) << "|"
+                << CamelotKey::toString(update.detectedKey) << "|" << update.analysisVersion << '\n';
+    }
 
-    std::ofstream playlistFileToWrite{ playlistFilePath };
-    for (const std::string line : tempPlaylist)
+    mStream.close();
+}
+
+void PlaylistFileProcessor::rewriteData(const std::vector<Track>& tracks)
+{
+    // Write to a temporary file first so the library survives a crash mid-write.
+    std::string tempFilePath = playlistFilePath + ".tmp";
+    std::ofstream playlistFileToWrite{ tempFilePath };
+
+    for (const Track& track : tracks)
     {
-        playlistFileToWrite << line << std::endl;
+        writeTrack(playlistFileToWrite, track);
     }
 
     playlistFileToWrite.close();
-}
\ No newline at end of file
+
+    if (playlistFileToWrite.fail()
+        || !juce::File{ tempFilePath }.moveFileTo(juce::File{ playlistFilePath }))
+    {
+        DBG("PlaylistFileProcessor::rewriteData could not rewrite the playlist file");
+    }
+}
+
+void PlaylistFileProcessor::writeTrack(std::ostream& stream, const Track& track)
+{
+    // The formatted length is kept second so the line stays readable.
+    stream << escape(track.title) << "|" << track.getLengthText() << "|" << escape(track.path) << "|"
+           << (track.contentHash != 0 ? juce::String::toHexString((juce::int64) track.contentHash) : juce::String())
+           << "|" << escape(track.artist) << "|" << escape(track.album) << "|" << escape(track.genre) << "|"
+           << (track.bpm > 0.0f ? juce::String(track.bpm, 2) : juce::String()) << "|" << escape(track.key) << "|"
+           << track.lengthInSamples << "|" << juce::String(track.sampleRate, 0) << "|"
+           << juce::String::toHexString((juce::int64) track.id) << "|"
+           << track.fileSize << "|" << track.modificationTime << "|"
+           << (track.detectedBpm > 0.0f ? juce::String(track.detectedBpm, 2) : juce::String()) << "|"
+           << CamelotKey::toString(track.detectedKey) << "|" << track.analysisVersion << "|"
+           << Track::contentHashVersion << '\n';
+}
+
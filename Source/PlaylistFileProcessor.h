@@ -14,11 +14,21 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <unordered_map>
 #include "Track.h"
 
 class PlaylistFileProcessor
 {
     public:
+        /** The analysis results of a track, journalled to the playlist file rather than rewriting its line. */
+        struct AnalysisUpdate
+        {
+            TrackId id;
+            float detectedBpm;
+            int detectedKey;
+            juce::uint32 analysisVersion;
+        };
+
         /**
         * PURPOSE: Creates the PlaylistFileProcessor object.
         * INPUTS: None.
@@ -41,43 +51,148 @@ class PlaylistFileProcessor
         void createPlaylistFile(std::string fileName);
 
         /**
-        * PURPOSE: Separates each line in the playlist file into tokens/parts based on the sent separator.
-        * INPUTS: The line in the file to be separated and the separator to use as the delimiter.
-        * OUTPUTS: A vector of strings representing the tokens.
+        * PURPOSE: Loads the tracks stored in the playlist file, replaying the deletions and analysis
+        *          updates journalled in it. Once the journal has grown to a good part of the file, the
+        *          file is rewritten without it. Bad lines are skipped.
+        * INPUTS: The path of the playlist file.
+        * OUTPUTS: A vector of the tracks in the library, in the order they were added.
         */
         std::vector<Track> loadData(std::string filePath);
 
         /**
         * PURPOSE: Appends track data to the playlist file.
-        * INPUTS: The title, length and file path of the track to be appended.
+        * INPUTS: The track to be appended.
+        * OUTPUTS: None.
+        */
+        void appendData(const Track& track);
+
+        /**
+        * PURPOSE: Appends the data of several tracks to the playlist file, opening it once for all of them.
+        * INPUTS: The tracks to be appended.
+        * OUTPUTS: None.
+        */
+        void appendData(const std::vector<Track>& tracks);
+
+        /**
+        * PURPOSE: Deletes the track data from the playlist file by appending a deletion record
+        *          for the track (the file is compacted the next time it is loaded).
+        * INPUTS: The ID of the track to be deleted.
         * OUTPUTS: None.
         */
-        void appendData(juce::String title, juce::String length, juce::String path);
+        void deleteData(TrackId id);
 
         /**
-        * PURPOSE: Deletes the track data from the playlist file as indicated by the line number.
-        * INPUTS: The line number of the track to be deleted.
+        * PURPOSE: Records the analysis results of several tracks by appending a journal line per
+        *          track to the playlist file, opening it once for all of them.
+        * INPUTS: The analysis results to be recorded.
         * OUTPUTS: None.
         */
-        void deleteData(int lineNumber);
+        void appendAnalysis(const std::vector<AnalysisUpdate>& updates);
+
+        /**
+        * PURPOSE: Writes the line of a track to a playlist file stream. Its text is escaped, so a tag
+        *          with a "|" or a line break in it can't split the line.
+        * INPUTS: The stream to write to and the track to be written.
+        * OUTPUTS: None.
+        */
+        static void writeTrack(std::ostream& stream, const Track& track);
 
     private:
+        /** A field of a playlist file line, pointing into the loaded file (i.e. not a copy). */
+        struct Field
+        {
+            const char* data;
+            size_t length;
+        };
+
+        /** What a line of the playlist file turned out to be. */
+        enum class LineType
+        {
+            track,
+            deletion,
+            analysis,
+            empty,
+            bad
+        };
+
         /**
-        * PURPOSE: Separates each line in the playlist file into tokens/parts based on the sent separator.
-        * INPUTS: The line in the file to be separated and the separator to use as the delimiter.
-        * OUTPUTS: A vector of strings representing the tokens.
+        * PURPOSE: Splits a line of the playlist file into its "|" separated fields, without copying them.
+        * INPUTS: The start and end of the line and an array of (maxFieldsPerLine + 1) fields to fill.
+        * OUTPUTS: The number of fields in the line (more than maxFieldsPerLine if it has too many).
         */
-        static std::vector<std::string> tokenise(std::string line, char separator);
+        static int splitLine(const char* start, const char* end, Field* fields);
 
         /**
-        * PURPOSE: Converts the vector of token strings to a Track data structure.
-        * INPUTS: A vector of strings representing the tokens.
-        * OUTPUTS: A track data structure (created from the Track class).
+        * PURPOSE: Converts the fields of a line to a track or a deletion record. Lines written before
+        *          the tags were stored only have the title, the formatted length, the path and
+        *          possibly the content hash; lines written before the ID was stored have no ID,
+        *          lines written before the file size and modification time were stored lack those,
+        *          lines written before the detected BPM and key were stored lack those, and lines
+        *          written before the analysis version or the content hash version was stored lack it.
+        *          A content hash from an older version of Track::createContentHash() is dropped (set to 0).
+        * INPUTS: The fields of the line, their number, the vector to append a track to, a reference
+        *         to store the ID of a deleted track in and a reference to store an analysis update in.
+        * OUTPUTS: The type of the line; a track is only appended if it is LineType::track.
         */
-        static Track stringsToTrack(std::vector<std::string> tokens);
+        static LineType parseLine(const Field* fields,
+                                  int numFields,
+                                  std::vector<Track>& tracks,
+                                  TrackId& deletedId,
+                                  AnalysisUpdate& analysisUpdate);
+
+        /**
+        * PURPOSE: Parses a hexadecimal number of up to 64 bits.
+        * INPUTS: The field to parse and a reference to store the number in.
+        * OUTPUTS: A boolean; true if the field is a valid number and false if it isn't.
+        */
+        static bool parseHex(const Field& field, juce::uint64& value);
+
+        /**
+        * PURPOSE: Parses a decimal integer.
+        * INPUTS: The field to parse and a reference to store the number in.
+        * OUTPUTS: A boolean; true if the field is a valid number and false if it isn't.
+        */
+        static bool parseInteger(const Field& field, juce::int64& value);
+
+        /**
+        * PURPOSE: Parses a decimal number, which may have a fractional part.
+        * INPUTS: The field to parse and a reference to store the number in.
+        * OUTPUTS: A boolean; true if the field is a valid number and false if it isn't.
+        */
+        static bool parseNumber(const Field& field, double& value);
+
+        /**
+        * PURPOSE: Copies a text field to a juce string, undoing its escapes.
+        * INPUTS: The UTF-8 field.
+        * OUTPUTS: The field as a juce string.
+        */
+        static juce::String toString(const Field& field);
+
+        /**
+        * PURPOSE: Escapes the characters that separate fields and lines, and the escape character itself.
+        * INPUTS: The text of a field.
+        * OUTPUTS: The text with backslashes doubled, and "|", newlines and carriage returns written as "\p", "\n" and "\r".
+        */
+        static juce::String escape(const juce::String& text);
+
+        /**
+        * PURPOSE: Replaces the contents of the playlist file with the given tracks.
+        * INPUTS: The tracks to be written.
+        * OUTPUTS: None.
+        */
+        void rewriteData(const std::vector<Track>& tracks);
 
 
         /** DATA MEMBERS */
+        static constexpr int numFieldsWithTags = 11;
+        static constexpr int numFieldsWithId = 12;
+        static constexpr int numFieldsWithFileState = 14;
+        static constexpr int numFieldsWithAnalysis = 16;
+        static constexpr int numFieldsWithAnalysisVersion = 17;
+        static constexpr int maxFieldsPerLine = 18;
+        static constexpr int numAnalysisFields = 5;
+        static constexpr int tracksPerJournalLine = 4;
+
         std::ofstream mStream;
         std::string playlistFilePath;
 };
\ No newline at end of file
@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+    RecorderBenchmark.cpp
+    Created: 20 Oct 2026 1:21:40am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "RecorderBenchmark.h"
+#include "BenchmarkRunner.h"
+#include <algorithm>
+
+RecorderBenchmark::RecorderBenchmark()
+                                    : random(20261020),
+                                      noise(2, noiseLength)
+{
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        for (int i = 0; i < noiseLength; ++i)
+        {
+            noise.setSample(channel, i, 0.5f * (random.nextFloat() * 2.0f - 1.0f));
+        }
+    }
+}
+
+RecorderBenchmark::~RecorderBenchmark()
+{
+}
+
+juce::var RecorderBenchmark::runFromCommandLine(const juce::StringArray& arguments)
+{
+    double minutes = BenchmarkRunner::getOption(arguments, "--minutes").getDoubleValue();
+    double speed = BenchmarkRunner::getOption(arguments, "--speed").getDoubleValue();
+    juce::String extension = BenchmarkRunner::getOption(arguments, "--format") == "flac" ? ".flac" : ".wav";
+
+    RecorderBenchmark benchmark;
+
+    return benchmark.run(minutes > 0.0 ? minutes : 60.0, speed > 0.0 ? speed : 30.0, extension);
+}
+
+juce::var RecorderBenchmark::run(double minutes, double speed, const juce::String& extension)
+{
+    juce::File folder = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                            .getNonexistentChildFile("OtoDecksRecorderBenchmark", "");
+    folder.createDirectory();
+
+    juce::DynamicObject::Ptr results = BenchmarkRunner::createResults();
+    results->setProperty("sampleRate", sampleRate);
+    results->setProperty("minutes", minutes);
+    results->setProperty("speed", speed);
+    results->setProperty("format", extension.substring(1));
+
+    SetRecorder recorder;
+    recorder.prepare(sampleRate);
+    juce::String error;
+
+    if (!recorder.startRecording(folder.getChildFile("Set" + extension), true, error))
+    {
+        results->setProperty("error", error);
+        results->setProperty("passed", false);
+        folder.deleteRecursively();
+        return juce::var(results.get());
+    }
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::AudioSourceChannelInfo bufferToFill(&buffer, 0, blockSize);
+    const int numBlocks = (int) (minutes * 60.0 * sampleRate / blockSize);
+    const double msPerBlock = 1000.0 * blockSize / sampleRate / speed;
+    const double startMs = juce::Time::getMillisecondCounterHiRes();
+    std::vector<double> pushTimesUs;
+    pushTimesUs.reserve((size_t) numBlocks);
+
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        // Keep to the pace, as the audio callback would.
+        while (juce::Time::getMillisecondCounterHiRes() - startMs < block * msPerBlock)
+        {
+            juce::Thread::sleep(1);
+        }
+
+        fillBlock(buffer, block);
+
+        juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+
+        for (int stream = 0; stream < SetRecorder::numStreams; ++stream)
+        {
+            recorder.pushBlock((SetRecorder::Stream) stream, bufferToFill);
+        }
+
+        juce::int64 endTicks = juce::Time::getHighResolutionTicks();
+        pushTimesUs.push_back(1.0e6 * juce::Time::highResolutionTicksToSeconds(endTicks - startTicks));
+    }
+
+    const double pushedMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+    recorder.stopRecording();
+
+    bool isLossless = true;
+    juce::Array<juce::var> streams;
+
+    for (int stream = 0; stream < SetRecorder::numStreams; ++stream)
+    {
+        SetRecorder::Stats stats = recorder.getStats((SetRecorder::Stream) stream);
+        bool isComplete = stats.samplesDropped == 0 && stats.samplesWritten == stats.samplesPushed;
+        isLossless = isLossless && isComplete;
+
+        juce::DynamicObject::Ptr result = new juce::DynamicObject();
+        result->setProperty("samplesPushed", stats.samplesPushed);
+        result->setProperty("samplesWritten", stats.samplesWritten);
+        result->setProperty("samplesDropped", stats.samplesDropped);
+        result->setProperty("overruns", stats.overruns);
+        result->setProperty("complete", isComplete);
+        streams.add(juce::var(result.get()));
+    }
+
+    juce::Array<juce::File> files = folder.findChildFiles(juce::File::findFiles, false);
+    juce::int64 bytesWritten = 0;
+
+    for (const auto& file : files)
+    {
+        bytesWritten += file.getSize();
+    }
+
+    std::sort(pushTimesUs.begin(), pushTimesUs.end());
+
+    auto percentile = [&pushTimesUs](double fraction)
+    {
+        if (pushTimesUs.empty())
+        {
+            return 0.0;
+        }
+
+        return pushTimesUs[juce::jmin(pushTimesUs.size() - 1, (size_t) (fraction * pushTimesUs.size()))];
+    };
+
+    juce::DynamicObject::Ptr pushCost = new juce::DynamicObject();
+    pushCost->setProperty("p50Us", percentile(0.5));
+    pushCost->setProperty("p99Us", percentile(0.99));
+    pushCost->setProperty("maxUs", percentile(1.0));
+
+    results->setProperty("wallSeconds", pushedMs / 1000.0);
+    results->setProperty("bytesWritten", bytesWritten);
+    results->setProperty("megabytesPerSecond", bytesWritten / 1.0e6 / (pushedMs / 1000.0));
+    results->setProperty("pushCost", juce::var(pushCost.get()));
+    results->setProperty("streams", streams);
+    results->setProperty("passed", isLossless);
+
+    folder.deleteRecursively();
+    return juce::var(results.get());
+}
+
+void RecorderBenchmark::fillBlock(juce::AudioBuffer<float>& buffer, int blockNumber) const
+{
+    const int start = (int) (((juce::int64) blockNumber * blockSize) % (noiseLength - blockSize + 1));
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        buffer.copyFrom(channel, 0, noise, channel, start, blockSize);
+    }
+}
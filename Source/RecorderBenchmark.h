@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    RecorderBenchmark.h
+    Created: 20 Oct 2026 1:21:40am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "SetRecorder.h"
+#include <vector>
+
+//==============================================================================
+/*
+    Checks that a long set can be recorded without losing a sample.
+
+    A SetRecorder records a set of stereo noise to a temporary folder, with
+    the stems on, while blocks are pushed the way the audio thread pushes
+    them but many times faster than real time. Pushing an hour at thirty
+    times real time asks as much of the disk as recording thirty sets at
+    once, so a disk that keeps up here has plenty of room in a real set.
+    The SetRecorder's counters then show, for each file, whether everything
+    pushed was written; the time each push took shows what recording costs
+    the audio thread.
+
+    Run the app with "--record-benchmark [output.json] [--minutes 60]
+    [--speed 30] [--format wav|flac]" to run it without opening a window;
+    the results are written as JSON (to the standard output if no file is
+    given).
+*/
+class RecorderBenchmark
+{
+    public:
+        /**
+        * PURPOSE: Creates the RecorderBenchmark object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        RecorderBenchmark();
+
+        /**
+        * PURPOSE: Destroys the RecorderBenchmark object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~RecorderBenchmark();
+
+        /**
+        * PURPOSE: Runs the benchmark with the options given on the command line.
+        * INPUTS: The arguments of the command line.
+        * OUTPUTS: The results, as a juce var holding a JSON object; "passed" is true if nothing was lost.
+        */
+        static juce::var runFromCommandLine(const juce::StringArray& arguments);
+
+        /**
+        * PURPOSE: Records a set and checks what reached the disk.
+        * INPUTS: The length of the set in minutes, how many times faster than real time to push
+        *         it and the file extension to record to (".wav" or ".flac").
+        * OUTPUTS: The results, as a juce var holding a JSON object.
+        */
+        juce::var run(double minutes, double speed, const juce::String& extension);
+
+    private:
+        /**
+        * PURPOSE: Copies the next block of the noise into the buffer to be pushed.
+        * INPUTS: The buffer and the number of the block.
+        * OUTPUTS: None.
+        */
+        void fillBlock(juce::AudioBuffer<float>& buffer, int blockNumber) const;
+
+
+        /** DATA MEMBERS */
+
+        static constexpr double sampleRate = 48000.0;
+        static constexpr int blockSize = 512;
+        static constexpr int noiseLength = 1 << 16;
+
+        juce::Random random;
+        juce::AudioBuffer<float> noise;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RecorderBenchmark)
+};
@@ -0,0 +1,424 @@
+/*
+  ==============================================================================
+
+    ScratchEngine.cpp
+    Created: 20 Oct 2026 2:17:48am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "ScratchEngine.h"
+#include <cmath>
+
+ScratchEngine::ScratchEngine()
+                            : juce::Thread("Scratch engine"),
+                              ring(2, ringSize),
+                              numBlockEvents(0),
+                              blockGeneration(0),
+                              outputSampleRate(44100.0),
+                              isActive(false),
+                              isTouched(false),
+                              isPlayingBackwards(false),
+                              handBackPending(false),
+                              playhead(0.0),
+                              velocity(0.0),
+                              handPosition(0.0),
+                              motor(0.0)
+{
+    ring.clear();
+    startThread(6);
+}
+
+ScratchEngine::~ScratchEngine()
+{
+    stopThread(2000);
+}
+
+void ScratchEngine::setSource(std::unique_ptr<juce::AudioFormatReader> newReader)
+{
+    {
+        const juce::ScopedLock sl(readerLock);
+        reader = std::move(newReader);
+
+        // Empty the ring before it starts filling with the new track.
+        ++generation;
+        validEnd = 0;
+        validStart = 0;
+        centre = 0;
+        sourceLength = reader != nullptr ? reader->lengthInSamples : 0;
+        sourceSampleRate = reader != nullptr ? reader->sampleRate : 0.0;
+    }
+
+    pushEvent(JogEvent::stopped, 0.0);
+    notify();
+}
+
+void ScratchEngine::prepare(double _outputSampleRate)
+{
+    outputSampleRate = _outputSampleRate;
+}
+
+void ScratchEngine::touch()
+{
+    pushEvent(JogEvent::touched, 0.0);
+}
+
+void ScratchEngine::move(double revolutions)
+{
+    pushEvent(JogEvent::moved, revolutions);
+}
+
+void ScratchEngine::release()
+{
+    pushEvent(JogEvent::released, 0.0);
+}
+
+void ScratchEngine::setReversed(bool shouldReverse)
+{
+    reversed = shouldReverse;
+}
+
+bool ScratchEngine::isReversed() const
+{
+    return reversed.load();
+}
+
+ScratchEngine::Source ScratchEngine::beginBlock(int numSamples, double transportSeconds, double motorSpeed, bool shouldSlip)
+{
+    const double rate = sourceSampleRate.load();
+    const bool backwards = reversed.load() && motorSpeed > 0.0;
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    const double blockMs = 1000.0 * numSamples / outputSampleRate;
+    bool hasTouch = false;
+    bool hasStop = false;
+
+    // Each event lands on the sample it would have if this block had been playing while it happened.
+    int start1, size1, start2, size2;
+    eventFifo.prepareToRead(eventFifo.getNumReady(), start1, size1, start2, size2);
+    numBlockEvents = 0;
+
+    for (int i = 0; i < size1 + size2; ++i)
+    {
+        JogEvent& event = blockEvents[numBlockEvents++];
+        event = events[i < size1 ? start1 + i : start2 + i - size1];
+        event.offset = juce::jlimit(0, juce::jmax(numSamples - 1, 0),
+                                    (int) ((event.timeMs - (nowMs - blockMs)) / blockMs * numSamples));
+        hasTouch = hasTouch || event.type == JogEvent::touched;
+        hasStop = hasStop || event.type == JogEvent::stopped;
+    }
+
+    eventFifo.finishedRead(size1 + size2);
+    blockGeneration = generation.load();
+
+    if (rate <= 0.0 || hasStop || (!isActive && !hasTouch && !backwards))
+    {
+        isActive = false;
+        isTouched = false;
+        isPlayingBackwards = false;
+        handBackPending = false;
+        numBlockEvents = 0;
+        scratching = false;
+        centre = (juce::int64) (transportSeconds * rate);
+        return transport;
+    }
+
+    motor = (backwards ? -motorSpeed : motorSpeed) * rate / outputSampleRate;
+
+    // Reverse flips the direction at once, like a DJ's reverse switch rather than a brake.
+    if (backwards != isPlayingBackwards && !isTouched)
+    {
+        velocity = motor;
+    }
+
+    isPlayingBackwards = backwards;
+
+    if (!isActive)
+    {
+        // Pick the record up where the transport is, still turning at its speed until the hand lands.
+        isActive = true;
+        isTouched = false;
+        handBackPending = false;
+        playhead = transportSeconds * rate;
+        handPosition = playhead;
+        velocity = motor;
+        playheadSeconds = transportSeconds;
+        scratching = true;
+        return toScratch;
+    }
+
+    // In slip mode the transport takes over as soon as the record is let go of and turning forwards,
+    // from wherever the deck would have been, so there is nothing to wait for.
+    if (shouldSlip && !isTouched && !hasTouch && !backwards)
+    {
+        handBackPending = true;
+    }
+
+    if (handBackPending && !hasTouch)
+    {
+        return toTransport;
+    }
+
+    handBackPending = false;
+    return scratch;
+}
+
+void ScratchEngine::render(const juce::AudioSourceChannelInfo& bufferToFill, Source source, float gain)
+{
+    const int numSamples = bufferToFill.numSamples;
+    const double rate = sourceSampleRate.load();
+    const double length = (double) sourceLength.load();
+    const juce::int64 start = validStart.load();
+    const juce::int64 end = validEnd.load();
+    const double followCoefficient = 1.0 / (followSeconds * outputSampleRate);
+    const double smoothingCoefficient = 1.0 - std::exp(-1.0 / (smoothingSeconds * outputSampleRate));
+    const double spinUpCoefficient = 1.0 - std::exp(-1.0 / (spinUpSeconds * outputSampleRate));
+    const double maxVelocity = maxSpeed * rate / outputSampleRate;
+
+    juce::AudioBuffer<float>* buffer = bufferToFill.buffer;
+    float* left = buffer->getWritePointer(0, bufferToFill.startSample);
+    float* right = buffer->getNumChannels() > 1 ? buffer->getWritePointer(1, bufferToFill.startSample) : nullptr;
+    int nextEvent = 0;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        while (nextEvent < numBlockEvents && blockEvents[nextEvent].offset <= i)
+        {
+            applyEvent(blockEvents[nextEvent++]);
+        }
+
+        // Held, the record chases the hand; let go, it spins back up to the deck's speed.
+        if (isTouched)
+        {
+            velocity += ((handPosition - playhead) * followCoefficient - velocity) * smoothingCoefficient;
+        }
+        else
+        {
+            velocity += (motor - velocity) * spinUpCoefficient;
+        }
+
+        velocity = juce::jlimit(-maxVelocity, maxVelocity, velocity);
+
+        float leftSample, rightSample;
+        interpolate(playhead, start, end, leftSample, rightSample);
+        leftSample *= gain;
+        rightSample *= gain;
+
+        const float fade = (float) (i + 1) / numSamples;
+
+        if (source == toScratch)
+        {
+            leftSample = left[i] + (leftSample - left[i]) * fade;
+            rightSample = right != nullptr ? right[i] + (rightSample - right[i]) * fade : rightSample;
+        }
+        else if (source == toTransport)
+        {
+            leftSample = leftSample + (left[i] - leftSample) * fade;
+            rightSample = right != nullptr ? rightSample + (right[i] - rightSample) * fade : rightSample;
+        }
+
+        left[i] = leftSample;
+
+        if (right != nullptr)
+        {
+            right[i] = rightSample;
+        }
+
+        playhead += velocity;
+
+        // The record can't be pulled back past the start or run on past the end.
+        if (playhead < 0.0 || playhead > length)
+        {
+            playhead = juce::jlimit(0.0, length, playhead);
+            velocity = 0.0;
+        }
+    }
+
+    numBlockEvents = 0;
+
+    // The ring was emptied under this block, which may have read another track.
+    if (generation.load() != blockGeneration && source == scratch)
+    {
+        bufferToFill.clearActiveBufferRegion();
+    }
+
+    handBackPending = !isTouched && !isPlayingBackwards
+                      && std::abs(velocity - motor) <= handBackTolerance * rate / outputSampleRate;
+    playheadSeconds = playhead / rate;
+    centre = (juce::int64) playhead;
+
+    if (source == toTransport)
+    {
+        isActive = false;
+        isPlayingBackwards = false;
+        handBackPending = false;
+        scratching = false;
+    }
+}
+
+double ScratchEngine::getPlayheadSeconds() const
+{
+    return playheadSeconds.load();
+}
+
+bool ScratchEngine::isScratching() const
+{
+    return scratching.load();
+}
+
+void ScratchEngine::run()
+{
+    while (!threadShouldExit())
+    {
+        {
+            const juce::ScopedLock sl(readerLock);
+
+            if (reader != nullptr)
+            {
+                fillRing();
+            }
+        }
+
+        wait(pollMs);
+    }
+}
+
+void ScratchEngine::pushEvent(JogEvent::Type type, double revolutions)
+{
+    int start1, size1, start2, size2;
+    eventFifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    // If the audio has stopped and the queue is full, the newest events are the ones dropped.
+    if (size1 > 0)
+    {
+        events[start1] = { type, juce::Time::getMillisecondCounterHiRes(), revolutions, 0 };
+    }
+
+    eventFifo.finishedWrite(size1);
+}
+
+void ScratchEngine::applyEvent(const JogEvent& event)
+{
+    switch (event.type)
+    {
+        case JogEvent::touched:
+            isTouched = true;
+            handPosition = playhead;
+            break;
+
+        case JogEvent::moved:
+            if (isTouched)
+            {
+                handPosition += event.revolutions * secondsPerRevolution * sourceSampleRate.load();
+            }
+            break;
+
+        case JogEvent::released:
+            isTouched = false;
+            break;
+
+        case JogEvent::stopped:
+        default:
+            break;
+    }
+}
+
+void ScratchEngine::interpolate(double position, juce::int64 start, juce::int64 end, float& left, float& right) const
+{
+    const juce::int64 index = (juce::int64) std::floor(position);
+
+    if (index - 1 < start || index + 2 >= end)
+    {
+        left = 0.0f;
+        right = 0.0f;
+        return;
+    }
+
+    const float t = (float) (position - (double) index);
+    float* outputs[] = { &left, &right };
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        const float* samples = ring.getReadPointer(channel);
+        const float y0 = samples[(index - 1) & ringMask];
+        const float y1 = samples[index & ringMask];
+        const float y2 = samples[(index + 1) & ringMask];
+        const float y3 = samples[(index + 2) & ringMask];
+
+        // Catmull-Rom through the two samples either side.
+        const float c1 = 0.5f * (y2 - y0);
+        const float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+        const float c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+
+        *outputs[channel] = ((c3 * t + c2) * t + c1) * t + y1;
+    }
+}
+
+void ScratchEngine::fillRing()
+{
+    const juce::int64 length = reader->lengthInSamples;
+    const juce::int64 capacity = ringSize - guardSamples;
+    const juce::int64 window = juce::jmin((juce::int64) (windowSeconds * reader->sampleRate), capacity / 2);
+    const juce::int64 middle = juce::jlimit((juce::int64) 0, length, centre.load());
+    const juce::int64 wantStart = juce::jmax((juce::int64) 0, middle - window);
+    const juce::int64 wantEnd = juce::jmin(length, middle + window);
+
+    juce::int64 start = validStart.load();
+    juce::int64 end = validEnd.load();
+
+    // The playhead jumped out of what is decoded, so start again around it.
+    if (middle < start || middle > end)
+    {
+        ++generation;
+        validEnd = 0;
+        validStart = middle;
+        validEnd = middle;
+        start = middle;
+        end = middle;
+    }
+
+    // Ahead first, as that is where the record is most likely going, dropping the oldest samples
+    // behind to make room. Then behind.
+    while (end < wantEnd && !threadShouldExit())
+    {
+        const int numSamples = (int) juce::jmin((juce::int64) chunkSamples, wantEnd - end);
+
+        if (end + numSamples - start > capacity)
+        {
+            start = end + numSamples - capacity;
+            validStart = start;
+        }
+
+        readIntoRing(end, numSamples);
+        end += numSamples;
+        validEnd = end;
+    }
+
+    while (start > wantStart && !threadShouldExit())
+    {
+        const int numSamples = (int) juce::jmin((juce::int64) chunkSamples, start - wantStart);
+
+        if (end - (start - numSamples) > capacity)
+        {
+            end = start - numSamples + capacity;
+            validEnd = end;
+        }
+
+        readIntoRing(start - numSamples, numSamples);
+        start -= numSamples;
+        validStart = start;
+    }
+}
+
+void ScratchEngine::readIntoRing(juce::int64 position, int numSamples)
+{
+    const int slot = (int) (position & ringMask);
+    const int firstPart = juce::jmin(numSamples, ringSize - slot);
+
+    reader->read(&ring, slot, firstPart, position, true, true);
+
+    if (firstPart < numSamples)
+    {
+        reader->read(&ring, 0, numSamples - firstPart, position + firstPart, true, true);
+    }
+}
@@ -0,0 +1,272 @@
+/*
+  ==============================================================================
+
+    ScratchEngine.h
+    Created: 20 Oct 2026 2:17:48am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <atomic>
+#include <memory>
+
+//==============================================================================
+/*
+    Plays a deck's track while the disc is being scratched, forwards or
+    backwards at any speed, the way a record follows the hand on it.
+
+    A background thread keeps a few seconds either side of the playhead
+    decoded into a ring buffer, read from the track with a reader of its
+    own, so the audio thread never waits on the disk. Touching, moving and
+    letting go of the disc are stamped with the time they happened and
+    queued through a lock-free FIFO. The audio thread applies each one at
+    the sample of the block it falls on, so a scratch sounds as smooth at
+    small block sizes as at large ones.
+
+    The playhead's velocity follows the hand with a little smoothing, and
+    the track is read at that velocity with cubic interpolation. Let go, the
+    record spins back up to the deck's speed, and the transport takes over
+    again from where the record stopped. Going in and out of a scratch is
+    crossfaded across a block, so neither clicks.
+
+    The engine also plays the deck in reverse, as the transport can only
+    play forwards: the record turns backwards at the deck's speed until
+    reverse is switched off. In slip mode, letting go of the disc or
+    switching reverse off hands back to the transport straight away, for
+    the deck to jump back to where the track would have been.
+*/
+class ScratchEngine : public juce::Thread
+{
+    public:
+        /** What a deck plays in a block. */
+        enum Source
+        {
+            transport = 0,
+            scratch,
+            toScratch,
+            toTransport
+        };
+
+        /**
+        * PURPOSE: Creates the ScratchEngine object and starts its background thread.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ScratchEngine();
+
+        /**
+        * PURPOSE: Destroys the ScratchEngine object and stops its background thread.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~ScratchEngine() override;
+
+        /**
+        * PURPOSE: Sets the track to scratch, stopping any scratch in progress. Called from the message thread.
+        * INPUTS: A reader for the track, of its own and not the transport's, or nullptr if no track is loaded.
+        * OUTPUTS: None.
+        */
+        void setSource(std::unique_ptr<juce::AudioFormatReader> newReader);
+
+        /**
+        * PURPOSE: Sets the sample rate of the output. Must not be called while blocks are being rendered.
+        * INPUTS: The sample rate.
+        * OUTPUTS: None.
+        */
+        void prepare(double _outputSampleRate);
+
+        /**
+        * PURPOSE: Puts a hand on the disc, which holds the record. Called from the message thread.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void touch();
+
+        /**
+        * PURPOSE: Moves the hand on the disc. Called from the message thread.
+        * INPUTS: How far it moved, in turns of the disc (negative to turn it backwards).
+        * OUTPUTS: None.
+        */
+        void move(double revolutions);
+
+        /**
+        * PURPOSE: Lets go of the disc, which spins back up to the deck's speed. Called from the message thread.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void release();
+
+        /**
+        * PURPOSE: Plays the deck backwards at its speed, or forwards again. Called from the message thread.
+        * INPUTS: A boolean; true to play in reverse and false to play forwards.
+        * OUTPUTS: None.
+        */
+        void setReversed(bool shouldReverse);
+
+        /**
+        * PURPOSE: Checks if the deck is set to play in reverse.
+        * INPUTS: None.
+        * OUTPUTS: A boolean; true if it is and false if it isn't.
+        */
+        bool isReversed() const;
+
+        /**
+        * PURPOSE: Takes the events that have come in and works out what the deck plays in the next
+        *          block. Called on the audio thread at the start of every block.
+        * INPUTS: The length of the block, the transport's position in seconds, the speed it
+        *         plays at (0 if it is stopped) and a boolean; true if the deck is in slip mode,
+        *         so the transport should take over as soon as the record is let go of.
+        * OUTPUTS: What to play: the transport, the scratch, or a crossfade from one to the other.
+        */
+        Source beginBlock(int numSamples, double transportSeconds, double motorSpeed, bool shouldSlip);
+
+        /**
+        * PURPOSE: Renders the scratch into the block, crossfading with the transport's output already
+        *          in it if the block goes in or out of a scratch. Called on the audio thread.
+        * INPUTS: The block, what beginBlock() said to play and the gain to play the track at.
+        * OUTPUTS: None.
+        */
+        void render(const juce::AudioSourceChannelInfo& bufferToFill, Source source, float gain);
+
+        /**
+        * PURPOSE: Gets where the record is while it is being scratched or played in reverse.
+        * INPUTS: None.
+        * OUTPUTS: The position in the track in seconds.
+        */
+        double getPlayheadSeconds() const;
+
+        /**
+        * PURPOSE: Checks if the deck is playing the scratch rather than the transport.
+        * INPUTS: None.
+        * OUTPUTS: A boolean; true if it is and false if it isn't.
+        */
+        bool isScratching() const;
+
+        /**
+        * PURPOSE: The background thread's main loop. Implements juce Thread (i.e. function is pure virtual).
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void run() override;
+
+
+        /** DATA MEMBERS */
+
+        // A record at 33 1/3 rpm.
+        static constexpr double secondsPerRevolution = 1.8;
+
+    private:
+        /** A hand on the disc doing something, and when it did it. */
+        struct JogEvent
+        {
+            enum Type
+            {
+                touched = 0,
+                moved,
+                released,
+                stopped
+            };
+
+            Type type;
+            double timeMs;
+            double revolutions;
+            int offset;
+        };
+
+        /**
+        * PURPOSE: Stamps an event with the time and queues it for the audio thread.
+        * INPUTS: The type of the event and how far the disc turned, for a move.
+        * OUTPUTS: None.
+        */
+        void pushEvent(JogEvent::Type type, double revolutions);
+
+        /**
+        * PURPOSE: Applies an event to the hand and the record. Called on the audio thread.
+        * INPUTS: The event.
+        * OUTPUTS: None.
+        */
+        void applyEvent(const JogEvent& event);
+
+        /**
+        * PURPOSE: Reads the track between samples of the ring with a four point cubic.
+        * INPUTS: The position in source samples, the decoded range, and references to the left and
+        *         right samples to be filled (with silence outside the decoded range).
+        * OUTPUTS: None.
+        */
+        void interpolate(double position, juce::int64 start, juce::int64 end, float& left, float& right) const;
+
+        /**
+        * PURPOSE: Decodes whatever is missing of the window around the playhead. Called on the
+        *          background thread with readerLock held.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void fillRing();
+
+        /**
+        * PURPOSE: Decodes a stretch of the track into its place in the ring.
+        * INPUTS: The first source sample and the number of samples.
+        * OUTPUTS: None.
+        */
+        void readIntoRing(juce::int64 position, int numSamples);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int ringSize = 1 << 19;
+        static constexpr int ringMask = ringSize - 1;
+        static constexpr int guardSamples = 1 << 16;
+        static constexpr int chunkSamples = 4096;
+        static constexpr double windowSeconds = 3.0;
+        static constexpr int maxEvents = 256;
+        static constexpr int pollMs = 5;
+
+        // How the record follows the hand: it catches up with it over 20 ms, its speed is smoothed
+        // over 5 ms and, let go, it takes 80 ms to get back up to the deck's speed.
+        static constexpr double followSeconds = 0.02;
+        static constexpr double smoothingSeconds = 0.005;
+        static constexpr double spinUpSeconds = 0.08;
+        static constexpr double maxSpeed = 8.0;
+        static constexpr double handBackTolerance = 0.002;
+
+        // Held by the background thread while decoding and by the message thread while swapping tracks.
+        juce::CriticalSection readerLock;
+        std::unique_ptr<juce::AudioFormatReader> reader;
+        juce::AudioBuffer<float> ring;
+
+        std::atomic<double> sourceSampleRate{ 0.0 };
+        std::atomic<juce::int64> sourceLength{ 0 };
+        std::atomic<juce::int64> validStart{ 0 };
+        std::atomic<juce::int64> validEnd{ 0 };
+        std::atomic<juce::int64> centre{ 0 };
+
+        // Bumped whenever the ring is emptied, so a block read from it meanwhile can be thrown away.
+        std::atomic<int> generation{ 0 };
+
+        juce::AbstractFifo eventFifo{ maxEvents };
+        JogEvent events[maxEvents];
+
+        // Only touched by the audio thread.
+        JogEvent blockEvents[maxEvents];
+        int numBlockEvents;
+        int blockGeneration;
+        double outputSampleRate;
+        bool isActive;
+        bool isTouched;
+        bool isPlayingBackwards;
+        bool handBackPending;
+        double playhead;
+        double velocity;
+        double handPosition;
+        double motor;
+
+        std::atomic<bool> reversed{ false };
+        std::atomic<bool> scratching{ false };
+        std::atomic<double> playheadSeconds{ 0.0 };
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScratchEngine)
+};
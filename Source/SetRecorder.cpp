@@ -0,0 +1,252 @@
+/*
+  ==============================================================================
+
+    SetRecorder.cpp
+    Created: 20 Oct 2026 1:03:19am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "SetRecorder.h"
+
+SetRecorder::SetRecorder()
+                        : juce::Thread("Set recorder")
+{
+    startThread(6);
+}
+
+SetRecorder::~SetRecorder()
+{
+    stopRecording();
+    stopThread(2000);
+}
+
+void SetRecorder::prepare(double _sampleRate)
+{
+    sampleRate = _sampleRate;
+}
+
+bool SetRecorder::startRecording(const juce::File& masterFile, bool shouldRecordStems, juce::String& error)
+{
+    if (recording.load())
+    {
+        error = "Already recording.";
+        return false;
+    }
+
+    const juce::ScopedLock sl(writerLock);
+    const int fifoSamples = juce::roundToInt(fifoSeconds * sampleRate.load());
+    const juce::String name = masterFile.getFileNameWithoutExtension();
+    const juce::String extension = masterFile.getFileExtension();
+
+    const juce::File files[numStreams] =
+    {
+        masterFile,
+        masterFile.getSiblingFile(name + " - Deck 1" + extension),
+        masterFile.getSiblingFile(name + " - Deck 2" + extension)
+    };
+
+    for (int stream = 0; stream < numStreams; ++stream)
+    {
+        Recording& recordingToStart = recordings[stream];
+        recordingToStart.isActive = false;
+        recordingToStart.samplesPushed = 0;
+        recordingToStart.samplesWritten = 0;
+        recordingToStart.samplesDropped = 0;
+        recordingToStart.overruns = 0;
+
+        if (stream != master && !shouldRecordStems)
+        {
+            continue;
+        }
+
+        recordingToStart.writer = createWriter(files[stream], error);
+
+        if (recordingToStart.writer == nullptr)
+        {
+            for (auto& recordingToClose : recordings)
+            {
+                recordingToClose.isActive = false;
+                recordingToClose.writer.reset();
+            }
+
+            return false;
+        }
+
+        // Nothing is pushed while not recording, so the FIFO can be resized here.
+        recordingToStart.fifo.setTotalSize(fifoSamples);
+        recordingToStart.ring.setSize(2, fifoSamples);
+        recordingToStart.isActive = true;
+    }
+
+    recording = true;
+    return true;
+}
+
+void SetRecorder::stopRecording()
+{
+    if (!recording.load())
+    {
+        return;
+    }
+
+    recording = false;
+
+    // A block that saw the recording running may still be going into a FIFO.
+    while (pushesInFlight.load() > 0)
+    {
+        juce::Thread::yield();
+    }
+
+    const juce::ScopedLock sl(writerLock);
+
+    for (auto& recordingToStop : recordings)
+    {
+        drain(recordingToStop);
+
+        // Deleting the writer finishes the file's header and closes it.
+        recordingToStop.isActive = false;
+        recordingToStop.writer.reset();
+    }
+}
+
+bool SetRecorder::isRecording() const
+{
+    return recording.load();
+}
+
+void SetRecorder::pushBlock(Stream stream, const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    ++pushesInFlight;
+
+    Recording& target = recordings[stream];
+    juce::AudioBuffer<float>* buffer = bufferToFill.buffer;
+
+    if (recording.load() && target.isActive.load()
+        && buffer != nullptr && buffer->getNumChannels() > 0 && bufferToFill.numSamples > 0)
+    {
+        int start1, size1, start2, size2;
+        target.fifo.prepareToWrite(bufferToFill.numSamples, start1, size1, start2, size2);
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            const float* source = buffer->getReadPointer(juce::jmin(channel, buffer->getNumChannels() - 1),
+                                                         bufferToFill.startSample);
+
+            juce::FloatVectorOperations::copy(target.ring.getWritePointer(channel, start1), source, size1);
+
+            if (size2 > 0)
+            {
+                juce::FloatVectorOperations::copy(target.ring.getWritePointer(channel, start2), source + size1, size2);
+            }
+        }
+
+        target.fifo.finishedWrite(size1 + size2);
+        target.samplesPushed += bufferToFill.numSamples;
+
+        // The disk has fallen ten seconds behind: drop what doesn't fit rather than wait.
+        if (size1 + size2 < bufferToFill.numSamples)
+        {
+            target.samplesDropped += bufferToFill.numSamples - (size1 + size2);
+            ++target.overruns;
+        }
+    }
+
+    --pushesInFlight;
+}
+
+SetRecorder::Stats SetRecorder::getStats(Stream stream) const
+{
+    const Recording& source = recordings[stream];
+
+    return { source.samplesPushed.load(), source.samplesWritten.load(),
+             source.samplesDropped.load(), source.overruns.load() };
+}
+
+double SetRecorder::getRecordedSeconds() const
+{
+    return recordings[master].samplesPushed.load() / sampleRate.load();
+}
+
+void SetRecorder::run()
+{
+    while (!threadShouldExit())
+    {
+        if (recording.load())
+        {
+            const juce::ScopedLock sl(writerLock);
+
+            for (auto& recordingToDrain : recordings)
+            {
+                drain(recordingToDrain);
+            }
+        }
+
+        wait(drainIntervalMs);
+    }
+}
+
+std::unique_ptr<juce::AudioFormatWriter> SetRecorder::createWriter(const juce::File& file, juce::String& error) const
+{
+    file.deleteFile();
+    std::unique_ptr<juce::FileOutputStream> stream = file.createOutputStream();
+
+    if (stream == nullptr || stream->failedToOpen())
+    {
+        error = "Couldn't create " + file.getFullPathName();
+        return nullptr;
+    }
+
+    std::unique_ptr<juce::AudioFormat> format;
+
+    if (file.hasFileExtension("flac"))
+    {
+        format.reset(new juce::FlacAudioFormat());
+    }
+    else
+    {
+        format.reset(new juce::WavAudioFormat());
+    }
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(), sampleRate.load(), 2,
+                                                                            bitsPerSample, {}, 0));
+
+    if (writer == nullptr)
+    {
+        error = "Can't record " + format->getFormatName() + " at this sample rate.";
+        return nullptr;
+    }
+
+    // The writer owns the stream now.
+    stream.release();
+    return writer;
+}
+
+void SetRecorder::drain(Recording& recordingToDrain)
+{
+    if (!recordingToDrain.isActive.load() || recordingToDrain.writer == nullptr)
+    {
+        return;
+    }
+
+    int start1, size1, start2, size2;
+    recordingToDrain.fifo.prepareToRead(recordingToDrain.fifo.getNumReady(), start1, size1, start2, size2);
+
+    const juce::AudioBuffer<float>& ring = recordingToDrain.ring;
+    const float* firstPart[] = { ring.getReadPointer(0, start1), ring.getReadPointer(1, start1) };
+    const float* secondPart[] = { ring.getReadPointer(0, start2), ring.getReadPointer(1, start2) };
+
+    if (size1 > 0)
+    {
+        recordingToDrain.writer->writeFromFloatArrays(firstPart, 2, size1);
+    }
+
+    if (size2 > 0)
+    {
+        recordingToDrain.writer->writeFromFloatArrays(secondPart, 2, size2);
+    }
+
+    recordingToDrain.fifo.finishedRead(size1 + size2);
+    recordingToDrain.samplesWritten += size1 + size2;
+}
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+    SetRecorder.h
+    Created: 20 Oct 2026 1:03:19am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <atomic>
+#include <memory>
+
+//==============================================================================
+/*
+    Records a set to disk: the master bus, and optionally each deck on its
+    own as a stem, as 24 bit WAV or FLAC files.
+
+    The audio thread only copies each block into a lock-free FIFO per file,
+    sized for ten seconds of audio. A background thread drains the FIFOs to
+    the files every few milliseconds, so a slow disk only fills the FIFOs up
+    and never holds up the audio. If a FIFO does fill up, the samples that
+    don't fit are counted rather than waited for; the counts show whether a
+    recording is complete.
+*/
+class SetRecorder : public juce::Thread
+{
+    public:
+        /** The files recorded at once. */
+        enum Stream
+        {
+            master = 0,
+            deck1,
+            deck2,
+            numStreams
+        };
+
+        /** What happened to the samples of one stream in the current or last recording. */
+        struct Stats
+        {
+            juce::int64 samplesPushed;
+            juce::int64 samplesWritten;
+            juce::int64 samplesDropped;
+            int overruns;
+        };
+
+        /**
+        * PURPOSE: Creates the SetRecorder object and starts its background thread.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        SetRecorder();
+
+        /**
+        * PURPOSE: Destroys the SetRecorder object, finishing any recording and stopping the thread.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~SetRecorder() override;
+
+        /**
+        * PURPOSE: Sets the sample rate that recordings will be made at.
+        * INPUTS: The sample rate.
+        * OUTPUTS: None.
+        */
+        void prepare(double sampleRate);
+
+        /**
+        * PURPOSE: Creates the files and starts recording. Stems are saved next to the master file,
+        *          named after it. Called from the message thread.
+        * INPUTS: The master file (FLAC if it ends in .flac and WAV otherwise), whether to record
+        *         a stem of each deck too and a reference to a string to be filled with the reason
+        *         if recording can't start.
+        * OUTPUTS: A boolean; true if recording started and false if it didn't.
+        */
+        bool startRecording(const juce::File& masterFile, bool shouldRecordStems, juce::String& error);
+
+        /**
+        * PURPOSE: Stops recording and returns once everything pushed is on disk and the files are
+        *          closed. Called from the message thread.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void stopRecording();
+
+        /**
+        * PURPOSE: Checks if a recording is running.
+        * INPUTS: None.
+        * OUTPUTS: A boolean; true if recording and false if not.
+        */
+        bool isRecording() const;
+
+        /**
+        * PURPOSE: Copies a block of audio into a stream's FIFO if it is being recorded. Called on
+        *          the audio thread; never blocks.
+        * INPUTS: The stream and the block, as handed to an audio source.
+        * OUTPUTS: None.
+        */
+        void pushBlock(Stream stream, const juce::AudioSourceChannelInfo& bufferToFill);
+
+        /**
+        * PURPOSE: Gets the sample counts of a stream in the current or last recording.
+        * INPUTS: The stream.
+        * OUTPUTS: The counts.
+        */
+        Stats getStats(Stream stream) const;
+
+        /**
+        * PURPOSE: Gets how much of the master bus has been recorded.
+        * INPUTS: None.
+        * OUTPUTS: The length of the recording in seconds.
+        */
+        double getRecordedSeconds() const;
+
+        /**
+        * PURPOSE: The background thread's main loop. Implements juce Thread (i.e. function is pure virtual).
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void run() override;
+
+    private:
+        /** A file being recorded, with the FIFO that feeds it. */
+        struct Recording
+        {
+            std::unique_ptr<juce::AudioFormatWriter> writer;
+            juce::AbstractFifo fifo{ 1 };
+            juce::AudioBuffer<float> ring;
+            std::atomic<bool> isActive{ false };
+            std::atomic<juce::int64> samplesPushed{ 0 };
+            std::atomic<juce::int64> samplesWritten{ 0 };
+            std::atomic<juce::int64> samplesDropped{ 0 };
+            std::atomic<int> overruns{ 0 };
+        };
+
+        /**
+        * PURPOSE: Creates the writer for a file, replacing it if it already exists.
+        * INPUTS: The file and a reference to a string to be filled with the reason if it fails.
+        * OUTPUTS: The writer, or nullptr if the file couldn't be created.
+        */
+        std::unique_ptr<juce::AudioFormatWriter> createWriter(const juce::File& file, juce::String& error) const;
+
+        /**
+        * PURPOSE: Writes everything in a stream's FIFO to its file. Called with writerLock held.
+        * INPUTS: The stream's recording.
+        * OUTPUTS: None.
+        */
+        void drain(Recording& recordingToDrain);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr double fifoSeconds = 10.0;
+        static constexpr int drainIntervalMs = 20;
+        static constexpr int bitsPerSample = 24;
+
+        std::atomic<double> sampleRate{ 44100.0 };
+        std::atomic<bool> recording{ false };
+
+        // The number of pushBlock() calls running, so that stopping can wait for the last of them.
+        std::atomic<int> pushesInFlight{ 0 };
+
+        // Held by the background thread while draining and by the message thread while
+        // opening or closing files. The audio thread never takes it.
+        juce::CriticalSection writerLock;
+        Recording recordings[numStreams];
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SetRecorder)
+};
@@ -0,0 +1,204 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.cpp
+    Created: 20 Oct 2026 12:37:52am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyser.h"
+#include <algorithm>
+#include <cmath>
+
+SpectrumAnalyser::SpectrumAnalyser()
+                                  : juce::Thread("Spectrum analyser"),
+                                    fifoBuffer((size_t) fifoSize, 0.0f),
+                                    timeline((size_t) fftSize, 0.0f),
+                                    fftData((size_t) fftSize * 2, 0.0f),
+                                    bandStarts((size_t) numBands, 0.0f),
+                                    bandEnds((size_t) numBands, 0.0f),
+                                    smoothedDb((size_t) numBands, minDb),
+                                    mappedSampleRate(0.0),
+                                    fallCoefficient(0.0f),
+                                    lastFrameRead(0)
+{
+    for (auto& frame : frames)
+    {
+        std::fill(std::begin(frame), std::end(frame), minDb);
+    }
+
+    startThread(3);
+}
+
+SpectrumAnalyser::~SpectrumAnalyser()
+{
+    stopThread(2000);
+}
+
+void SpectrumAnalyser::prepare(double sampleRate)
+{
+    pushedSampleRate = sampleRate;
+}
+
+void SpectrumAnalyser::pushSamples(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    juce::AudioBuffer<float>* buffer = bufferToFill.buffer;
+
+    if (buffer == nullptr || buffer->getNumChannels() == 0 || bufferToFill.numSamples <= 0)
+    {
+        return;
+    }
+
+    const float* left = buffer->getReadPointer(0, bufferToFill.startSample);
+    const float* right = buffer->getReadPointer(buffer->getNumChannels() > 1 ? 1 : 0, bufferToFill.startSample);
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(bufferToFill.numSamples, start1, size1, start2, size2);
+
+    for (int i = 0; i < size1; ++i)
+    {
+        fifoBuffer[(size_t) (start1 + i)] = 0.5f * (left[i] + right[i]);
+    }
+
+    for (int i = 0; i < size2; ++i)
+    {
+        fifoBuffer[(size_t) (start2 + i)] = 0.5f * (left[size1 + i] + right[size1 + i]);
+    }
+
+    fifo.finishedWrite(size1 + size2);
+}
+
+bool SpectrumAnalyser::getNextFrame(float* levelsDb)
+{
+    const juce::uint32 count = frameCount.load();
+
+    if (count == lastFrameRead)
+    {
+        return false;
+    }
+
+    // Claim the published buffer, then make sure it wasn't replaced before the claim landed.
+    int index = publishedIndex.load();
+    readingIndex = index;
+
+    while (publishedIndex.load() != index)
+    {
+        index = publishedIndex.load();
+        readingIndex = index;
+    }
+
+    std::copy(std::begin(frames[index]), std::end(frames[index]), levelsDb);
+    readingIndex = -1;
+
+    lastFrameRead = count;
+    return true;
+}
+
+void SpectrumAnalyser::run()
+{
+    while (!threadShouldExit())
+    {
+        const double sampleRate = pushedSampleRate.load();
+
+        if (sampleRate != mappedSampleRate)
+        {
+            mapBands(sampleRate);
+        }
+
+        // The audio thread doesn't wake this thread, so it looks for new samples every few ms.
+        while (fifo.getNumReady() >= hopSize && !threadShouldExit())
+        {
+            int start1, size1, start2, size2;
+            fifo.prepareToRead(hopSize, start1, size1, start2, size2);
+
+            std::copy(timeline.begin() + hopSize, timeline.end(), timeline.begin());
+            std::copy(fifoBuffer.begin() + start1, fifoBuffer.begin() + start1 + size1, timeline.end() - hopSize);
+            std::copy(fifoBuffer.begin() + start2, fifoBuffer.begin() + start2 + size2, timeline.end() - hopSize + size1);
+
+            fifo.finishedRead(size1 + size2);
+            analyseFrame();
+        }
+
+        wait(pollMs);
+    }
+}
+
+float SpectrumAnalyser::getProportionOfBands(double frequency)
+{
+    return (float) (std::log(frequency / minHz) / std::log(maxHz / minHz));
+}
+
+void SpectrumAnalyser::mapBands(double sampleRate)
+{
+    const double hzPerBin = sampleRate / fftSize;
+    const float lastBin = fftSize / 2.0f;
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        double lowHz = minHz * std::pow(maxHz / minHz, (double) band / numBands);
+        double highHz = minHz * std::pow(maxHz / minHz, (double) (band + 1) / numBands);
+
+        bandStarts[(size_t) band] = juce::jmin(lastBin, (float) (lowHz / hzPerBin));
+        bandEnds[(size_t) band] = juce::jmin(lastBin, (float) (highHz / hzPerBin));
+    }
+
+    fallCoefficient = (float) (1.0 - std::exp(-hopSize / (fallSeconds * sampleRate)));
+    mappedSampleRate = sampleRate;
+}
+
+void SpectrumAnalyser::analyseFrame()
+{
+    std::copy(timeline.begin(), timeline.end(), fftData.begin());
+    window.multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+    // A full scale sine reads 0 dB: the Hann window passes half of it, split over two halves of the spectrum.
+    const float scale = 4.0f / fftSize;
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        const float startBin = bandStarts[(size_t) band];
+        const float endBin = bandEnds[(size_t) band];
+        const int firstBin = (int) std::ceil(startBin);
+        const int lastBin = (int) std::floor(endBin);
+        float magnitude = 0.0f;
+
+        if (lastBin >= firstBin)
+        {
+            // A wide band shows the loudest bin in it.
+            magnitude = *std::max_element(fftData.begin() + firstBin, fftData.begin() + lastBin + 1);
+        }
+        else
+        {
+            // A band narrower than a bin (in the bass) reads between the bins either side of its middle.
+            const float middle = 0.5f * (startBin + endBin);
+            const int below = (int) middle;
+            const float fraction = middle - below;
+            magnitude = fftData[(size_t) below] + fraction * (fftData[(size_t) below + 1] - fftData[(size_t) below]);
+        }
+
+        const float levelDb = juce::Decibels::gainToDecibels(magnitude * scale, minDb);
+        float& smoothed = smoothedDb[(size_t) band];
+
+        // Rise at once, fall back smoothly.
+        smoothed = levelDb > smoothed ? levelDb : smoothed + (levelDb - smoothed) * fallCoefficient;
+    }
+
+    publishFrame();
+}
+
+void SpectrumAnalyser::publishFrame()
+{
+    const int index = 1 - publishedIndex.load();
+
+    if (readingIndex.load() == index)
+    {
+        return;
+    }
+
+    std::copy(smoothedDb.begin(), smoothedDb.end(), frames[index]);
+    publishedIndex = index;
+    ++frameCount;
+}
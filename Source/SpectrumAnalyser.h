@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.h
+    Created: 20 Oct 2026 12:37:52am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+/*
+    Analyses the spectrum of the master bus for a SpectrumDisplay to show.
+
+    The audio thread only copies the samples (left and right summed to mono)
+    into a lock-free FIFO. A background thread takes them out, runs a
+    Hann-windowed FFT of the last 2048 samples every 512 samples, and bins
+    the result into bands spaced evenly in log frequency from 20 Hz to
+    20 kHz. Each band rises at once and falls back smoothly, so the display
+    is steady enough to read.
+
+    Finished frames are handed to the GUI through a double buffer: the
+    background thread writes into the buffer the GUI isn't reading and
+    publishes it with an atomic, so neither side ever waits for the other.
+*/
+class SpectrumAnalyser : public juce::Thread
+{
+    public:
+        /**
+        * PURPOSE: Creates the SpectrumAnalyser object and starts its background thread.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        SpectrumAnalyser();
+
+        /**
+        * PURPOSE: Destroys the SpectrumAnalyser object and stops the thread.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~SpectrumAnalyser() override;
+
+        /**
+        * PURPOSE: Sets the sample rate of the samples that will be pushed.
+        * INPUTS: The sample rate.
+        * OUTPUTS: None.
+        */
+        void prepare(double sampleRate);
+
+        /**
+        * PURPOSE: Copies a block of audio into the FIFO, dropping what doesn't fit if the background
+        *          thread has fallen behind. Called on the audio thread; never blocks.
+        * INPUTS: The block, as handed to an audio source.
+        * OUTPUTS: None.
+        */
+        void pushSamples(const juce::AudioSourceChannelInfo& bufferToFill);
+
+        /**
+        * PURPOSE: Copies out the latest frame, if one has been finished since the last call.
+        *          Called from the message thread.
+        * INPUTS: An array of numBands levels to be filled, in dB.
+        * OUTPUTS: A boolean; true if a new frame was copied and false if there was none.
+        */
+        bool getNextFrame(float* levelsDb);
+
+        /**
+        * PURPOSE: The background thread's main loop. Implements juce Thread (i.e. function is pure virtual).
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void run() override;
+
+        /**
+        * PURPOSE: Works out where a frequency falls on the log-frequency axis of the bands.
+        * INPUTS: The frequency in Hz.
+        * OUTPUTS: The proportion of the way from minHz to maxHz.
+        */
+        static float getProportionOfBands(double frequency);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int numBands = 96;
+        static constexpr double minHz = 20.0;
+        static constexpr double maxHz = 20000.0;
+        static constexpr float minDb = -90.0f;
+
+    private:
+        /**
+        * PURPOSE: Works out which FFT bins each band covers, for the current sample rate.
+        * INPUTS: The sample rate.
+        * OUTPUTS: None.
+        */
+        void mapBands(double sampleRate);
+
+        /**
+        * PURPOSE: Analyses the last fftSize samples and publishes the frame.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void analyseFrame();
+
+        /**
+        * PURPOSE: Copies the smoothed levels into the buffer the GUI isn't reading and publishes it.
+        *          The frame is skipped if the GUI is still reading the other one.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void publishFrame();
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int fftOrder = 11;
+        static constexpr int fftSize = 1 << fftOrder;
+        static constexpr int hopSize = fftSize / 4;
+        static constexpr int fifoSize = 1 << 15;
+        static constexpr int pollMs = 5;
+        static constexpr double fallSeconds = 0.3;
+
+        // Written by the audio thread, read by the background thread.
+        juce::AbstractFifo fifo{ fifoSize };
+        std::vector<float> fifoBuffer;
+        std::atomic<double> pushedSampleRate{ 44100.0 };
+
+        // On the background thread.
+        juce::dsp::FFT fft{ fftOrder };
+        juce::dsp::WindowingFunction<float> window{ (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann, false };
+        std::vector<float> timeline;
+        std::vector<float> fftData;
+        std::vector<float> bandStarts;
+        std::vector<float> bandEnds;
+        std::vector<float> smoothedDb;
+        double mappedSampleRate;
+        float fallCoefficient;
+
+        // The double buffer. The GUI claims a buffer in readingIndex before copying it out.
+        float frames[2][numBands];
+        std::atomic<int> publishedIndex{ 0 };
+        std::atomic<int> readingIndex{ -1 };
+        std::atomic<juce::uint32> frameCount{ 0 };
+        juce::uint32 lastFrameRead;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyser)
+};
@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    SpectrumDisplay.cpp
+    Created: 20 Oct 2026 12:37:52am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "SpectrumDisplay.h"
+
+//==============================================================================
+SpectrumDisplay::SpectrumDisplay(SpectrumAnalyser* _analyser)
+                                : analyser(_analyser)
+{
+    for (int band = 0; band < SpectrumAnalyser::numBands; ++band)
+    {
+        levelsDb[band] = SpectrumAnalyser::minDb;
+        bandXs[band] = 0.0f;
+    }
+
+    setInterceptsMouseClicks(false, false);
+    startTimerHz(refreshRateHz);
+}
+
+SpectrumDisplay::~SpectrumDisplay()
+{
+}
+
+void SpectrumDisplay::paint (juce::Graphics& g)
+{
+    g.setColour(juce::Colour::fromRGBA(35, 36, 40, 255));
+    g.fillRoundedRectangle(getLocalBounds().toFloat(), 3);
+
+    g.setColour(juce::Colours::grey.withAlpha(0.4f));
+    g.strokePath(gridPath, juce::PathStrokeType(1.0f));
+
+    g.setColour(juce::Colours::yellowgreen.withAlpha(0.3f));
+    g.fillPath(spectrumPath);
+    g.setColour(juce::Colours::yellowgreen);
+    g.strokePath(spectrumPath, juce::PathStrokeType(1.0f));
+}
+
+void SpectrumDisplay::resized()
+{
+    float w = (float) getWidth();
+    float h = (float) getHeight();
+
+    for (int band = 0; band < SpectrumAnalyser::numBands; ++band)
+    {
+        bandXs[band] = w * (band + 0.5f) / SpectrumAnalyser::numBands;
+    }
+
+    // A line at 100 Hz, 1 kHz and 10 kHz, and every 30 dB.
+    gridPath.clear();
+
+    for (double frequency = 100.0; frequency < SpectrumAnalyser::maxHz; frequency *= 10.0)
+    {
+        float x = w * SpectrumAnalyser::getProportionOfBands(frequency);
+        gridPath.startNewSubPath(x, 0);
+        gridPath.lineTo(x, h);
+    }
+
+    for (float db = -30.0f; db > SpectrumAnalyser::minDb; db -= 30.0f)
+    {
+        float y = h * db / SpectrumAnalyser::minDb;
+        gridPath.startNewSubPath(0, y);
+        gridPath.lineTo(w, y);
+    }
+
+    spectrumPath.preallocateSpace(3 * (SpectrumAnalyser::numBands + 4));
+    updatePath();
+}
+
+void SpectrumDisplay::timerCallback()
+{
+    if (analyser->getNextFrame(levelsDb))
+    {
+        updatePath();
+        repaint();
+    }
+}
+
+void SpectrumDisplay::updatePath()
+{
+    float w = (float) getWidth();
+    float h = (float) getHeight();
+
+    // Clearing keeps the path's storage, so this only rewrites the points.
+    spectrumPath.clear();
+    spectrumPath.startNewSubPath(0, h);
+
+    for (int band = 0; band < SpectrumAnalyser::numBands; ++band)
+    {
+        float proportion = juce::jlimit(0.0f, 1.0f, levelsDb[band] / SpectrumAnalyser::minDb);
+        spectrumPath.lineTo(bandXs[band], h * proportion);
+    }
+
+    spectrumPath.lineTo(w, h);
+    spectrumPath.closeSubPath();
+}
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    SpectrumDisplay.h
+    Created: 20 Oct 2026 12:37:52am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "SpectrumAnalyser.h"
+
+//==============================================================================
+/*
+    Draws the frames of a SpectrumAnalyser as a filled curve over a grid of
+    octaves and levels.
+
+    The grid and where each band sits across the display are worked out only
+    when the display is resized. A timer at the screen's refresh rate checks
+    for a new frame and, if there is one, moves the curve's points to the new
+    levels in the same path, so painting is only filling and stroking it.
+*/
+class SpectrumDisplay  : public juce::Component,
+                         public juce::Timer
+{
+    public:
+        /**
+        * PURPOSE: Creates the SpectrumDisplay object and starts a timer.
+        * INPUTS: A pointer to the SpectrumAnalyser to show.
+        * OUTPUTS: None.
+        */
+        SpectrumDisplay(SpectrumAnalyser* _analyser);
+
+        /**
+        * PURPOSE: Destroys the SpectrumDisplay object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~SpectrumDisplay() override;
+
+        /**
+        * PURPOSE: Draws the component's contents. Overrides juce Component member function.
+        * INPUTS: The graphics context that must be used to do the drawing operations.
+        * OUTPUTS: None.
+        */
+        void paint (juce::Graphics& g) override;
+
+        /**
+        * PURPOSE: Works out the grid and the bands' positions when the component's width or height
+        *          changes. Overrides juce Component member function.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void resized() override;
+
+        /**
+        * PURPOSE: The user-defined callback routine that actually gets called periodically.
+        *          Implements juce Timer.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void timerCallback() override;
+
+    private:
+        /**
+        * PURPOSE: Rebuilds the curve from the latest levels, at the precomputed band positions.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void updatePath();
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int refreshRateHz = 60;
+
+        SpectrumAnalyser* analyser;
+
+        float levelsDb[SpectrumAnalyser::numBands];
+        float bandXs[SpectrumAnalyser::numBands];
+        juce::Path spectrumPath;
+        juce::Path gridPath;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumDisplay)
+};
@@ -0,0 +1,283 @@
+/*
+  ==============================================================================
+
+    StereoBiquad.cpp
+    Created: 19 Oct 2026 10:12:44pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "StereoBiquad.h"
+#include <cmath>
+
+StereoBiquad::Coefficients StereoBiquad::Coefficients::makeKWeightingShelf(double sampleRate)
+{
+    // The analogue prototype of BS.1770, re-designed for any sample rate (at 48 kHz
+    // it gives the coefficients printed in the standard).
+    const double centreFrequency = 1681.974450955533;
+    const double gainDb = 3.999843853973347;
+    const double q = 0.7071752369554196;
+
+    const double k = std::tan(juce::MathConstants<double>::pi * centreFrequency / sampleRate);
+    const double highGain = std::pow(10.0, gainDb / 20.0);
+    const double bandGain = std::pow(highGain, 0.4996667741545416);
+    const double a0 = 1.0 + k / q + k * k;
+
+    return { (highGain + bandGain * k / q + k * k) / a0,
+             2.0 * (k * k - highGain) / a0,
+             (highGain - bandGain * k / q + k * k) / a0,
+             2.0 * (k * k - 1.0) / a0,
+             (1.0 - k / q + k * k) / a0 };
+}
+
+StereoBiquad::Coefficients StereoBiquad::Coefficients::makeKWeightingHighPass(double sampleRate)
+{
+    const double cutoff = 38.13547087602444;
+    const double q = 0.5003270373238773;
+
+    const double k = std::tan(juce::MathConstants<double>::pi * cutoff / sampleRate);
+    const double a0 = 1.0 + k / q + k * k;
+
+    return { 1.0,
+             -2.0,
+             1.0,
+             2.0 * (k * k - 1.0) / a0,
+             (1.0 - k / q + k * k) / a0 };
+}
+
+StereoBiquad::Coefficients StereoBiquad::Coefficients::makeLowShelf(double sampleRate,
+                                                                    double frequency,
+                                                                    double q,
+                                                                    double gainDb)
+{
+    const double a = std::pow(10.0, gainDb / 40.0);
+    const double w0 = 2.0 * juce::MathConstants<double>::pi * frequency / sampleRate;
+    const double cosW0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double twoSqrtAAlpha = 2.0 * std::sqrt(a) * alpha;
+
+    return normalise(a * ((a + 1.0) - (a - 1.0) * cosW0 + twoSqrtAAlpha),
+                     2.0 * a * ((a - 1.0) - (a + 1.0) * cosW0),
+                     a * ((a + 1.0) - (a - 1.0) * cosW0 - twoSqrtAAlpha),
+                     (a + 1.0) + (a - 1.0) * cosW0 + twoSqrtAAlpha,
+                     -2.0 * ((a - 1.0) + (a + 1.0) * cosW0),
+                     (a + 1.0) + (a - 1.0) * cosW0 - twoSqrtAAlpha);
+}
+
+StereoBiquad::Coefficients StereoBiquad::Coefficients::makePeak(double sampleRate,
+                                                                double frequency,
+                                                                double q,
+                                                                double gainDb)
+{
+    const double a = std::pow(10.0, gainDb / 40.0);
+    const double w0 = 2.0 * juce::MathConstants<double>::pi * frequency / sampleRate;
+    const double cosW0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+
+    return normalise(1.0 + alpha * a,
+                     -2.0 * cosW0,
+                     1.0 - alpha * a,
+                     1.0 + alpha / a,
+                     -2.0 * cosW0,
+                     1.0 - alpha / a);
+}
+
+StereoBiquad::Coefficients StereoBiquad::Coefficients::makeHighShelf(double sampleRate,
+                                                                     double frequency,
+                                                                     double q,
+                                                                     double gainDb)
+{
+    const double a = std::pow(10.0, gainDb / 40.0);
+    const double w0 = 2.0 * juce::MathConstants<double>::pi * frequency / sampleRate;
+    const double cosW0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double twoSqrtAAlpha = 2.0 * std::sqrt(a) * alpha;
+
+    return normalise(a * ((a + 1.0) + (a - 1.0) * cosW0 + twoSqrtAAlpha),
+                     -2.0 * a * ((a - 1.0) + (a + 1.0) * cosW0),
+                     a * ((a + 1.0) + (a - 1.0) * cosW0 - twoSqrtAAlpha),
+                     (a + 1.0) - (a - 1.0) * cosW0 + twoSqrtAAlpha,
+                     2.0 * ((a - 1.0) - (a + 1.0) * cosW0),
+                     (a + 1.0) - (a - 1.0) * cosW0 - twoSqrtAAlpha);
+}
+
+StereoBiquad::Coefficients StereoBiquad::Coefficients::makeLowPass(double sampleRate, double frequency, double q)
+{
+    const double w0 = 2.0 * juce::MathConstants<double>::pi * frequency / sampleRate;
+    const double cosW0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+
+    return normalise((1.0 - cosW0) / 2.0,
+                     1.0 - cosW0,
+                     (1.0 - cosW0) / 2.0,
+                     1.0 + alpha,
+                     -2.0 * cosW0,
+                     1.0 - alpha);
+}
+
+StereoBiquad::Coefficients StereoBiquad::Coefficients::makeHighPass(double sampleRate, double frequency, double q)
+{
+    const double w0 = 2.0 * juce::MathConstants<double>::pi * frequency / sampleRate;
+    const double cosW0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+
+    return normalise((1.0 + cosW0) / 2.0,
+                     -(1.0 + cosW0),
+                     (1.0 + cosW0) / 2.0,
+                     1.0 + alpha,
+                     -2.0 * cosW0,
+                     1.0 - alpha);
+}
+
+StereoBiquad::Coefficients StereoBiquad::Coefficients::makePassThrough()
+{
+    return { 1.0, 0.0, 0.0, 0.0, 0.0 };
+}
+
+StereoBiquad::Coefficients StereoBiquad::Coefficients::normalise(double b0,
+                                                                 double b1,
+                                                                 double b2,
+                                                                 double a0,
+                                                                 double a1,
+                                                                 double a2)
+{
+    return { b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0 };
+}
+
+StereoBiquad::StereoBiquad()
+                          : rampSamplesLeft(0)
+{
+    setCoefficients(Coefficients::makePassThrough());
+    reset();
+}
+
+StereoBiquad::~StereoBiquad()
+{
+}
+
+void StereoBiquad::setCoefficients(const Coefficients& coefficients)
+{
+    b0 = Vector::expand(coefficients.b0);
+    b1 = Vector::expand(coefficients.b1);
+    b2 = Vector::expand(coefficients.b2);
+    a1 = Vector::expand(coefficients.a1);
+    a2 = Vector::expand(coefficients.a2);
+
+    target = coefficients;
+    rampSamplesLeft = 0;
+}
+
+void StereoBiquad::rampToCoefficients(const Coefficients& coefficients, int rampLength)
+{
+    if (rampLength <= 0)
+    {
+        setCoefficients(coefficients);
+        return;
+    }
+
+    // Both lanes hold the same coefficients, so the first lane is where the ramp is now.
+    const Vector steps = Vector::expand(1.0 / rampLength);
+
+    b0Step = (Vector::expand(coefficients.b0) - b0) * steps;
+    b1Step = (Vector::expand(coefficients.b1) - b1) * steps;
+    b2Step = (Vector::expand(coefficients.b2) - b2) * steps;
+    a1Step = (Vector::expand(coefficients.a1) - a1) * steps;
+    a2Step = (Vector::expand(coefficients.a2) - a2) * steps;
+
+    target = coefficients;
+    rampSamplesLeft = rampLength;
+}
+
+bool StereoBiquad::isRamping() const
+{
+    return rampSamplesLeft > 0;
+}
+
+void StereoBiquad::reset()
+{
+    state1 = Vector::expand(0.0);
+    state2 = Vector::expand(0.0);
+}
+
+void StereoBiquad::process(const float* leftIn, const float* rightIn, float* leftOut, float* rightOut, int numSamples)
+{
+    int numRampSamples = juce::jmin(numSamples, rampSamplesLeft);
+
+    if (numRampSamples > 0)
+    {
+        processRamp(leftIn, rightIn, leftOut, rightOut, numRampSamples);
+        rampSamplesLeft -= numRampSamples;
+
+        if (rampSamplesLeft == 0)
+        {
+            // Land exactly on the target rather than on the sum of the steps.
+            setCoefficients(target);
+        }
+    }
+
+    processSteady(leftIn + numRampSamples, rightIn + numRampSamples,
+                  leftOut + numRampSamples, rightOut + numRampSamples,
+                  numSamples - numRampSamples);
+}
+
+void StereoBiquad::processRamp(const float* leftIn, const float* rightIn, float* leftOut, float* rightOut, int numSamples)
+{
+    alignas(Vector::SIMDRegisterSize) double frame[Vector::SIMDNumElements] = {};
+
+    Vector s1 = state1;
+    Vector s2 = state2;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        b0 += b0Step;
+        b1 += b1Step;
+        b2 += b2Step;
+        a1 += a1Step;
+        a2 += a2Step;
+
+        frame[0] = leftIn[i];
+        frame[1] = rightIn[i];
+
+        const Vector x = Vector::fromRawArray(frame);
+        const Vector y = b0 * x + s1;
+
+        s1 = b1 * x - a1 * y + s2;
+        s2 = b2 * x - a2 * y;
+
+        y.copyToRawArray(frame);
+        leftOut[i] = (float) frame[0];
+        rightOut[i] = (float) frame[1];
+    }
+
+    state1 = s1;
+    state2 = s2;
+}
+
+void StereoBiquad::processSteady(const float* leftIn, const float* rightIn, float* leftOut, float* rightOut, int numSamples)
+{
+    alignas(Vector::SIMDRegisterSize) double frame[Vector::SIMDNumElements] = {};
+
+    // The state lives in locals for the length of the block, so it stays in registers.
+    Vector s1 = state1;
+    Vector s2 = state2;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        frame[0] = leftIn[i];
+        frame[1] = rightIn[i];
+
+        const Vector x = Vector::fromRawArray(frame);
+        const Vector y = b0 * x + s1;
+
+        s1 = b1 * x - a1 * y + s2;
+        s2 = b2 * x - a2 * y;
+
+        y.copyToRawArray(frame);
+        leftOut[i] = (float) frame[0];
+        rightOut[i] = (float) frame[1];
+    }
+
+    state1 = s1;
+    state2 = s2;
+}
@@ -0,0 +1,191 @@
+/*
+  ==============================================================================
+
+    StereoBiquad.h
+    Created: 19 Oct 2026 10:12:44pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    A biquad filter that runs both channels of a stereo signal at once.
+
+    The left and right samples share one SIMD register of doubles (two lanes on
+    SSE2 and NEON), so one set of vector multiplies and adds filters both
+    channels. The filter is a transposed direct form II, in double precision so
+    that low frequency filters stay quiet and stable.
+
+    Coefficients are normalised (a0 = 1). The design functions follow the
+    Audio EQ Cookbook, except for the K-weighting stages of ITU-R BS.1770.
+
+    New coefficients can also be ramped to, sample by sample, so that a filter
+    can be swept while it plays without clicks or zipper noise. The ramp is a
+    straight line between the two sets of coefficients; every set on the way
+    between two stable filters is stable too, so the ramp never blows up.
+*/
+class StereoBiquad
+{
+    public:
+        /** The normalised coefficients of a biquad: b0, b1, b2 feed forward and a1, a2 feed back. */
+        struct Coefficients
+        {
+            double b0, b1, b2, a1, a2;
+
+            /**
+            * PURPOSE: Designs the first K-weighting stage of ITU-R BS.1770: a high shelf
+            *          of about +4 dB that models the acoustic effect of the head.
+            * INPUTS: The sample rate.
+            * OUTPUTS: The coefficients.
+            */
+            static Coefficients makeKWeightingShelf(double sampleRate);
+
+            /**
+            * PURPOSE: Designs the second K-weighting stage of ITU-R BS.1770: the "RLB" high pass at about 38 Hz.
+            * INPUTS: The sample rate.
+            * OUTPUTS: The coefficients.
+            */
+            static Coefficients makeKWeightingHighPass(double sampleRate);
+
+            /**
+            * PURPOSE: Designs a low shelf, which boosts or cuts everything below a frequency.
+            * INPUTS: The sample rate, the frequency of the shelf's midpoint in Hz, its Q and its gain in dB.
+            * OUTPUTS: The coefficients.
+            */
+            static Coefficients makeLowShelf(double sampleRate, double frequency, double q, double gainDb);
+
+            /**
+            * PURPOSE: Designs a peaking filter, which boosts or cuts a band around a frequency.
+            * INPUTS: The sample rate, the centre frequency in Hz, the Q and the gain in dB.
+            * OUTPUTS: The coefficients.
+            */
+            static Coefficients makePeak(double sampleRate, double frequency, double q, double gainDb);
+
+            /**
+            * PURPOSE: Designs a high shelf, which boosts or cuts everything above a frequency.
+            * INPUTS: The sample rate, the frequency of the shelf's midpoint in Hz, its Q and its gain in dB.
+            * OUTPUTS: The coefficients.
+            */
+            static Coefficients makeHighShelf(double sampleRate, double frequency, double q, double gainDb);
+
+            /**
+            * PURPOSE: Designs a 12 dB per octave low pass.
+            * INPUTS: The sample rate, the cutoff frequency in Hz and the Q (resonance).
+            * OUTPUTS: The coefficients.
+            */
+            static Coefficients makeLowPass(double sampleRate, double frequency, double q);
+
+            /**
+            * PURPOSE: Designs a 12 dB per octave high pass.
+            * INPUTS: The sample rate, the cutoff frequency in Hz and the Q (resonance).
+            * OUTPUTS: The coefficients.
+            */
+            static Coefficients makeHighPass(double sampleRate, double frequency, double q);
+
+            /**
+            * PURPOSE: Makes the coefficients of a filter that passes everything unchanged.
+            * INPUTS: None.
+            * OUTPUTS: The coefficients.
+            */
+            static Coefficients makePassThrough();
+
+            /**
+            * PURPOSE: Divides the coefficients of a cookbook design by its a0.
+            * INPUTS: The six unnormalised coefficients.
+            * OUTPUTS: The normalised coefficients.
+            */
+            static Coefficients normalise(double b0, double b1, double b2, double a0, double a1, double a2);
+        };
+
+        /**
+        * PURPOSE: Creates the StereoBiquad object as a filter that passes everything unchanged.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        StereoBiquad();
+
+        /**
+        * PURPOSE: Destroys the StereoBiquad object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~StereoBiquad();
+
+        /**
+        * PURPOSE: Sets the coefficients of both channels. Takes effect from the next sample and
+        *          stops any ramp that was under way.
+        * INPUTS: The coefficients.
+        * OUTPUTS: None.
+        */
+        void setCoefficients(const Coefficients& coefficients);
+
+        /**
+        * PURPOSE: Ramps the coefficients of both channels from where they are now to new ones, over
+        *          the next rampLength samples. A new target replaces the old one from wherever the
+        *          ramp has got to. Allocates nothing, so it can be called on the audio thread.
+        * INPUTS: The coefficients to ramp to and the length of the ramp in samples (0 or less
+        *         sets them at once).
+        * OUTPUTS: None.
+        */
+        void rampToCoefficients(const Coefficients& coefficients, int rampLength);
+
+        /**
+        * PURPOSE: Checks if the coefficients are still ramping towards a target.
+        * INPUTS: None.
+        * OUTPUTS: A boolean; true if the coefficients are ramping and false if they have settled.
+        */
+        bool isRamping() const;
+
+        /**
+        * PURPOSE: Clears the filter's memory of past samples.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void reset();
+
+        /**
+        * PURPOSE: Filters a block of stereo samples in place, or copies it filtered into other buffers.
+        * INPUTS: The left and right input channels, the left and right output channels (may be the
+        *         same as the inputs) and the number of samples.
+        * OUTPUTS: None.
+        */
+        void process(const float* leftIn, const float* rightIn, float* leftOut, float* rightOut, int numSamples);
+
+    private:
+        using Vector = juce::dsp::SIMDRegister<double>;
+
+        static_assert(Vector::SIMDNumElements >= 2, "Both channels must fit in one register");
+
+        /**
+        * PURPOSE: Filters samples with the coefficients moving one step along the ramp every sample.
+        * INPUTS: The left and right input and output channels and the number of samples, which
+        *         must not be more than the samples left in the ramp.
+        * OUTPUTS: None.
+        */
+        void processRamp(const float* leftIn, const float* rightIn, float* leftOut, float* rightOut, int numSamples);
+
+        /**
+        * PURPOSE: Filters samples with fixed coefficients.
+        * INPUTS: The left and right input and output channels and the number of samples.
+        * OUTPUTS: None.
+        */
+        void processSteady(const float* leftIn, const float* rightIn, float* leftOut, float* rightOut, int numSamples);
+
+
+        /** DATA MEMBERS */
+
+        Vector b0, b1, b2, a1, a2;
+        Vector state1, state2;
+
+        // The step added to each coefficient every sample of a ramp, and where the ramp ends.
+        Vector b0Step, b1Step, b2Step, a1Step, a2Step;
+        Coefficients target;
+        int rampSamplesLeft;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StereoBiquad)
+};
@@ -9,13 +9,178 @@
 */
 
 #include "Track.h"
+#include "CamelotKey.h"
+#include <cstring>
 
 Track::Track(juce::String _title, 
-             juce::String _length, 
-             juce::String _path)
-            : title(_title), 
-              length(_length), 
-              path(_path)
+             juce::String _path,
+             juce::uint64 _contentHash)
+            : id(createId(_path)),
+              title(_title), 
+              path(_path),
+              contentHash(_contentHash),
+              lengthInSamples(0),
+              sampleRate(0.0),
+              bpm(0.0f),
+              detectedBpm(0.0f),
+              detectedKey(CamelotKey::noKey),
+              analysisVersion(0),
+              fileSize(0),
+              modificationTime(0)
 {
 
+}
+
+Track::Track(TrackId _id,
+             juce::String _title,
+             juce::String _path,
+             juce::uint64 _contentHash)
+            : id(_id),
+              title(_title),
+              path(_path),
+              contentHash(_contentHash),
+              lengthInSamples(0),
+              sampleRate(0.0),
+              bpm(0.0f),
+              detectedBpm(0.0f),
+              detectedKey(CamelotKey::noKey),
+              analysisVersion(0),
+              fileSize(0),
+              modificationTime(0)
+{
+
+}
+
+juce::String Track::getDisplayName() const
+{
+    if (artist.isEmpty())
+    {
+        return title;
+    }
+
+    return artist + " - " + title;
+}
+
+double Track::getLengthInSeconds() const
+{
+    if (sampleRate <= 0.0)
+    {
+        return 0.0;
+    }
+
+    return lengthInSamples / sampleRate;
+}
+
+juce::String Track::getLengthText() const
+{
+    return formatLength(getLengthInSeconds());
+}
+
+juce::String Track::formatLength(double lengthInSecs)
+{
+    int minutes = (int) floor(lengthInSecs / 60.0);
+    int seconds = (int) floor(lengthInSecs - (minutes * 60.0));
+
+    juce::String songLength;
+
+    if (seconds >= 0 && seconds < 10)
+    {
+        songLength = juce::String{ minutes } + ":0" + juce::String{ seconds };
+    }
+    else
+    {
+        songLength = juce::String{ minutes } + ":" + juce::String{ seconds };
+    }
+
+    return songLength;
+}
+
+TrackId Track::createId(const juce::String& path)
+{
+    // 64-bit FNV-1a hash of the normalised path.
+    juce::String normalisedPath = normalisePath(path);
+    TrackId hash = 14695981039346656037ull;
+
+    for (auto* c = normalisedPath.toRawUTF8(); *c != 0; ++c)
+    {
+        hash ^= (juce::uint8) *c;
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+juce::String Track::normalisePath(const juce::String& path)
+{
+    juce::String fullPath = path;
+
+    if (juce::File::isAbsolutePath(path))
+    {
+        fullPath = juce::File{ path }.getFullPathName();
+    }
+    else if (juce::URL{ path }.isLocalFile())
+    {
+        fullPath = juce::URL{ path }.getLocalFile().getFullPathName();
+    }
+
+    if (!juce::File::areFileNamesCaseSensitive())
+    {
+        fullPath = fullPath.toLowerCase();
+    }
+
+    return fullPath;
+}
+
+juce::uint64 Track::createContentHash(const juce::File& file)
+{
+    const int blockSize = 1 << 20;
+    juce::FileInputStream stream{ file };
+
+    if (stream.failedToOpen())
+    {
+        return 0;
+    }
+
+    juce::int64 fileSize = stream.getTotalLength();
+    juce::HeapBlock<char> buffer(blockSize);
+    juce::uint64 hash = 14695981039346656037ull;
+
+    // FNV-1a over 8-byte words, with a shift that folds the high bits back into the low ones.
+    auto addWord = [&hash](juce::uint64 word)
+    {
+        hash ^= word;
+        hash *= 1099511628211ull;
+        hash ^= hash >> 29;
+    };
+
+    addWord((juce::uint64) fileSize);
+
+    // Every byte is hashed: files of the same length that only differ in the middle
+    // (e.g. stems of one session with silent heads and tails) must never share a hash.
+    for (;;)
+    {
+        const int numRead = stream.read(buffer.get(), blockSize);
+
+        if (numRead <= 0)
+        {
+            break;
+        }
+
+        int i = 0;
+
+        for (; i + 8 <= numRead; i += 8)
+        {
+            juce::uint64 word;
+            std::memcpy(&word, buffer.get() + i, sizeof(word));
+            addWord(word);
+        }
+
+        for (; i < numRead; ++i)
+        {
+            addWord((juce::uint8) buffer[i]);
+        }
+    }
+
+    // Never return 0, which means "unknown".
+    return hash != 0 ? hash : 1;
 }
\ No newline at end of file
@@ -12,22 +12,111 @@
 
 #include "../JuceLibraryCode/JuceHeader.h"
 
+/** Stable identifier of a track in the music library. */
+using TrackId = juce::uint64;
+
 class Track 
 {
     public:
         /** 
         * PURPOSE: Track constructor used to create and initialise 
         *          a track object made of several data members.
-        * INPUTS: Track title, length and path.
+        *          The metadata read from the file's tags is filled in afterwards.
+        * INPUTS: Track title, path and content hash (0 if unknown).
         * OUTPUTS: None.
         */
         Track(juce::String _title,
-              juce::String _length,
-              juce::String _path);
+              juce::String _path,
+              juce::uint64 _contentHash = 0);
+
+        /**
+        * PURPOSE: Track constructor used when the ID of the track is already known
+        *          (e.g. stored in the playlist file), which saves computing it from the path.
+        * INPUTS: Track ID, title, path and content hash (0 if unknown).
+        * OUTPUTS: None.
+        */
+        Track(TrackId _id,
+              juce::String _title,
+              juce::String _path,
+              juce::uint64 _contentHash);
+
+        /**
+        * PURPOSE: Gets the name to show for the track, i.e. "artist - title" if the artist is known.
+        * INPUTS: None.
+        * OUTPUTS: The display name of the track.
+        */
+        juce::String getDisplayName() const;
+
+        /**
+        * PURPOSE: Gets the length of the track in seconds.
+        * INPUTS: None.
+        * OUTPUTS: The length in seconds, or 0 if unknown.
+        */
+        double getLengthInSeconds() const;
+
+        /**
+        * PURPOSE: Gets the length of the track formatted as minutes and seconds (e.g. "3:07").
+        * INPUTS: None.
+        * OUTPUTS: The formatted length.
+        */
+        juce::String getLengthText() const;
+
+        /**
+        * PURPOSE: Formats a length in seconds as minutes and seconds (e.g. "3:07").
+        * INPUTS: The length in seconds.
+        * OUTPUTS: The formatted length.
+        */
+        static juce::String formatLength(double lengthInSecs);
+
+        /**
+        * PURPOSE: Computes the stable ID of the track stored at a path. The same file
+        *          always gets the same ID, across sessions and however the path is spelt.
+        * INPUTS: The path of the track as a URL string.
+        * OUTPUTS: The ID of the track.
+        */
+        static TrackId createId(const juce::String& path);
+
+        /**
+        * PURPOSE: Converts a track path to a canonical form, i.e. a full local file path
+        *          that is lower case on file systems that ignore case.
+        * INPUTS: The path of the track as a URL string.
+        * OUTPUTS: The normalised path.
+        */
+        static juce::String normalisePath(const juce::String& path);
+
+        /**
+        * PURPOSE: Computes a hash of a music file's contents that is the same for identical copies
+        *          of the file wherever they are stored. The whole file is read, so this should be
+        *          called off the message thread wherever possible.
+        * INPUTS: The music file.
+        * OUTPUTS: The content hash, or 0 if the file can't be read.
+        */
+        static juce::uint64 createContentHash(const juce::File& file);
 
 
         /** DATA MEMBERS */
+
+        // Changes whenever createContentHash() does; hashes stored by an older version are discarded.
+        static constexpr juce::uint32 contentHashVersion = 2;
+
+        TrackId id;
         juce::String title;
-        juce::String length;
+        juce::String artist;
+        juce::String album;
+        juce::String genre;
+        juce::String key;
         juce::String path;
+        juce::uint64 contentHash;
+        juce::int64 lengthInSamples;
+        double sampleRate;
+        float bpm;
+
+        // Found by analysing the track (the key as a CamelotKey index). A BPM or key from the tags takes precedence.
+        // The analysis version is TrackAnalyser::getAnalysisVersion() when they were found, or 0 if never analysed.
+        float detectedBpm;
+        int detectedKey;
+        juce::uint32 analysisVersion;
+
+        juce::int64 fileSize;
+        juce::int64 modificationTime;
 };
\ No newline at end of file
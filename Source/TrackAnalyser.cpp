@@ -0,0 +1,246 @@
+/*
+  ==============================================================================
+
+    TrackAnalyser.cpp
+    Created: 19 Oct 2026 7:40:52pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "TrackAnalyser.h"
+
+TrackAnalyser::TrackAnalyser(juce::AudioFormatManager& _formatManager,
+                             AnalysisCache& _analysisCache,
+                             AnalysisScheduler& _scheduler)
+                            : formatManager(_formatManager),
+                              analysisCache(_analysisCache),
+                              scheduler(_scheduler)
+{
+}
+
+TrackAnalyser::~TrackAnalyser()
+{
+    cancelAll();
+    cancelPendingUpdate();
+}
+
+void TrackAnalyser::addListener(Listener* listener)
+{
+    listeners.add(listener);
+}
+
+void TrackAnalyser::removeListener(Listener* listener)
+{
+    listeners.remove(listener);
+}
+
+void TrackAnalyser::analyseTrack(const juce::URL& trackPath, juce::uint64 contentHash, AnalysisScheduler::Priority priority)
+{
+    if (contentHash == 0)
+    {
+        return;
+    }
+
+    std::shared_ptr<AnalysisTask> task;
+
+    {
+        const juce::ScopedLock sl(lock);
+        auto pending = pendingTasks.find(contentHash);
+
+        if (pending != pendingTasks.end())
+        {
+            // Already queued at this priority or a more urgent one, or already running.
+            if ((int) priority >= (int) pending->second.priority || !pending->second.task->cancelIfQueued())
+            {
+                return;
+            }
+        }
+
+        task = std::make_shared<AnalysisTask>(*this, trackPath, contentHash);
+        pendingTasks[contentHash] = { task, priority };
+    }
+
+    scheduler.addJob(task, priority);
+}
+
+void TrackAnalyser::cancelAll()
+{
+    std::vector<std::shared_ptr<AnalysisTask>> tasks;
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        for (auto& pending : pendingTasks)
+        {
+            tasks.push_back(pending.second.task);
+        }
+
+        pendingTasks.clear();
+    }
+
+    for (auto& task : tasks)
+    {
+        task->cancel();
+    }
+
+    for (auto& task : tasks)
+    {
+        task->waitUntilFinished(-1);
+    }
+}
+
+bool TrackAnalyser::analyse(const AnalysisTask& task, Result& result)
+{
+    result.contentHash = task.contentHash;
+
+    bool hasDuration = analysisCache.readValue(task.contentHash, AnalysisCache::duration,
+                                               durationVersion, result.duration);
+    bool hasBeatGrid = analysisCache.readValue(task.contentHash, AnalysisCache::bpm,
+                                               beatGridVersion, result.beatGrid);
+    bool hasKey = analysisCache.readValue(task.contentHash, AnalysisCache::key,
+                                          keyVersion, result.key);
+    bool hasLoudness = analysisCache.readValue(task.contentHash, AnalysisCache::loudness,
+                                               loudnessVersion, result.loudness);
+
+    if (hasDuration && hasBeatGrid && hasKey && hasLoudness)
+    {
+        return !task.shouldExit();
+    }
+
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        formatManager.createReaderFor(task.trackPath.createInputStream(false)));
+
+    if (reader == nullptr || reader->sampleRate <= 0.0)
+    {
+        return false;
+    }
+
+    if (!hasDuration)
+    {
+        result.duration = { reader->lengthInSamples, reader->sampleRate };
+        analysisCache.writeValue(task.contentHash, AnalysisCache::duration, durationVersion, result.duration);
+    }
+
+    if (!hasBeatGrid || !hasKey || !hasLoudness)
+    {
+        Result decoded;
+
+        if (!decodeTrack(*reader, &task, decoded))
+        {
+            return false;
+        }
+
+        // Tracks without a beat, a key or any sound are stored too, so that they aren't decoded again.
+        if (!hasBeatGrid)
+        {
+            result.beatGrid = decoded.beatGrid;
+            analysisCache.writeValue(task.contentHash, AnalysisCache::bpm, beatGridVersion, result.beatGrid);
+        }
+
+        if (!hasKey)
+        {
+            result.key = decoded.key;
+            analysisCache.writeValue(task.contentHash, AnalysisCache::key, keyVersion, result.key);
+        }
+
+        if (!hasLoudness)
+        {
+            result.loudness = decoded.loudness;
+            analysisCache.writeValue(task.contentHash, AnalysisCache::loudness, loudnessVersion, result.loudness);
+        }
+    }
+
+    return !task.shouldExit();
+}
+
+bool TrackAnalyser::decodeTrack(juce::AudioFormatReader& reader, const AnalysisJob* job, Result& result)
+{
+    BeatDetector beatDetector{ reader.sampleRate };
+    KeyDetector keyDetector{ reader.sampleRate };
+    LoudnessMeter loudnessMeter{ reader.sampleRate };
+    juce::AudioBuffer<float> buffer(2, decodeBlockSize);
+
+    for (juce::int64 position = 0; position < reader.lengthInSamples; position += decodeBlockSize)
+    {
+        if (job != nullptr && job->shouldExit())
+        {
+            return false;
+        }
+
+        int numSamples = (int) juce::jmin((juce::int64) decodeBlockSize, reader.lengthInSamples - position);
+        reader.read(&buffer, 0, numSamples, position, true, true);
+
+        beatDetector.process(buffer.getReadPointer(0), buffer.getReadPointer(1), numSamples);
+        keyDetector.process(buffer.getReadPointer(0), buffer.getReadPointer(1), numSamples);
+        loudnessMeter.process(buffer.getReadPointer(0), buffer.getReadPointer(1), numSamples);
+    }
+
+    if (!beatDetector.findBeatGrid(result.beatGrid))
+    {
+        result.beatGrid = { 0.0, 0.0, 0.0 };
+    }
+
+    if (!keyDetector.findKey(result.key))
+    {
+        result.key = { CamelotKey::noKey, 0.0 };
+    }
+
+    if (!loudnessMeter.getLoudness(result.loudness))
+    {
+        result.loudness = { LoudnessMeter::silentLufs, LoudnessMeter::silentLufs };
+    }
+
+    return true;
+}
+
+void TrackAnalyser::taskFinished(const AnalysisTask& task, bool succeeded, const Result& result)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        auto pending = pendingTasks.find(task.contentHash);
+
+        if (pending != pendingTasks.end() && pending->second.task.get() == &task)
+        {
+            pendingTasks.erase(pending);
+        }
+
+        if (!succeeded)
+        {
+            return;
+        }
+
+        results.push_back(result);
+    }
+
+    triggerAsyncUpdate();
+}
+
+void TrackAnalyser::handleAsyncUpdate()
+{
+    std::vector<Result> finishedResults;
+
+    {
+        const juce::ScopedLock sl(lock);
+        finishedResults.swap(results);
+    }
+
+    if (!finishedResults.empty())
+    {
+        listeners.call([&finishedResults](Listener& l) { l.tracksAnalysed(finishedResults); });
+    }
+}
+
+TrackAnalyser::AnalysisTask::AnalysisTask(TrackAnalyser& _owner, const juce::URL& _trackPath, juce::uint64 _contentHash)
+                                         : owner(_owner),
+                                           trackPath(_trackPath),
+                                           contentHash(_contentHash)
+{
+}
+
+void TrackAnalyser::AnalysisTask::runJob()
+{
+    Result result;
+    bool succeeded = owner.analyse(*this, result);
+    owner.taskFinished(*this, succeeded, result);
+}
@@ -0,0 +1,219 @@
+/*
+  ==============================================================================
+
+    TrackAnalyser.h
+    Created: 19 Oct 2026 7:40:52pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "AnalysisCache.h"
+#include "AnalysisScheduler.h"
+#include "BeatDetector.h"
+#include "KeyDetector.h"
+#include "LoudnessMeter.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+//==============================================================================
+/*
+    Analyses tracks in the background on the AnalysisScheduler and keeps the
+    results in the AnalysisCache, so each track is analysed once per version
+    of its file.
+
+    Each track is decoded once, and only if some part of its analysis isn't
+    cached yet; every analyser is fed from the same decoding pass. For now
+    that means the duration, the beat grid (tempo and beat phase), the
+    musical key and the loudness.
+
+    Tracks are identified by their content hash. Asking for a track that is
+    already queued at a lower priority moves it up, so a track loaded on a
+    deck overtakes the bulk analysis of the library. Results are delivered to
+    the listeners on the message thread, whether they were computed or read
+    from the cache.
+*/
+class TrackAnalyser : private juce::AsyncUpdater
+{
+    public:
+        /** The duration of a track, as decoded rather than estimated from its headers. */
+        struct Duration
+        {
+            juce::int64 lengthInSamples;
+            double sampleRate;
+        };
+
+        /**
+        * The analysis of a track. A beat grid with a BPM of 0 means no beat was found, a key
+        * of CamelotKey::noKey means no key was found and a loudness of LoudnessMeter::silentLufs means the
+        * track is silent.
+        */
+        struct Result
+        {
+            juce::uint64 contentHash;
+            Duration duration;
+            BeatDetector::BeatGrid beatGrid;
+            KeyDetector::KeyEstimate key;
+            LoudnessMeter::Loudness loudness;
+        };
+
+        /** Receives the results of analyses on the message thread. */
+        class Listener
+        {
+            public:
+                virtual ~Listener() = default;
+
+                /**
+                * PURPOSE: Called when tracks have been analysed. Results that arrive close together
+                *          are delivered together, so a listener can update the library once for all of them.
+                * INPUTS: The results of the analyses.
+                * OUTPUTS: None.
+                */
+                virtual void tracksAnalysed(const std::vector<Result>& results) = 0;
+        };
+
+        /**
+        * PURPOSE: Creates the TrackAnalyser object.
+        * INPUTS: A reference to the juce AudioFormatManager used to decode the tracks, the cache
+        *         to keep the results in and the scheduler to run the analyses on.
+        * OUTPUTS: None.
+        */
+        TrackAnalyser(juce::AudioFormatManager& _formatManager,
+                      AnalysisCache& _analysisCache,
+                      AnalysisScheduler& _scheduler);
+
+        /**
+        * PURPOSE: Destroys the TrackAnalyser object, cancelling the analyses that haven't finished.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~TrackAnalyser() override;
+
+        /**
+        * PURPOSE: Adds a listener to be told about results.
+        * INPUTS: The listener.
+        * OUTPUTS: None.
+        */
+        void addListener(Listener* listener);
+
+        /**
+        * PURPOSE: Removes a listener.
+        * INPUTS: The listener.
+        * OUTPUTS: None.
+        */
+        void removeListener(Listener* listener);
+
+        /**
+        * PURPOSE: Queues a track to be analysed, or moves it up if it is already queued at a lower priority.
+        * INPUTS: The track's file path as a juce URL, the content hash of the file (tracks with
+        *         an unknown hash, 0, aren't analysed) and the priority of the analysis.
+        * OUTPUTS: None.
+        */
+        void analyseTrack(const juce::URL& trackPath, juce::uint64 contentHash, AnalysisScheduler::Priority priority);
+
+        /**
+        * PURPOSE: Cancels all the analyses that haven't finished and waits for the running ones to stop.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void cancelAll();
+
+        /**
+        * PURPOSE: Decodes a whole track and finds its beat grid, its key and its loudness.
+        * INPUTS: A reader for the track, the job doing the analysis (checked for cancellation
+        *         between blocks, may be nullptr) and a reference to the result to store them in
+        *         (its content hash and duration are left alone).
+        * OUTPUTS: A boolean; true if the track was decoded and false if the job was cancelled.
+        */
+        static bool decodeTrack(juce::AudioFormatReader& reader, const AnalysisJob* job, Result& result);
+
+        /**
+        * PURPOSE: Gets the version of the results the library keeps (the beat grid and the key), which
+        *          changes whenever either analyser does, so tracks analysed by an older one can be found.
+        * INPUTS: None.
+        * OUTPUTS: The version, which is never 0.
+        */
+        static constexpr juce::uint32 getAnalysisVersion()
+        {
+            return (beatGridVersion << 16) | keyVersion;
+        }
+
+    private:
+        /** The job that analyses one track. */
+        class AnalysisTask : public AnalysisJob
+        {
+            public:
+                /**
+                * PURPOSE: Creates the AnalysisTask object.
+                * INPUTS: The analyser that owns it, the track's file path and its content hash.
+                * OUTPUTS: None.
+                */
+                AnalysisTask(TrackAnalyser& _owner, const juce::URL& _trackPath, juce::uint64 _contentHash);
+
+                /**
+                * PURPOSE: Analyses the track. Implements AnalysisJob (i.e. function is pure virtual).
+                * INPUTS: None.
+                * OUTPUTS: None.
+                */
+                void runJob() override;
+
+                /** DATA MEMBERS */
+
+                TrackAnalyser& owner;
+                const juce::URL trackPath;
+                const juce::uint64 contentHash;
+        };
+
+        /** An analysis that hasn't finished yet. */
+        struct PendingTask
+        {
+            std::shared_ptr<AnalysisTask> task;
+            AnalysisScheduler::Priority priority;
+        };
+
+        /**
+        * PURPOSE: Analyses a track, reading each part of the analysis from the cache when it is there.
+        * INPUTS: The job doing the analysis (checked for cancellation) and a reference to store the result in.
+        * OUTPUTS: A boolean; true if the track was analysed and false if it couldn't be read or the job was cancelled.
+        */
+        bool analyse(const AnalysisTask& task, Result& result);
+
+        /**
+        * PURPOSE: Records the end of an analysis and posts its result to the message thread.
+        * INPUTS: The job that has finished, whether it produced a result and the result.
+        * OUTPUTS: None.
+        */
+        void taskFinished(const AnalysisTask& task, bool succeeded, const Result& result);
+
+        /**
+        * PURPOSE: Delivers the finished results to the listeners.
+        *          Implements juce AsyncUpdater (i.e. function is pure virtual).
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void handleAsyncUpdate() override;
+
+
+        /** DATA MEMBERS */
+
+        static constexpr juce::uint32 durationVersion = 1;
+        static constexpr juce::uint32 beatGridVersion = 1;
+        static constexpr juce::uint32 keyVersion = 1;
+        static constexpr juce::uint32 loudnessVersion = 1;
+        static constexpr int decodeBlockSize = 1 << 16;
+
+        juce::AudioFormatManager& formatManager;
+        AnalysisCache& analysisCache;
+        AnalysisScheduler& scheduler;
+        juce::ListenerList<Listener> listeners;
+
+        juce::CriticalSection lock;
+        std::unordered_map<juce::uint64, PendingTask> pendingTasks;
+        std::vector<Result> results;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TrackAnalyser)
+};
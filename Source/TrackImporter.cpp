@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    TrackImporter.cpp
+    Created: 20 Oct 2026 3:12:40am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "TrackImporter.h"
+
+TrackImporter::TrackImporter(juce::AudioFormatManager& _formatManager,
+                             AnalysisScheduler& _scheduler,
+                             Listener& _listener)
+                            : scheduler(_scheduler),
+                              listener(_listener),
+                              metadataScanner(_formatManager)
+{
+}
+
+TrackImporter::~TrackImporter()
+{
+    cancelAll();
+    cancelPendingUpdate();
+}
+
+void TrackImporter::importFile(const juce::File& file)
+{
+    TrackId id = Track::createId(juce::URL{ file }.toString(false));
+    std::shared_ptr<ImportJob> job;
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        if (pendingJobs.count(id) != 0)
+        {
+            return;
+        }
+
+        job = std::make_shared<ImportJob>(*this, file, id);
+        pendingJobs[id] = job;
+    }
+
+    // The user is waiting to see these tracks, so they go ahead of bulk library analysis.
+    scheduler.addJob(job, AnalysisScheduler::Priority::normal);
+}
+
+void TrackImporter::cancelAll()
+{
+    std::vector<std::shared_ptr<ImportJob>> jobs;
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        for (auto& pending : pendingJobs)
+        {
+            jobs.push_back(pending.second);
+        }
+
+        pendingJobs.clear();
+    }
+
+    for (auto& job : jobs)
+    {
+        job->cancel();
+    }
+
+    for (auto& job : jobs)
+    {
+        job->waitUntilFinished(-1);
+    }
+}
+
+void TrackImporter::jobFinished(const ImportJob& job, bool succeeded, const Track& track)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        auto pending = pendingJobs.find(job.id);
+
+        if (pending != pendingJobs.end() && pending->second.get() == &job)
+        {
+            pendingJobs.erase(pending);
+        }
+
+        if (!succeeded)
+        {
+            return;
+        }
+
+        readTracks.push_back(track);
+    }
+
+    triggerAsyncUpdate();
+}
+
+void TrackImporter::handleAsyncUpdate()
+{
+    std::vector<Track> tracks;
+
+    {
+        const juce::ScopedLock sl(lock);
+        tracks.swap(readTracks);
+    }
+
+    if (!tracks.empty())
+    {
+        listener.tracksRead(tracks);
+    }
+}
+
+TrackImporter::ImportJob::ImportJob(TrackImporter& _owner, const juce::File& _file, TrackId _id)
+                                   : owner(_owner),
+                                     file(_file),
+                                     id(_id)
+{
+}
+
+void TrackImporter::ImportJob::runJob()
+{
+    Track track{ id, "", juce::URL{ file }.toString(false), Track::createContentHash(file) };
+
+    // A file deleted while it was queued is dropped rather than added without its tags.
+    if (shouldExit() || !file.existsAsFile())
+    {
+        owner.jobFinished(*this, false, track);
+        return;
+    }
+
+    // Read the tags once, so sorting and filtering never have to open the file again.
+    owner.metadataScanner.scan(file, track);
+    track.fileSize = file.getSize();
+    track.modificationTime = file.getLastModificationTime().toMilliseconds();
+
+    owner.jobFinished(*this, !shouldExit(), track);
+}
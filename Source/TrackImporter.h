@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    TrackImporter.h
+    Created: 20 Oct 2026 3:12:40am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Track.h"
+#include "TrackMetadataScanner.h"
+#include "AnalysisScheduler.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+//==============================================================================
+/*
+    Reads music files into tracks in the background, so that importing a large
+    folder never holds up the message thread.
+
+    Each file is read by its own job on the AnalysisScheduler: its tags are
+    scanned and the hash of its contents is computed, which together cost a
+    few small reads per file. Tracks that finish close together are handed to
+    the listener on the message thread together, so the library is updated
+    once per batch rather than once per file. A file that is already being
+    read isn't queued again.
+*/
+class TrackImporter : private juce::AsyncUpdater
+{
+    public:
+        /** Receives the tracks read from files on the message thread. */
+        class Listener
+        {
+            public:
+                virtual ~Listener() = default;
+
+                /**
+                * PURPOSE: Called when files have been read.
+                * INPUTS: The tracks read from the files, with their tags, content hash, size and modification time.
+                * OUTPUTS: None.
+                */
+                virtual void tracksRead(const std::vector<Track>& tracks) = 0;
+        };
+
+        /**
+        * PURPOSE: Creates the TrackImporter object.
+        * INPUTS: A reference to the juce AudioFormatManager used for files without a readable header,
+        *         the scheduler to read the files on and the listener that receives the tracks.
+        * OUTPUTS: None.
+        */
+        TrackImporter(juce::AudioFormatManager& _formatManager,
+                      AnalysisScheduler& _scheduler,
+                      Listener& _listener);
+
+        /**
+        * PURPOSE: Destroys the TrackImporter object, cancelling the files that haven't been read yet.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~TrackImporter() override;
+
+        /**
+        * PURPOSE: Queues a music file to be read, unless it is already queued. Called from the message thread.
+        * INPUTS: The music file.
+        * OUTPUTS: None.
+        */
+        void importFile(const juce::File& file);
+
+        /**
+        * PURPOSE: Cancels the files that haven't been read yet and waits for the running jobs to stop.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void cancelAll();
+
+    private:
+        /** The job that reads one file. */
+        class ImportJob : public AnalysisJob
+        {
+            public:
+                /**
+                * PURPOSE: Creates the ImportJob object.
+                * INPUTS: The importer that owns it, the file and the ID of its track.
+                * OUTPUTS: None.
+                */
+                ImportJob(TrackImporter& _owner, const juce::File& _file, TrackId _id);
+
+                /**
+                * PURPOSE: Reads the file. Implements AnalysisJob (i.e. function is pure virtual).
+                * INPUTS: None.
+                * OUTPUTS: None.
+                */
+                void runJob() override;
+
+                /** DATA MEMBERS */
+
+                TrackImporter& owner;
+                const juce::File file;
+                const TrackId id;
+        };
+
+        /**
+        * PURPOSE: Records the end of a job and posts its track to the message thread.
+        * INPUTS: The job that has finished, whether it read the file and the track read from it.
+        * OUTPUTS: None.
+        */
+        void jobFinished(const ImportJob& job, bool succeeded, const Track& track);
+
+        /**
+        * PURPOSE: Delivers the tracks read so far to the listener.
+        *          Implements juce AsyncUpdater (i.e. function is pure virtual).
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void handleAsyncUpdate() override;
+
+
+        /** DATA MEMBERS */
+
+        AnalysisScheduler& scheduler;
+        Listener& listener;
+        TrackMetadataScanner metadataScanner;
+
+        juce::CriticalSection lock;
+        std::unordered_map<TrackId, std::shared_ptr<ImportJob>> pendingJobs;
+        std::vector<Track> readTracks;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TrackImporter)
+};
@@ -0,0 +1,626 @@
+/*
+  ==============================================================================
+
+    TrackMetadataScanner.cpp
+    Created: 19 Oct 2026 2:31:50pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "TrackMetadataScanner.h"
+
+TrackMetadataScanner::TrackMetadataScanner(juce::AudioFormatManager& formatManagerToUse)
+                                          : formatManager(formatManagerToUse)
+{
+}
+
+TrackMetadataScanner::~TrackMetadataScanner()
+{
+}
+
+bool TrackMetadataScanner::scan(const juce::File& file, Track& track) const
+{
+    juce::FileInputStream stream{ file };
+
+    if (stream.failedToOpen())
+    {
+        return false;
+    }
+
+    char magic[12] = {};
+    stream.read(magic, sizeof(magic));
+    stream.setPosition(0);
+
+    if (memcmp(magic, "ID3", 3) == 0)
+    {
+        readID3v2(stream, track);
+
+        // A FLAC file may (rarely) start with an ID3 tag too.
+        juce::int64 audioStart = stream.getPosition();
+        stream.read(magic, 4);
+        stream.setPosition(audioStart);
+
+        if (memcmp(magic, "fLaC", 4) == 0)
+        {
+            readFLAC(stream, track);
+        }
+        else
+        {
+            readMPEGAudioHeader(stream, track);
+        }
+    }
+    else if (memcmp(magic, "fLaC", 4) == 0)
+    {
+        readFLAC(stream, track);
+    }
+    else if (memcmp(magic, "OggS", 4) == 0)
+    {
+        readOggVorbis(stream, track);
+    }
+    else if (memcmp(magic, "RIFF", 4) == 0 && memcmp(magic + 8, "WAVE", 4) == 0)
+    {
+        readRIFF(stream, track);
+    }
+    else if ((juce::uint8) magic[0] == 0xFF && ((juce::uint8) magic[1] & 0xE0) == 0xE0)
+    {
+        readMPEGAudioHeader(stream, track);
+    }
+
+    if (track.lengthInSamples <= 0 || track.sampleRate <= 0.0)
+    {
+        // Unknown format or no usable header: let juce find the length.
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+        if (reader != nullptr)
+        {
+            track.lengthInSamples = reader->lengthInSamples;
+            track.sampleRate = reader->sampleRate;
+        }
+    }
+
+    if (track.title.isEmpty())
+    {
+        track.title = file.getFileNameWithoutExtension();
+    }
+
+    return track.lengthInSamples > 0 && track.sampleRate > 0.0;
+}
+
+bool TrackMetadataScanner::readID3v2(juce::InputStream& stream, Track& track)
+{
+    juce::uint8 header[10];
+    juce::int64 tagStart = stream.getPosition();
+
+    if (stream.read(header, 10) != 10 || memcmp(header, "ID3", 3) != 0)
+    {
+        stream.setPosition(tagStart);
+        return false;
+    }
+
+    auto syncsafe = [](const juce::uint8* b)
+    {
+        return (juce::int64) ((b[0] & 0x7F) << 21 | (b[1] & 0x7F) << 14 | (b[2] & 0x7F) << 7 | (b[3] & 0x7F));
+    };
+
+    const int version = header[3];
+    const int flags = header[5];
+    juce::int64 tagEnd = tagStart + 10 + syncsafe(header + 6) + ((flags & 0x10) != 0 ? 10 : 0);
+
+    if (version < 2 || version > 4)
+    {
+        stream.setPosition(tagEnd);
+        return true;
+    }
+
+    // Skip the extended header.
+    if ((flags & 0x40) != 0 && version >= 3)
+    {
+        juce::uint8 sizeBytes[4];
+        stream.read(sizeBytes, 4);
+        juce::int64 extendedSize = version == 4 ? syncsafe(sizeBytes) - 4
+                                                : (juce::int64) juce::ByteOrder::bigEndianInt(sizeBytes);
+        stream.setPosition(stream.getPosition() + extendedSize);
+    }
+
+    const int idSize = version == 2 ? 3 : 4;
+    const int frameHeaderSize = version == 2 ? 6 : 10;
+    juce::MemoryBlock frameData;
+
+    while (stream.getPosition() + frameHeaderSize <= tagEnd)
+    {
+        juce::uint8 frameHeader[10];
+
+        if (stream.read(frameHeader, frameHeaderSize) != frameHeaderSize || frameHeader[0] == 0)
+        {
+            break; // padding
+        }
+
+        juce::int64 frameSize;
+
+        if (version == 2)
+        {
+            frameSize = (frameHeader[3] << 16) | (frameHeader[4] << 8) | frameHeader[5];
+        }
+        else if (version == 3)
+        {
+            frameSize = juce::ByteOrder::bigEndianInt(frameHeader + 4);
+        }
+        else
+        {
+            frameSize = syncsafe(frameHeader + 4);
+        }
+
+        juce::int64 nextFrame = stream.getPosition() + frameSize;
+        juce::String frameId{ juce::CharPointer_ASCII((const char*) frameHeader), (size_t) idSize };
+        juce::String field;
+
+        if (frameId == "TIT2" || frameId == "TT2")       field = "TITLE";
+        else if (frameId == "TPE1" || frameId == "TP1")  field = "ARTIST";
+        else if (frameId == "TALB" || frameId == "TAL")  field = "ALBUM";
+        else if (frameId == "TCON" || frameId == "TCO")  field = "GENRE";
+        else if (frameId == "TBPM" || frameId == "TBP")  field = "BPM";
+        else if (frameId == "TKEY" || frameId == "TKE")  field = "KEY";
+
+        // Only text frames are read; everything else (e.g. pictures) is skipped.
+        if (field.isNotEmpty() && nextFrame <= tagEnd && readBlock(stream, frameSize, frameData))
+        {
+            juce::String text = decodeID3Text((const juce::uint8*) frameData.getData(), frameData.getSize());
+
+            // ID3v2.3 genres may be references to the ID3v1 list, e.g. "(17)" or "(17)Rock".
+            if (field == "GENRE" && text.startsWithChar('(') && text.containsChar(')'))
+            {
+                juce::String name = text.fromFirstOccurrenceOf(")", false, false);
+                text = name.isNotEmpty() ? name : text;
+            }
+
+            setField(field, text, track);
+        }
+
+        stream.setPosition(nextFrame);
+    }
+
+    stream.setPosition(tagEnd);
+    return true;
+}
+
+void TrackMetadataScanner::readMPEGAudioHeader(juce::InputStream& stream, Track& track)
+{
+    static const int bitrates[2][3][15] =
+    {
+        { // MPEG 1: layers I, II and III
+            { 0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448 },
+            { 0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384 },
+            { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 }
+        },
+        { // MPEG 2 and 2.5: layers I, II and III
+            { 0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256 },
+            { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 },
+            { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 }
+        }
+    };
+    static const int sampleRates[3] = { 44100, 48000, 32000 };
+
+    // Look for the first valid frame header (skipping any padding after the ID3 tag).
+    const int searchSize = 64 * 1024;
+    juce::int64 searchStart = stream.getPosition();
+    juce::MemoryBlock block;
+
+    if (!readBlock(stream, juce::jmin((juce::int64) searchSize, stream.getTotalLength() - searchStart), block))
+    {
+        return;
+    }
+
+    auto* data = (const juce::uint8*) block.getData();
+    const int size = (int) block.getSize();
+
+    for (int i = 0; i + 4 <= size; ++i)
+    {
+        if (data[i] != 0xFF || (data[i + 1] & 0xE0) != 0xE0)
+        {
+            continue;
+        }
+
+        int versionBits = (data[i + 1] >> 3) & 3;
+        int layerBits = (data[i + 1] >> 1) & 3;
+        int bitrateIndex = data[i + 2] >> 4;
+        int sampleRateIndex = (data[i + 2] >> 2) & 3;
+
+        if (versionBits == 1 || layerBits == 0 || bitrateIndex == 0 || bitrateIndex == 15 || sampleRateIndex == 3)
+        {
+            continue;
+        }
+
+        const bool isMPEG1 = versionBits == 3;
+        const int layer = 4 - layerBits;
+        const bool isMono = (data[i + 3] >> 6) == 3;
+        const int sampleRate = sampleRates[sampleRateIndex] >> (isMPEG1 ? 0 : (versionBits == 2 ? 1 : 2));
+        const int bitrate = bitrates[isMPEG1 ? 0 : 1][layer - 1][bitrateIndex] * 1000;
+        const int samplesPerFrame = layer == 1 ? 384 : (layer == 3 && !isMPEG1 ? 576 : 1152);
+
+        track.sampleRate = sampleRate;
+
+        // A VBR file has a Xing/Info (or VBRI) header holding its number of frames.
+        int xingOffset = i + 4 + (isMPEG1 ? (isMono ? 17 : 32) : (isMono ? 9 : 17));
+        int vbriOffset = i + 4 + 32;
+
+        if (xingOffset + 12 <= size
+            && (memcmp(data + xingOffset, "Xing", 4) == 0 || memcmp(data + xingOffset, "Info", 4) == 0)
+            && (juce::ByteOrder::bigEndianInt(data + xingOffset + 4) & 1) != 0)
+        {
+            track.lengthInSamples = (juce::int64) juce::ByteOrder::bigEndianInt(data + xingOffset + 8) * samplesPerFrame;
+        }
+        else if (vbriOffset + 18 <= size && memcmp(data + vbriOffset, "VBRI", 4) == 0)
+        {
+            track.lengthInSamples = (juce::int64) juce::ByteOrder::bigEndianInt(data + vbriOffset + 14) * samplesPerFrame;
+        }
+        else
+        {
+            // Constant bitrate: the length follows from the size of the audio data.
+            juce::int64 audioBytes = stream.getTotalLength() - (searchStart + i);
+            track.lengthInSamples = (juce::int64) ((double) audioBytes * 8.0 / bitrate * sampleRate);
+        }
+
+        return;
+    }
+}
+
+void TrackMetadataScanner::readFLAC(juce::InputStream& stream, Track& track)
+{
+    stream.setPosition(stream.getPosition() + 4); // "fLaC"
+    juce::MemoryBlock blockData;
+    bool isLastBlock = false;
+
+    while (!isLastBlock && !stream.isExhausted())
+    {
+        juce::uint8 header[4];
+
+        if (stream.read(header, 4) != 4)
+        {
+            return;
+        }
+
+        isLastBlock = (header[0] & 0x80) != 0;
+        const int blockType = header[0] & 0x7F;
+        const juce::int64 blockSize = (header[1] << 16) | (header[2] << 8) | header[3];
+        juce::int64 nextBlock = stream.getPosition() + blockSize;
+
+        if (blockType == 0 && blockSize >= 18 && readBlock(stream, blockSize, blockData)) // STREAMINFO
+        {
+            auto* d = (const juce::uint8*) blockData.getData();
+            track.sampleRate = (d[10] << 12) | (d[11] << 4) | (d[12] >> 4);
+            track.lengthInSamples = ((juce::int64) (d[13] & 0x0F) << 32) | juce::ByteOrder::bigEndianInt(d + 14);
+        }
+        else if (blockType == 4 && readBlock(stream, blockSize, blockData)) // VORBIS_COMMENT
+        {
+            readVorbisComments((const juce::uint8*) blockData.getData(), blockData.getSize(), track);
+        }
+
+        // Everything else, e.g. PICTURE blocks, is skipped.
+        stream.setPosition(nextBlock);
+    }
+}
+
+void TrackMetadataScanner::readOggVorbis(juce::InputStream& stream, Track& track)
+{
+    // Gather the first two packets (identification and comment headers) from the first pages.
+    juce::MemoryBlock packets[2];
+    int packetIndex = 0;
+
+    while (packetIndex < 2 && !stream.isExhausted())
+    {
+        juce::uint8 pageHeader[27];
+        juce::uint8 segmentTable[255];
+
+        if (stream.read(pageHeader, 27) != 27 || memcmp(pageHeader, "OggS", 4) != 0)
+        {
+            break;
+        }
+
+        const int numSegments = pageHeader[26];
+
+        if (stream.read(segmentTable, numSegments) != numSegments)
+        {
+            break;
+        }
+
+        for (int i = 0; i < numSegments && packetIndex < 2; ++i)
+        {
+            juce::MemoryBlock segment;
+
+            if (!readBlock(stream, segmentTable[i], segment)
+                || packets[packetIndex].getSize() + segment.getSize() > (size_t) maxTagBlockSize)
+            {
+                packetIndex = 2;
+                break;
+            }
+
+            packets[packetIndex].append(segment.getData(), segment.getSize());
+
+            // A segment shorter than 255 bytes ends the packet.
+            if (segmentTable[i] < 255)
+            {
+                ++packetIndex;
+            }
+        }
+    }
+
+    auto* identification = (const juce::uint8*) packets[0].getData();
+
+    if (packets[0].getSize() >= 16 && memcmp(identification, "\x01vorbis", 7) == 0)
+    {
+        track.sampleRate = juce::ByteOrder::littleEndianInt(identification + 12);
+    }
+
+    auto* comments = (const juce::uint8*) packets[1].getData();
+
+    if (packets[1].getSize() > 7 && memcmp(comments, "\x03vorbis", 7) == 0)
+    {
+        readVorbisComments(comments + 7, packets[1].getSize() - 7, track);
+    }
+
+    // The granule position of the last page is the number of samples in the stream.
+    const juce::int64 tailSize = juce::jmin((juce::int64) 65536, stream.getTotalLength());
+    juce::MemoryBlock tail;
+    stream.setPosition(stream.getTotalLength() - tailSize);
+
+    if (readBlock(stream, tailSize, tail))
+    {
+        auto* d = (const juce::uint8*) tail.getData();
+
+        for (int i = (int) tail.getSize() - 27; i >= 0; --i)
+        {
+            if (memcmp(d + i, "OggS", 4) == 0)
+            {
+                track.lengthInSamples = (juce::int64) juce::ByteOrder::littleEndianInt64(d + i + 6);
+                break;
+            }
+        }
+    }
+}
+
+void TrackMetadataScanner::readRIFF(juce::InputStream& stream, Track& track)
+{
+    stream.setPosition(stream.getPosition() + 12); // "RIFF", size, "WAVE"
+    juce::int64 dataSize = 0;
+    int blockAlign = 0;
+    juce::MemoryBlock chunkData;
+
+    while (!stream.isExhausted())
+    {
+        juce::uint8 chunkHeader[8];
+
+        if (stream.read(chunkHeader, 8) != 8)
+        {
+            break;
+        }
+
+        const juce::int64 chunkSize = juce::ByteOrder::littleEndianInt(chunkHeader + 4);
+        const juce::int64 chunkStart = stream.getPosition();
+        const juce::int64 nextChunk = chunkStart + chunkSize + (chunkSize & 1);
+
+        if (memcmp(chunkHeader, "fmt ", 4) == 0 && chunkSize >= 16 && readBlock(stream, chunkSize, chunkData))
+        {
+            auto* d = (const juce::uint8*) chunkData.getData();
+            track.sampleRate = juce::ByteOrder::littleEndianInt(d + 4);
+            blockAlign = juce::ByteOrder::littleEndianShort(d + 12);
+        }
+        else if (memcmp(chunkHeader, "data", 4) == 0)
+        {
+            // Don't read the audio, its size is all that is needed.
+            dataSize = chunkSize;
+        }
+        else if (memcmp(chunkHeader, "LIST", 4) == 0 && chunkSize >= 4 && readBlock(stream, chunkSize, chunkData)
+                 && memcmp(chunkData.getData(), "INFO", 4) == 0)
+        {
+            auto* d = (const juce::uint8*) chunkData.getData();
+            size_t pos = 4;
+
+            while (pos + 8 <= chunkData.getSize())
+            {
+                size_t infoSize = juce::ByteOrder::littleEndianInt(d + pos + 4);
+
+                if (pos + 8 + infoSize > chunkData.getSize())
+                {
+                    break;
+                }
+
+                juce::String value = juce::String::fromUTF8((const char*) d + pos + 8, (int) infoSize);
+                juce::String field;
+
+                if (memcmp(d + pos, "INAM", 4) == 0)        field = "TITLE";
+                else if (memcmp(d + pos, "IART", 4) == 0)   field = "ARTIST";
+                else if (memcmp(d + pos, "IPRD", 4) == 0)   field = "ALBUM";
+                else if (memcmp(d + pos, "IGNR", 4) == 0)   field = "GENRE";
+                else if (memcmp(d + pos, "IBPM", 4) == 0)   field = "BPM";
+
+                if (field.isNotEmpty())
+                {
+                    // INFO strings are zero-terminated.
+                    setField(field, value.upToFirstOccurrenceOf(juce::String::charToString(0), false, false), track);
+                }
+
+                pos += 8 + infoSize + (infoSize & 1);
+            }
+        }
+        else if (memcmp(chunkHeader, "id3 ", 4) == 0 || memcmp(chunkHeader, "ID3 ", 4) == 0)
+        {
+            readID3v2(stream, track);
+        }
+
+        stream.setPosition(nextChunk);
+    }
+
+    if (dataSize > 0 && blockAlign > 0)
+    {
+        track.lengthInSamples = dataSize / blockAlign;
+    }
+}
+
+void TrackMetadataScanner::readVorbisComments(const juce::uint8* data, size_t size, Track& track)
+{
+    if (size < 8)
+    {
+        return;
+    }
+
+    // Vendor string, then the number of comments and the comments themselves.
+    size_t pos = 4 + (size_t) juce::ByteOrder::littleEndianInt(data);
+
+    if (pos + 4 > size)
+    {
+        return;
+    }
+
+    juce::uint32 numComments = juce::ByteOrder::littleEndianInt(data + pos);
+    pos += 4;
+
+    for (juce::uint32 i = 0; i < numComments && pos + 4 <= size; ++i)
+    {
+        size_t commentSize = juce::ByteOrder::littleEndianInt(data + pos);
+        pos += 4;
+
+        if (commentSize > size - pos)
+        {
+            break;
+        }
+
+        juce::String comment = juce::String::fromUTF8((const char*) data + pos, (int) commentSize);
+        juce::String name = comment.upToFirstOccurrenceOf("=", false, false).toUpperCase();
+        juce::String value = comment.fromFirstOccurrenceOf("=", false, false);
+        pos += commentSize;
+
+        if (name == "TEMPO")
+        {
+            name = "BPM";
+        }
+        else if (name == "INITIALKEY")
+        {
+            name = "KEY";
+        }
+
+        setField(name, value, track);
+    }
+}
+
+juce::String TrackMetadataScanner::decodeID3Text(const juce::uint8* data, size_t size)
+{
+    if (size < 2)
+    {
+        return {};
+    }
+
+    const int encoding = data[0];
+    const juce::uint8* text = data + 1;
+    size_t numBytes = size - 1;
+
+    if (encoding == 0) // ISO-8859-1
+    {
+        juce::String result;
+
+        for (size_t i = 0; i < numBytes && text[i] != 0; ++i)
+        {
+            result += (juce::juce_wchar) text[i];
+        }
+
+        return result;
+    }
+
+    if (encoding == 3) // UTF-8
+    {
+        size_t length = 0;
+
+        while (length < numBytes && text[length] != 0)
+        {
+            ++length;
+        }
+
+        return juce::String::fromUTF8((const char*) text, (int) length);
+    }
+
+    // UTF-16, with a byte order mark (encoding 1) or big endian (encoding 2).
+    bool isBigEndian = encoding == 2;
+
+    if (encoding == 1 && numBytes >= 2)
+    {
+        isBigEndian = text[0] == 0xFE && text[1] == 0xFF;
+
+        if ((text[0] == 0xFE && text[1] == 0xFF) || (text[0] == 0xFF && text[1] == 0xFE))
+        {
+            text += 2;
+            numBytes -= 2;
+        }
+    }
+
+    juce::String result;
+
+    for (size_t i = 0; i + 1 < numBytes; i += 2)
+    {
+        juce::uint32 unit = isBigEndian ? (juce::uint32) ((text[i] << 8) | text[i + 1])
+                                        : (juce::uint32) ((text[i + 1] << 8) | text[i]);
+
+        if (unit == 0)
+        {
+            break;
+        }
+
+        // Combine surrogate pairs.
+        if (unit >= 0xD800 && unit < 0xDC00 && i + 3 < numBytes)
+        {
+            juce::uint32 low = isBigEndian ? (juce::uint32) ((text[i + 2] << 8) | text[i + 3])
+                                           : (juce::uint32) ((text[i + 3] << 8) | text[i + 2]);
+            unit = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+            i += 2;
+        }
+
+        result += (juce::juce_wchar) unit;
+    }
+
+    return result;
+}
+
+void TrackMetadataScanner::setField(const juce::String& name, const juce::String& value, Track& track)
+{
+    juce::String trimmedValue = value.trim();
+
+    if (trimmedValue.isEmpty())
+    {
+        return;
+    }
+
+    if (name == "TITLE" && track.title.isEmpty())
+    {
+        track.title = trimmedValue;
+    }
+    else if (name == "ARTIST" && track.artist.isEmpty())
+    {
+        track.artist = trimmedValue;
+    }
+    else if (name == "ALBUM" && track.album.isEmpty())
+    {
+        track.album = trimmedValue;
+    }
+    else if (name == "GENRE" && track.genre.isEmpty())
+    {
+        track.genre = trimmedValue;
+    }
+    else if (name == "BPM" && track.bpm <= 0.0f)
+    {
+        track.bpm = trimmedValue.getFloatValue();
+    }
+    else if (name == "KEY" && track.key.isEmpty())
+    {
+        track.key = trimmedValue;
+    }
+}
+
+bool TrackMetadataScanner::readBlock(juce::InputStream& stream, juce::int64 numBytes, juce::MemoryBlock& block)
+{
+    if (numBytes < 0 || numBytes > maxTagBlockSize)
+    {
+        return false;
+    }
+
+    block.setSize((size_t) numBytes);
+    return numBytes == 0 || stream.read(block.getData(), (int) numBytes) == (int) numBytes;
+}
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    TrackMetadataScanner.h
+    Created: 19 Oct 2026 2:31:50pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Track.h"
+
+//==============================================================================
+/*
+    Reads the metadata of a music file (title, artist, album, genre, BPM, key,
+    length in samples and sample rate) from its tags and headers.
+
+    Understands ID3v2 tags and MPEG audio headers (MP3), FLAC metadata blocks,
+    Ogg Vorbis headers, Vorbis comments and RIFF/WAVE chunks (including INFO
+    lists). Only the headers are read: audio data and embedded pictures are
+    skipped, so scanning a file costs a few small reads. Files the scanner can't
+    get a length from fall back to a juce AudioFormatReader.
+*/
+class TrackMetadataScanner
+{
+    public:
+        /**
+        * PURPOSE: Creates the TrackMetadataScanner object.
+        * INPUTS: A reference to the juce AudioFormatManager used for files without a readable header.
+        * OUTPUTS: None.
+        */
+        TrackMetadataScanner(juce::AudioFormatManager& formatManagerToUse);
+
+        /**
+        * PURPOSE: Destroys the TrackMetadataScanner object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~TrackMetadataScanner();
+
+        /**
+        * PURPOSE: Reads the metadata of a music file into a track. Fields the file has no
+        *          tag for are left unchanged (the title defaults to the file name).
+        * INPUTS: The music file and the track to be filled in.
+        * OUTPUTS: A boolean; true if the file's length could be read and false if it couldn't.
+        */
+        bool scan(const juce::File& file, Track& track) const;
+
+    private:
+        /**
+        * PURPOSE: Reads an ID3v2 tag starting at the current position of the stream,
+        *          leaving the stream just after the tag.
+        * INPUTS: The stream to read from and the track to be filled in.
+        * OUTPUTS: A boolean; true if there was an ID3v2 tag and false if there wasn't.
+        */
+        static bool readID3v2(juce::InputStream& stream, Track& track);
+
+        /**
+        * PURPOSE: Reads the length and sample rate of MPEG audio (e.g. MP3) from its first frame header,
+        *          using the Xing/Info or VBRI header if there is one.
+        * INPUTS: The stream, positioned at or just before the first frame, and the track to be filled in.
+        * OUTPUTS: None.
+        */
+        static void readMPEGAudioHeader(juce::InputStream& stream, Track& track);
+
+        /**
+        * PURPOSE: Reads the STREAMINFO and VORBIS_COMMENT blocks of a FLAC file.
+        * INPUTS: The stream, positioned at the "fLaC" marker, and the track to be filled in.
+        * OUTPUTS: None.
+        */
+        static void readFLAC(juce::InputStream& stream, Track& track);
+
+        /**
+        * PURPOSE: Reads the identification and comment headers of an Ogg Vorbis file,
+        *          and its length from the granule position of the last page.
+        * INPUTS: The stream, positioned at the first page, and the track to be filled in.
+        * OUTPUTS: None.
+        */
+        static void readOggVorbis(juce::InputStream& stream, Track& track);
+
+        /**
+        * PURPOSE: Reads the fmt, data, LIST/INFO and id3 chunks of a RIFF/WAVE file.
+        * INPUTS: The stream, positioned at the "RIFF" marker, and the track to be filled in.
+        * OUTPUTS: None.
+        */
+        static void readRIFF(juce::InputStream& stream, Track& track);
+
+        /**
+        * PURPOSE: Reads a block of Vorbis comments (as found in FLAC and Ogg files).
+        * INPUTS: The comment block, its size in bytes and the track to be filled in.
+        * OUTPUTS: None.
+        */
+        static void readVorbisComments(const juce::uint8* data, size_t size, Track& track);
+
+        /**
+        * PURPOSE: Decodes the text of an ID3v2 text frame (which starts with its encoding byte).
+        * INPUTS: The frame's contents and their size in bytes.
+        * OUTPUTS: The decoded text (the first value, if the frame holds several).
+        */
+        static juce::String decodeID3Text(const juce::uint8* data, size_t size);
+
+        /**
+        * PURPOSE: Stores a tag value in the matching field of the track, unless that field was
+        *          already set by an earlier tag.
+        * INPUTS: The upper case name of the field (e.g. "TITLE", "BPM"), its value and the track.
+        * OUTPUTS: None.
+        */
+        static void setField(const juce::String& name, const juce::String& value, Track& track);
+
+        /**
+        * PURPOSE: Reads a block of bytes from the stream, refusing blocks larger than the limit.
+        * INPUTS: The stream, the number of bytes to read and the memory block to read them into.
+        * OUTPUTS: A boolean; true if all the bytes were read and false if they weren't.
+        */
+        static bool readBlock(juce::InputStream& stream, juce::int64 numBytes, juce::MemoryBlock& block);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr juce::int64 maxTagBlockSize = 1024 * 1024;
+
+        juce::AudioFormatManager& formatManager;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TrackMetadataScanner)
+};
@@ -0,0 +1,240 @@
+/*
+  ==============================================================================
+
+    TrackSearcher.cpp
+    Created: 19 Oct 2026 10:52:05am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "TrackSearcher.h"
+#include <algorithm>
+
+TrackSearcher::TrackSearcher(const TrackStore& _store, Listener& _listener)
+                            : juce::Thread("Library search"),
+                              store(_store),
+                              listener(_listener),
+                              generation(0)
+{
+    startThread(4);
+}
+
+TrackSearcher::~TrackSearcher()
+{
+    cancelQuery();
+    stopThread(2000);
+    cancelPendingUpdate();
+}
+
+void TrackSearcher::libraryChanged()
+{
+    const juce::ScopedLock sl(lock);
+
+    if (query.isNotEmpty())
+    {
+        // Search again so that the new tracks are included.
+        ++generation;
+        notify();
+    }
+}
+
+void TrackSearcher::setQuery(const juce::String& keyword)
+{
+    const juce::ScopedLock sl(lock);
+    query = keyword.toLowerCase();
+    ++generation;
+    notify();
+}
+
+void TrackSearcher::cancelQuery()
+{
+    const juce::ScopedLock sl(lock);
+    query.clear();
+    readyChunks.clear();
+    ++generation;
+}
+
+void TrackSearcher::run()
+{
+    while (!threadShouldExit())
+    {
+        wait(-1);
+
+        // Debounce: keep waiting for as long as the user is still typing.
+        while (wait(debounceMs))
+        {
+            if (threadShouldExit())
+            {
+                return;
+            }
+        }
+
+        if (threadShouldExit())
+        {
+            return;
+        }
+
+        juce::String keyword;
+        int queryGeneration;
+
+        {
+            const juce::ScopedLock sl(lock);
+            keyword = query;
+            queryGeneration = generation.load();
+        }
+
+        if (keyword.isNotEmpty())
+        {
+            runQuery(keyword, queryGeneration);
+        }
+    }
+}
+
+void TrackSearcher::appendLowerCase(const juce::String& text, LowerCaseText& lowerCaseText)
+{
+    for (auto p = text.getCharPointer(); !p.isEmpty(); ++p)
+    {
+        lowerCaseText.push_back(juce::CharacterFunctions::toLowerCase(*p));
+    }
+}
+
+void TrackSearcher::getSearchText(const Track& track, LowerCaseText& searchText)
+{
+    searchText.clear();
+    appendLowerCase(track.title, searchText);
+    searchText.push_back(' ');
+    appendLowerCase(track.artist, searchText);
+}
+
+int TrackSearcher::getMatchRank(const LowerCaseText& lowerCaseTitle, const LowerCaseText& lowerCaseKeyword)
+{
+    const size_t keywordLength = lowerCaseKeyword.size();
+
+    if (keywordLength == 0)
+    {
+        return 0;
+    }
+
+    int rank = -1;
+
+    for (size_t index = 0; index + keywordLength <= lowerCaseTitle.size(); ++index)
+    {
+        if (lowerCaseTitle[index] != lowerCaseKeyword[0]
+            || !std::equal(lowerCaseKeyword.begin(), lowerCaseKeyword.end(), lowerCaseTitle.begin() + (std::ptrdiff_t) index))
+        {
+            continue;
+        }
+
+        if (index == 0)
+        {
+            return 0;
+        }
+
+        // An occurrence at the start of a word beats one inside a word.
+        if (!juce::CharacterFunctions::isLetterOrDigit(lowerCaseTitle[index - 1]))
+        {
+            return 1;
+        }
+
+        rank = 2;
+    }
+
+    return rank;
+}
+
+void TrackSearcher::handleAsyncUpdate()
+{
+    std::vector<ResultChunk> chunks;
+
+    {
+        const juce::ScopedLock sl(lock);
+        chunks.swap(readyChunks);
+    }
+
+    for (const auto& chunk : chunks)
+    {
+        // Drop the results of queries that have been superseded in the meantime.
+        if (chunk.generation == generation.load())
+        {
+            listener.searchResultsArrived(chunk.rows, chunk.isFirst, chunk.isLast);
+        }
+    }
+}
+
+void TrackSearcher::runQuery(const juce::String& keyword, int queryGeneration)
+{
+    std::vector<juce::uint32> bestMatches;
+    std::vector<juce::uint32> wordMatches;
+    std::vector<juce::uint32> otherMatches;
+    bool firstChunkSent = false;
+    const juce::uint32 numRows = store.getNumRows();
+
+    // The text of each track is lowered into the same buffer, so the scan allocates nothing per row.
+    LowerCaseText lowerCaseKeyword;
+    LowerCaseText searchText;
+    appendLowerCase(keyword, lowerCaseKeyword);
+
+    for (juce::uint32 row = 0; row < numRows; ++row)
+    {
+        if (row % titlesPerCancelCheck == 0 && queryIsStale(queryGeneration))
+        {
+            return;
+        }
+
+        getSearchText(store.getTrack(row), searchText);
+        int rank = getMatchRank(searchText, lowerCaseKeyword);
+
+        if (rank == 0)
+        {
+            bestMatches.push_back(row);
+
+            // Stream the best matches as soon as a chunk is full.
+            if ((int) bestMatches.size() >= rowsPerChunk)
+            {
+                publishChunk(bestMatches, queryGeneration, !firstChunkSent, false);
+                firstChunkSent = true;
+            }
+        }
+        else if (rank == 1)
+        {
+            wordMatches.push_back(row);
+        }
+        else if (rank == 2)
+        {
+            otherMatches.push_back(row);
+        }
+    }
+
+    if (queryIsStale(queryGeneration))
+    {
+        return;
+    }
+
+    // Append the weaker matches after the best ones.
+    bestMatches.insert(bestMatches.end(), wordMatches.begin(), wordMatches.end());
+    bestMatches.insert(bestMatches.end(), otherMatches.begin(), otherMatches.end());
+    publishChunk(bestMatches, queryGeneration, !firstChunkSent, true);
+}
+
+void TrackSearcher::publishChunk(std::vector<juce::uint32>& rows, int queryGeneration, bool isFirstChunk, bool isLastChunk)
+{
+    {
+        const juce::ScopedLock sl(lock);
+
+        if (queryGeneration != generation.load())
+        {
+            return;
+        }
+
+        readyChunks.push_back({ queryGeneration, std::move(rows), isFirstChunk, isLastChunk });
+    }
+
+    rows.clear();
+    triggerAsyncUpdate();
+}
+
+bool TrackSearcher::queryIsStale(int queryGeneration)
+{
+    return threadShouldExit() || queryGeneration != generation.load();
+}
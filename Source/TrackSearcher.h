@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+    TrackSearcher.h
+    Created: 19 Oct 2026 10:52:05am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "TrackStore.h"
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+/*
+    Runs music library searches on a background thread so that typing in the
+    search bar never blocks the message thread.
+
+    Queries are debounced, a query that is still running is abandoned as soon as
+    a newer one arrives, and matches are handed back to the listener (on the
+    message thread) in ranked chunks as they are found.
+*/
+class TrackSearcher : public juce::Thread,
+                      private juce::AsyncUpdater
+{
+    public:
+        /** Receives search results on the message thread. */
+        class Listener
+        {
+            public:
+                virtual ~Listener() = default;
+
+                /**
+                * PURPOSE: Called for every chunk of results of the most recent query.
+                * INPUTS: The store rows matching the query (best matches first), a boolean that is
+                *         true for the first chunk of a query and a boolean that is true for its last chunk.
+                *         Rows of tracks deleted since the search started may be included.
+                * OUTPUTS: None.
+                */
+                virtual void searchResultsArrived(const std::vector<juce::uint32>& rows,
+                                                  bool isFirstChunk,
+                                                  bool isLastChunk) = 0;
+        };
+
+        /**
+        * PURPOSE: Creates the TrackSearcher object and starts its background thread.
+        * INPUTS: The track store to search and the listener that receives the search results.
+        * OUTPUTS: None.
+        */
+        TrackSearcher(const TrackStore& _store, Listener& _listener);
+
+        /**
+        * PURPOSE: Destroys the TrackSearcher object, cancelling any running query and stopping the thread.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~TrackSearcher() override;
+
+        /**
+        * PURPOSE: Restarts the current search, if any, after tracks have been added to the store.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void libraryChanged();
+
+        /**
+        * PURPOSE: Starts a new (debounced) search and cancels the previous one.
+        *          Returns immediately; results arrive through the listener.
+        * INPUTS: The keyword to search for.
+        * OUTPUTS: None.
+        */
+        void setQuery(const juce::String& keyword);
+
+        /**
+        * PURPOSE: Cancels the current search so that none of its results are delivered.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void cancelQuery();
+
+        /**
+        * PURPOSE: The background thread's main loop. Implements juce Thread (i.e. function is pure virtual).
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void run() override;
+
+        /** Lower case text as characters, kept in a buffer that is reused so matching makes no allocations. */
+        using LowerCaseText = std::vector<juce::juce_wchar>;
+
+        /**
+        * PURPOSE: Appends text to a buffer in lower case.
+        * INPUTS: The text and the buffer to append it to.
+        * OUTPUTS: None.
+        */
+        static void appendLowerCase(const juce::String& text, LowerCaseText& lowerCaseText);
+
+        /**
+        * PURPOSE: Makes the lower case title and artist that a track is searched by, in a reused buffer.
+        * INPUTS: The track and the buffer to overwrite with its text.
+        * OUTPUTS: None.
+        */
+        static void getSearchText(const Track& track, LowerCaseText& searchText);
+
+        /**
+        * PURPOSE: Ranks how well a title matches a keyword: 0 if the title starts with the keyword,
+        *          1 if one of its words does, 2 if it only contains the keyword and -1 if it doesn't match.
+        * INPUTS: The lower case title and the lower case keyword.
+        * OUTPUTS: The rank of the match.
+        */
+        static int getMatchRank(const LowerCaseText& lowerCaseTitle, const LowerCaseText& lowerCaseKeyword);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int debounceMs = 100;
+
+    private:
+        /**
+        * PURPOSE: Delivers the chunks of results collected by the background thread to the listener.
+        *          Implements juce AsyncUpdater (i.e. function is pure virtual).
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void handleAsyncUpdate() override;
+
+        /**
+        * PURPOSE: Searches the store for the keyword, publishing chunks of results as it goes.
+        * INPUTS: The lower case keyword and the generation of the query.
+        * OUTPUTS: None.
+        */
+        void runQuery(const juce::String& keyword, int queryGeneration);
+
+        /**
+        * PURPOSE: Queues a chunk of results to be delivered on the message thread.
+        * INPUTS: The rows found, the generation of the query and the first/last chunk flags.
+        * OUTPUTS: None.
+        */
+        void publishChunk(std::vector<juce::uint32>& rows, int queryGeneration, bool isFirstChunk, bool isLastChunk);
+
+        /**
+        * PURPOSE: Checks if the query of the given generation has been superseded or the thread is stopping.
+        * INPUTS: The generation of the query.
+        * OUTPUTS: A boolean; true if the query should be abandoned and false if it shouldn't.
+        */
+        bool queryIsStale(int queryGeneration);
+
+
+        struct ResultChunk
+        {
+            int generation;
+            std::vector<juce::uint32> rows;
+            bool isFirst;
+            bool isLast;
+        };
+
+        /** DATA MEMBERS */
+
+        static constexpr int titlesPerCancelCheck = 2048;
+        static constexpr int rowsPerChunk = 256;
+
+        const TrackStore& store;
+        Listener& listener;
+
+        juce::CriticalSection lock;
+        juce::String query;
+        std::vector<ResultChunk> readyChunks;
+        std::atomic<int> generation;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TrackSearcher)
+};
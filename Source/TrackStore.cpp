@@ -0,0 +1,490 @@
+/*
+  ==============================================================================
+
+    TrackStore.cpp
+    Created: 19 Oct 2026 11:24:37am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "TrackStore.h"
+#include <iterator>
+#include <numeric>
+
+TrackStore::TrackStore()
+                      : numRows(0),
+                        numTracks(0)
+{
+    // The chunk table is sized once, so readers never see it reallocate.
+    chunks.resize(maxChunks);
+}
+
+TrackStore::~TrackStore()
+{
+}
+
+juce::uint32 TrackStore::add(const Track& track)
+{
+    jassert(rowsById.count(track.id) == 0);
+
+    juce::uint32 row = numRows.load(std::memory_order_relaxed);
+    juce::uint32 chunkIndex = row >> rowsPerChunkBits;
+
+    if (chunkIndex >= maxChunks)
+    {
+        throw std::length_error("TrackStore is full");
+    }
+
+    if (chunks[chunkIndex] == nullptr)
+    {
+        // Reserve the whole chunk up front so its tracks never move.
+        auto chunk = std::make_unique<Chunk>();
+        chunk->tracks.reserve(rowsPerChunk);
+        chunk->alive.reserve(rowsPerChunk);
+        chunk->lengths.reserve(rowsPerChunk);
+        chunk->bpms.reserve(rowsPerChunk);
+        chunk->keys.reserve(rowsPerChunk);
+        chunk->detectedBpms.reserve(rowsPerChunk);
+        chunk->detectedKeys.reserve(rowsPerChunk);
+        chunk->analysisVersions.reserve(rowsPerChunk);
+        chunks[chunkIndex] = std::move(chunk);
+    }
+
+    Chunk& chunk = *chunks[chunkIndex];
+    chunk.tracks.push_back(track);
+    chunk.alive.push_back(true);
+    chunk.lengths.push_back((float) track.getLengthInSeconds());
+    chunk.bpms.push_back(track.bpm > 0.0f ? track.bpm : track.detectedBpm);
+    chunk.keys.push_back(track.key.isEmpty() ? track.detectedKey : CamelotKey::parse(track.key));
+    chunk.detectedBpms.push_back(track.detectedBpm);
+    chunk.detectedKeys.push_back(track.detectedKey);
+    chunk.analysisVersions.push_back(track.analysisVersion);
+    rowsById[track.id] = row;
+
+    if (track.contentHash != 0)
+    {
+        rowsByContent.emplace(track.contentHash, row);
+    }
+
+    ++numTracks;
+
+    // Publish the new row to the other threads.
+    numRows.store(row + 1, std::memory_order_release);
+
+    return row;
+}
+
+void TrackStore::remove(juce::uint32 row)
+{
+    jassert(row < getNumRows());
+    auto&& alive = chunks[row >> rowsPerChunkBits]->alive[row & (rowsPerChunk - 1)];
+
+    if (alive)
+    {
+        alive = false;
+        const Track& track = getTrack(row);
+        rowsById.erase(track.id);
+
+        // Other copies of the same file keep their entries, so they can still be found by content.
+        auto sameContent = rowsByContent.equal_range(track.contentHash);
+
+        for (auto it = sameContent.first; it != sameContent.second; ++it)
+        {
+            if (it->second == row)
+            {
+                rowsByContent.erase(it);
+                break;
+            }
+        }
+
+        --numTracks;
+    }
+}
+
+bool TrackStore::findRow(TrackId id, juce::uint32& row) const
+{
+    auto it = rowsById.find(id);
+
+    if (it == rowsById.end())
+    {
+        return false;
+    }
+
+    row = it->second;
+    return true;
+}
+
+bool TrackStore::findRowByContent(juce::uint64 contentHash, juce::uint32& row) const
+{
+    auto it = rowsByContent.find(contentHash);
+
+    if (contentHash == 0 || it == rowsByContent.end())
+    {
+        return false;
+    }
+
+    row = it->second;
+    return true;
+}
+
+void TrackStore::findRowsByContent(juce::uint64 contentHash, std::vector<juce::uint32>& rows) const
+{
+    rows.clear();
+
+    if (contentHash == 0)
+    {
+        return;
+    }
+
+    auto sameContent = rowsByContent.equal_range(contentHash);
+
+    for (auto it = sameContent.first; it != sameContent.second; ++it)
+    {
+        rows.push_back(it->second);
+    }
+}
+
+bool TrackStore::isAlive(juce::uint32 row) const
+{
+    return row < getNumRows() && chunks[row >> rowsPerChunkBits]->alive[row & (rowsPerChunk - 1)];
+}
+
+const Track& TrackStore::getTrack(juce::uint32 row) const
+{
+    jassert(row < getNumRows());
+    return chunks[row >> rowsPerChunkBits]->tracks[row & (rowsPerChunk - 1)];
+}
+
+int TrackStore::getKey(juce::uint32 row) const
+{
+    jassert(row < getNumRows());
+    return chunks[row >> rowsPerChunkBits]->keys[row & (rowsPerChunk - 1)];
+}
+
+float TrackStore::getBpm(juce::uint32 row) const
+{
+    jassert(row < getNumRows());
+    return chunks[row >> rowsPerChunkBits]->bpms[row & (rowsPerChunk - 1)];
+}
+
+bool TrackStore::setAnalysis(juce::uint32 row, float bpm, int key, juce::uint32 analysisVersion)
+{
+    jassert(row < getNumRows());
+    Chunk& chunk = *chunks[row >> rowsPerChunkBits];
+    const juce::uint32 index = row & (rowsPerChunk - 1);
+    const bool versionChanged = chunk.analysisVersions[index] != analysisVersion;
+    chunk.analysisVersions[index] = analysisVersion;
+
+    if (chunk.detectedBpms[index] == bpm && chunk.detectedKeys[index] == key)
+    {
+        return versionChanged;
+    }
+
+    // A BPM or key from the tags is the user's own, so it is kept.
+    const Track& track = chunk.tracks[index];
+    chunk.detectedBpms[index] = bpm;
+    chunk.detectedKeys[index] = key;
+
+    if (track.bpm <= 0.0f && chunk.bpms[index] != bpm)
+    {
+        chunk.bpms[index] = bpm;
+        markSortValueChanged(SortColumn::bpm, row);
+    }
+
+    if (track.key.isEmpty() && chunk.keys[index] != key)
+    {
+        chunk.keys[index] = key;
+        markSortValueChanged(SortColumn::key, row);
+    }
+
+    return true;
+}
+
+void TrackStore::markSortValueChanged(SortColumn column, juce::uint32 row)
+{
+    SortOrder& order = sortOrders[(int) column];
+
+    // Rows not in the cached order yet are merged into it as new rows anyway.
+    if (row < order.rows.size())
+    {
+        order.changedRows.push_back(row);
+    }
+}
+
+juce::uint32 TrackStore::getAnalysisVersion(juce::uint32 row) const
+{
+    jassert(row < getNumRows());
+    return chunks[row >> rowsPerChunkBits]->analysisVersions[row & (rowsPerChunk - 1)];
+}
+
+juce::uint32 TrackStore::getNumRows() const
+{
+    return numRows.load(std::memory_order_acquire);
+}
+
+int TrackStore::getNumTracks() const
+{
+    return numTracks;
+}
+
+void TrackStore::sortRows(std::vector<juce::uint32>& rows, const std::vector<SortKey>& sortKeys)
+{
+    std::vector<juce::uint32> buffer(rows.size());
+
+    // Least significant column first: each pass is stable, so the
+    // order of the earlier (less significant) passes breaks ties.
+    for (auto sortKey = sortKeys.rbegin(); sortKey != sortKeys.rend(); ++sortKey)
+    {
+        const SortOrder& order = updateSortOrder(sortKey->column);
+
+        sortByRankDigit(rows, buffer, order, 0, !sortKey->isForwards);
+
+        if (order.numRanks > 0x10000)
+        {
+            sortByRankDigit(rows, buffer, order, 16, !sortKey->isForwards);
+        }
+    }
+}
+
+juce::String TrackStore::createSortKey(const juce::String& text)
+{
+    // Accents folded to their base letter, for U+00E0 to U+00FF.
+    static const char* const latin1Folding = "aaaaaaaceeeeiiiidnooooo-ouuuuyty";
+
+    juce::String lowerCaseText = text.toLowerCase().trim();
+
+    if (lowerCaseText.startsWith("the "))
+    {
+        lowerCaseText = lowerCaseText.substring(4);
+    }
+
+    juce::String sortKey;
+    sortKey.preallocateBytes(lowerCaseText.getNumBytesAsUTF8());
+    bool isAfterSpace = false;
+
+    for (auto p = lowerCaseText.getCharPointer(); !p.isEmpty(); ++p)
+    {
+        juce::juce_wchar c = *p;
+
+        if (c >= 0xE0 && c <= 0xFF && c != 0xF7)
+        {
+            c = (juce::juce_wchar) latin1Folding[c - 0xE0];
+        }
+
+        if (juce::CharacterFunctions::isLetterOrDigit(c))
+        {
+            // Punctuation and runs of spaces collapse to a single space between words.
+            if (isAfterSpace && sortKey.isNotEmpty())
+            {
+                sortKey += ' ';
+            }
+
+            sortKey += c;
+            isAfterSpace = false;
+        }
+        else
+        {
+            isAfterSpace = true;
+        }
+    }
+
+    return sortKey;
+}
+
+const TrackStore::SortOrder& TrackStore::updateSortOrder(SortColumn column)
+{
+    SortOrder& order = sortOrders[(int) column];
+    const juce::uint32 numRowsNow = getNumRows();
+    const juce::uint32 numRowsSorted = (juce::uint32) order.rows.size();
+
+    if (numRowsSorted == numRowsNow && order.changedRows.empty())
+    {
+        return order;
+    }
+
+    // Rows whose value changed since (e.g. a BPM found by analysis) are taken out of the
+    // cached order and merged back in with the appended rows.
+    std::vector<juce::uint32> newRows;
+    std::vector<bool> isMoved;
+
+    if (!order.changedRows.empty())
+    {
+        isMoved.assign(numRowsSorted, false);
+
+        for (juce::uint32 row : order.changedRows)
+        {
+            if (!isMoved[row])
+            {
+                isMoved[row] = true;
+                newRows.push_back(row);
+            }
+        }
+
+        order.changedRows.clear();
+        std::sort(newRows.begin(), newRows.end());
+
+        auto hasMoved = [&isMoved](juce::uint32 row)
+        {
+            return isMoved[row];
+        };
+
+        order.rows.erase(std::remove_if(order.rows.begin(), order.rows.end(), hasMoved), order.rows.end());
+    }
+
+    for (juce::uint32 row = numRowsSorted; row < numRowsNow; ++row)
+    {
+        newRows.push_back(row);
+    }
+
+    auto isOldRow = [numRowsSorted, &isMoved](juce::uint32 row)
+    {
+        return row < numRowsSorted && (isMoved.empty() || !isMoved[row]);
+    };
+
+    // Title and artist sort keys are made for the new rows only, and for the few older rows
+    // the merge below compares them with. A batch that is large next to the sorted rows would
+    // compare with most of them anyway, so then the keys of every row are made once instead.
+    const bool isTextColumn = column == SortColumn::title || column == SortColumn::artist;
+    const juce::uint32 numNewRows = (juce::uint32) newRows.size();
+    const juce::uint32 firstKeyedRow = (juce::uint64) numNewRows * fullKeyingRatio >= numRowsSorted ? 0 : numRowsSorted;
+    std::vector<juce::String> textSortKeys;
+
+    if (isTextColumn)
+    {
+        textSortKeys.reserve(numRowsNow - firstKeyedRow);
+
+        for (juce::uint32 row = firstKeyedRow; row < numRowsNow; ++row)
+        {
+            textSortKeys.push_back(getTextSortKey(column, row));
+        }
+    }
+
+    auto isBefore = [this, column, isTextColumn, firstKeyedRow, &textSortKeys](juce::uint32 first, juce::uint32 second)
+    {
+        if (!isTextColumn)
+        {
+            return isSortedBefore(column, first, second);
+        }
+
+        auto sortKeyOf = [this, column, firstKeyedRow, &textSortKeys](juce::uint32 row)
+        {
+            return row >= firstKeyedRow ? textSortKeys[row - firstKeyedRow] : getTextSortKey(column, row);
+        };
+
+        return sortKeyOf(first) < sortKeyOf(second);
+    };
+
+    // Sort the new rows, then find where each goes in the cached order by binary search
+    // (after the older rows it equals), so the older rows are never compared with each other.
+    std::stable_sort(newRows.begin(), newRows.end(), isBefore);
+
+    std::vector<juce::uint32> mergedRows;
+    mergedRows.reserve(numRowsNow);
+    auto nextOldRow = order.rows.begin();
+
+    for (juce::uint32 newRow : newRows)
+    {
+        auto insertAt = std::upper_bound(nextOldRow, order.rows.end(), newRow, isBefore);
+        mergedRows.insert(mergedRows.end(), nextOldRow, insertAt);
+        mergedRows.push_back(newRow);
+        nextOldRow = insertAt;
+    }
+
+    mergedRows.insert(mergedRows.end(), nextOldRow, order.rows.end());
+    order.rows.swap(mergedRows);
+
+    // Equal rows share a rank, so ties are left to the less significant columns. Two older
+    // rows next to each other are told apart by their old ranks; only the neighbours of the
+    // new rows need comparing.
+    order.ranks.resize(numRowsNow);
+    juce::uint32 rank = 0;
+    juce::uint32 previousOldRank = 0;
+    bool previousIsOld = false;
+
+    for (juce::uint32 i = 0; i < numRowsNow; ++i)
+    {
+        const juce::uint32 row = order.rows[i];
+        const bool isOld = isOldRow(row);
+        const juce::uint32 oldRank = isOld ? order.ranks[row] : 0;
+
+        if (i > 0)
+        {
+            const bool isAfterPrevious = isOld && previousIsOld ? oldRank != previousOldRank
+                                                                : isBefore(order.rows[i - 1], row);
+
+            if (isAfterPrevious)
+            {
+                ++rank;
+            }
+        }
+
+        order.ranks[row] = rank;
+        previousOldRank = oldRank;
+        previousIsOld = isOld;
+    }
+
+    order.numRanks = rank + 1;
+
+    return order;
+}
+
+juce::String TrackStore::getTextSortKey(SortColumn column, juce::uint32 row) const
+{
+    const Track& track = getTrack(row);
+    return createSortKey(column == SortColumn::title ? track.title : track.artist);
+}
+
+bool TrackStore::isSortedBefore(SortColumn column, juce::uint32 first, juce::uint32 second) const
+{
+    const Chunk& firstChunk = *chunks[first >> rowsPerChunkBits];
+    const Chunk& secondChunk = *chunks[second >> rowsPerChunkBits];
+    const juce::uint32 firstIndex = first & (rowsPerChunk - 1);
+    const juce::uint32 secondIndex = second & (rowsPerChunk - 1);
+
+    switch (column)
+    {
+        case SortColumn::length:
+            return firstChunk.lengths[firstIndex] < secondChunk.lengths[secondIndex];
+        case SortColumn::bpm:
+            return firstChunk.bpms[firstIndex] < secondChunk.bpms[secondIndex];
+        case SortColumn::key:
+            return firstChunk.keys[firstIndex] < secondChunk.keys[secondIndex];
+        case SortColumn::title:
+        case SortColumn::artist:
+            // Text columns are compared by their sort keys instead.
+            jassertfalse;
+            break;
+    }
+
+    return false;
+}
+
+void TrackStore::sortByRankDigit(std::vector<juce::uint32>& rows,
+                                 std::vector<juce::uint32>& buffer,
+                                 const SortOrder& order,
+                                 int shift,
+                                 bool isDescending)
+{
+    std::vector<juce::uint32> counts(0x10001, 0);
+
+    auto digitOf = [&order, shift, isDescending](juce::uint32 row)
+    {
+        juce::uint32 rank = order.ranks[row];
+        return ((isDescending ? order.numRanks - 1 - rank : rank) >> shift) & 0xFFFF;
+    };
+
+    for (juce::uint32 row : rows)
+    {
+        ++counts[digitOf(row) + 1];
+    }
+
+    std::partial_sum(counts.begin(), counts.end(), counts.begin());
+
+    for (juce::uint32 row : rows)
+    {
+        buffer[counts[digitOf(row)]++] = row;
+    }
+
+    rows.swap(buffer);
+}
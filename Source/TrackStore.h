@@ -0,0 +1,275 @@
+/*
+  ==============================================================================
+
+    TrackStore.h
+    Created: 19 Oct 2026 11:24:37am
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Track.h"
+#include "CamelotKey.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+//==============================================================================
+/*
+    Holds every track of the music library exactly once.
+
+    Tracks are appended and never move or change afterwards (only the BPM and key
+    found by analysing them are updated, in columns of their own), so the rest of
+    the app refers to them by their 32-bit row in the store: filtered, sorted and
+    searched views of the library are just vectors of rows. Deleting a track only
+    marks its row as deleted. Tracks can also be looked up by their stable ID
+    (i.e. by their normalised path) and by the hash of their contents.
+
+    Rows are stored in fixed-size chunks, which means that a row never moves once
+    added. Other threads (e.g. the library searcher) may therefore read any row
+    below getNumRows() while the message thread keeps appending.
+
+    Next to the tracks, every chunk keeps the numeric columns the library is
+    sorted by: length, BPM and the Camelot key (so harmonic filtering never
+    parses key tags), each taken from the tags or else from the analysis.
+    For each sort column the store caches the order of all rows and the rank
+    of every row in that order, merging rows in as they are appended (or as
+    their BPM or key is found). Title and artist sort keys are only made while
+    those ranks are brought up to date, for the appended rows and the few
+    older rows they are compared with, and are freed straight after, so the
+    store holds no second copy of the library's text. Sorting a view then only
+    means radix sorting its rows by these ranks, one column at a time.
+*/
+class TrackStore
+{
+    public:
+        /** The columns the library can be sorted by. */
+        enum class SortColumn
+        {
+            title,
+            artist,
+            length,
+            bpm,
+            key
+        };
+
+        /** One level of a (multi-column) sort order. */
+        struct SortKey
+        {
+            SortColumn column;
+            bool isForwards;
+        };
+
+        /**
+        * PURPOSE: Creates an empty TrackStore object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        TrackStore();
+
+        /**
+        * PURPOSE: Destroys the TrackStore object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~TrackStore();
+
+        /**
+        * PURPOSE: Appends a track to the store. Must only be called from the message thread.
+        *          A track whose ID is already in the library must not be added again.
+        * INPUTS: The track to be added.
+        * OUTPUTS: The row of the new track.
+        */
+        juce::uint32 add(const Track& track);
+
+        /**
+        * PURPOSE: Looks up the row of a track in the library from its ID.
+        * INPUTS: The ID of the track and a reference to store the row in.
+        * OUTPUTS: A boolean; true if the track is in the library and false if it isn't.
+        */
+        bool findRow(TrackId id, juce::uint32& row) const;
+
+        /**
+        * PURPOSE: Looks up the row of a track in the library from the hash of its contents.
+        * INPUTS: The content hash of the track (0 never matches) and a reference to store the row in.
+        * OUTPUTS: A boolean; true if a track with these contents is in the library and false if there isn't.
+        */
+        bool findRowByContent(juce::uint64 contentHash, juce::uint32& row) const;
+
+        /**
+        * PURPOSE: Looks up the rows of every copy of a track in the library from the hash of its contents.
+        * INPUTS: The content hash of the track (0 never matches) and the vector to store the rows in.
+        * OUTPUTS: None.
+        */
+        void findRowsByContent(juce::uint64 contentHash, std::vector<juce::uint32>& rows) const;
+
+        /**
+        * PURPOSE: Marks the track in the given row as deleted. The row itself is never reused.
+        * INPUTS: The row of the track to be deleted.
+        * OUTPUTS: None.
+        */
+        void remove(juce::uint32 row);
+
+        /**
+        * PURPOSE: Checks if the track in the given row has not been deleted.
+        * INPUTS: The row of the track.
+        * OUTPUTS: A boolean; true if the track is still in the library and false if it isn't.
+        */
+        bool isAlive(juce::uint32 row) const;
+
+        /**
+        * PURPOSE: Gets the track stored in the given row.
+        * INPUTS: The row of the track (must be less than getNumRows()).
+        * OUTPUTS: A reference to the track.
+        */
+        const Track& getTrack(juce::uint32 row) const;
+
+        /**
+        * PURPOSE: Gets the musical key of the track in the given row, read from its key tag once when
+        *          it was added, or found by analysing it if it has no key tag.
+        * INPUTS: The row of the track (must be less than getNumRows()).
+        * OUTPUTS: The key as a CamelotKey index, or CamelotKey::noKey if the track has none.
+        */
+        int getKey(juce::uint32 row) const;
+
+        /**
+        * PURPOSE: Gets the tempo of the track in the given row, from its BPM tag or else from its analysis.
+        * INPUTS: The row of the track (must be less than getNumRows()).
+        * OUTPUTS: The BPM, or 0 if it isn't known.
+        */
+        float getBpm(juce::uint32 row) const;
+
+        /**
+        * PURPOSE: Stores the BPM and key found by analysing the track in the given row, in place.
+        *          They are used wherever the track's tags give none. Must only be called from the message thread.
+        * INPUTS: The row of the track, the detected BPM (0 if none), the detected key (CamelotKey::noKey if none)
+        *         and the version of the analysis that found them.
+        * OUTPUTS: A boolean; true if the stored analysis changed and false if it didn't.
+        */
+        bool setAnalysis(juce::uint32 row, float bpm, int key, juce::uint32 analysisVersion);
+
+        /**
+        * PURPOSE: Gets the version of the analysis stored for the track in the given row.
+        * INPUTS: The row of the track (must be less than getNumRows()).
+        * OUTPUTS: The version, or 0 if the track hasn't been analysed.
+        */
+        juce::uint32 getAnalysisVersion(juce::uint32 row) const;
+
+        /**
+        * PURPOSE: Gets the number of rows in the store, including the rows of deleted tracks.
+        *          Safe to call from any thread.
+        * INPUTS: None.
+        * OUTPUTS: The number of rows.
+        */
+        juce::uint32 getNumRows() const;
+
+        /**
+        * PURPOSE: Gets the number of tracks that haven't been deleted.
+        * INPUTS: None.
+        * OUTPUTS: The number of tracks in the library.
+        */
+        int getNumTracks() const;
+
+        /**
+        * PURPOSE: Sorts a view of the library. The sort is stable: rows that are equal in every
+        *          sort column keep their order. Must only be called from the message thread.
+        * INPUTS: The rows to be sorted and the sort columns, the most significant first.
+        * OUTPUTS: None.
+        */
+        void sortRows(std::vector<juce::uint32>& rows, const std::vector<SortKey>& sortKeys);
+
+        /**
+        * PURPOSE: Converts text to the key it is sorted by, ignoring case, accents, punctuation
+        *          and a leading "the" (e.g. "The Beatles" sorts as "beatles").
+        * INPUTS: The text to be converted.
+        * OUTPUTS: The sort key.
+        */
+        static juce::String createSortKey(const juce::String& text);
+
+    private:
+        struct Chunk
+        {
+            std::vector<Track> tracks;
+            std::vector<bool> alive;
+            std::vector<float> lengths;
+            std::vector<float> bpms;
+            std::vector<int> keys;
+            std::vector<float> detectedBpms;
+            std::vector<int> detectedKeys;
+            std::vector<juce::uint32> analysisVersions;
+        };
+
+        /** The cached order of the rows by one sort column. */
+        struct SortOrder
+        {
+            std::vector<juce::uint32> rows;
+            std::vector<juce::uint32> ranks;
+            std::vector<juce::uint32> changedRows;
+            juce::uint32 numRanks = 0;
+        };
+
+        /**
+        * PURPOSE: Records that the value a row is sorted by in a column has changed, so the row
+        *          is moved in that column's cached order the next time it is used.
+        * INPUTS: The sort column and the row.
+        * OUTPUTS: None.
+        */
+        void markSortValueChanged(SortColumn column, juce::uint32 row);
+
+        /**
+        * PURPOSE: Brings the cached order of a sort column up to date with the rows
+        *          appended or changed since it was last used, by merging them into it.
+        * INPUTS: The sort column.
+        * OUTPUTS: A reference to the up to date order.
+        */
+        const SortOrder& updateSortOrder(SortColumn column);
+
+        /**
+        * PURPOSE: Makes the sort key of the title or artist of the track in the given row.
+        * INPUTS: The sort column (title or artist) and the row.
+        * OUTPUTS: The sort key.
+        */
+        juce::String getTextSortKey(SortColumn column, juce::uint32 row) const;
+
+        /**
+        * PURPOSE: Compares two rows by one of the numeric sort columns (length, BPM or key).
+        * INPUTS: The sort column and the two rows.
+        * OUTPUTS: A boolean; true if the first row sorts before the second and false if it doesn't.
+        */
+        bool isSortedBefore(SortColumn column, juce::uint32 first, juce::uint32 second) const;
+
+        /**
+        * PURPOSE: Stable counting sort of rows by a 16-bit digit of their sort ranks.
+        * INPUTS: The rows to be sorted, a buffer of the same size to sort into, the ranks of
+        *         all rows, the shift of the digit and a boolean that is true for descending order.
+        * OUTPUTS: None.
+        */
+        static void sortByRankDigit(std::vector<juce::uint32>& rows,
+                                    std::vector<juce::uint32>& buffer,
+                                    const SortOrder& order,
+                                    int shift,
+                                    bool isDescending);
+
+        /** DATA MEMBERS */
+
+        static constexpr int rowsPerChunkBits = 12;
+        static constexpr juce::uint32 rowsPerChunk = 1u << rowsPerChunkBits;
+        static constexpr juce::uint32 maxChunks = 4096;
+        static constexpr int numSortColumns = 5;
+        static constexpr juce::uint32 fullKeyingRatio = 32;
+
+        std::vector<std::unique_ptr<Chunk>> chunks;
+        std::unordered_map<TrackId, juce::uint32> rowsById;
+        std::unordered_multimap<juce::uint64, juce::uint32> rowsByContent;
+        std::atomic<juce::uint32> numRows;
+        int numTracks;
+        SortOrder sortOrders[numSortColumns];
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TrackStore)
+};
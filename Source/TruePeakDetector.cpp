@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    TruePeakDetector.cpp
+    Created: 19 Oct 2026 11:52:10pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#include "TruePeakDetector.h"
+#include <cmath>
+
+TruePeakDetector::TruePeakDetector()
+{
+    // Phase p interpolates the point p / 4 of a sample after the middle of the taps, with a
+    // sinc windowed by a Hann window as wide as the taps. Phase 0 is the sample itself.
+    const double halfWidth = tapsPerPhase / 2.0;
+
+    for (int phase = 0; phase < oversampling; ++phase)
+    {
+        for (int tap = 0; tap < tapsPerPhase; ++tap)
+        {
+            double t = tap - halfWidth + (double) phase / oversampling;
+            double sinc = t == 0.0 ? 1.0 : std::sin(juce::MathConstants<double>::pi * t) / (juce::MathConstants<double>::pi * t);
+            double window = 0.5 + 0.5 * std::cos(juce::MathConstants<double>::pi * t / halfWidth);
+
+            phases[phase][tap] = (float) (sinc * window);
+        }
+    }
+
+    reset();
+}
+
+TruePeakDetector::~TruePeakDetector()
+{
+}
+
+void TruePeakDetector::reset()
+{
+    for (auto& channel : history)
+    {
+        std::fill(std::begin(channel), std::end(channel), 0.0f);
+    }
+
+    historyPosition = 0;
+}
+
+float TruePeakDetector::process(float left, float right)
+{
+    history[0][historyPosition] = history[0][historyPosition + tapsPerPhase] = left;
+    history[1][historyPosition] = history[1][historyPosition + tapsPerPhase] = right;
+    historyPosition = (historyPosition + 1) % tapsPerPhase;
+
+    float peak = 0.0f;
+
+    // The latest tapsPerPhase samples, oldest first.
+    for (const auto& channel : history)
+    {
+        const float* samples = channel + historyPosition;
+
+        for (const auto& phase : phases)
+        {
+            float value = 0.0f;
+
+            for (int tap = 0; tap < tapsPerPhase; ++tap)
+            {
+                value += phase[tapsPerPhase - 1 - tap] * samples[tap];
+            }
+
+            peak = juce::jmax(peak, std::abs(value));
+        }
+    }
+
+    return peak;
+}
@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    TruePeakDetector.h
+    Created: 19 Oct 2026 11:52:10pm
+    Author:  Mary-Brenda Akoda
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+//==============================================================================
+/*
+    Finds the true peak of a stereo signal, sample by sample, as ITU-R BS.1770
+    defines it: the largest value after upsampling by four, which catches the
+    peaks between samples that a converter will reconstruct.
+
+    The upsampler is a 48 tap windowed-sinc interpolator (four phases of 12
+    taps), so each peak comes out half the taps (6 samples) after the sample
+    it belongs to. Nothing is allocated, so it can run on the audio thread.
+*/
+class TruePeakDetector
+{
+    public:
+        /**
+        * PURPOSE: Creates the TruePeakDetector object and designs its interpolator.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        TruePeakDetector();
+
+        /**
+        * PURPOSE: Destroys the TruePeakDetector object.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        ~TruePeakDetector();
+
+        /**
+        * PURPOSE: Forgets the samples fed so far.
+        * INPUTS: None.
+        * OUTPUTS: None.
+        */
+        void reset();
+
+        /**
+        * PURPOSE: Feeds the next sample of both channels and upsamples around it.
+        * INPUTS: The left and right samples.
+        * OUTPUTS: The largest absolute value of both channels at the sample latencySamples ago
+        *          and at the three points upsampled after it.
+        */
+        float process(float left, float right);
+
+
+        /** DATA MEMBERS */
+
+        static constexpr int oversampling = 4;
+        static constexpr int tapsPerPhase = 12;
+        static constexpr int latencySamples = tapsPerPhase / 2;
+
+    private:
+        /** DATA MEMBERS */
+
+        // The interpolator's phases and the last samples of each channel, written twice
+        // so that the latest tapsPerPhase samples are always contiguous.
+        float phases[oversampling][tapsPerPhase];
+        float history[2][2 * tapsPerPhase];
+        int historyPosition;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TruePeakDetector)
+};
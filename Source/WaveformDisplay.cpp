@@ -22,7 +22,8 @@ WaveformDisplay::WaveformDisplay(juce::AudioFormatManager & formatManagerToUse,
                                  trackName(""),
                                  trackLength(""),
                                  formatManager(formatManagerToUse),
-                                 accentColour(colourToUse)
+                                 accentColour(colourToUse),
+                                 beatGrid{ 0.0, 0.0, 0.0 }
                           
 {
     audioThumb.addChangeListener(this);
@@ -61,6 +62,29 @@ void WaveformDisplay::paint (juce::Graphics& g)
                                audioThumb.getTotalLength(), 
                                0, 
                                1.0f);
+
+        // Draw the beat grid: a tick per beat, or per bar (and so on) when beats would crowd together.
+        double totalLength = audioThumb.getTotalLength();
+
+        if (beatGrid.bpm > 0.0 && totalLength > 0.0)
+        {
+            double beatSeconds = 60.0 / beatGrid.bpm;
+            double tickSeconds = beatSeconds;
+
+            while (tickSeconds / totalLength * getWidth() < 4.0)
+            {
+                tickSeconds *= 4.0;
+            }
+
+            g.setColour(Colours::white.withAlpha(0.4f));
+
+            for (double tick = beatGrid.firstBeatSeconds; tick < totalLength; tick += tickSeconds)
+            {
+                int tickX = (int) (tick / totalLength * getWidth());
+                g.drawVerticalLine(tickX, (float) getHeight() - 8.0f, (float) getHeight());
+            }
+        }
+
         g.setColour(Colours::lightgreen);
         
         // Draw playhead.
@@ -83,13 +107,14 @@ void WaveformDisplay::resized()
 
 }
 
-void WaveformDisplay::loadFile(juce::String fileName, juce::String fileLength, juce::URL audioURL)
+void WaveformDisplay::loadFile(juce::String fileName, juce::String fileLength, juce::URL audioURL, juce::uint64 contentHash)
 {
     trackName = fileName;
     trackLength = fileLength;
+    beatGrid = { 0.0, 0.0, 0.0 };
     
     audioThumb.clear();
-    fileLoaded = audioThumb.setSource(new juce::URLInputSource(audioURL));
+    fileLoaded = audioThumb.setSource(new AnalysisThumbnailCache::TrackInputSource(audioURL, contentHash));
     if (fileLoaded)
     {
         repaint();
@@ -99,6 +124,12 @@ void WaveformDisplay::loadFile(juce::String fileName, juce::String fileLength, j
     }
 }
 
+void WaveformDisplay::setBeatGrid(const BeatDetector::BeatGrid& grid)
+{
+    beatGrid = grid;
+    repaint();
+}
+
 void WaveformDisplay::changeListenerCallback (juce::ChangeBroadcaster* source)
 {
     repaint();
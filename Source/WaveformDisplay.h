@@ -11,6 +11,8 @@
 #pragma once
 
 #include "../JuceLibraryCode/JuceHeader.h"
+#include "AnalysisThumbnailCache.h"
+#include "BeatDetector.h"
 
 //==============================================================================
 /*
@@ -61,11 +63,13 @@ class WaveformDisplay    : public juce::Component,
         void changeListenerCallback (juce::ChangeBroadcaster *source) override;
 
         /**
-        * PURPOSE: Load the track file to be painted.
-        * INPUTS: The track's name as a juce string, length as a juce string and file path as a juce URL.
+        * PURPOSE: Load the track file to be painted. Its waveform is taken from the analysis cache if
+        *          it was generated before.
+        * INPUTS: The track's name as a juce string, length as a juce string, file path as a juce URL
+        *         and the content hash of the file.
         * OUTPUTS: None.
         */
-        void loadFile(juce::String fileName, juce::String fileLength, juce::URL audioURL);
+        void loadFile(juce::String fileName, juce::String fileLength, juce::URL audioURL, juce::uint64 contentHash);
 
         /**
         * PURPOSE: Sets the position of the playhead relative to the track's length and between 0 and 1.
@@ -74,6 +78,13 @@ class WaveformDisplay    : public juce::Component,
         */
         void setPositionRelative(double pos);
 
+        /**
+        * PURPOSE: Sets the beat grid of the loaded track, drawn as ticks under the waveform.
+        * INPUTS: The beat grid (a BPM of 0 hides the ticks).
+        * OUTPUTS: None.
+        */
+        void setBeatGrid(const BeatDetector::BeatGrid& grid);
+
         /**
         * PURPOSE: Calculates the remaining duration of the track that is currently playing.
         * INPUTS: The current position of the playhead.
@@ -103,6 +114,7 @@ class WaveformDisplay    : public juce::Component,
         juce::String trackName;
         juce::String trackLength;
         juce::Colour accentColour;
+        BeatDetector::BeatGrid beatGrid;
     
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveformDisplay)
 };
\ No newline at end of file